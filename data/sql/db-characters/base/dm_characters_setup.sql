@@ -81,6 +81,30 @@ CREATE TABLE IF NOT EXISTS `dm_roguelike_leaderboard` (
     INDEX `idx_guid`   (`guid`)
 ) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
 
+-- ---------------------------------------------------------------------------
+-- Per-session combat telemetry (one row per ended session, for balancing
+-- and abuse review)
+-- ---------------------------------------------------------------------------
+CREATE TABLE IF NOT EXISTS `dm_session_telemetry` (
+    `id`               INT UNSIGNED NOT NULL AUTO_INCREMENT,
+    `guid`             INT UNSIGNED NOT NULL,               -- session leader
+    `map_id`           INT UNSIGNED NOT NULL,
+    `difficulty_id`    INT UNSIGNED NOT NULL,
+    `roguelike`        TINYINT UNSIGNED NOT NULL DEFAULT 0,
+    `success`          TINYINT UNSIGNED NOT NULL DEFAULT 0,
+    `duration`         INT UNSIGNED NOT NULL DEFAULT 0,     -- seconds
+    `party_size`       TINYINT UNSIGNED NOT NULL DEFAULT 1,
+    `damage_dealt`     BIGINT UNSIGNED NOT NULL DEFAULT 0,
+    `damage_taken`     BIGINT UNSIGNED NOT NULL DEFAULT 0,  -- after module scaling
+    `damage_taken_raw` BIGINT UNSIGNED NOT NULL DEFAULT 0,  -- before module scaling
+    `healing`          BIGINT UNSIGNED NOT NULL DEFAULT 0,
+    `overkill`         BIGINT UNSIGNED NOT NULL DEFAULT 0,
+    `ended_at`         DATETIME     NOT NULL DEFAULT CURRENT_TIMESTAMP,
+    PRIMARY KEY (`id`),
+    INDEX `idx_guid`     (`guid`),
+    INDEX `idx_map_diff` (`map_id`, `difficulty_id`)
+) ENGINE=InnoDB DEFAULT CHARSET=utf8mb4;
+
 -- ---------------------------------------------------------------------------
 -- MIGRATION: If upgrading from a previous version, this adds new columns
 -- to existing tables.  Safe to run on fresh installs (columns already exist).
@@ -0,0 +1,90 @@
+/*
+ * mod-dungeon-master — DMArena.cpp
+ * Block management for the bump arena.
+ */
+
+#include "DMArena.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace DungeonMaster
+{
+
+DMArena& DMArena::Tick()
+{
+    static DMArena instance;
+    return instance;
+}
+
+void* DMArena::Allocate(size_t size, size_t align)
+{
+    ++_allocations;
+    _tickBytes += size;
+
+    for (;;)
+    {
+        if (_current < _blocks.size())
+        {
+            Block& b = _blocks[_current];
+            uintptr_t base = reinterpret_cast<uintptr_t>(b.Data.get());
+            uintptr_t p    = (base + _offset + align - 1) & ~uintptr_t(align - 1);
+            if (p + size <= base + b.Size)
+            {
+                _offset = p + size - base;
+                return reinterpret_cast<void*>(p);
+            }
+            if (_current + 1 < _blocks.size())
+            {
+                ++_current;
+                _offset = 0;
+                continue;
+            }
+        }
+
+        AddBlock(size + align);
+        _current = _blocks.size() - 1;
+        _offset  = 0;
+    }
+}
+
+void DMArena::Reset()
+{
+    _highWater = std::max(_highWater, _tickBytes);
+
+    if (_blocks.size() > 1)
+    {
+        size_t total = BlockBytes();
+        _blocks.clear();
+        AddBlock(total);
+    }
+
+    _current   = 0;
+    _offset    = 0;
+    _tickBytes = 0;
+    ++_resets;
+
+    _published.Allocations.store(_allocations, std::memory_order_relaxed);
+    _published.BlockAllocations.store(_blockAllocations, std::memory_order_relaxed);
+    _published.Resets.store(_resets, std::memory_order_relaxed);
+    _published.HighWater.store(_highWater, std::memory_order_relaxed);
+    _published.Capacity.store(BlockBytes(), std::memory_order_relaxed);
+}
+
+size_t DMArena::BlockBytes() const
+{
+    size_t total = 0;
+    for (Block const& b : _blocks)
+        total += b.Size;
+    return total;
+}
+
+void DMArena::AddBlock(size_t minSize)
+{
+    Block b;
+    b.Size = std::max(_blockSize, minSize);
+    b.Data.reset(new char[b.Size]);
+    _blocks.push_back(std::move(b));
+    ++_blockAllocations;
+}
+
+} // namespace DungeonMaster
@@ -0,0 +1,120 @@
+/*
+ * mod-dungeon-master — DMArena.h
+ * Bump allocator for update-scoped scratch data. Allocations are never
+ * freed individually; Reset() rewinds the whole arena at tick end.
+ */
+
+#ifndef DM_ARENA_H
+#define DM_ARENA_H
+
+#include "Define.h"
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace DungeonMaster
+{
+
+template<typename T> class DMArenaAllocator;
+template<typename T> using DMScratchVector = std::vector<T, DMArenaAllocator<T>>;
+
+class DMArena
+{
+public:
+    explicit DMArena(size_t blockSize = 16 * 1024) : _blockSize(blockSize) { }
+
+    DMArena(DMArena const&) = delete;
+    DMArena& operator=(DMArena const&) = delete;
+
+    // World-thread scratch arena shared by the manager Update loops;
+    // dm_world_script resets it after every world update.
+    static DMArena& Tick();
+
+    void* Allocate(size_t size, size_t align);
+
+    // Rewinds to empty. A tick that spilled into extra blocks leaves one
+    // block sized for the whole tick, so steady state allocates nothing.
+    void Reset();
+
+    template<typename T>
+    DMScratchVector<T> NewVector(size_t reserve = 0);
+
+    // As of the last Reset(): published with relaxed stores there, so any
+    // thread (.dm status) may read them while the owner keeps allocating.
+    uint64 GetAllocations()      const { return _published.Allocations.load(std::memory_order_relaxed); }
+    uint64 GetBlockAllocations() const { return _published.BlockAllocations.load(std::memory_order_relaxed); }
+    uint64 GetResets()           const { return _published.Resets.load(std::memory_order_relaxed); }
+    size_t GetHighWater()        const { return _published.HighWater.load(std::memory_order_relaxed); }
+    size_t GetCapacity()         const { return _published.Capacity.load(std::memory_order_relaxed); }
+
+private:
+    struct Block
+    {
+        std::unique_ptr<char[]> Data;
+        size_t                  Size = 0;
+    };
+
+    void   AddBlock(size_t minSize);
+    size_t BlockBytes() const;
+
+    size_t             _blockSize;
+    std::vector<Block> _blocks;
+    size_t             _current   = 0;      // block being bumped
+    size_t             _offset    = 0;      // within _blocks[_current]
+    size_t             _tickBytes = 0;      // requested since the last Reset
+
+    uint64 _allocations      = 0;
+    uint64 _blockAllocations = 0;
+    uint64 _resets           = 0;
+    size_t _highWater        = 0;
+
+    struct Published
+    {
+        std::atomic<uint64> Allocations{ 0 };
+        std::atomic<uint64> BlockAllocations{ 0 };
+        std::atomic<uint64> Resets{ 0 };
+        std::atomic<size_t> HighWater{ 0 };
+        std::atomic<size_t> Capacity{ 0 };
+    };
+    Published _published;
+};
+
+// std-compatible allocator over a DMArena; deallocate is a no-op.
+template<typename T>
+class DMArenaAllocator
+{
+public:
+    using value_type = T;
+
+    explicit DMArenaAllocator(DMArena& arena) : _arena(&arena) { }
+    template<typename U>
+    DMArenaAllocator(DMArenaAllocator<U> const& other) : _arena(other._arena) { }
+
+    T* allocate(size_t n) { return static_cast<T*>(_arena->Allocate(n * sizeof(T), alignof(T))); }
+    void deallocate(T*, size_t) { }
+
+    template<typename U>
+    bool operator==(DMArenaAllocator<U> const& other) const { return _arena == other._arena; }
+    template<typename U>
+    bool operator!=(DMArenaAllocator<U> const& other) const { return _arena != other._arena; }
+
+private:
+    template<typename U> friend class DMArenaAllocator;
+    DMArena* _arena;
+};
+
+template<typename T>
+DMScratchVector<T> DMArena::NewVector(size_t reserve)
+{
+    DMScratchVector<T> v{ DMArenaAllocator<T>(*this) };
+    if (reserve)
+        v.reserve(reserve);
+    return v;
+}
+
+} // namespace DungeonMaster
+
+#define sDMTickArena DungeonMaster::DMArena::Tick()
+
+#endif // DM_ARENA_H
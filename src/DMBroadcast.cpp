@@ -0,0 +1,74 @@
+/*
+ * mod-dungeon-master — DMBroadcast.cpp
+ * Prebuilt system-message packets and the fixed-message catalog.
+ */
+
+#include "DMBroadcast.h"
+#include "Chat.h"
+#include "WorldSession.h"
+#include <array>
+
+namespace DungeonMaster
+{
+
+void DMChatPacket::Build(std::string_view text)
+{
+    _lines.clear();
+
+    // Same line split as SendSysMessage: one packet per line, empty lines kept
+    size_t start = 0;
+    for (;;)
+    {
+        size_t end = text.find('\n', start);
+        std::string_view line = text.substr(start, end == std::string_view::npos ? end : end - start);
+
+        WorldPacket& data = _lines.emplace_back();
+        ChatHandler::BuildChatPacket(data, CHAT_MSG_SYSTEM, LANG_UNIVERSAL,
+            ObjectGuid::Empty, ObjectGuid::Empty, line, 0);
+
+        if (end == std::string_view::npos)
+            break;
+        start = end + 1;
+    }
+}
+
+void DMChatPacket::SendTo(Player* player) const
+{
+    WorldSession* session = player ? player->GetSession() : nullptr;
+    if (!session)
+        return;
+    for (WorldPacket const& data : _lines)
+        session->SendPacket(&data);
+}
+
+// Catalog, in DMMessage order
+static char const* const kMessageText[] =
+{
+    "|cFFFF0000[Dungeon Master]|r Teleport failed! You may lack access to this dungeon.",
+    "|cFFFFD700[Dungeon Master]|r A |cFFFF8800rare enemy|r lurks in this dungeon!",
+    "|cFFFF0000[Dungeon Master]|r Total party wipe! Challenge failed.",
+    "|cFFFFFF00[Dungeon Master]|r You have fallen! You will be revived when your group leaves combat.",
+    "|cFF00FFFF[Roguelike]|r Rewards added to your inventory!",
+    "|cFF00FF00[Dungeon Master]|r Challenge complete! Distributing rewards...",
+    "|cFFFF0000[Dungeon Master]|r Challenge ended. No rewards given.",
+    "|cFF00FF00[Dungeon Master]|r Preparing the challenge...",
+    "|cFFFF8000[Dungeon Master]|r The boss enters a new phase!",
+    "|cFF00FF00[Dungeon Master]|r Revived at entrance. Get back in there!",
+    "|cFFFF0000[Dungeon Master]|r Time's up! Challenge failed.",
+};
+static_assert(std::size(kMessageText) == size_t(DMMessage::Count), "kMessageText must match DMMessage");
+
+DMChatPacket const& GetMessagePacket(DMMessage id)
+{
+    // Packed on first use, read-only afterwards
+    static std::array<DMChatPacket, size_t(DMMessage::Count)> const catalog = []
+    {
+        std::array<DMChatPacket, size_t(DMMessage::Count)> c;
+        for (size_t i = 0; i < c.size(); ++i)
+            c[i].Build(kMessageText[i]);
+        return c;
+    }();
+    return catalog[size_t(id)];
+}
+
+} // namespace DungeonMaster
@@ -0,0 +1,76 @@
+/*
+ * mod-dungeon-master — DMBroadcast.h
+ * System messages packed once and sent to a whole party: announcements,
+ * progress updates and countdowns. Fixed texts come from a catalog that
+ * is packed on first use.
+ */
+
+#ifndef DM_BROADCAST_H
+#define DM_BROADCAST_H
+
+#include "Define.h"
+#include "DMTypes.h"
+#include "ObjectAccessor.h"
+#include "Player.h"
+#include "WorldPacket.h"
+#include <string_view>
+#include <vector>
+
+namespace DungeonMaster
+{
+
+// The SMSG_MESSAGECHAT packets (CHAT_MSG_SYSTEM, one per line) that
+// ChatHandler::SendSysMessage would build for every recipient, built once.
+class DMChatPacket
+{
+public:
+    DMChatPacket() = default;
+    explicit DMChatPacket(std::string_view text) { Build(text); }
+
+    void Build(std::string_view text);
+    void SendTo(Player* player) const;
+
+    // Every online member of a session or run (anything with PlayerGuid).
+    template<typename Members>
+    void SendToMembers(Members const& members) const
+    {
+        for (auto const& m : members)
+            if (Player* p = ObjectAccessor::FindPlayer(m.PlayerGuid))
+                SendTo(p);
+    }
+
+    // Members already resolved this tick; no lookups.
+    void SendToMembers(SessionMembers const& members) const
+    {
+        for (ResolvedMember const& m : members)
+            if (m.Ptr)
+                SendTo(m.Ptr);
+    }
+
+private:
+    std::vector<WorldPacket> _lines;
+};
+
+// Recurring fixed messages.
+enum class DMMessage : uint8
+{
+    TeleportFailed,
+    RareSpawned,
+    PartyWipe,
+    PlayerFallen,
+    RoguelikeRewardsAdded,
+    ChallengeComplete,
+    ChallengeEnded,
+    PreparingChallenge,
+    BossNewPhase,
+    RevivedAtEntrance,
+    TimeUp,
+
+    Count
+};
+
+DMChatPacket const& GetMessagePacket(DMMessage id);
+
+} // namespace DungeonMaster
+
+#endif // DM_BROADCAST_H
@@ -0,0 +1,94 @@
+/*
+ * mod-dungeon-master — DMCommandQueue.h
+ * Lock-free multi-producer / single-consumer queue (Vyukov's intrusive
+ * list with a stub node). Any thread may Push; only the owner Pops.
+ */
+
+#ifndef DM_COMMAND_QUEUE_H
+#define DM_COMMAND_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+namespace DungeonMaster
+{
+
+template<typename T>
+class DMMpscQueue
+{
+public:
+    DMMpscQueue() : _head(&_stub), _tail(&_stub) { }
+    ~DMMpscQueue() { Clear(); }
+
+    DMMpscQueue(DMMpscQueue const&) = delete;
+    DMMpscQueue& operator=(DMMpscQueue const&) = delete;
+
+    // Wait-free: one exchange and one store.
+    void Push(T value)
+    {
+        Link(new Node(std::move(value)));
+    }
+
+    // Consumer only. False when empty, or when the next item's producer
+    // is between its two steps (it is picked up on a later call).
+    bool Pop(T& out)
+    {
+        Node* tail = _tail;
+        Node* next = tail->Next.load(std::memory_order_acquire);
+        if (tail == &_stub)
+        {
+            if (!next)
+                return false;
+            _tail = next;
+            tail  = next;
+            next  = next->Next.load(std::memory_order_acquire);
+        }
+
+        if (!next)
+        {
+            if (tail != _head.load(std::memory_order_acquire))
+                return false;
+            Link(&_stub);
+            next = tail->Next.load(std::memory_order_acquire);
+            if (!next)
+                return false;
+        }
+
+        _tail = next;
+        out = std::move(tail->Value);
+        delete tail;
+        return true;
+    }
+
+    // Consumer only.
+    void Clear()
+    {
+        T discard;
+        while (Pop(discard)) { }
+    }
+
+private:
+    struct Node
+    {
+        Node() = default;
+        explicit Node(T&& value) : Value(std::move(value)) { }
+
+        std::atomic<Node*> Next{ nullptr };
+        T                  Value{};
+    };
+
+    void Link(Node* node)
+    {
+        node->Next.store(nullptr, std::memory_order_relaxed);
+        Node* prev = _head.exchange(node, std::memory_order_acq_rel);
+        prev->Next.store(node, std::memory_order_release);
+    }
+
+    std::atomic<Node*> _head;     // producers
+    Node*              _tail;     // consumer
+    Node               _stub;
+};
+
+} // namespace DungeonMaster
+
+#endif // DM_COMMAND_QUEUE_H
@@ -4,49 +4,65 @@
  */
 
 #include "DMConfig.h"
+#include "DMConfigParse.h"
+#include "DMDungeonTable.h"
+#include "DMHookRecorder.h"
+#include "DMTrace.h"
 #include "Config.h"
 #include "Log.h"
+#include <algorithm>
+#include <cstdio>
 #include <sstream>
 
 namespace DungeonMaster
 {
 
-
-static std::vector<std::string> SplitString(const std::string& str, char delim)
+// Singleton
+DMConfig* DMConfig::Instance()
 {
-    std::vector<std::string> tokens;
-    std::stringstream ss(str);
-    std::string token;
-    while (std::getline(ss, token, delim))
-    {
-        size_t start = token.find_first_not_of(" \t");
-        size_t end   = token.find_last_not_of(" \t");
-        if (start != std::string::npos && end != std::string::npos)
-            tokens.push_back(token.substr(start, end - start + 1));
-        else if (!token.empty())
-            tokens.push_back(token);
-    }
-    return tokens;
+    static DMConfig instance;
+    return &instance;
 }
 
+// Build a snapshot from the config file and publish it
+void DMConfig::LoadConfig(bool reload)
+{
+    auto snapshot = std::make_unique<DMConfigSnapshot>();
+    snapshot->Load(reload);
+
+    DMLockGuard lock(_publishMutex);
+    snapshot->_version = ++_version;
+    _current.store(snapshot.get(), std::memory_order_release);
+    if (_live)
+        _retired.push_back({ std::move(_live), _tick });
+    _live = std::move(snapshot);
+}
 
-static std::string StripQuotes(const std::string& s)
+void DMConfig::LoadAndApply(bool reload)
 {
-    std::string out = s;
-    if (!out.empty() && out.front() == '"') out.erase(out.begin());
-    if (!out.empty() && out.back()  == '"') out.pop_back();
-    return out;
+    LoadConfig(reload);
+
+    DMConfigSnapshot const* cfg = Current();
+    sDMTrace->Configure(cfg->IsTraceEnabled(), cfg->GetTraceFile(), cfg->GetTraceMaxFileSizeMB());
+    DMMutex::SetProfilingEnabled(cfg->IsLockProfilerEnabled());
+    sDMHookRecorder->Configure(cfg->IsHookRecorderEnabled(), cfg->GetHookRecorderFile(),
+        cfg->GetHookRecorderMaxFileSizeMB());
 }
 
-// Singleton
-DMConfig* DMConfig::Instance()
+// A map thread that read the old pointer just before the swap is done with
+// it by the end of the next full map update; two world ticks cover that.
+void DMConfig::ReclaimRetired()
 {
-    static DMConfig instance;
-    return &instance;
+    DMLockGuard lock(_publishMutex);
+    ++_tick;
+    _retired.erase(std::remove_if(_retired.begin(), _retired.end(), [this](Retired const& r)
+    {
+        return _tick >= r.RetiredTick + 2 && r.Snapshot->_pins.load(std::memory_order_acquire) == 0;
+    }), _retired.end());
 }
 
 // Load all config values
-void DMConfig::LoadConfig(bool reload)
+void DMConfigSnapshot::Load(bool reload)
 {
     if (reload)
         LOG_INFO("module", "DungeonMaster: Reloading configuration...");
@@ -81,6 +97,13 @@ void DMConfig::LoadConfig(bool reload)
     _rareSpawnChance = sConfigMgr->GetOption<uint32>("DungeonMaster.Dungeon.RareSpawnChance", 5);
     _rareHealthMult  = sConfigMgr->GetOption<float> ("DungeonMaster.Scaling.RareHealthMult",  4.0f);
     _rareDamageMult  = sConfigMgr->GetOption<float> ("DungeonMaster.Scaling.RareDamageMult",  2.0f);
+    _corpseLootedGrace = sConfigMgr->GetOption<uint32>("DungeonMaster.Dungeon.CorpseLootedGrace", 10);
+    _corpseBudget      = sConfigMgr->GetOption<uint32>("DungeonMaster.Dungeon.CorpseBudget",      40);
+    _loadTickMs        = sConfigMgr->GetOption<uint32>("DungeonMaster.Dungeon.LoadTickMs",        150);
+    _loadTickMaxMs     = sConfigMgr->GetOption<uint32>("DungeonMaster.Dungeon.LoadTickMaxMs",     400);
+    _loadCreatures     = sConfigMgr->GetOption<uint32>("DungeonMaster.Dungeon.LoadCreatures",     3000);
+    _loadCreaturesMax  = sConfigMgr->GetOption<uint32>("DungeonMaster.Dungeon.LoadCreaturesMax",  8000);
+    _loadMinDensity    = sConfigMgr->GetOption<float> ("DungeonMaster.Dungeon.LoadMinDensity",    0.5f);
 
     // Timers
     _cooldownMinutes   = sConfigMgr->GetOption<uint32>("DungeonMaster.Cooldown.Minutes",     5);
@@ -110,6 +133,15 @@ void DMConfig::LoadConfig(bool reload)
     _roguelikeMaxBuffs        = sConfigMgr->GetOption<uint32>("DungeonMaster.Roguelike.MaxBuffs",            20);
     _roguelikeVendorEnabled = sConfigMgr->GetOption<bool>("DungeonMaster.Roguelike.VendorEnable", true);
 
+    // Diagnostics
+    _traceEnabled       = sConfigMgr->GetOption<bool>       ("DungeonMaster.Trace.Enable",        false);
+    _traceFile          = sConfigMgr->GetOption<std::string>("DungeonMaster.Trace.File",          "dm_trace.json");
+    _traceMaxFileSizeMB = sConfigMgr->GetOption<uint32>     ("DungeonMaster.Trace.MaxFileSizeMB", 64);
+    _lockProfilerEnabled = sConfigMgr->GetOption<bool>      ("DungeonMaster.LockProfiler.Enable", false);
+    _hookRecorderEnabled = sConfigMgr->GetOption<bool>      ("DungeonMaster.HookRecorder.Enable", false);
+    _hookRecorderFile    = sConfigMgr->GetOption<std::string>("DungeonMaster.HookRecorder.File",  "dm_hooks.dmhk");
+    _hookRecorderMaxFileSizeMB = sConfigMgr->GetOption<uint32>("DungeonMaster.HookRecorder.MaxFileSizeMB", 256);
+
     // White / black lists
     _dungeonWhitelist.clear();
     _dungeonBlacklist.clear();
@@ -121,13 +153,15 @@ void DMConfig::LoadConfig(bool reload)
     LoadThemes();
     LoadDungeons();
     LoadRoguelikeBuffPool();
+    BuildLookupTables();
+    BuildMenus();
 
     LOG_INFO("module", "DungeonMaster: Config loaded — {} difficulties, {} themes, {} dungeons, {} roguelike buffs.",
         _difficulties.size(), _themes.size(), _dungeons.size(), _roguelikeBuffPool.size());
 }
 
 // Load difficulty tiers from config
-void DMConfig::LoadDifficulties()
+void DMConfigSnapshot::LoadDifficulties()
 {
     _difficulties.clear();
 
@@ -138,20 +172,9 @@ void DMConfig::LoadDifficulties()
         if (val.empty())
             break;
 
-        auto parts = SplitString(StripQuotes(val), ',');
-        if (parts.size() < 7) continue;
-
         DifficultyTier t;
-        t.Id = i;
-        t.Name = parts[0];
-        try {
-            t.MinLevel         = static_cast<uint8>(std::stoi(parts[1]));
-            t.MaxLevel         = static_cast<uint8>(std::stoi(parts[2]));
-            t.HealthMultiplier = std::stof(parts[3]);
-            t.DamageMultiplier = std::stof(parts[4]);
-            t.RewardMultiplier = std::stof(parts[5]);
-            t.MobCountMultiplier = std::stof(parts[6]);
-        } catch (...) {
+        if (!Core::ParseDifficultyTier(val, i, t))
+        {
             LOG_ERROR("module", "DungeonMaster: Bad difficulty entry #{}", i);
             continue;
         }
@@ -168,7 +191,7 @@ void DMConfig::LoadDifficulties()
 }
 
 // Load themes from config
-void DMConfig::LoadThemes()
+void DMConfigSnapshot::LoadThemes()
 {
     _themes.clear();
 
@@ -179,20 +202,8 @@ void DMConfig::LoadThemes()
         if (val.empty())
             break;
 
-        auto parts = SplitString(StripQuotes(val), ',');
-        if (parts.size() < 2) continue;
-
         Theme theme;
-        theme.Id   = i;
-        theme.Name = parts[0];
-
-        for (size_t j = 1; j < parts.size(); ++j)
-        {
-            try {
-                theme.CreatureTypes.push_back(
-                    static_cast<uint32>(std::stoi(parts[j])));
-            } catch (...) { /* skip bad token */ }
-        }
+        if (!Core::ParseTheme(val, i, theme)) continue;
         _themes.push_back(theme);
     }
 
@@ -206,130 +217,180 @@ void DMConfig::LoadThemes()
 }
 
     // hard-coded list of WotLK 5-man instances with level ranges
-void DMConfig::LoadDungeons()
+void DMConfigSnapshot::LoadDungeons()
 {
     _dungeons.clear();
 
-    struct Def { uint32 map; const char* name; uint8 lo; uint8 hi; };
-
-    static const Def kDungeons[] =
-    {
-        // Classic
-        { 389, "Ragefire Chasm",       13, 20 },
-        {  36, "Deadmines",            15, 25 },
-        {  33, "Shadowfang Keep",      18, 28 },
-        {  34, "The Stockade",         20, 30 },
-        {  43, "Wailing Caverns",      15, 28 },
-        {  48, "Blackfathom Deeps",    20, 32 },
-        {  47, "Razorfen Kraul",       25, 35 },
-        {  90, "Gnomeregan",           25, 38 },
-        { 129, "Razorfen Downs",       35, 45 },
-        { 189, "Scarlet Monastery",    30, 45 },
-        {  70, "Uldaman",              38, 50 },
-        { 209, "Zul'Farrak",           42, 52 },
-        { 349, "Maraudon",             40, 52 },
-        { 109, "Sunken Temple",        45, 55 },
-        { 230, "Blackrock Depths",     48, 60 },
-        { 229, "Blackrock Spire",      52, 60 },
-        { 289, "Scholomance",          55, 60 },
-        { 329, "Stratholme",           55, 60 },
-        // TBC
-        { 543, "Hellfire Ramparts",    58, 70 },
-        { 542, "Blood Furnace",        59, 70 },
-        { 547, "Slave Pens",           60, 70 },
-        { 546, "Underbog",             61, 70 },
-        { 557, "Mana-Tombs",           62, 70 },
-        { 558, "Auchenai Crypts",      63, 70 },
-        { 556, "Sethekk Halls",        65, 70 },
-        { 555, "Shadow Labyrinth",     68, 70 },
-        { 540, "Shattered Halls",      68, 70 },
-        { 553, "Botanica",             68, 70 },
-        { 554, "Mechanar",             68, 70 },
-        { 552, "Arcatraz",             68, 70 },
-        // WotLK
-        { 574, "Utgarde Keep",         68, 80 },
-        { 576, "The Nexus",            69, 80 },
-        { 601, "Azjol-Nerub",          70, 80 },
-        { 619, "Ahn'kahet",            71, 80 },
-        { 600, "Drak'Tharon Keep",     72, 80 },
-        { 608, "Violet Hold",          73, 80 },
-        { 604, "Gundrak",              74, 80 },
-        { 599, "Halls of Stone",       75, 80 },
-        { 602, "Halls of Lightning",   77, 80 },
-        { 578, "The Oculus",           77, 80 },
-        { 575, "Utgarde Pinnacle",     78, 80 },
-        { 595, "Culling of Stratholme",78, 80 },
-        { 632, "Forge of Souls",       79, 80 },
-        { 658, "Pit of Saron",         79, 80 },
-        { 668, "Halls of Reflection",  79, 80 },
-    };
-
-    for (const auto& d : kDungeons)
+    for (const auto& d : Core::DUNGEON_TABLE)
     {
-        if (!IsDungeonAllowed(d.map))
+        if (!IsDungeonAllowed(d.Map))
             continue;
 
         DungeonInfo info;
-        info.MapId       = d.map;
-        info.Name        = d.name;
-        info.MinLevel    = d.lo;
-        info.MaxLevel    = d.hi;
+        info.MapId       = d.Map;
+        info.Name        = d.Name;
+        info.MinLevel    = d.MinLevel;
+        info.MaxLevel    = d.MaxLevel;
         info.IsAvailable = true;
         _dungeons.push_back(info);
     }
 }
 
 // Utility
-void DMConfig::ParseStringList(const std::string& str, std::unordered_set<uint32>& outSet)
+void DMConfigSnapshot::ParseStringList(const std::string& str, std::unordered_set<uint32>& outSet)
+{
+    Core::ParseIdList(str, outSet);
+}
+
+// Dense indexes and per-level / per-difficulty spans, so the lookups below
+// are O(1) and never allocate. Pointers stay valid until the next load.
+void DMConfigSnapshot::BuildLookupTables()
 {
-    if (str.empty()) return;
-    for (const auto& tok : SplitString(str, ','))
+    _difficultyIndex.Clear();
+    _themeIndex.Clear();
+    _dungeonIndex.Clear();
+
+    for (size_t i = 0; i < _difficulties.size(); ++i)
+        if (!_difficultyIndex.Set(_difficulties[i].Id, i))
+            LOG_ERROR("module", "DungeonMaster: Difficulty id {} out of range", _difficulties[i].Id);
+    for (size_t i = 0; i < _themes.size(); ++i)
+        if (!_themeIndex.Set(_themes[i].Id, i))
+            LOG_ERROR("module", "DungeonMaster: Theme id {} out of range", _themes[i].Id);
+    for (size_t i = 0; i < _dungeons.size(); ++i)
+        if (!_dungeonIndex.Set(_dungeons[i].MapId, i))
+            LOG_ERROR("module", "DungeonMaster: Dungeon map {} out of range", _dungeons[i].MapId);
+
+    _difficultiesByLevel.Clear();
+    _dungeonsByLevel.Clear();
+    for (uint32 level = 0; level <= 255; ++level)
+    {
+        for (const auto& d : _difficulties)
+            if (d.IsValidForLevel(uint8(level)))
+                _difficultiesByLevel.Add(&d);
+        _difficultiesByLevel.EndGroup();
+
+        for (const auto& d : _dungeons)
+            if (d.IsAvailable && level >= d.MinLevel && level <= d.MaxLevel)
+                _dungeonsByLevel.Add(&d);
+        _dungeonsByLevel.EndGroup();
+    }
+
+    _dungeonsByDifficulty.Clear();
+    for (const auto& d : _dungeons)
+        if (d.IsAvailable)
+            _dungeonsByDifficulty.Add(&d);
+    _dungeonsByDifficulty.EndGroup();
+
+    for (const auto& diff : _difficulties)
     {
-        try { outSet.insert(static_cast<uint32>(std::stoul(tok))); }
-        catch (...) { /* skip */ }
+        for (const auto& d : _dungeons)
+            if (d.MaxLevel >= diff.MinLevel && d.MinLevel <= diff.MaxLevel && d.IsAvailable)
+                _dungeonsByDifficulty.Add(&d);
+        _dungeonsByDifficulty.EndGroup();
     }
 }
 
-const DifficultyTier* DMConfig::GetDifficulty(uint32 id) const
+// Difficulty lists only change where some tier's MinLevel or MaxLevel is
+// crossed, so each run of levels between those edges gets one band with a
+// plain and a roguelike list. Dungeon lists follow _dungeonsByDifficulty.
+void DMConfigSnapshot::BuildMenus()
 {
-    for (const auto& d : _difficulties)
-        if (d.Id == id) return &d;
-    return nullptr;
+    _menuBandByLevel.assign(256, 0);
+    _difficultyMenus.Clear();
+
+    char buf[256];
+    uint16 bands = 0;
+    for (uint32 level = 0; level <= 255; ++level)
+    {
+        bool edge = level == 0;
+        for (const auto& d : _difficulties)
+            if (level == d.MinLevel || level == uint32(d.MaxLevel) + 1)
+                edge = true;
+        if (!edge)
+        {
+            _menuBandByLevel[level] = bands - 1;
+            continue;
+        }
+        _menuBandByLevel[level] = bands++;
+
+        uint8 lvl = uint8(level);
+        for (bool roguelike : { false, true })
+        {
+            for (const auto& d : _difficulties)
+            {
+                if (!d.IsValidForLevel(lvl))
+                    snprintf(buf, sizeof(buf), "|cFF808080%s|r (Lv %u-%u) - |cFFFF0000Requires %u+|r",
+                        d.Name.c_str(), d.MinLevel, d.MaxLevel, d.MinLevel);
+                else if (roguelike)
+                    snprintf(buf, sizeof(buf), "|cFF00FFFF%s|r (Lv %u-%u)",
+                        d.Name.c_str(), d.MinLevel, d.MaxLevel);
+                else if (!d.IsOnLevelFor(lvl))
+                    snprintf(buf, sizeof(buf), "%s |cFF808080(Lv %u-%u — Easy)|r",
+                        d.Name.c_str(), d.MinLevel, d.MaxLevel);
+                else
+                    snprintf(buf, sizeof(buf), "|cFF00FF00%s|r (Lv %u-%u)",
+                        d.Name.c_str(), d.MinLevel, d.MaxLevel);
+
+                _difficultyMenus.Add({ buf, d.Id, d.IsValidForLevel(lvl) });
+            }
+            _difficultyMenus.EndGroup();
+        }
+    }
+
+    _dungeonMenus.Clear();
+    for (size_t slot = 0; slot < _difficulties.size(); ++slot)
+    {
+        for (const DungeonInfo* dg : _dungeonsByDifficulty.Get(slot + 1))
+        {
+            snprintf(buf, sizeof(buf), "%s (Lv %u-%u)", dg->Name.c_str(), dg->MinLevel, dg->MaxLevel);
+            _dungeonMenus.Add({ buf, dg->MapId, true });
+        }
+        _dungeonMenus.EndGroup();
+    }
 }
 
-std::vector<const DifficultyTier*> DMConfig::GetDifficultiesForLevel(uint8 level) const
+MenuSpan DMConfigSnapshot::GetDifficultyMenu(uint8 level, bool roguelike) const
 {
-    std::vector<const DifficultyTier*> out;
-    for (const auto& d : _difficulties)
-        if (d.IsValidForLevel(level))
-            out.push_back(&d);
-    return out;
+    if (_menuBandByLevel.empty())
+        return {};
+    return _difficultyMenus.Get(_menuBandByLevel[level] * 2u + (roguelike ? 1 : 0));
 }
 
-const Theme* DMConfig::GetTheme(uint32 id) const
+MenuSpan DMConfigSnapshot::GetDungeonMenu(uint32 difficultyId) const
 {
-    for (const auto& t : _themes)
-        if (t.Id == id) return &t;
-    return nullptr;
+    uint32 slot = _difficultyIndex.Find(difficultyId);
+    if (slot == Core::DenseIndex::NPOS)
+        return {};
+    return _dungeonMenus.Get(slot);
 }
 
-const DungeonInfo* DMConfig::GetDungeon(uint32 mapId) const
+const DifficultyTier* DMConfigSnapshot::GetDifficulty(uint32 id) const
 {
-    for (const auto& d : _dungeons)
-        if (d.MapId == mapId) return &d;
-    return nullptr;
+    uint32 slot = _difficultyIndex.Find(id);
+    return slot != Core::DenseIndex::NPOS ? &_difficulties[slot] : nullptr;
 }
 
-std::vector<const DungeonInfo*> DMConfig::GetDungeonsForLevel(uint8 minLevel, uint8 maxLevel) const
+const Theme* DMConfigSnapshot::GetTheme(uint32 id) const
 {
-    std::vector<const DungeonInfo*> out;
-    for (const auto& d : _dungeons)
-        if (d.MaxLevel >= minLevel && d.MinLevel <= maxLevel && d.IsAvailable)
-            out.push_back(&d);
-    return out;
+    uint32 slot = _themeIndex.Find(id);
+    return slot != Core::DenseIndex::NPOS ? &_themes[slot] : nullptr;
+}
+
+const DungeonInfo* DMConfigSnapshot::GetDungeon(uint32 mapId) const
+{
+    uint32 slot = _dungeonIndex.Find(mapId);
+    return slot != Core::DenseIndex::NPOS ? &_dungeons[slot] : nullptr;
+}
+
+DungeonSpan DMConfigSnapshot::GetDungeonsForDifficulty(uint32 difficultyId) const
+{
+    uint32 slot = _difficultyIndex.Find(difficultyId);
+    if (slot == Core::DenseIndex::NPOS)
+        return {};
+    return _dungeonsByDifficulty.Get(slot + 1);
 }
 
-bool DMConfig::IsDungeonAllowed(uint32 mapId) const
+bool DMConfigSnapshot::IsDungeonAllowed(uint32 mapId) const
 {
     if (_dungeonBlacklist.count(mapId)) return false;
     if (!_dungeonWhitelist.empty() && !_dungeonWhitelist.count(mapId)) return false;
@@ -337,7 +398,7 @@ bool DMConfig::IsDungeonAllowed(uint32 mapId) const
 }
 
     // sequential entries from DungeonMaster
-void DMConfig::LoadRoguelikeBuffPool()
+void DMConfigSnapshot::LoadRoguelikeBuffPool()
 {
     _roguelikeBuffPool.clear();
 
@@ -1,6 +1,7 @@
 /*
  * mod-dungeon-master — Config singleton
- * Reads settings from mod_dungeon_master.conf.dist. Thread-safe (loaded on world thread).
+ * Reads settings from mod_dungeon_master.conf.dist into an immutable snapshot
+ * and publishes it by pointer swap; readers never lock. Loaded on the world thread.
  * AGPL v3
  */
 
@@ -8,7 +9,11 @@
 #define DM_CONFIG_H
 
 #include "DMTypes.h"
+#include "DMLookupTable.h"
+#include "DMMutex.h"
 #include "RoguelikeTypes.h"
+#include <atomic>
+#include <memory>
 #include <vector>
 #include <unordered_map>
 #include <unordered_set>
@@ -16,15 +21,32 @@
 namespace DungeonMaster
 {
 
-class DMConfig
+// Views into a snapshot's load-time tables; valid as long as the snapshot.
+using DifficultySpan = Core::Span<const DifficultyTier*>;
+using DungeonSpan    = Core::Span<const DungeonInfo*>;
+
+// One gossip option with its text formatted at load. Id is the difficulty
+// id or dungeon map id the option selects.
+struct MenuLine
 {
-    DMConfig() = default;
-    ~DMConfig() = default;
+    std::string Text;
+    uint32      Id      = 0;
+    bool        Enabled = true;
+};
+using MenuSpan = Core::Span<MenuLine>;
 
+class DMConfig;
+
+// One loaded configuration. Never modified after it is published, so any
+// pointer or span it hands out stays valid as long as the snapshot does.
+class DMConfigSnapshot
+{
 public:
-    static DMConfig* Instance();
+    DMConfigSnapshot() = default;
+    DMConfigSnapshot(DMConfigSnapshot const&) = delete;
+    DMConfigSnapshot& operator=(DMConfigSnapshot const&) = delete;
 
-    void LoadConfig(bool reload = false);
+    uint32 GetVersion() const { return _version; }
 
     // --- Core ---
     bool   IsEnabled()        const { return _enabled; }
@@ -34,7 +56,7 @@ public:
     // --- Difficulties ---
     const std::vector<DifficultyTier>&      GetDifficulties() const { return _difficulties; }
     const DifficultyTier*                   GetDifficulty(uint32 id) const;
-    std::vector<const DifficultyTier*>      GetDifficultiesForLevel(uint8 level) const;
+    DifficultySpan                          GetDifficultiesForLevel(uint8 level) const { return _difficultiesByLevel.Get(level); }
 
     // --- Themes ---
     const std::vector<Theme>&   GetThemes() const { return _themes; }
@@ -43,9 +65,15 @@ public:
     // --- Dungeons ---
     const std::vector<DungeonInfo>&     GetDungeons() const { return _dungeons; }
     const DungeonInfo*                  GetDungeon(uint32 mapId) const;
-    std::vector<const DungeonInfo*>     GetDungeonsForLevel(uint8 minLevel, uint8 maxLevel) const;
+    DungeonSpan                         GetAvailableDungeons() const { return _dungeonsByDifficulty.Get(0); }
+    DungeonSpan                         GetDungeonsForLevel(uint8 level) const { return _dungeonsByLevel.Get(level); }
+    DungeonSpan                         GetDungeonsForDifficulty(uint32 difficultyId) const;
     bool                                IsDungeonAllowed(uint32 mapId) const;
 
+    // --- Gossip menus ---
+    MenuSpan GetDifficultyMenu(uint8 level, bool roguelike) const;
+    MenuSpan GetDungeonMenu(uint32 difficultyId) const;
+
     // --- Scaling ---
     uint8 GetLevelBand()          const { return _levelBand; }
     float GetPerPlayerHealthMult() const { return _perPlayerHealth; }
@@ -72,6 +100,13 @@ public:
     uint32 GetRareSpawnChance() const { return _rareSpawnChance; }
     float  GetRareHealthMult()  const { return _rareHealthMult; }
     float  GetRareDamageMult()  const { return _rareDamageMult; }
+    uint32 GetCorpseLootedGrace() const { return _corpseLootedGrace; }
+    uint32 GetCorpseBudget()      const { return _corpseBudget; }
+    uint32 GetLoadTickMs()        const { return _loadTickMs; }
+    uint32 GetLoadTickMaxMs()     const { return _loadTickMaxMs; }
+    uint32 GetLoadCreatures()     const { return _loadCreatures; }
+    uint32 GetLoadCreaturesMax()  const { return _loadCreaturesMax; }
+    float  GetLoadMinDensity()    const { return _loadMinDensity; }
 
     // --- Timers ---
     uint32 GetCooldownMinutes()   const { return _cooldownMinutes; }
@@ -102,11 +137,26 @@ public:
     const std::vector<RoguelikeBuff>& GetRoguelikeBuffPool() const { return _roguelikeBuffPool; }
     bool   IsRoguelikeVendorEnabled()       const { return _roguelikeVendorEnabled; }
 
+    // --- Diagnostics ---
+    bool               IsTraceEnabled()        const { return _traceEnabled; }
+    const std::string& GetTraceFile()          const { return _traceFile; }
+    uint32             GetTraceMaxFileSizeMB() const { return _traceMaxFileSizeMB; }
+    bool               IsLockProfilerEnabled() const { return _lockProfilerEnabled; }
+    bool               IsHookRecorderEnabled()        const { return _hookRecorderEnabled; }
+    const std::string& GetHookRecorderFile()          const { return _hookRecorderFile; }
+    uint32             GetHookRecorderMaxFileSizeMB() const { return _hookRecorderMaxFileSizeMB; }
+
 private:
+    friend class DMConfig;
+    friend class DMConfigPin;
+
+    void Load(bool reload);
     void LoadDifficulties();
     void LoadThemes();
     void LoadDungeons();
     void LoadRoguelikeBuffPool();
+    void BuildLookupTables();
+    void BuildMenus();
     void ParseStringList(const std::string& str, std::unordered_set<uint32>& outSet);
 
     // Core
@@ -121,6 +171,20 @@ private:
     std::unordered_set<uint32>      _dungeonWhitelist;
     std::unordered_set<uint32>      _dungeonBlacklist;
 
+    // Lookup tables over the data above, rebuilt after every load
+    Core::DenseIndex                        _difficultyIndex;       // id -> _difficulties slot
+    Core::DenseIndex                        _themeIndex;            // id -> _themes slot
+    Core::DenseIndex                        _dungeonIndex;          // map id -> _dungeons slot
+    Core::SpanTable<const DifficultyTier*>  _difficultiesByLevel;   // key: player level
+    Core::SpanTable<const DungeonInfo*>     _dungeonsByLevel;       // key: level inside the dungeon's range
+    Core::SpanTable<const DungeonInfo*>     _dungeonsByDifficulty;  // key: 0 = all available, else slot + 1
+
+    // Gossip menus, formatted once per load. Player levels that see the
+    // same difficulty list share a band.
+    std::vector<uint16>                     _menuBandByLevel;       // player level -> band
+    Core::SpanTable<MenuLine>               _difficultyMenus;       // key: band * 2 + roguelike
+    Core::SpanTable<MenuLine>               _dungeonMenus;          // key: difficulty slot
+
     // Scaling
     uint8 _levelBand       = 3;     // creatures must be within ±N levels
     float _perPlayerHealth = 0.25f;
@@ -147,6 +211,13 @@ private:
     uint32 _rareSpawnChance = 5;
     float  _rareHealthMult  = 4.0f;
     float  _rareDamageMult  = 2.0f;
+    uint32 _corpseLootedGrace = 10;
+    uint32 _corpseBudget      = 40;
+    uint32 _loadTickMs        = 150;    // 0 = ignore world tick time
+    uint32 _loadTickMaxMs     = 400;
+    uint32 _loadCreatures     = 3000;   // 0 = ignore live creature count
+    uint32 _loadCreaturesMax  = 8000;
+    float  _loadMinDensity    = 0.5f;
 
     // Timers
     uint32 _cooldownMinutes   = 5;
@@ -176,10 +247,84 @@ private:
     uint32 _roguelikeThirdAffixTier   = 10;
     uint32 _roguelikeMaxBuffs         = 20;
     std::vector<RoguelikeBuff> _roguelikeBuffPool;
+
+    // Diagnostics
+    bool        _traceEnabled       = false;
+    std::string _traceFile          = "dm_trace.json";
+    uint32      _traceMaxFileSizeMB = 64;
+    bool        _lockProfilerEnabled = false;
+    bool        _hookRecorderEnabled = false;
+    std::string _hookRecorderFile    = "dm_hooks.dmhk";
+    uint32      _hookRecorderMaxFileSizeMB = 256;
+
+    // Publication
+    uint32                       _version = 0;     // 0 = built-in defaults, before the first load
+    mutable std::atomic<uint32>  _pins{ 0 };
+};
+
+// Keeps a snapshot alive past the world tick it was read in.
+class DMConfigPin
+{
+public:
+    explicit DMConfigPin(DMConfigSnapshot const* snapshot) : _snapshot(snapshot)
+    {
+        _snapshot->_pins.fetch_add(1, std::memory_order_relaxed);
+    }
+    DMConfigPin(DMConfigPin const& other) : DMConfigPin(other._snapshot) {}
+    DMConfigPin& operator=(DMConfigPin const&) = delete;
+    ~DMConfigPin() { _snapshot->_pins.fetch_sub(1, std::memory_order_release); }
+
+    DMConfigSnapshot const* operator->() const { return _snapshot; }
+    DMConfigSnapshot const& operator*()  const { return *_snapshot; }
+
+private:
+    DMConfigSnapshot const* _snapshot;
+};
+
+// Owns the published snapshot. LoadConfig builds a new one off to the side
+// and swaps it in; the previous one is retired and freed by ReclaimRetired
+// once every map thread has been through a full update since the swap and
+// nothing pins it. Reads are one acquire load, and a pointer read from a
+// snapshot is good for the rest of the current hook or update; code that
+// walks one snapshot's tables at length (populate, gossip menus) pins it.
+class DMConfig
+{
+    DMConfig() = default;
+    ~DMConfig() = default;
+
+public:
+    static DMConfig* Instance();
+
+    void LoadConfig(bool reload = false);
+
+    // LoadConfig, then hands the trace, lock profiler and hook recorder
+    // settings to their owners. The config-load hook and .dm reload use it.
+    void LoadAndApply(bool reload = false);
+
+    DMConfigSnapshot const* Current() const { return _current.load(std::memory_order_acquire); }
+    DMConfigPin             Pin()     const { return DMConfigPin(Current()); }
+
+    // World thread, once per world update.
+    void ReclaimRetired();
+
+private:
+    struct Retired
+    {
+        std::unique_ptr<DMConfigSnapshot> Snapshot;
+        uint64 RetiredTick = 0;
+    };
+
+    DMConfigSnapshot                        _defaults;
+    std::atomic<DMConfigSnapshot const*>    _current{ &_defaults };
+    std::unique_ptr<DMConfigSnapshot>       _live;
+    std::vector<Retired>                    _retired;
+    uint64                                  _tick    = 0;
+    uint32                                  _version = 0;
+    mutable DMMutex                         _publishMutex{ "_configPublishMutex" };
 };
 
 } // namespace DungeonMaster
 
-#define sDMConfig DungeonMaster::DMConfig::Instance()
+#define sDMConfig DungeonMaster::DMConfig::Instance()->Current()
 
 #endif // DM_CONFIG_H
@@ -0,0 +1,147 @@
+/*
+ * mod-dungeon-master — DMHookRecorder.cpp
+ * Buffered binary writer for hook traffic. Recording stops (records are
+ * counted as dropped) once the file reaches its size cap.
+ */
+
+#include "DMHookRecorder.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+
+namespace DungeonMaster
+{
+
+static uint64 SteadyNowUs()
+{
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+DMHookRecorder::~DMHookRecorder()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    CloseLocked();
+}
+
+DMHookRecorder* DMHookRecorder::Instance()
+{
+    static DMHookRecorder instance;
+    return &instance;
+}
+
+void DMHookRecorder::Configure(bool enabled, std::string const& path, uint32 maxFileSizeMB)
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!path.empty() && path != _path)
+        {
+            CloseLocked();
+            _path = path;
+        }
+        _maxBytes = uint64(std::max<uint32>(1, maxFileSizeMB)) * 1024 * 1024;
+    }
+    SetEnabled(enabled);
+}
+
+bool DMHookRecorder::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (enabled && !_file && !OpenLocked())
+    {
+        _enabled.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    if (!enabled)
+        CloseLocked();
+    _enabled.store(enabled, std::memory_order_relaxed);
+    return true;
+}
+
+std::string DMHookRecorder::GetPath() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _path;
+}
+
+bool DMHookRecorder::OpenLocked()
+{
+    _file = std::fopen(_path.c_str(), "wb");
+    if (!_file)
+    {
+        LOG_ERROR("module", "DungeonMaster: Cannot open hook recording '{}'", _path);
+        return false;
+    }
+
+    Core::HookTraceHeader hdr;
+    hdr.RecordSize  = sizeof(Core::HookRecord);
+    hdr.StartUnixMs = static_cast<uint64>(std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count());
+    std::fwrite(&hdr, sizeof(hdr), 1, _file);
+
+    _bytes   = sizeof(hdr);
+    _startUs = SteadyNowUs();
+    _buffer.clear();
+    _buffer.reserve(FLUSH_THRESHOLD);
+
+    LOG_INFO("module", "DungeonMaster: Recording hook traffic -> {}", _path);
+    return true;
+}
+
+void DMHookRecorder::CloseLocked()
+{
+    if (!_file)
+        return;
+    FlushLocked();
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+void DMHookRecorder::FlushLocked()
+{
+    if (!_file || _buffer.empty())
+        return;
+
+    size_t room = static_cast<size_t>((_maxBytes > _bytes ? _maxBytes - _bytes : 0) / sizeof(Core::HookRecord));
+    size_t n = std::min(room, _buffer.size());
+    if (n)
+    {
+        std::fwrite(_buffer.data(), sizeof(Core::HookRecord), n, _file);
+        std::fflush(_file);
+        _bytes += n * sizeof(Core::HookRecord);
+    }
+    if (n < _buffer.size())
+    {
+        _dropped.fetch_add(_buffer.size() - n, std::memory_order_relaxed);
+        LOG_WARN("module", "DungeonMaster: Hook recording '{}' reached its size cap; recording stopped.", _path);
+        _enabled.store(false, std::memory_order_relaxed);
+    }
+    _buffer.clear();
+}
+
+void DMHookRecorder::Record(Core::HookRecord rec)
+{
+    if (!IsEnabled())
+        return;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!_file)
+        return;
+
+    rec.TimeUs = SteadyNowUs() - _startUs;
+    _buffer.push_back(rec);
+    _records.fetch_add(1, std::memory_order_relaxed);
+
+    if (_buffer.size() >= FLUSH_THRESHOLD)
+        FlushLocked();
+}
+
+void DMHookRecorder::Flush()
+{
+    if (!IsEnabled())
+        return;
+    std::lock_guard<std::mutex> lock(_mutex);
+    FlushLocked();
+}
+
+} // namespace DungeonMaster
@@ -0,0 +1,69 @@
+/*
+ * mod-dungeon-master — DMHookRecorder.h
+ * Opt-in capture of damage/death hook traffic and session lifecycle events
+ * into a compact binary file for offline replay (tools/dm_replay).
+ */
+
+#ifndef DM_HOOK_RECORDER_H
+#define DM_HOOK_RECORDER_H
+
+#include "Define.h"
+#include "DMHookTrace.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace DungeonMaster
+{
+
+class DMHookRecorder
+{
+    DMHookRecorder() = default;
+    ~DMHookRecorder();
+
+public:
+    static DMHookRecorder* Instance();
+
+    void Configure(bool enabled, std::string const& path, uint32 maxFileSizeMB);
+
+    // Runtime toggle (.dm record on|off). Returns false if the file can't be opened.
+    bool SetEnabled(bool enabled);
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    // Stamps TimeUs and buffers the record; callable from any map thread.
+    void Record(Core::HookRecord rec);
+
+    // Writes buffered records; called from the world update tick.
+    void Flush();
+
+    std::string GetPath() const;
+    uint64      GetRecordCount() const { return _records.load(std::memory_order_relaxed); }
+    uint64      GetDroppedCount() const { return _dropped.load(std::memory_order_relaxed); }
+
+private:
+    bool OpenLocked();
+    void CloseLocked();
+    void FlushLocked();
+
+    static constexpr size_t FLUSH_THRESHOLD = 4096;
+
+    std::atomic<bool>   _enabled{ false };
+    std::atomic<uint64> _records{ 0 };
+    std::atomic<uint64> _dropped{ 0 };
+
+    mutable std::mutex _mutex;
+    FILE*       _file = nullptr;
+    std::string _path = "dm_hooks.dmhk";
+    uint64      _maxBytes = 256ull * 1024 * 1024;
+    uint64      _bytes = 0;
+    uint64      _startUs = 0;
+    std::vector<Core::HookRecord> _buffer;
+};
+
+} // namespace DungeonMaster
+
+#define sDMHookRecorder DungeonMaster::DMHookRecorder::Instance()
+
+#endif // DM_HOOK_RECORDER_H
@@ -0,0 +1,146 @@
+/*
+ * mod-dungeon-master — DMLog.h
+ * Module log macros for hot paths: a compile-time minimum level and
+ * per-call-site rate limiting on top of the core LOG_* macros.
+ */
+
+#ifndef DM_LOG_H
+#define DM_LOG_H
+
+#include "Define.h"
+#include "Log.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
+#define DM_LOG_LEVEL_TRACE 0
+#define DM_LOG_LEVEL_DEBUG 1
+#define DM_LOG_LEVEL_INFO  2
+#define DM_LOG_LEVEL_WARN  3
+#define DM_LOG_LEVEL_ERROR 4
+
+// Calls below this level are discarded at compile time (arguments are
+// still type-checked, never evaluated). Release builds drop trace/debug;
+// build with -DDM_LOG_MIN_LEVEL=DM_LOG_LEVEL_TRACE to keep them.
+#ifndef DM_LOG_MIN_LEVEL
+#  ifdef NDEBUG
+#    define DM_LOG_MIN_LEVEL DM_LOG_LEVEL_INFO
+#  else
+#    define DM_LOG_MIN_LEVEL DM_LOG_LEVEL_TRACE
+#  endif
+#endif
+
+// Default budget for the *_RL variants, per call site.
+#ifndef DM_LOG_RL_PER_SEC
+#define DM_LOG_RL_PER_SEC 5
+#endif
+#ifndef DM_LOG_RL_BURST
+#define DM_LOG_RL_BURST 20
+#endif
+
+namespace DungeonMaster
+{
+
+// Lock-free token bucket for one log call site. Refill time (ms) and
+// milli-tokens share one atomic word; constant-initialized, so a
+// function-local static costs no guard.
+class DMLogLimiter
+{
+public:
+    constexpr DMLogLimiter(uint32 perSecond, uint32 burst)
+        : _perSecond(perSecond), _capacity(uint64(burst) * 1000) { }
+
+    // True if the message may be written; suppressed is set to the number
+    // dropped at this site since the last one that got through.
+    bool Acquire(uint32& suppressed)
+    {
+        uint64 now = NowMs();
+        uint64 cur = _state.load(std::memory_order_relaxed);
+        for (;;)
+        {
+            uint64 last   = cur >> TOKEN_BITS;
+            uint64 tokens = cur & TOKEN_MASK;
+            if (!cur)
+                tokens = _capacity;                 // first use: full bucket
+            else if (now > last)
+                tokens = std::min<uint64>(_capacity, tokens + (now - last) * _perSecond);
+
+            bool allowed = tokens >= 1000;
+            if (allowed)
+                tokens -= 1000;
+
+            uint64 next = (std::max(now, last) << TOKEN_BITS) | tokens;
+            if (_state.compare_exchange_weak(cur, next, std::memory_order_relaxed))
+            {
+                if (!allowed)
+                {
+                    _suppressed.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+                suppressed = _suppressed.exchange(0, std::memory_order_relaxed);
+                return true;
+            }
+        }
+    }
+
+private:
+    static constexpr uint32 TOKEN_BITS = 24;
+    static constexpr uint64 TOKEN_MASK = (uint64(1) << TOKEN_BITS) - 1;
+
+    // Offset from a fixed origin so a zero word always means "unused".
+    static uint64 NowMs()
+    {
+        using namespace std::chrono;
+        return uint64(duration_cast<milliseconds>(steady_clock::now().time_since_epoch()).count()) + 1;
+    }
+
+    uint32 const         _perSecond;        // milli-tokens per ms == tokens per second
+    uint64 const         _capacity;         // milli-tokens
+    std::atomic<uint64>  _state{ 0 };
+    std::atomic<uint32>  _suppressed{ 0 };
+};
+
+} // namespace DungeonMaster
+
+// ---- Internal ----
+
+#define DM_LOG_AT(lvl, LOGMACRO, ...)                                        \
+    do {                                                                     \
+        if constexpr ((lvl) >= DM_LOG_MIN_LEVEL)                             \
+            LOGMACRO("module", __VA_ARGS__);                                 \
+    } while (0)
+
+#define DM_LOG_AT_RL(lvl, LOGMACRO, ...)                                     \
+    do {                                                                     \
+        if constexpr ((lvl) >= DM_LOG_MIN_LEVEL)                             \
+        {                                                                    \
+            static DungeonMaster::DMLogLimiter dmLogLimiter(                 \
+                DM_LOG_RL_PER_SEC, DM_LOG_RL_BURST);                         \
+            uint32 dmLogSuppressed = 0;                                      \
+            if (dmLogLimiter.Acquire(dmLogSuppressed))                       \
+            {                                                                \
+                LOGMACRO("module", __VA_ARGS__);                             \
+                if (dmLogSuppressed)                                         \
+                    LOGMACRO("module", "DungeonMaster: ({} similar message(s) suppressed)", \
+                        dmLogSuppressed);                                    \
+            }                                                                \
+        }                                                                    \
+    } while (0)
+
+// ---- Public ----
+// Arguments are formatted only when the core logger has the level enabled.
+
+#define DM_LOG_TRACE(...) DM_LOG_AT(DM_LOG_LEVEL_TRACE, LOG_TRACE, __VA_ARGS__)
+#define DM_LOG_DEBUG(...) DM_LOG_AT(DM_LOG_LEVEL_DEBUG, LOG_DEBUG, __VA_ARGS__)
+#define DM_LOG_INFO(...)  DM_LOG_AT(DM_LOG_LEVEL_INFO,  LOG_INFO,  __VA_ARGS__)
+#define DM_LOG_WARN(...)  DM_LOG_AT(DM_LOG_LEVEL_WARN,  LOG_WARN,  __VA_ARGS__)
+#define DM_LOG_ERROR(...) DM_LOG_AT(DM_LOG_LEVEL_ERROR, LOG_ERROR, __VA_ARGS__)
+
+// At most DM_LOG_RL_PER_SEC per second per call site (bursts of
+// DM_LOG_RL_BURST); the next message through reports how many were dropped.
+#define DM_LOG_DEBUG_RL(...) DM_LOG_AT_RL(DM_LOG_LEVEL_DEBUG, LOG_DEBUG, __VA_ARGS__)
+#define DM_LOG_INFO_RL(...)  DM_LOG_AT_RL(DM_LOG_LEVEL_INFO,  LOG_INFO,  __VA_ARGS__)
+#define DM_LOG_WARN_RL(...)  DM_LOG_AT_RL(DM_LOG_LEVEL_WARN,  LOG_WARN,  __VA_ARGS__)
+#define DM_LOG_ERROR_RL(...) DM_LOG_AT_RL(DM_LOG_LEVEL_ERROR, LOG_ERROR, __VA_ARGS__)
+
+#endif // DM_LOG_H
@@ -0,0 +1,249 @@
+/*
+ * mod-dungeon-master — DMMutex.cpp
+ * Lock registry, profiled acquire/release paths and the .dm locks report.
+ */
+
+#include "DMMutex.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+namespace DungeonMaster
+{
+
+std::atomic<bool> DMMutex::sProfilingEnabled{ false };
+
+// Registry is function-local so file-scope DMMutex objects in other
+// translation units can register during static init.
+static std::mutex& RegistryMutex()
+{
+    static std::mutex m;
+    return m;
+}
+
+static std::vector<DMMutex*>& Registry()
+{
+    static std::vector<DMMutex*> r;
+    return r;
+}
+
+static uint64 NowNs()
+{
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+static uint32 Log2Bucket(uint64 ns)
+{
+    uint32 b = 0;
+    while (ns > 1 && b < DMMutex::HIST_BUCKETS - 1) { ns >>= 1; ++b; }
+    return b;
+}
+
+static char const* BaseName(char const* path)
+{
+    char const* base = path;
+    for (char const* p = path; *p; ++p)
+        if (*p == '/' || *p == '\\')
+            base = p + 1;
+    return base;
+}
+
+static std::string FormatNs(uint64 ns)
+{
+    char buf[32];
+    if (ns < 1000)               snprintf(buf, sizeof(buf), "<1us");
+    else if (ns < 1000000)       snprintf(buf, sizeof(buf), "%lluus", (unsigned long long)(ns / 1000));
+    else if (ns < 1000000000ull) snprintf(buf, sizeof(buf), "%.1fms", ns / 1e6);
+    else                         snprintf(buf, sizeof(buf), "%.2fs", ns / 1e9);
+    return buf;
+}
+
+// Upper bound of the bucket containing the pct-th percentile.
+static uint64 HistPercentile(uint64 const* hist, uint64 total, float pct)
+{
+    if (!total) return 0;
+    uint64 target = static_cast<uint64>(total * pct);
+    uint64 acc = 0;
+    for (uint32 i = 0; i < DMMutex::HIST_BUCKETS; ++i)
+    {
+        acc += hist[i];
+        if (acc > target)
+            return uint64(1) << (i + 1);
+    }
+    return uint64(1) << DMMutex::HIST_BUCKETS;
+}
+
+DMMutex::DMMutex(char const* name) : _name(name)
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    Registry().push_back(this);
+}
+
+DMMutex::~DMMutex()
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex());
+    auto& r = Registry();
+    r.erase(std::remove(r.begin(), r.end(), this), r.end());
+}
+
+void DMMutex::LockProfiled(char const* file, uint32 line)
+{
+    uint64 t0 = NowNs();
+    bool contended = !_m.try_lock();
+    if (contended)
+        _m.lock();
+    uint64 t1 = NowNs();
+    uint64 wait = t1 - t0;
+
+    ++_stats.Acquisitions;
+    if (contended)
+        ++_stats.Contended;
+    ++_stats.WaitHist[Log2Bucket(wait)];
+    _stats.MaxWaitNs = std::max(_stats.MaxWaitNs, wait);
+
+    _holderSite = FindSite(file, line);
+    Site& site = _stats.Sites[_holderSite];
+    ++site.Count;
+    site.WaitNs += wait;
+
+    _currentSite.store(static_cast<int32>(_holderSite), std::memory_order_relaxed);
+    _acquireNs = t1 ? t1 : 1;
+}
+
+void DMMutex::RecordRelease()
+{
+    uint64 hold = NowNs() - _acquireNs;
+    _acquireNs = 0;
+
+    ++_stats.HoldHist[Log2Bucket(hold)];
+    _stats.MaxHoldNs = std::max(_stats.MaxHoldNs, hold);
+
+    Site& site = _stats.Sites[_holderSite];
+    site.HoldNs += hold;
+    site.MaxHoldNs = std::max(site.MaxHoldNs, hold);
+
+    _currentSite.store(-1, std::memory_order_relaxed);
+}
+
+uint32 DMMutex::FindSite(char const* file, uint32 line)
+{
+    for (uint32 i = 0; i < _stats.SiteCount; ++i)
+        if (_stats.Sites[i].Line == line && _stats.Sites[i].File == file)
+            return i;
+
+    if (_stats.SiteCount < MAX_SITES - 1)
+    {
+        Site& s = _stats.Sites[_stats.SiteCount];
+        s.File = file;
+        s.Line = line;
+        return _stats.SiteCount++;
+    }
+
+    // Overflow bucket
+    Site& other = _stats.Sites[MAX_SITES - 1];
+    other.File = nullptr;
+    other.Line = 0;
+    _stats.SiteCount = MAX_SITES;
+    return MAX_SITES - 1;
+}
+
+DMMutex::Stats DMMutex::Snapshot(std::string& holderSite)
+{
+    holderSite.clear();
+    int32 held = -1;
+    if (!_m.try_lock())
+    {
+        held = _currentSite.load(std::memory_order_relaxed);
+        _m.lock();
+    }
+
+    Stats out = _stats;
+    if (held >= 0 && uint32(held) < MAX_SITES)
+    {
+        char buf[128];
+        Site const& s = _stats.Sites[held];
+        snprintf(buf, sizeof(buf), "%s:%u", s.File ? BaseName(s.File) : "other", s.Line);
+        holderSite = buf;
+    }
+
+    _m.unlock();
+    return out;
+}
+
+void DMMutex::Reset()
+{
+    std::lock_guard<std::mutex> lock(_m);
+    _stats = Stats();
+    _acquireNs = 0;
+}
+
+void DMMutex::SetProfilingEnabled(bool enabled)
+{
+    sProfilingEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+void DMMutex::ResetAll()
+{
+    std::vector<DMMutex*> locks;
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        locks = Registry();
+    }
+    for (DMMutex* m : locks)
+        m->Reset();
+}
+
+std::vector<std::string> DMMutex::BuildReport(uint32 sitesPerLock)
+{
+    std::vector<DMMutex*> locks;
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex());
+        locks = Registry();
+    }
+
+    std::vector<std::string> lines;
+    char buf[256];
+    for (DMMutex* m : locks)
+    {
+        std::string holder;
+        Stats st = m->Snapshot(holder);
+
+        uint64 holds = 0;
+        for (uint64 h : st.HoldHist) holds += h;
+
+        snprintf(buf, sizeof(buf),
+            "%s: %llu acq, %llu contended (%.1f%%) | wait p50 %s p99 %s max %s | hold p50 %s p99 %s max %s%s%s",
+            m->GetName(), (unsigned long long)st.Acquisitions, (unsigned long long)st.Contended,
+            st.Acquisitions ? 100.0 * st.Contended / st.Acquisitions : 0.0,
+            FormatNs(HistPercentile(st.WaitHist, st.Acquisitions, 0.50f)).c_str(),
+            FormatNs(HistPercentile(st.WaitHist, st.Acquisitions, 0.99f)).c_str(),
+            FormatNs(st.MaxWaitNs).c_str(),
+            FormatNs(HistPercentile(st.HoldHist, holds, 0.50f)).c_str(),
+            FormatNs(HistPercentile(st.HoldHist, holds, 0.99f)).c_str(),
+            FormatNs(st.MaxHoldNs).c_str(),
+            holder.empty() ? "" : " | held by ", holder.c_str());
+        lines.push_back(buf);
+
+        // Heaviest call sites by total hold time
+        std::vector<Site const*> sites;
+        for (uint32 i = 0; i < std::min(st.SiteCount, MAX_SITES); ++i)
+            if (st.Sites[i].Count)
+                sites.push_back(&st.Sites[i]);
+        std::sort(sites.begin(), sites.end(),
+            [](Site const* a, Site const* b) { return a->HoldNs > b->HoldNs; });
+
+        for (uint32 i = 0; i < sites.size() && i < sitesPerLock; ++i)
+        {
+            Site const* s = sites[i];
+            snprintf(buf, sizeof(buf), "    %s:%u  x%llu  hold %s (max %s)  wait %s",
+                s->File ? BaseName(s->File) : "other", s->Line, (unsigned long long)s->Count,
+                FormatNs(s->HoldNs).c_str(), FormatNs(s->MaxHoldNs).c_str(), FormatNs(s->WaitNs).c_str());
+            lines.push_back(buf);
+        }
+    }
+    return lines;
+}
+
+} // namespace DungeonMaster
@@ -0,0 +1,128 @@
+/*
+ * mod-dungeon-master — DMMutex.h
+ * Named mutex with optional contention profiling (wait / hold histograms,
+ * per call-site totals). Drop-in for std::mutex via DMLockGuard.
+ */
+
+#ifndef DM_MUTEX_H
+#define DM_MUTEX_H
+
+#include "Define.h"
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace DungeonMaster
+{
+
+class DMMutex
+{
+public:
+    static constexpr uint32 HIST_BUCKETS = 40;   // log2(ns): bucket i = [2^i, 2^(i+1))
+    static constexpr uint32 MAX_SITES    = 16;   // last slot collects overflow
+
+    struct Site
+    {
+        char const* File = nullptr;
+        uint32 Line      = 0;
+        uint64 Count     = 0;
+        uint64 WaitNs    = 0;
+        uint64 HoldNs    = 0;
+        uint64 MaxHoldNs = 0;
+    };
+
+    struct Stats
+    {
+        uint64 Acquisitions = 0;
+        uint64 Contended    = 0;
+        uint64 MaxWaitNs    = 0;
+        uint64 MaxHoldNs    = 0;
+        uint64 WaitHist[HIST_BUCKETS] = {};
+        uint64 HoldHist[HIST_BUCKETS] = {};
+        Site   Sites[MAX_SITES];
+        uint32 SiteCount    = 0;
+    };
+
+    explicit DMMutex(char const* name);
+    ~DMMutex();
+
+    DMMutex(DMMutex const&) = delete;
+    DMMutex& operator=(DMMutex const&) = delete;
+
+    // __builtin_FILE/LINE resolve at the caller (GCC, Clang, MSVC 16.6+).
+    void lock(char const* file = __builtin_FILE(), uint32 line = __builtin_LINE())
+    {
+        if (!sProfilingEnabled.load(std::memory_order_relaxed))
+        {
+            _m.lock();
+            _acquireNs = 0;
+            return;
+        }
+        LockProfiled(file, line);
+    }
+
+    void unlock()
+    {
+        if (_acquireNs)
+            RecordRelease();
+        _m.unlock();
+    }
+
+    bool try_lock()
+    {
+        if (!_m.try_lock())
+            return false;
+        _acquireNs = 0;
+        return true;
+    }
+
+    char const* GetName() const { return _name; }
+
+    // Copies stats under the lock. holderSite is the call site holding the
+    // lock at the time of the call, or empty if it was free.
+    Stats Snapshot(std::string& holderSite);
+    void  Reset();
+
+    static bool IsProfilingEnabled() { return sProfilingEnabled.load(std::memory_order_relaxed); }
+    static void SetProfilingEnabled(bool enabled);
+    static void ResetAll();
+
+    // One line per lock plus its heaviest call sites; for .dm locks.
+    static std::vector<std::string> BuildReport(uint32 sitesPerLock = 3);
+
+private:
+    void LockProfiled(char const* file, uint32 line);
+    void RecordRelease();
+    uint32 FindSite(char const* file, uint32 line);
+
+    static std::atomic<bool> sProfilingEnabled;
+
+    std::mutex  _m;
+    char const* _name;
+
+    // Everything below is only touched while _m is held.
+    uint64 _acquireNs = 0;
+    uint32 _holderSite = 0;
+    std::atomic<int32> _currentSite{ -1 };
+    Stats  _stats;
+};
+
+// std::lock_guard equivalent that forwards the caller's file/line.
+class DMLockGuard
+{
+public:
+    explicit DMLockGuard(DMMutex& m, char const* file = __builtin_FILE(), uint32 line = __builtin_LINE())
+        : _m(m) { _m.lock(file, line); }
+    ~DMLockGuard() { _m.unlock(); }
+
+    DMLockGuard(DMLockGuard const&) = delete;
+    DMLockGuard& operator=(DMLockGuard const&) = delete;
+
+private:
+    DMMutex& _m;
+};
+
+} // namespace DungeonMaster
+
+#endif // DM_MUTEX_H
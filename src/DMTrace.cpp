@@ -0,0 +1,257 @@
+/*
+ * mod-dungeon-master — DMTrace.cpp
+ * Chrome trace-event JSON writer with size-based rotation.
+ */
+
+#include "DMTrace.h"
+#include "Log.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+
+namespace DungeonMaster
+{
+
+// Track layout: pid 1 = threads (tid = per-thread ordinal),
+//               pid 2 = sessions (tid = session id).
+static constexpr uint32 PID_THREADS  = 1;
+static constexpr uint32 PID_SESSIONS = 2;
+
+static uint32 CurrentThreadOrdinal()
+{
+    static std::atomic<uint32> sNext{ 1 };
+    static thread_local uint32 tOrdinal = sNext.fetch_add(1, std::memory_order_relaxed);
+    return tOrdinal;
+}
+
+DMTrace::~DMTrace()
+{
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    CloseLocked();
+}
+
+DMTrace* DMTrace::Instance()
+{
+    static DMTrace instance;
+    return &instance;
+}
+
+uint64 DMTrace::NowUs()
+{
+    static const auto sEpoch = std::chrono::steady_clock::now();
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - sEpoch).count());
+}
+
+void DMTrace::Configure(bool enabled, std::string const& path, uint32 maxFileSizeMB)
+{
+    {
+        std::lock_guard<std::mutex> lock(_fileMutex);
+        if (!path.empty() && path != _path)
+        {
+            CloseLocked();
+            _path = path;
+        }
+        _maxBytes = uint64(std::max<uint32>(1, maxFileSizeMB)) * 1024 * 1024;
+    }
+    SetEnabled(enabled);
+}
+
+bool DMTrace::SetEnabled(bool enabled)
+{
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    if (enabled && !_file && !OpenLocked())
+    {
+        _enabled.store(false, std::memory_order_relaxed);
+        return false;
+    }
+    if (!enabled)
+        CloseLocked();
+    _enabled.store(enabled, std::memory_order_relaxed);
+    return true;
+}
+
+std::string DMTrace::GetPath() const
+{
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    return _path;
+}
+
+bool DMTrace::OpenLocked()
+{
+    _file = std::fopen(_path.c_str(), "w");
+    if (!_file)
+    {
+        LOG_ERROR("module", "DungeonMaster: Cannot open trace file '{}'", _path);
+        return false;
+    }
+    _bytes = 0;
+    _namedThreads.clear();
+    _namedSessions.clear();
+
+    // JSON array format; viewers accept a missing closing bracket if the
+    // server dies mid-write.
+    char buf[160];
+    int n = snprintf(buf, sizeof(buf),
+        "[\n{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"DM threads\"}},\n"
+        "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"DM sessions\"}}",
+        PID_THREADS, PID_SESSIONS);
+    WriteLocked(buf, n);
+
+    LOG_INFO("module", "DungeonMaster: Trace output -> {}", _path);
+    return true;
+}
+
+void DMTrace::CloseLocked()
+{
+    if (!_file)
+        return;
+    std::fputs("\n]\n", _file);
+    std::fclose(_file);
+    _file = nullptr;
+}
+
+void DMTrace::RotateLocked()
+{
+    CloseLocked();
+    std::string old = _path + ".1";
+    std::remove(old.c_str());
+    std::rename(_path.c_str(), old.c_str());
+    _rotations.fetch_add(1, std::memory_order_relaxed);
+    if (!OpenLocked())
+        _enabled.store(false, std::memory_order_relaxed);
+}
+
+void DMTrace::WriteLocked(char const* data, int len)
+{
+    if (!_file || len <= 0)
+        return;
+    std::fwrite(data, 1, static_cast<size_t>(len), _file);
+    _bytes += static_cast<uint64>(len);
+}
+
+void DMTrace::EnsureTrackNamesLocked(uint32 tid, uint32 sessionId)
+{
+    char buf[160];
+    if (_namedThreads.insert(tid).second)
+    {
+        int n = snprintf(buf, sizeof(buf),
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"thread %u\"}}",
+            PID_THREADS, tid, tid);
+        WriteLocked(buf, n);
+    }
+    if (sessionId && _namedSessions.insert(sessionId).second)
+    {
+        int n = snprintf(buf, sizeof(buf),
+            ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%u,\"tid\":%u,\"args\":{\"name\":\"session %u\"}}",
+            PID_SESSIONS, sessionId, sessionId);
+        WriteLocked(buf, n);
+    }
+}
+
+void DMTrace::Complete(char const* name, uint32 sessionId, uint64 startUs, uint64 durUs)
+{
+    uint32 tid = CurrentThreadOrdinal();
+
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    if (!_file)
+        return;
+
+    EnsureTrackNamesLocked(tid, sessionId);
+
+    char buf[256];
+    int n = snprintf(buf, sizeof(buf),
+        ",\n{\"name\":\"%s\",\"cat\":\"dm\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,"
+        "\"pid\":%u,\"tid\":%u,\"args\":{\"session\":%u}}",
+        name, (unsigned long long)startUs, (unsigned long long)durUs, PID_THREADS, tid, sessionId);
+    WriteLocked(buf, n);
+
+    if (sessionId)
+    {
+        n = snprintf(buf, sizeof(buf),
+            ",\n{\"name\":\"%s\",\"cat\":\"dm\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,"
+            "\"pid\":%u,\"tid\":%u,\"args\":{\"thread\":%u}}",
+            name, (unsigned long long)startUs, (unsigned long long)durUs, PID_SESSIONS, sessionId, tid);
+        WriteLocked(buf, n);
+    }
+
+    _events.fetch_add(1, std::memory_order_relaxed);
+    if (_bytes >= _maxBytes)
+        RotateLocked();
+}
+
+void DMTrace::SessionBegin(uint32 sessionId, uint32 mapId)
+{
+    if (!IsEnabled())
+        return;
+    uint64 ts = NowUs();
+
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    if (!_file)
+        return;
+
+    EnsureTrackNamesLocked(CurrentThreadOrdinal(), sessionId);
+
+    char buf[192];
+    int n = snprintf(buf, sizeof(buf),
+        ",\n{\"name\":\"Session\",\"cat\":\"session\",\"ph\":\"b\",\"id\":%u,\"ts\":%llu,"
+        "\"pid\":%u,\"tid\":%u,\"args\":{\"map\":%u}}",
+        sessionId, (unsigned long long)ts, PID_SESSIONS, sessionId, mapId);
+    WriteLocked(buf, n);
+    _events.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DMTrace::SessionEnd(uint32 sessionId, bool success)
+{
+    if (!IsEnabled())
+        return;
+    uint64 ts = NowUs();
+
+    std::lock_guard<std::mutex> lock(_fileMutex);
+    if (!_file)
+        return;
+
+    char buf[192];
+    int n = snprintf(buf, sizeof(buf),
+        ",\n{\"name\":\"Session\",\"cat\":\"session\",\"ph\":\"e\",\"id\":%u,\"ts\":%llu,"
+        "\"pid\":%u,\"tid\":%u,\"args\":{\"success\":%s}}",
+        sessionId, (unsigned long long)ts, PID_SESSIONS, sessionId, success ? "true" : "false");
+    WriteLocked(buf, n);
+    _events.fetch_add(1, std::memory_order_relaxed);
+    if (_bytes >= _maxBytes)
+        RotateLocked();
+}
+
+// ---- DMTraceSpan ----
+
+DMTraceSpan::DMTraceSpan(char const* name, uint32 sessionId)
+    : _name(name), _sessionId(sessionId)
+{
+    if (sDMTrace->IsEnabled())
+    {
+        _start  = DMTrace::NowUs();
+        _active = true;
+    }
+}
+
+void DMTraceSpan::Finish()
+{
+    if (!_active)
+        return;
+    _active = false;
+    uint64 end = DMTrace::NowUs();
+    sDMTrace->Complete(_name, _sessionId, _start, end - _start);
+}
+
+void DMTraceSpan::Next(char const* name)
+{
+    Finish();
+    _name = name;
+    if (sDMTrace->IsEnabled())
+    {
+        _start  = DMTrace::NowUs();
+        _active = true;
+    }
+}
+
+} // namespace DungeonMaster
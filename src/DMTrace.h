@@ -0,0 +1,96 @@
+/*
+ * mod-dungeon-master — DMTrace.h
+ * Optional Chrome trace-event export of session lifecycle spans.
+ * Load the output in chrome://tracing or ui.perfetto.dev.
+ */
+
+#ifndef DM_TRACE_H
+#define DM_TRACE_H
+
+#include "Define.h"
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace DungeonMaster
+{
+
+class DMTrace
+{
+    DMTrace() = default;
+    ~DMTrace();
+
+public:
+    static DMTrace* Instance();
+
+    // Applies config values; opens or closes the output file as needed.
+    void Configure(bool enabled, std::string const& path, uint32 maxFileSizeMB);
+
+    // Runtime toggle (.dm trace on|off). Returns false if the file can't be opened.
+    bool SetEnabled(bool enabled);
+    bool IsEnabled() const { return _enabled.load(std::memory_order_relaxed); }
+
+    // "X" complete event on the calling thread's track, mirrored on the
+    // session's track when sessionId != 0.
+    void Complete(char const* name, uint32 sessionId, uint64 startUs, uint64 durUs);
+
+    // Async begin/end pair spanning a session's whole lifetime.
+    void SessionBegin(uint32 sessionId, uint32 mapId);
+    void SessionEnd(uint32 sessionId, bool success);
+
+    static uint64 NowUs();
+
+    std::string GetPath() const;
+    uint64      GetEventCount()   const { return _events.load(std::memory_order_relaxed); }
+    uint32      GetRotationCount() const { return _rotations.load(std::memory_order_relaxed); }
+
+private:
+    bool OpenLocked();
+    void CloseLocked();
+    void RotateLocked();
+    void WriteLocked(char const* data, int len);
+    void EnsureTrackNamesLocked(uint32 tid, uint32 sessionId);
+
+    std::atomic<bool>   _enabled{ false };
+    std::atomic<uint64> _events{ 0 };
+    std::atomic<uint32> _rotations{ 0 };
+
+    mutable std::mutex _fileMutex;
+    FILE*       _file = nullptr;
+    std::string _path = "dm_trace.json";
+    uint64      _maxBytes = 64ull * 1024 * 1024;
+    uint64      _bytes = 0;
+    std::unordered_set<uint32> _namedThreads;
+    std::unordered_set<uint32> _namedSessions;
+};
+
+// RAII span. Costs one relaxed load when tracing is off.
+class DMTraceSpan
+{
+public:
+    explicit DMTraceSpan(char const* name, uint32 sessionId = 0);
+    ~DMTraceSpan() { Finish(); }
+
+    DMTraceSpan(DMTraceSpan const&) = delete;
+    DMTraceSpan& operator=(DMTraceSpan const&) = delete;
+
+    // Close the current span and open the next one (PopulateDungeon phases).
+    void Next(char const* name);
+    void SetSession(uint32 sessionId) { _sessionId = sessionId; }
+
+private:
+    void Finish();
+
+    char const* _name;
+    uint32      _sessionId;
+    uint64      _start  = 0;
+    bool        _active = false;
+};
+
+} // namespace DungeonMaster
+
+#define sDMTrace DungeonMaster::DMTrace::Instance()
+
+#endif // DM_TRACE_H
@@ -9,6 +9,12 @@
 #include "Define.h"
 #include "ObjectGuid.h"
 #include "Position.h"
+#include "DMCoreTypes.h"
+#include "DMCommandQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -35,33 +41,13 @@ enum class SessionState : uint8
     Abandoned
 };
 
-struct DifficultyTier
-{
-    uint32      Id               = 0;
-    std::string Name;
-    uint8       MinLevel         = 1;
-    uint8       MaxLevel         = 80;
-    float       HealthMultiplier = 1.0f;
-    float       DamageMultiplier = 1.0f;
-    float       RewardMultiplier = 1.0f;
-    float       MobCountMultiplier = 1.0f;
-
-    bool IsValidForLevel(uint8 level) const { return level >= MinLevel; }
-    bool IsOnLevelFor(uint8 level) const { return level >= MinLevel && level <= MaxLevel; }
-};
-
-// Groups creature types for themed spawns; -1 = any type
-struct Theme
-{
-    uint32                  Id = 0;
-    std::string             Name;
-    std::vector<uint32>     CreatureTypes;
-
-    bool IsRandom() const
-    {
-        return CreatureTypes.size() == 1 && CreatureTypes[0] == uint32(-1);
-    }
-};
+// Config and pool records live in the std-only core (src/core/DMCoreTypes.h)
+using Core::DifficultyTier;
+using Core::Theme;
+using Core::CreaturePoolEntry;
+using Core::RewardItem;
+using Core::LootPoolItem;
+using Core::ClassLevelStatEntry;
 
 struct DungeonInfo
 {
@@ -81,16 +67,180 @@ struct SpawnPoint
     bool        IsUsed               = false;
 };
 
-struct SpawnedCreature
+enum SpawnFlag : uint8
+{
+    SPAWN_FLAG_ELITE         = 0,
+    SPAWN_FLAG_BOSS,
+    SPAWN_FLAG_RARE,
+    SPAWN_FLAG_DEAD,
+    SPAWN_FLAG_LOOT_FILLED,     // FillCreatureLoot has run post-death
+    SPAWN_FLAG_KILL_CREDITED,   // kill XP/count has been awarded
+    SPAWN_FLAG_CORPSE_TRACKED,  // corpse is in Session::Corpses
+    MAX_SPAWN_FLAGS
+};
+
+// Creatures a session owns, stored column-wise: GUIDs, entries and one
+// bitset per SpawnFlag, plus an open-addressed GUID -> index table.
+// Indices are stable (append-only until Clear), so callers may hold one
+// across a scan. Clear keeps all capacity for pooled sessions.
+class SessionCreatureSet
+{
+public:
+    static constexpr uint32 NPOS = 0xFFFFFFFF;
+
+    void Reserve(size_t n)
+    {
+        _guids.reserve(n);
+        _entries.reserve(n);
+        for (auto& bits : _flags)
+            bits.reserve((n + 63) / 64);
+        if (n * 2 > _slots.size())
+            Rehash(n * 2);
+    }
+
+    uint32 Add(ObjectGuid guid, uint32 entry, bool isElite, bool isBoss, bool isRare)
+    {
+        uint32 i = uint32(_guids.size());
+        _guids.push_back(guid);
+        _entries.push_back(entry);
+        if ((i & 63) == 0)
+            for (auto& bits : _flags)
+                bits.push_back(0);
+        if (isElite) Set(i, SPAWN_FLAG_ELITE);
+        if (isBoss)  Set(i, SPAWN_FLAG_BOSS);
+        if (isRare)  Set(i, SPAWN_FLAG_RARE);
+        if ((i + 1) * 2 > _slots.size())
+            Rehash((i + 1) * 2);
+        else
+            InsertSlot(i);
+        return i;
+    }
+
+    void Clear()
+    {
+        _guids.clear();
+        _entries.clear();
+        for (auto& bits : _flags)
+            bits.clear();
+        std::fill(_slots.begin(), _slots.end(), 0);
+    }
+
+    uint32 Size()  const { return uint32(_guids.size()); }
+    bool   Empty() const { return _guids.empty(); }
+
+    uint32 Find(ObjectGuid guid) const
+    {
+        if (_slots.empty())
+            return NPOS;
+        size_t mask = _slots.size() - 1;
+        for (size_t h = Hash(guid) & mask; _slots[h]; h = (h + 1) & mask)
+            if (_guids[_slots[h] - 1] == guid)
+                return _slots[h] - 1;
+        return NPOS;
+    }
+    bool Contains(ObjectGuid guid) const { return Find(guid) != NPOS; }
+
+    ObjectGuid GetGuid(uint32 i)  const { return _guids[i]; }
+    uint32     GetEntry(uint32 i) const { return _entries[i]; }
+    std::vector<ObjectGuid> const& GetGuids() const { return _guids; }
+
+    bool Test(uint32 i, SpawnFlag f) const { return (_flags[f][i >> 6] >> (i & 63)) & 1; }
+    void Set(uint32 i, SpawnFlag f)        { _flags[f][i >> 6] |= uint64(1) << (i & 63); }
+
+    // Calls fn(index) for every creature not yet dead, looted and credited,
+    // skipping fully processed creatures 64 at a time.
+    template<typename Fn>
+    void ForEachUnprocessed(Fn&& fn) const
+    {
+        uint32 count = Size();
+        for (uint32 w = 0; w * 64 < count; ++w)
+        {
+            uint64 pending = ~(_flags[SPAWN_FLAG_DEAD][w] & _flags[SPAWN_FLAG_LOOT_FILLED][w]
+                               & _flags[SPAWN_FLAG_KILL_CREDITED][w]);
+            if (count - w * 64 < 64)
+                pending &= (uint64(1) << (count - w * 64)) - 1;
+            for (uint32 b = 0; pending; ++b, pending >>= 1)
+                if (pending & 1)
+                    fn(w * 64 + b);
+        }
+    }
+
+private:
+    static size_t Hash(ObjectGuid guid)
+    {
+        uint64 h = guid.GetRawValue();
+        h ^= h >> 33;
+        h *= 0xFF51AFD7ED558CCDULL;
+        h ^= h >> 33;
+        return size_t(h);
+    }
+
+    // Slot holds index + 1; 0 is empty. Load factor stays at or below 1/2.
+    void InsertSlot(uint32 i)
+    {
+        size_t mask = _slots.size() - 1;
+        size_t h = Hash(_guids[i]) & mask;
+        while (_slots[h])
+            h = (h + 1) & mask;
+        _slots[h] = i + 1;
+    }
+
+    void Rehash(size_t minSlots)
+    {
+        size_t n = 16;
+        while (n < minSlots)
+            n <<= 1;
+        _slots.assign(n, 0);
+        for (uint32 i = 0; i < Size(); ++i)
+            InsertSlot(i);
+    }
+
+    std::vector<ObjectGuid> _guids;
+    std::vector<uint32>     _entries;
+    std::vector<uint64>     _flags[MAX_SPAWN_FLAGS];
+    std::vector<uint32>     _slots;
+};
+
+enum class CombatStat : uint8
+{
+    // Counted for every player in the session's instance, member or not
+    // (a GM following the party counts too).
+    DamageDealt,        // by players and their pets
+    DamageTaken,        // by players, after the module's damage scaling
+    DamageTakenRaw,     // by players, as the damage hooks received it
+    Healing,            // received by players
+    Overkill,           // dealt past a victim's remaining health
+    Count
+};
+
+// Combat totals of one session. Only the instance's map thread adds, with
+// relaxed atomics, so the counters share one block; it is padded to a
+// cache line of its own so no other allocation's writes contend with it.
+// Read for .dm status and the end-of-session row.
+class alignas(64) SessionTelemetry
+{
+public:
+    void   Add(CombatStat stat, uint64 amount) { _counters[size_t(stat)].fetch_add(amount, std::memory_order_relaxed); }
+    uint64 Get(CombatStat stat) const          { return _counters[size_t(stat)].load(std::memory_order_relaxed); }
+
+    void Clear()
+    {
+        for (std::atomic<uint64>& c : _counters)
+            c.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<uint64> _counters[size_t(CombatStat::Count)] = {};
+};
+static_assert(sizeof(SessionTelemetry) == 64, "telemetry block should fill one cache line");
+
+// Corpse of a session kill, kept until its loot is taken (or over budget)
+struct SessionCorpse
 {
     ObjectGuid  Guid;
-    uint32      Entry      = 0;
-    bool        IsElite    = false;
-    bool        IsBoss     = false;
-    bool        IsRare     = false;
-    bool        IsDead     = false;
-    bool        LootFilled = false;   // true once FillCreatureLoot has run post-death
-    bool        KillCredited = false; // true once kill XP/count has been awarded
+    uint64      DeathTime  = 0;
+    uint64      EmptySince = 0;     // first pass its loot was seen empty
+    bool        BossOrRare = false; // never evicted while it holds loot
 };
 
 struct PendingPhaseCheck
@@ -101,6 +251,26 @@ struct PendingPhaseCheck
     bool        Resolved   = false;
 };
 
+enum MemberState : uint8
+{
+    MEMBER_IN_WORLD  = 0x01,
+    MEMBER_IN_MAP    = 0x02,   // on the session's map (may be mid-teleport)
+    MEMBER_ALIVE     = 0x04,
+    MEMBER_IN_COMBAT = 0x08,   // alive and in combat
+};
+
+// Player state transitions reported by dm_player_script.
+enum class MemberEvent : uint8
+{
+    Login,
+    Logout,
+    MapChanged,
+    Died,
+    Resurrected,
+    EnterCombat,
+    LeaveCombat,
+};
+
 struct PlayerSessionData
 {
     ObjectGuid  PlayerGuid;
@@ -109,8 +279,72 @@ struct PlayerSessionData
     uint32      MobsKilled   = 0;
     uint32      BossesKilled = 0;
     uint32      Deaths       = 0;
+    uint8       State        = 0;   // MemberState, tracked from MemberEvents
+};
+
+struct ResolvedMember
+{
+    Player* Ptr   = nullptr;   // null when the player is offline
+    uint8   State = 0;
+
+    bool Is(uint8 state) const { return Ptr && (State & state) == state; }
 };
 
+// Session (or run) members resolved to Player* once, with the state the
+// update sub-steps test. Entries parallel the member list. Pointers are
+// only good for the world tick they were resolved in.
+class SessionMembers
+{
+public:
+    template<typename Members>
+    void Resolve(Members const& members, uint32 mapId, uint64 pass = 0)
+    {
+        _members.clear();
+        for (auto const& m : members)
+            Add(m.PlayerGuid, mapId);
+        _pass = pass;
+    }
+
+    void Clear() { _members.clear(); _pass = 0; }
+
+    ResolvedMember const* begin() const { return _members.data(); }
+    ResolvedMember const* end()   const { return _members.data() + _members.size(); }
+    size_t size() const { return _members.size(); }
+    ResolvedMember const& operator[](size_t i) const { return _members[i]; }
+
+    // First member in the given state, or null.
+    Player* First(uint8 state) const
+    {
+        for (auto const& m : _members)
+            if (m.Is(state))
+                return m.Ptr;
+        return nullptr;
+    }
+    bool   Any(uint8 state)   const { return First(state) != nullptr; }
+    uint32 Count(uint8 state) const
+    {
+        uint32 n = 0;
+        for (auto const& m : _members)
+            n += m.Is(state);
+        return n;
+    }
+
+    uint64 GetPass() const { return _pass; }
+
+private:
+    void Add(ObjectGuid guid, uint32 mapId);    // DungeonMasterMgr.cpp
+
+    std::vector<ResolvedMember> _members;
+    uint64                      _pass = 0;
+};
+
+struct Session;
+
+// Work posted to a session's instance map; runs on that map's update
+// thread (DungeonMasterMgr::UpdateSessionMap).
+using SessionCommand      = std::function<void(Session&, InstanceMap*)>;
+using SessionCommandQueue = DMMpscQueue<SessionCommand>;
+
 struct Session
 {
     uint32          SessionId    = 0;
@@ -133,23 +367,60 @@ struct Session
     uint32  TimeLimit = 0;
 
     std::vector<PlayerSessionData>  Players;
-    std::vector<SpawnedCreature>    SpawnedCreatures;
+    SessionCreatureSet              Creatures;
     std::vector<SpawnPoint>         SpawnPoints;
     std::vector<PendingPhaseCheck>  PendingPhaseChecks;
+    std::vector<SessionCorpse>      Corpses;     // map thread only, oldest first
+    SessionMembers                  Members;     // see DungeonMasterMgr::GetMembers
+    std::unique_ptr<SessionCommandQueue> Commands;  // consumed by the instance map thread
+    std::unique_ptr<SessionTelemetry>    Telemetry; // fed by unit hooks on the map thread
+    uint32                          MapUpdateTimer = 0;
 
     uint32  TotalMobs   = 0;
     uint32  MobsKilled  = 0;
     uint32  TotalBosses = 0;
     uint32  BossesKilled = 0;
     uint32  Wipes       = 0;
+    float   TrashXpMult     = 1.0f;     // above 1 when trash was thinned under load
+    float   TrashGoldMult   = 1.0f;
 
     Position EntrancePos;
 
-    bool IsSessionCreature(ObjectGuid guid) const
+    bool IsSessionCreature(ObjectGuid guid) const { return Creatures.Contains(guid); }
+
+    // Back to a default-constructed session, keeping container capacity
+    // so a pooled session repopulates without allocating.
+    void Reset()
     {
-        for (const auto& sc : SpawnedCreatures)
-            if (sc.Guid == guid) return true;
-        return false;
+        std::vector<PlayerSessionData> players = std::move(Players);
+        std::vector<SpawnPoint>        points  = std::move(SpawnPoints);
+        std::vector<PendingPhaseCheck> checks  = std::move(PendingPhaseChecks);
+        std::vector<SessionCorpse>     corpses = std::move(Corpses);
+        SessionCreatureSet             creatures = std::move(Creatures);
+        SessionMembers                 members   = std::move(Members);
+        std::unique_ptr<SessionCommandQueue> commands = std::move(Commands);
+        std::unique_ptr<SessionTelemetry>    telemetry = std::move(Telemetry);
+
+        *this = Session();
+
+        players.clear();
+        points.clear();
+        checks.clear();
+        corpses.clear();
+        creatures.Clear();
+        members.Clear();
+        if (commands)
+            commands->Clear();
+        if (telemetry)
+            telemetry->Clear();
+        Players            = std::move(players);
+        SpawnPoints        = std::move(points);
+        PendingPhaseChecks = std::move(checks);
+        Corpses            = std::move(corpses);
+        Creatures          = std::move(creatures);
+        Members            = std::move(members);
+        Commands           = std::move(commands);
+        Telemetry          = std::move(telemetry);
     }
 
     bool IsActive() const
@@ -175,51 +446,19 @@ struct Session
         return nullptr;
     }
 
+    // Tracked state: true if some member has every flag in state.
+    bool AnyMemberIn(uint8 state) const
+    {
+        for (const auto& p : Players)
+            if ((p.State & state) == state) return true;
+        return false;
+    }
+
     uint32 GetAlivePlayerCount() const;
     bool   IsPartyWiped() const;
     bool   IsGroupInCombat() const;
 };
 
-struct CreaturePoolEntry
-{
-    uint32 Entry    = 0;
-    uint32 Type     = 0;
-    uint8  MinLevel = 1;
-    uint8  MaxLevel = 80;
-};
-
-struct ClassLevelStatEntry
-{
-    uint32 BaseHP         = 1;
-    float  BaseDamage     = 1.0f;
-    uint32 BaseArmor      = 0;
-    uint32 AttackPower    = 0;
-};
-
-struct RewardItem
-{
-    uint32 Entry         = 0;
-    uint32 MinLevel      = 1;
-    uint32 MaxLevel      = 80;
-    uint16 ItemLevel     = 0;
-    uint8  Quality       = 0;       // 0=Poor .. 4=Epic
-    uint32 InventoryType = 0;
-    uint32 Class         = 0;       // 2=Weapon, 4=Armor
-    uint32 SubClass      = 0;
-    int32  AllowableClass = -1;
-};
-
-struct LootPoolItem
-{
-    uint32 Entry          = 0;
-    uint8  MinLevel       = 0;
-    uint16 ItemLevel      = 0;
-    uint8  Quality        = 0;
-    uint8  ItemClass      = 0;
-    uint8  SubClass       = 0;
-    int32  AllowableClass = -1;
-};
-
 struct PlayerStats
 {
     ObjectGuid PlayerGuid;
@@ -5,7 +5,16 @@
 
 #include "DungeonMasterMgr.h"
 #include "RoguelikeMgr.h"
+#include "DMArena.h"
+#include "DMBroadcast.h"
 #include "DMConfig.h"
+#include "DMLog.h"
+#include "DMTrace.h"
+#include "DMHookRecorder.h"
+#include "DMScalingMath.h"
+#include "DMLootMath.h"
+#include "DMPopulatePlan.h"
+#include "DMSpawnMath.h"
 #include "Player.h"
 #include "Group.h"
 #include "Creature.h"
@@ -13,6 +22,7 @@
 #include "Map.h"
 #include "MapMgr.h"
 #include "GameObject.h"
+#include "TemporarySummon.h"
 #include "ObjectMgr.h"
 #include "WorldSession.h"
 #include "World.h"
@@ -32,9 +42,9 @@
 #include "GridNotifiersImpl.h"
 #include <random>
 #include <algorithm>
-#include <set>
 #include <cstdio>
 #include <cmath>
+#include <unordered_set>
 
 namespace DungeonMaster
 {
@@ -351,7 +361,30 @@ private:
     uint32 _aggroTimer = 0;
 };
 
+// Live MemberState of a player relative to a session map.
+static uint8 GetMemberState(Player* p, uint32 mapId)
+{
+    uint8 state = 0;
+    if (p->IsInWorld())         state |= MEMBER_IN_WORLD;
+    if (p->GetMapId() == mapId) state |= MEMBER_IN_MAP;
+    if (p->IsAlive())
+    {
+        state |= MEMBER_ALIVE;
+        if (p->IsInCombat())    state |= MEMBER_IN_COMBAT;
+    }
+    return state;
+}
+
 // Session helper implementations (declared in DMTypes.h)
+void SessionMembers::Add(ObjectGuid guid, uint32 mapId)
+{
+    ResolvedMember m;
+    m.Ptr = ObjectAccessor::FindPlayer(guid);
+    if (m.Ptr)
+        m.State = GetMemberState(m.Ptr, mapId);
+    _members.push_back(m);
+}
+
 uint32 Session::GetAlivePlayerCount() const
 {
     uint32 n = 0;
@@ -391,6 +424,12 @@ void DungeonMasterMgr::Initialize()
 {
     LOG_INFO("module", "DungeonMaster: Initializing...");
     LoadFromDB();
+    {
+        DMLockGuard lock(_sessionMutex);
+        _activeSessions.reserve(sDMConfig->GetMaxConcurrentRuns());
+        _sessionPool.reserve(sDMConfig->GetMaxConcurrentRuns());
+        _mapSessions.reserve(sDMConfig->GetMaxConcurrentRuns());
+    }
     LOG_INFO("module", "DungeonMaster: Ready — {} creature types, {} bosses, {} dungeon bosses, {} reward items, {} loot items.",
         _creaturesByType.size(), _bossCreatures.size(), _dungeonBossPool.size(), _rewardItems.size(), _lootPool.size());
 }
@@ -770,20 +809,21 @@ Session* DungeonMasterMgr::CreateSession(Player* leader, uint32 difficultyId,
                                           uint32 themeId, uint32 mapId,
                                           bool scaleToParty)
 {
+    DMTraceSpan span("CreateSession");
+
     const DifficultyTier* diff  = sDMConfig->GetDifficulty(difficultyId);
     const Theme*          theme = sDMConfig->GetTheme(themeId);
     const DungeonInfo*    dg    = sDMConfig->GetDungeon(mapId);
     if (!diff || !theme || !dg)
         return nullptr;
 
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
 
     // Check capacity under the lock to avoid race conditions
     if (!CanCreateNewSession())
         return nullptr;
 
-    Session s;
-    s.SessionId    = _nextSessionId++;
+    Session& s = AcquireSession(_nextSessionId++)->second;
     s.LeaderGuid   = leader->GetGUID();
     s.State        = SessionState::Preparing;
     s.DifficultyId = difficultyId;
@@ -829,6 +869,7 @@ Session* DungeonMasterMgr::CreateSession(Player* leader, uint32 difficultyId,
     ld.ReturnMapId = leader->GetMapId();
     ld.ReturnPosition = { leader->GetPositionX(), leader->GetPositionY(),
                           leader->GetPositionZ(), leader->GetOrientation() };
+    ld.State       = GetMemberState(leader, mapId);
     s.Players.push_back(ld);
 
 
@@ -844,32 +885,63 @@ Session* DungeonMasterMgr::CreateSession(Player* leader, uint32 difficultyId,
                 md.ReturnMapId = m->GetMapId();
                 md.ReturnPosition = { m->GetPositionX(), m->GetPositionY(),
                                       m->GetPositionZ(), m->GetOrientation() };
+                md.State       = GetMemberState(m, mapId);
                 s.Players.push_back(md);
             }
         }
     }
 
-    _activeSessions[s.SessionId] = s;
     for (const auto& pd : s.Players)
         _playerToSession[pd.PlayerGuid] = s.SessionId;
 
+    // Nobody is on the map until the teleport lands
+    if (!s.AnyMemberIn(MEMBER_IN_MAP))
+        _abandonWatch.push_back(s.SessionId);
+
+    span.SetSession(s.SessionId);
+    sDMTrace->SessionBegin(s.SessionId, mapId);
+
+    if (sDMHookRecorder->IsEnabled())
+    {
+        Core::HookRecord rec;
+        rec.Type      = uint8(Core::HookType::SessionStart);
+        rec.Actor     = leader->GetGUID().GetRawValue();
+        rec.MapId     = mapId;
+        rec.SessionId = s.SessionId;
+        rec.Amount    = s.EffectiveLevel;
+        rec.Extra     = dg->MaxLevel;
+        rec.F0        = sDMConfig->GetSoloMultiplier();
+        rec.Flags     = scaleToParty ? Core::HOOK_FLAG_SCALE_TO_PARTY : 0;
+        sDMHookRecorder->Record(rec);
+
+        for (const auto& pd : s.Players)
+        {
+            Core::HookRecord join;
+            join.Type      = uint8(Core::HookType::PlayerJoin);
+            join.Actor     = pd.PlayerGuid.GetRawValue();
+            join.MapId     = mapId;
+            join.SessionId = s.SessionId;
+            sDMHookRecorder->Record(join);
+        }
+    }
+
     LOG_INFO("module", "DungeonMaster: Session {} — leader {}, party {}, diff {}, level band {}-{}, scale={}",
         s.SessionId, leader->GetName(), s.Players.size(),
         diff->Name, s.LevelBandMin, s.LevelBandMax, scaleToParty ? "party" : "tier");
 
-    return &_activeSessions[s.SessionId];
+    return &s;
 }
 
 Session* DungeonMasterMgr::GetSession(uint32 id)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
     auto it = _activeSessions.find(id);
     return it != _activeSessions.end() ? &it->second : nullptr;
 }
 
 Session* DungeonMasterMgr::GetSessionByInstance(uint32 instId)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
     auto it = _instanceToSession.find(instId);
     if (it != _instanceToSession.end())
     {
@@ -881,7 +953,7 @@ Session* DungeonMasterMgr::GetSessionByInstance(uint32 instId)
 
 Session* DungeonMasterMgr::GetSessionByPlayer(ObjectGuid guid)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
     auto it = _playerToSession.find(guid);
     if (it != _playerToSession.end())
     {
@@ -896,6 +968,7 @@ Session* DungeonMasterMgr::GetSessionByPlayer(ObjectGuid guid)
 bool DungeonMasterMgr::StartDungeon(Session* session)
 {
     if (!session) return false;
+    DMTraceSpan span("StartDungeon", session->SessionId);
 
     session->EntrancePos = GetDungeonEntrance(session->MapId);
     if (session->EntrancePos.GetPositionX() == 0 &&
@@ -911,17 +984,38 @@ bool DungeonMasterMgr::StartDungeon(Session* session)
 bool DungeonMasterMgr::TeleportPartyIn(Session* session)
 {
     if (!session) return false;
+    DMTraceSpan span("TeleportPartyIn", session->SessionId);
     const DungeonInfo* dg = sDMConfig->GetDungeon(session->MapId);
     if (!dg) return false;
 
     Position ent = session->EntrancePos;
     uint32 ok = 0;
 
-    for (auto& pd : session->Players)
+    // Same text for everyone: pack it once
+    char buf[256];
+    snprintf(buf, sizeof(buf),
+        "|cFF00FF00[Dungeon Master]|r Welcome to |cFFFFFFFF%s|r! "
+        "Defeat the boss to claim your reward.",
+        dg->Name.c_str());
+    DMChatPacket welcome(buf);
+
+    DMChatPacket affixes;
+    if (session->RoguelikeRunId != 0 && sRoguelikeMgr->HasActiveAffixes(session->RoguelikeRunId))
     {
-        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
+        std::string affixNames = sRoguelikeMgr->GetActiveAffixNames(session->RoguelikeRunId);
+        char affixBuf[512];
+        snprintf(affixBuf, sizeof(affixBuf),
+            "|cFF00FFFF[Roguelike]|r Active affixes: %s", affixNames.c_str());
+        affixes.Build(affixBuf);
+    }
+
+    SessionMembers const& members = GetMembers(*session);
+    for (size_t i = 0; i < members.size(); ++i)
+    {
+        Player* p = members[i].Ptr;
         if (!p) continue;
 
+        PlayerSessionData& pd = session->Players[i];
         pd.ReturnMapId    = p->GetMapId();
         pd.ReturnPosition = { p->GetPositionX(), p->GetPositionY(),
                               p->GetPositionZ(), p->GetOrientation() };
@@ -940,28 +1034,14 @@ bool DungeonMasterMgr::TeleportPartyIn(Session* session)
             ++ok;
             LOG_INFO("module", "DungeonMaster: TeleportTo queued for {} → map {} ({:.1f}, {:.1f}, {:.1f})",
                 p->GetName(), session->MapId, ent.GetPositionX(), ent.GetPositionY(), ent.GetPositionZ());
-            char buf[256];
-            snprintf(buf, sizeof(buf),
-                "|cFF00FF00[Dungeon Master]|r Welcome to |cFFFFFFFF%s|r! "
-                "Defeat the boss to claim your reward.",
-                dg->Name.c_str());
-            ChatHandler(p->GetSession()).SendSysMessage(buf);
-
-            if (session->RoguelikeRunId != 0 && sRoguelikeMgr->HasActiveAffixes(session->RoguelikeRunId))
-            {
-                std::string affixNames = sRoguelikeMgr->GetActiveAffixNames(session->RoguelikeRunId);
-                char affixBuf[512];
-                snprintf(affixBuf, sizeof(affixBuf),
-                    "|cFF00FFFF[Roguelike]|r Active affixes: %s", affixNames.c_str());
-                ChatHandler(p->GetSession()).SendSysMessage(affixBuf);
-            }
+            welcome.SendTo(p);
+            affixes.SendTo(p);
         }
         else
         {
             LOG_ERROR("module", "DungeonMaster: TeleportTo FAILED for {} → map {} ({:.1f}, {:.1f}, {:.1f})",
                 p->GetName(), session->MapId, ent.GetPositionX(), ent.GetPositionY(), ent.GetPositionZ());
-            ChatHandler(p->GetSession()).SendSysMessage(
-                "|cFFFF0000[Dungeon Master]|r Teleport failed! You may lack access to this dungeon.");
+            GetMessagePacket(DMMessage::TeleportFailed).SendTo(p);
         }
     }
 
@@ -978,10 +1058,12 @@ bool DungeonMasterMgr::TeleportPartyIn(Session* session)
 void DungeonMasterMgr::TeleportPartyOut(Session* session)
 {
     if (!session) return;
-    for (const auto& pd : session->Players)
+    SessionMembers const& members = GetMembers(*session);
+    for (size_t i = 0; i < members.size(); ++i)
     {
-        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-        if (!p || !p->IsInWorld()) continue;
+        if (!members[i].Is(MEMBER_IN_WORLD)) continue;
+        Player* p = members[i].Ptr;
+        PlayerSessionData const& pd = session->Players[i];
         p->RemoveFlag(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTE_NO_RELEASE_WINDOW);
         if (!p->IsAlive()) { p->ResurrectPlayer(1.0f); p->SpawnCorpseBones(); }
         p->TeleportTo(pd.ReturnMapId, pd.ReturnPosition.GetPositionX(),
@@ -1007,16 +1089,16 @@ Position DungeonMasterMgr::GetDungeonEntrance(uint32 mapId)
 }
 
 // Spawn-point collection
-std::vector<SpawnPoint> DungeonMasterMgr::GetSpawnPointsForMap(uint32 mapId)
+void DungeonMasterMgr::GetSpawnPointsForMap(uint32 mapId, std::vector<SpawnPoint>& pts)
 {
-    std::vector<SpawnPoint> pts;
+    pts.clear();
 
     char q[256];
     snprintf(q, sizeof(q),
         "SELECT position_x, position_y, position_z, orientation "
         "FROM creature WHERE map = %u", mapId);
     QueryResult result = WorldDatabase.Query(q);
-    if (!result) return pts;
+    if (!result) return;
 
     Position ent = GetDungeonEntrance(mapId);
     float ex = ent.GetPositionX(), ey = ent.GetPositionY(), ez = ent.GetPositionZ();
@@ -1126,33 +1208,132 @@ std::vector<SpawnPoint> DungeonMasterMgr::GetSpawnPointsForMap(uint32 mapId)
         for (uint32 i = 0; i < bc && i < pts.size(); ++i)
             pts[pts.size() - 1 - i].IsBossPosition = true;
     }
-
-    return pts;
 }
 
 // Instance population
+
+// Spawns are built off-map: created, given their final faction, flags,
+// level, stats and movement, and only then added. AddToMap publishes the
+// finished object in one create block, instead of a values delta per
+// setter plus a forced visibility pass for every creature.
+static TempSummon* CreateOffMapSummon(InstanceMap* map, uint32 entry, Position const& pos)
+{
+    TempSummon* summon = new TempSummon(nullptr, ObjectGuid::Empty, false);
+    if (!summon->Create(map->GenerateLowGuid<HighGuid::Unit>(), map, PHASEMASK_NORMAL, entry, 0,
+                        pos.GetPositionX(), pos.GetPositionY(), pos.GetPositionZ(), pos.GetOrientation()))
+    {
+        delete summon;
+        return nullptr;
+    }
+
+    summon->SetHomePosition(pos);
+    summon->InitStats(0);
+    return summon;
+}
+
+static bool AddSummonToMap(InstanceMap* map, TempSummon* summon)
+{
+    if (!map->AddToMap(summon->ToCreature()))
+    {
+        delete summon;
+        return false;
+    }
+
+    summon->InitSummon();
+    return true;
+}
+
+// Hostile to all and attackable; shared by trash, rares and bosses.
+static void SetHostileSpawnFields(Creature* c, uint32 corpseDelay)
+{
+    c->SetFaction(14);
+    c->SetReactState(REACT_AGGRESSIVE);
+    c->SetCorpseDelay(corpseDelay);
+    c->RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE | UNIT_FLAG_IMMUNE_TO_PC
+                                    | UNIT_FLAG_IMMUNE_TO_NPC | UNIT_FLAG_PACIFIED
+                                    | UNIT_FLAG_STUNNED | UNIT_FLAG_FLEEING
+                                    | UNIT_FLAG_NOT_SELECTABLE);
+    c->SetUInt32Value(UNIT_FIELD_FLAGS_2, 0);
+    c->setActive(true);             // Keep creature in grid update cycle for aggro detection
+}
+
+std::vector<ObjectGuid>& DungeonMasterMgr::TrackInstanceCreatures(uint32 instanceId)
+{
+    auto it = _instanceCreatureGuids.find(instanceId);
+    if (it != _instanceCreatureGuids.end())
+        return it->second;
+
+    // Over the bound only when destroy hooks were missed. Instances with
+    // no session left are never populated again, so their lists can go;
+    // callers copy lists out under the lock, so none is in use here.
+    if (_instanceCreatureGuids.size() >= MAX_TRACKED_INSTANCES)
+    {
+        std::unordered_set<uint32> live;
+        for (auto const& [id, session] : _activeSessions)
+            if (session.InstanceId)
+                live.insert(session.InstanceId);
+
+        for (auto e = _instanceCreatureGuids.begin(); e != _instanceCreatureGuids.end();)
+        {
+            if (live.count(e->first))
+                ++e;
+            else
+                e = _instanceCreatureGuids.erase(e);
+        }
+        LOG_WARN("module", "DungeonMaster: Creature tracking hit {} instances, kept {} with a live session",
+            MAX_TRACKED_INSTANCES, _instanceCreatureGuids.size());
+    }
+    return _instanceCreatureGuids[instanceId];
+}
+
+void DungeonMasterMgr::OnInstanceDestroyed(uint32 instanceId)
+{
+    DMLockGuard lock(_sessionMutex);
+    _instanceCreatureGuids.erase(instanceId);
+}
+
+float DungeonMasterMgr::GetSpawnDensity() const
+{
+    DMConfigSnapshot const* cfg = sDMConfig;
+    float pressure = std::max(
+        Core::LoadPressure(float(GetAverageWorldTickMs()), float(cfg->GetLoadTickMs()), float(cfg->GetLoadTickMaxMs())),
+        Core::LoadPressure(float(GetLiveCreatureCount()), float(cfg->GetLoadCreatures()), float(cfg->GetLoadCreaturesMax())));
+    return Core::LoadDensity(pressure, cfg->GetLoadMinDensity());
+}
+
+uint32 DungeonMasterMgr::GetTrackedInstanceCount() const
+{
+    DMLockGuard lock(_sessionMutex);
+    return static_cast<uint32>(_instanceCreatureGuids.size());
+}
+
 void DungeonMasterMgr::ClearDungeonCreatures(InstanceMap* map)
 {
     if (!map) return;
+    DMTraceSpan span("ClearDungeonCreatures");
 
     uint32 npcEntry = sDMConfig->GetNpcEntry();
     uint32 totalRemoved = 0;
 
     // Phase 1: despawn our tracked creatures
+    // Taken out of the map under the lock; the entry may be erased by
+    // another thread while we despawn.
     uint32 instanceId = map->GetInstanceId();
-    auto guidIt = _instanceCreatureGuids.find(instanceId);
-    if (guidIt != _instanceCreatureGuids.end())
+    std::vector<ObjectGuid> tracked;
     {
-        for (const ObjectGuid& guid : guidIt->second)
+        DMLockGuard lock(_sessionMutex);
+        auto guidIt = _instanceCreatureGuids.find(instanceId);
+        if (guidIt != _instanceCreatureGuids.end())
+            tracked.swap(guidIt->second);
+    }
+    for (const ObjectGuid& guid : tracked)
+    {
+        Creature* c = map->GetCreature(guid);
+        if (c && c->IsInWorld())
         {
-            Creature* c = map->GetCreature(guid);
-            if (c && c->IsInWorld())
-            {
-                c->DespawnOrUnsummon();
-                ++totalRemoved;
-            }
+            c->DespawnOrUnsummon();
+            ++totalRemoved;
         }
-        guidIt->second.clear();
     }
 
     uint32 dbRemoved = 0;
@@ -1232,13 +1413,21 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
         session->SessionId, session->MapId, map->GetInstanceId(),
         session->TotalMobs, session->TotalBosses);
 
-    const DifficultyTier* diff  = sDMConfig->GetDifficulty(session->DifficultyId);
-    const Theme*          theme = sDMConfig->GetTheme(session->ThemeId);
+    // One version for the whole populate; diff and theme point into it.
+    DMConfigPin cfg = DMConfig::Instance()->Pin();
+
+    const DifficultyTier* diff  = cfg->GetDifficulty(session->DifficultyId);
+    const Theme*          theme = cfg->GetTheme(session->ThemeId);
     if (!diff || !theme) return;
 
+    DMTraceSpan total("PopulateDungeon", session->SessionId);
+    DMTraceSpan phase("Populate.Clear", session->SessionId);
+
     ClearDungeonCreatures(map);
     OpenAllDoors(map);
 
+    phase.Next("Populate.NeutralizeEncounters");
+
     // Mark all boss encounters as DONE so scripts don't interfere
     if (InstanceScript* script = map->GetInstanceScript())
     {
@@ -1263,10 +1452,11 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
     }
 
     // Purge lingering debuffs from despawned creatures
-    for (const auto& pd : session->Players)
+    phase.Next("Populate.PurgeDebuffs");
+    for (auto const& m : GetMembers(*session))
     {
-        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-        if (!p || !p->IsInWorld()) continue;
+        if (!m.Is(MEMBER_IN_WORLD)) continue;
+        Player* p = m.Ptr;
 
         std::vector<uint32> toRemove;
         for (auto const& pair : p->GetAppliedAuras())
@@ -1286,7 +1476,8 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
                 toRemove.size(), p->GetName());
     }
 
-    session->SpawnPoints = GetSpawnPointsForMap(session->MapId);
+    phase.Next("Populate.SpawnPoints");
+    GetSpawnPointsForMap(session->MapId, session->SpawnPoints);
     if (session->SpawnPoints.empty())
     {
         LOG_ERROR("module", "DungeonMaster: No spawn points for map {}", session->MapId);
@@ -1301,10 +1492,28 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
     uint8 targetLevel = session->EffectiveLevel;
 
 
+    // The GUID list is built locally (reusing the tracked list's storage)
+    // and published under the lock once everything is summoned; the map
+    // entry itself may be erased meanwhile by OnInstanceDestroyed or the
+    // tracking cap.
     uint32 instanceId = map->GetInstanceId();
-    auto& guidList = _instanceCreatureGuids[instanceId];
+    std::vector<ObjectGuid> guidList;
+    {
+        DMLockGuard lock(_sessionMutex);
+        guidList.swap(TrackInstanceCreatures(instanceId));
+    }
     guidList.clear();
 
+    if (sDMHookRecorder->IsEnabled())
+    {
+        Core::HookRecord rec;
+        rec.Type       = uint8(Core::HookType::InstanceBind);
+        rec.MapId      = session->MapId;
+        rec.InstanceId = instanceId;
+        rec.SessionId  = session->SessionId;
+        sDMHookRecorder->Record(rec);
+    }
+
     LOG_INFO("module", "DungeonMaster: Populating session {} — theme '{}', band {}-{}, target lvl {}, HP x{:.2f}, DMG x{:.2f}",
         session->SessionId, theme->Name, bandMin, bandMax, targetLevel, hpMult, dmgMult);
 
@@ -1313,19 +1522,20 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
     // NOT the difficulty tier's DamageMultiplier (to avoid double-stacking).
     float bossOnlyDmgMult;
     {
-        uint32 n = session->Players.size();
-        if (n <= 1) bossOnlyDmgMult = sDMConfig->GetSoloMultiplier();
-        else        bossOnlyDmgMult = 1.0f + (n - 1) * sDMConfig->GetPerPlayerDamageMult();
+        bossOnlyDmgMult = Core::PartyMultiplier(1.0f, session->Players.size(),
+            cfg->GetSoloMultiplier(), cfg->GetPerPlayerDamageMult());
         if (session->RoguelikeRunId != 0)
             bossOnlyDmgMult *= sRoguelikeMgr->GetTierDamageMultiplier(session->RoguelikeRunId);
     }
 
+    float armorMult = session->RoguelikeRunId != 0
+        ? sRoguelikeMgr->GetTierArmorMultiplier(session->RoguelikeRunId) : 1.0f;
+
+    // Runs on the off-map summon, before AddToMap
     auto applyLevelAndStats = [&](Creature* c, float extraHpMult, float extraDmgMult, bool isBoss)
     {
-    
         c->SetLevel(targetLevel);
 
-    
         if (isBoss)
         {
             c->SetByteValue(UNIT_FIELD_BYTES_0, 2, 1);  // Elite rank → gold dragon frame
@@ -1335,50 +1545,27 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
         uint8 unitClass = c->GetCreatureTemplate()->unit_class;
         const ClassLevelStatEntry* baseStats = GetBaseStatsForLevel(unitClass, targetLevel);
 
-    
-        float finalHP;
-        if (baseStats)
-            finalHP = static_cast<float>(baseStats->BaseHP) * hpMult * extraHpMult;
-        else
-            finalHP = c->GetMaxHealth() * hpMult * extraHpMult;
-
-        uint32 hp = std::max(1u, static_cast<uint32>(finalHP));
-        c->SetMaxHealth(hp);
-        c->SetHealth(hp);
-
         // For bosses, use party-only scaling (bossOnlyDmgMult) instead of the full
         // tier+party dmgMult to prevent double-stacking tier DamageMultiplier with BossDamageMult
         float effectiveDmgMult = isBoss ? bossOnlyDmgMult : dmgMult;
 
-        if (baseStats)
-        {
-            float dmgBase  = baseStats->BaseDamage;
-            float apBonus  = static_cast<float>(baseStats->AttackPower) / 14.0f;
-            float atkTime  = static_cast<float>(c->GetCreatureTemplate()->BaseAttackTime) / 1000.0f;
-            if (atkTime <= 0.0f) atkTime = 2.0f;
-
-            float minDmg = (dmgBase + apBonus) * atkTime * effectiveDmgMult * extraDmgMult;
-            float maxDmg = ((dmgBase * 1.15f) + apBonus) * atkTime * effectiveDmgMult * extraDmgMult;
+        Core::CreatureStats stats = Core::ComputeCreatureStats(baseStats, c->GetMaxHealth(), c->GetArmor(),
+            c->GetCreatureTemplate()->BaseAttackTime, hpMult, extraHpMult,
+            effectiveDmgMult, extraDmgMult, armorMult);
 
-            minDmg = std::max(1.0f, minDmg);
-            maxDmg = std::max(minDmg, maxDmg);
+        c->SetMaxHealth(stats.MaxHealth);
+        c->SetHealth(stats.MaxHealth);
 
-            c->SetBaseWeaponDamage(BASE_ATTACK, MINDAMAGE, minDmg);
-            c->SetBaseWeaponDamage(BASE_ATTACK, MAXDAMAGE, maxDmg);
+        if (stats.HasWeaponDamage)
+        {
+            c->SetBaseWeaponDamage(BASE_ATTACK, MINDAMAGE, stats.MinDamage);
+            c->SetBaseWeaponDamage(BASE_ATTACK, MAXDAMAGE, stats.MaxDamage);
             c->UpdateDamagePhysical(BASE_ATTACK);
         }
 
-        // --- Armor (from classlevelstats for the TARGET level) ---
-        if (baseStats && baseStats->BaseArmor > 0)
-            c->SetArmor(baseStats->BaseArmor);
-
-        // --- Roguelike: additional armor scaling from tier progression ---
-        if (session->RoguelikeRunId != 0)
-        {
-            float armorMult = sRoguelikeMgr->GetTierArmorMultiplier(session->RoguelikeRunId);
-            if (armorMult > 1.0f)
-                c->SetArmor(static_cast<uint32>(c->GetArmor() * armorMult));
-        }
+        // --- Armor (classlevelstats for the TARGET level, roguelike tier on top) ---
+        if (stats.HasArmor)
+            c->SetArmor(stats.Armor);
 
         // --- Clear ALL spell resistances (original template values are for original level) ---
         for (uint8 school = SPELL_SCHOOL_HOLY; school < MAX_SPELL_SCHOOL; ++school)
@@ -1403,8 +1590,15 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
             // Trash mobs patrol a 5 yd radius around their spawn point
             c->SetWanderDistance(5.0f);
             c->SetDefaultMovementType(RANDOM_MOTION_TYPE);
-            c->GetMotionMaster()->MoveRandom(5.0f);
         }
+    };
+
+    // Adds a configured summon to the map, then installs the AI (AddToMap
+    // initializes the template AI) and tracks the GUID for cleanup.
+    auto publishSpawn = [&](TempSummon* c, bool isBoss) -> bool
+    {
+        if (!AddSummonToMap(map, c))
+            return false;
 
         // --- Install custom AI ---
         // Both trash and bosses get custom AI.  Boss creatures are pulled from
@@ -1417,181 +1611,133 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
         if (isBoss)
             c->SetAI(new DungeonMasterBossAI(c));
         else
+        {
             c->SetAI(new DungeonMasterCreatureAI(c));
-
-        // Force visibility refresh or client won't see the creature
-        c->UpdateObjectVisibility(true);
+            c->GetMotionMaster()->MoveRandom(5.0f);
+        }
 
         // Track this GUID for future cleanup
         guidList.push_back(c->GetGUID());
+        return true;
     };
 
+    // Plan every spawn (creature picks, elite/rare rolls, multipliers) up
+    // front; the loops below only summon and apply what was planned.
+    phase.Next("Populate.Plan");
+    Core::PopulateParams params;
+    params.EliteChance = cfg->GetEliteChance();
+    params.EliteHpMult = cfg->GetEliteHealthMult();
+    params.RareChance  = cfg->GetRareSpawnChance();
+    params.RareHpMult  = cfg->GetRareHealthMult();
+    params.RareDmgMult = cfg->GetRareDamageMult();
+    params.BossCount   = cfg->GetBossCount();
+    params.BossHpMult  = cfg->GetBossHealthMult();
+    params.BossDmgMult = cfg->GetBossDamageMult();
+    params.Density     = GetSpawnDensity();
+    if (params.Density < 1.0f)
+        LOG_INFO("module", "DungeonMaster: Session {} — server under load (world tick {} ms, {} live creatures), "
+            "trash density {:.0f}%",
+            session->SessionId, GetAverageWorldTickMs(), GetLiveCreatureCount(), params.Density * 100.0f);
+    if (session->RoguelikeRunId != 0)
+    {
+        float unused = 1.0f;
+        sRoguelikeMgr->GetAffixMultipliers(session->RoguelikeRunId, false, false,
+            params.TrashAffixHp, params.TrashAffixDmg, params.AffixEliteMult);
+        sRoguelikeMgr->GetAffixMultipliers(session->RoguelikeRunId, true, true,
+            params.BossAffixHp, params.BossAffixDmg, unused);
+    }
+
+    // Thinned trash pays out what the full population would have, with
+    // the kept creatures' higher elite share (and its XP) priced in.
+    session->TrashXpMult   = Core::ThinnedTotalFactor(params, ELITE_KILL_XP_MULT);
+    session->TrashGoldMult = Core::ThinnedTotalFactor(params, 1.0f);
+
+    Core::PopulationPlan plan;
+    Core::PlanPopulation(session->SpawnPoints, params,
+        [&] { return SelectCreatureForTheme(theme, false); },
+        [&] { return SelectCreatureForTheme(theme, true); },
+        [&]
+        {
+            uint32 entry = SelectDungeonBoss(theme);
+            if (!entry)
+                LOG_WARN("module", "DungeonMaster: No boss candidate.");
+            return entry;
+        },
+        tRng, plan);
+
+    session->Creatures.Reserve(session->Creatures.Size() + plan.Spawns.size());
+    guidList.reserve(plan.Spawns.size() + 1);
+
     // Spawn trash mobs
+    phase.Next("Populate.Trash");
+    size_t next = 0;
     uint32 spawnedMobs = 0;
-    for (auto& sp : session->SpawnPoints)
+    for (; next < plan.Spawns.size() && plan.Spawns[next].Role == Core::SpawnRole::Trash; ++next)
     {
-        if (sp.IsBossPosition) continue;
-
-        uint32 entry = SelectCreatureForTheme(theme, false);
-        if (!entry) continue;
+        Core::PlannedSpawn const& ps = plan.Spawns[next];
 
-        Creature* c = map->SummonCreature(entry, sp.Pos);
+        TempSummon* c = CreateOffMapSummon(map, ps.Entry, session->SpawnPoints[ps.Point].Pos);
         if (!c) continue;
 
-        c->SetFaction(14);               // hostile to all
-        c->SetReactState(REACT_AGGRESSIVE);
-        c->SetObjectScale(1.0f);
-        c->SetCorpseDelay(300);          // 5 min corpse before despawn
-        c->RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE | UNIT_FLAG_IMMUNE_TO_PC
-                                        | UNIT_FLAG_IMMUNE_TO_NPC | UNIT_FLAG_PACIFIED
-                                        | UNIT_FLAG_STUNNED | UNIT_FLAG_FLEEING
-                                        | UNIT_FLAG_NOT_SELECTABLE);
-        c->SetUInt32Value(UNIT_FIELD_FLAGS_2, 0);
-        c->SetImmuneToPC(false);
-        c->SetImmuneToNPC(false);
-        c->setActive(true);             // Keep creature in grid update cycle for aggro detection
-
-        bool isElite = (RandInt<uint32>(1, 100) <= sDMConfig->GetEliteChance());
-
-        // Roguelike affix multipliers for trash
-        float affixHpMult = 1.0f, affixDmgMult = 1.0f, affixEliteMult = 1.0f;
-        if (session->RoguelikeRunId != 0)
-        {
-            sRoguelikeMgr->GetAffixMultipliers(session->RoguelikeRunId,
-                false, isElite, affixHpMult, affixDmgMult, affixEliteMult);
-            // Savage affix: boosted elite chance
-            if (affixEliteMult > 1.0f && !isElite)
-            {
-                uint32 boostedChance = static_cast<uint32>(sDMConfig->GetEliteChance() * affixEliteMult);
-                isElite = (RandInt<uint32>(1, 100) <= boostedChance);
-            }
-        }
-
-        float eliteHpMult  = isElite ? sDMConfig->GetEliteHealthMult() : 1.0f;
-        float eliteDmgMult = isElite ? 1.5f : 1.0f;
+        SetHostileSpawnFields(c, 300);   // 5 min corpse before despawn
+        applyLevelAndStats(c, ps.HpMult, ps.DmgMult, false);
+        if (!publishSpawn(c, false)) continue;
 
-        applyLevelAndStats(c, eliteHpMult * affixHpMult, eliteDmgMult * affixDmgMult, false);
-
-        SpawnedCreature sc;
-        sc.Guid = c->GetGUID(); sc.Entry = entry;
-        sc.IsElite = isElite; sc.IsBoss = false;
-        session->SpawnedCreatures.push_back(sc);
+        uint32 idx = session->Creatures.Add(c->GetGUID(), ps.Entry, ps.IsElite, false, false);
+        RecordCreatureSpawn(*session, c, idx, instanceId);
         ++spawnedMobs;
     }
-    session->TotalMobs = spawnedMobs;
 
-    // --- Rare spawn (configurable chance, max 1 per run) ---
-    if (sDMConfig->GetRareSpawnChance() > 0 &&
-        RandInt<uint32>(1, 100) <= sDMConfig->GetRareSpawnChance())
+    // --- Rare spawn (configurable chance, max 1 per run, middle of the dungeon) ---
+    phase.Next("Populate.Rare");
+    if (next < plan.Spawns.size() && plan.Spawns[next].Role == Core::SpawnRole::Rare)
     {
-        // Pick non-boss spawn points for rare placement (prefer middle of dungeon)
-        std::vector<size_t> validRarePoints;
-        for (size_t i = 0; i < session->SpawnPoints.size(); ++i)
-            if (!session->SpawnPoints[i].IsBossPosition)
-                validRarePoints.push_back(i);
+        Core::PlannedSpawn const& ps = plan.Spawns[next++];
+        SpawnPoint& rareSP = session->SpawnPoints[ps.Point];
 
-        if (!validRarePoints.empty())
+        TempSummon* r = CreateOffMapSummon(map, ps.Entry, rareSP.Pos);
+        if (r)
         {
-            size_t startIdx = validRarePoints.size() / 3;
-            size_t endIdx   = std::max(startIdx, validRarePoints.size() * 2 / 3);
-            if (endIdx >= validRarePoints.size()) endIdx = validRarePoints.size() - 1;
-            size_t pickIdx  = validRarePoints[RandInt<size_t>(startIdx, endIdx)];
-            SpawnPoint& rareSP = session->SpawnPoints[pickIdx];
+            SetHostileSpawnFields(r, 300);
 
-            uint32 rareEntry = SelectCreatureForTheme(theme, true);
-            if (rareEntry)
-            {
-                Creature* r = map->SummonCreature(rareEntry, rareSP.Pos);
-                if (r)
-                {
-                    r->SetFaction(14);
-                    r->SetReactState(REACT_AGGRESSIVE);
-                    r->SetCorpseDelay(300);
-                    r->RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE | UNIT_FLAG_IMMUNE_TO_PC
-                                                    | UNIT_FLAG_IMMUNE_TO_NPC | UNIT_FLAG_PACIFIED
-                                                    | UNIT_FLAG_STUNNED | UNIT_FLAG_FLEEING
-                                                    | UNIT_FLAG_NOT_SELECTABLE);
-                    r->SetUInt32Value(UNIT_FIELD_FLAGS_2, 0);
-                    r->SetImmuneToPC(false);
-                    r->SetImmuneToNPC(false);
-                    r->setActive(true);
-
-                    // Silver dragon portrait (rank 4 = rare)
-                    r->SetByteValue(UNIT_FIELD_BYTES_0, 2, 4);
-                    r->SetObjectScale(1.15f);
-
-                    float rareHpMult  = sDMConfig->GetRareHealthMult();
-                    float rareDmgMult = sDMConfig->GetRareDamageMult();
-
-                    // Apply roguelike affix multipliers to rares
-                    float affixHpM = 1.0f, affixDmgM = 1.0f, affixEliteM = 1.0f;
-                    if (session->RoguelikeRunId != 0)
-                        sRoguelikeMgr->GetAffixMultipliers(session->RoguelikeRunId,
-                            false, true, affixHpM, affixDmgM, affixEliteM);
-
-                    applyLevelAndStats(r, rareHpMult * affixHpM, rareDmgMult * affixDmgM, false);
-
-                    // Install custom AI (rare is treated as enhanced trash, not a scripted boss)
-                    r->SetAI(new DungeonMasterCreatureAI(r));
-
-                    SpawnedCreature sc;
-                    sc.Guid = r->GetGUID(); sc.Entry = rareEntry;
-                    sc.IsElite = true; sc.IsBoss = false; sc.IsRare = true;
-                    session->SpawnedCreatures.push_back(sc);
-                    guidList.push_back(r->GetGUID());
-
-                    for (const auto& pd : session->Players)
-                        if (Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid))
-                            if (p->GetSession())
-                                ChatHandler(p->GetSession()).SendSysMessage(
-                                    "|cFFFFD700[Dungeon Master]|r A |cFFFF8800rare enemy|r lurks in this dungeon!");
-
-                    LOG_INFO("module", "DungeonMaster: Rare creature spawned — entry {} at ({:.1f}, {:.1f}, {:.1f})",
-                        rareEntry, rareSP.Pos.GetPositionX(), rareSP.Pos.GetPositionY(), rareSP.Pos.GetPositionZ());
-                }
-            }
+            // Silver dragon portrait (rank 4 = rare)
+            r->SetByteValue(UNIT_FIELD_BYTES_0, 2, 4);
+            r->SetObjectScale(1.15f);
+
+            applyLevelAndStats(r, ps.HpMult, ps.DmgMult, false);
+
+            // Rare is treated as enhanced trash, not a scripted boss
+            if (!publishSpawn(r, false))
+                r = nullptr;
+        }
+        if (r)
+        {
+            uint32 idx = session->Creatures.Add(r->GetGUID(), ps.Entry, true, false, true);
+            RecordCreatureSpawn(*session, r, idx, instanceId);
+
+            GetMessagePacket(DMMessage::RareSpawned).SendToMembers(GetMembers(*session));
+
+            LOG_INFO("module", "DungeonMaster: Rare creature spawned — entry {} at ({:.1f}, {:.1f}, {:.1f})",
+                ps.Entry, rareSP.Pos.GetPositionX(), rareSP.Pos.GetPositionY(), rareSP.Pos.GetPositionZ());
         }
     }
 
     // Spawn bosses (real dungeon bosses)
+    phase.Next("Populate.Bosses");
     uint32 bossesSpawned = 0;
-    for (auto& sp : session->SpawnPoints)
+    for (; next < plan.Spawns.size(); ++next)
     {
-        if (!sp.IsBossPosition || bossesSpawned >= sDMConfig->GetBossCount())
-            continue;
+        Core::PlannedSpawn const& ps = plan.Spawns[next];
 
-        uint32 entry = SelectDungeonBoss(theme);
-        if (!entry) { LOG_WARN("module", "DungeonMaster: No boss candidate."); continue; }
-
-        Creature* b = map->SummonCreature(entry, sp.Pos);
+        TempSummon* b = CreateOffMapSummon(map, ps.Entry, session->SpawnPoints[ps.Point].Pos);
         if (!b) continue;
 
-        b->SetFaction(14);
-        b->SetReactState(REACT_AGGRESSIVE);
-        b->SetCorpseDelay(600);          // 10 min corpse for bosses
-        b->RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE | UNIT_FLAG_IMMUNE_TO_PC
-                                        | UNIT_FLAG_IMMUNE_TO_NPC | UNIT_FLAG_PACIFIED
-                                        | UNIT_FLAG_STUNNED | UNIT_FLAG_FLEEING
-                                        | UNIT_FLAG_NOT_SELECTABLE);
-        b->SetUInt32Value(UNIT_FIELD_FLAGS_2, 0);
-        b->SetImmuneToPC(false);
-        b->SetImmuneToNPC(false);
-        b->setActive(true);             // Keep creature in grid update cycle for aggro detection
-
-        // Roguelike affix multipliers for bosses
-        float bossAffixHpMult = 1.0f, bossAffixDmgMult = 1.0f, _unused = 1.0f;
-        if (session->RoguelikeRunId != 0)
-            sRoguelikeMgr->GetAffixMultipliers(session->RoguelikeRunId,
-                true, true, bossAffixHpMult, bossAffixDmgMult, _unused);
-
-        applyLevelAndStats(b,
-            sDMConfig->GetBossHealthMult() * bossAffixHpMult,
-            sDMConfig->GetBossDamageMult() * bossAffixDmgMult, true);
+        SetHostileSpawnFields(b, 600);   // 10 min corpse for bosses
+        applyLevelAndStats(b, ps.HpMult, ps.DmgMult, true);
+        if (!publishSpawn(b, true)) continue;
 
-        SpawnedCreature sc;
-        sc.Guid = b->GetGUID(); sc.Entry = entry;
-        sc.IsElite = true; sc.IsBoss = true;
-        session->SpawnedCreatures.push_back(sc);
+        uint32 idx = session->Creatures.Add(b->GetGUID(), ps.Entry, true, true, false);
+        RecordCreatureSpawn(*session, b, idx, instanceId);
         ++bossesSpawned;
 
         LOG_INFO("module", "DungeonMaster: Boss spawned — entry {}, name '{}', "
@@ -1600,15 +1746,23 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
             static_cast<int>(b->GetReactState()),
             b->GetLevel());
     }
-    session->TotalBosses = bossesSpawned;
+    // Totals are read by Update's load sample; the new creatures count as
+    // live through _populatedCreatures until that sample has seen them.
+    {
+        DMLockGuard lock(_sessionMutex);
+        session->TotalMobs   = spawnedMobs;
+        session->TotalBosses = bossesSpawned;
+        _populatedCreatures.fetch_add(spawnedMobs + bossesSpawned, std::memory_order_relaxed);
+    }
 
     LOG_INFO("module", "DungeonMaster: Session {} — {} mobs, {} bosses spawned.",
-        session->SessionId, session->TotalMobs, session->TotalBosses);
+        session->SessionId, spawnedMobs, bossesSpawned);
 
     // --- Reset encounter states to NOT_STARTED so boss AIs can engage properly ---
     // We set all encounters to DONE earlier (line ~1049) to clear original dungeon
     // bosses. Now that our custom bosses are spawned, reset encounters so their
     // ScriptName AIs do not think the encounter is already defeated.
+    phase.Next("Populate.ResetEncounters");
     if (InstanceScript* script = map->GetInstanceScript())
     {
         uint32 encountersReset = 0;
@@ -1629,8 +1783,9 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
     }
 
     // --- Spawn roguelike vendor NPC at entrance ---
-    if (session->RoguelikeRunId != 0 && sDMConfig->IsRoguelikeVendorEnabled())
+    if (session->RoguelikeRunId != 0 && cfg->IsRoguelikeVendorEnabled())
     {
+        phase.Next("Populate.Vendor");
         static constexpr uint32 DM_VENDOR_NPC_ENTRY = 500001;
 
         // Small offset from entrance so vendor doesn't overlap player spawn point
@@ -1639,20 +1794,21 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
         float vendorZ = session->EntrancePos.GetPositionZ();
         float vendorO = session->EntrancePos.GetOrientation();
 
-        Creature* vendor = map->SummonCreature(DM_VENDOR_NPC_ENTRY,
+        TempSummon* vendor = CreateOffMapSummon(map, DM_VENDOR_NPC_ENTRY,
             { vendorX, vendorY, vendorZ, vendorO });
         if (vendor)
         {
             vendor->SetFaction(35);           // friendly to all
-            vendor->SetFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE);
-            vendor->SetImmuneToPC(true);
-            vendor->SetImmuneToNPC(true);
+            vendor->SetFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE
+                                              | UNIT_FLAG_IMMUNE_TO_PC | UNIT_FLAG_IMMUNE_TO_NPC);
             vendor->SetWanderDistance(0.0f);
             vendor->SetDefaultMovementType(IDLE_MOTION_TYPE);
-            vendor->GetMotionMaster()->MoveIdle();
             vendor->setActive(true);
-            vendor->UpdateObjectVisibility(true);
-
+            if (!AddSummonToMap(map, vendor))
+                vendor = nullptr;
+        }
+        if (vendor)
+        {
             // Track for cleanup — ClearDungeonCreatures() will despawn it
             guidList.push_back(vendor->GetGUID());
 
@@ -1665,6 +1821,10 @@ void DungeonMasterMgr::PopulateDungeon(Session* session, InstanceMap* map)
                 session->SessionId);
         }
     }
+
+    DMLockGuard lock(_sessionMutex);
+    std::vector<ObjectGuid>& tracked = TrackInstanceCreatures(instanceId);
+    tracked.insert(tracked.end(), guidList.begin(), guidList.end());
 }
 
 // Select a creature matching the theme
@@ -1672,136 +1832,45 @@ uint32 DungeonMasterMgr::SelectCreatureForTheme(const Theme* theme, bool isBoss)
 {
     if (!theme) return 0;
 
+    Core::CreaturePick pick = Core::SelectCreatureForTheme(
+        theme->CreatureTypes, _creaturesByType, _bossCreatures, isBoss, tRng);
 
-    std::set<uint32> types;
-    bool anyType = false;
-    for (uint32 t : theme->CreatureTypes)
-    {
-        if (t == uint32(-1)) anyType = true;
-        else types.insert(t);
-    }
-
-    auto typeMatch = [&](uint32 cType) -> bool
-    {
-        return anyType || types.count(cType);
-    };
-
-    std::vector<uint32> candidates;
-
-    if (isBoss)
-    {
-        // --- Try themed elites first ---
-        for (const auto& [type, vec] : _bossCreatures)
-        {
-            if (!typeMatch(type)) continue;
-            for (const auto& e : vec)
-                candidates.push_back(e.Entry);
-        }
-
-        // --- Fallback: promote themed trash to boss (stats will be scaled up) ---
-        if (candidates.empty())
-        {
-            for (const auto& [type, vec] : _creaturesByType)
-            {
-                if (!typeMatch(type)) continue;
-                for (const auto& e : vec)
-                    candidates.push_back(e.Entry);
-            }
-        }
-    }
-    else
-    {
-        // --- Themed trash ---
-        for (const auto& [type, vec] : _creaturesByType)
-        {
-            if (!typeMatch(type)) continue;
-            for (const auto& e : vec)
-                candidates.push_back(e.Entry);
-        }
-    }
-
-    // Fallback: any type
-    if (candidates.empty() && !anyType)
-    {
-        LOG_WARN("module", "DungeonMaster: No '{}' creatures found — falling back to any type.",
+    if (pick.AnyTypeFallback)
+        DM_LOG_WARN_RL("DungeonMaster: No '{}' creatures found — falling back to any type.",
             theme->Name);
 
-        if (isBoss)
-        {
-            for (const auto& [type, vec] : _bossCreatures)
-                for (const auto& e : vec)
-                    candidates.push_back(e.Entry);
-        }
-
-        if (candidates.empty())
-        {
-            for (const auto& [type, vec] : _creaturesByType)
-                for (const auto& e : vec)
-                    candidates.push_back(e.Entry);
-        }
-    }
-
-    if (!candidates.empty())
+    if (pick.Entry)
     {
-        LOG_DEBUG("module", "DungeonMaster: {} candidates for theme '{}' (boss={})",
-            candidates.size(), theme->Name, isBoss);
-        return candidates[RandInt<size_t>(0, candidates.size() - 1)];
+        DM_LOG_DEBUG("DungeonMaster: {} candidates for theme '{}' (boss={})",
+            pick.Candidates, theme->Name, isBoss);
+        return pick.Entry;
     }
 
-    LOG_ERROR("module", "DungeonMaster: ZERO candidates for theme '{}' (boss={})",
+    DM_LOG_ERROR_RL("DungeonMaster: ZERO candidates for theme '{}' (boss={})",
         theme->Name, isBoss);
     return 0;
 }
 
-
 uint32 DungeonMasterMgr::SelectDungeonBoss(const Theme* theme)
 {
     if (!theme) return 0;
 
+    Core::CreaturePick pick = Core::SelectDungeonBoss(theme->CreatureTypes, _dungeonBossPool, tRng);
 
-    std::set<uint32> types;
-    bool anyType = false;
-    for (uint32 t : theme->CreatureTypes)
-    {
-        if (t == uint32(-1)) anyType = true;
-        else types.insert(t);
-    }
-
-    auto typeMatch = [&](uint32 cType) -> bool
-    {
-        return anyType || types.count(cType);
-    };
-
-    // Prefer themed dungeon bosses
-    std::vector<uint32> candidates;
-    for (const auto& [type, vec] : _dungeonBossPool)
-    {
-        if (!typeMatch(type)) continue;
-        for (const auto& e : vec)
-            candidates.push_back(e.Entry);
-    }
-
-    // Fallback: any dungeon boss
-    if (candidates.empty())
-    {
-        LOG_DEBUG("module", "DungeonMaster: No themed dungeon boss for '{}' — using any dungeon boss.",
+    if (pick.AnyTypeFallback)
+        DM_LOG_DEBUG("DungeonMaster: No themed dungeon boss for '{}' — using any dungeon boss.",
             theme->Name);
-        for (const auto& [type, vec] : _dungeonBossPool)
-            for (const auto& e : vec)
-                candidates.push_back(e.Entry);
-    }
 
     // Last resort: generic boss pool
-    if (candidates.empty())
+    if (!pick.Entry)
     {
-        LOG_WARN("module", "DungeonMaster: Dungeon boss pool empty — falling back to generic boss selection.");
+        DM_LOG_WARN_RL("DungeonMaster: Dungeon boss pool empty — falling back to generic boss selection.");
         return SelectCreatureForTheme(theme, true);
     }
 
-    uint32 entry = candidates[RandInt<size_t>(0, candidates.size() - 1)];
-    LOG_DEBUG("module", "DungeonMaster: Selected dungeon boss entry {} from {} candidates (theme '{}')",
-        entry, candidates.size(), theme->Name);
-    return entry;
+    DM_LOG_DEBUG("DungeonMaster: Selected dungeon boss entry {} from {} candidates (theme '{}')",
+        pick.Entry, pick.Candidates, theme->Name);
+    return pick.Entry;
 }
 
 // Death handling
@@ -1810,35 +1879,44 @@ void DungeonMasterMgr::HandleCreatureDeath(Creature* creature, Session* session)
     if (!creature || !session || !session->IsActive())
         return;
 
-    LOG_INFO("module", "DungeonMaster: HandleCreatureDeath called for {} (GUID: {}) in session {}",
+    DM_LOG_DEBUG("DungeonMaster: HandleCreatureDeath called for {} (GUID: {}) in session {}",
         creature->GetName(), creature->GetGUID().GetCounter(), session->SessionId);
 
-    for (auto& sc : session->SpawnedCreatures)
+    SessionCreatureSet& creatures = session->Creatures;
+    uint32 idx = creatures.Find(creature->GetGUID());
+    if (idx != SessionCreatureSet::NPOS)
     {
-        if (sc.Guid == creature->GetGUID())
+        bool isBoss   = creatures.Test(idx, SPAWN_FLAG_BOSS);
+        bool isElite  = creatures.Test(idx, SPAWN_FLAG_ELITE);
+        bool fillLoot = false;
+        bool credit   = false;
+
+        // Flags, counters and corpses are read by the world thread; the
+        // loot and XP themselves are handed out after the lock.
         {
+            DMLockGuard lock(_sessionMutex);
+
             // Mark dead if not already (boss-AI path via OnUnitDeath may arrive
             // here first when creatures don't use our custom AI).
-            if (!sc.IsDead)
-                sc.IsDead = true;
+            creatures.Set(idx, SPAWN_FLAG_DEAD);
+            TrackCorpse(*session, idx, creature);
 
-            LOG_INFO("module", "DungeonMaster: Processing death for {} (Boss: {}, Elite: {}, LootFilled: {}, KillCredited: {})",
-                creature->GetName(), sc.IsBoss, sc.IsElite, sc.LootFilled, sc.KillCredited);
+            DM_LOG_DEBUG("DungeonMaster: Processing death for {} (Boss: {}, Elite: {}, LootFilled: {}, KillCredited: {})",
+                creature->GetName(), isBoss, isElite,
+                creatures.Test(idx, SPAWN_FLAG_LOOT_FILLED), creatures.Test(idx, SPAWN_FLAG_KILL_CREDITED));
 
             // ---- Loot: always fill here (OnUnitDeath fires AFTER core death processing) ----
-            if (!sc.LootFilled)
-            {
-                sc.LootFilled = true;
-                FillCreatureLoot(creature, session, sc.IsBoss);
-            }
+            fillLoot = !creatures.Test(idx, SPAWN_FLAG_LOOT_FILLED);
+            if (fillLoot)
+                creatures.Set(idx, SPAWN_FLAG_LOOT_FILLED);
 
             // ---- Kill credit: only once ----
-            if (!sc.KillCredited)
+            credit = !creatures.Test(idx, SPAWN_FLAG_KILL_CREDITED);
+            if (credit)
             {
-                sc.KillCredited = true;
-                GiveKillXP(session, sc.IsBoss, sc.IsElite);
+                creatures.Set(idx, SPAWN_FLAG_KILL_CREDITED);
 
-                if (sc.IsBoss)
+                if (isBoss)
                 {
                     PendingPhaseCheck ppc;
                     ppc.DeathPos   = { creature->GetPositionX(), creature->GetPositionY(),
@@ -1858,8 +1936,12 @@ void DungeonMasterMgr::HandleCreatureDeath(Creature* creature, Session* session)
                         ++pd.MobsKilled;
                 }
             }
-            break;
         }
+
+        if (fillLoot)
+            FillCreatureLoot(creature, session, isBoss);
+        if (credit)
+            GiveKillXP(session, isBoss, isElite);
     }
 
     // Completion is now handled by the phase check system in Update()
@@ -1867,19 +1949,13 @@ void DungeonMasterMgr::HandleCreatureDeath(Creature* creature, Session* session)
 
 void DungeonMasterMgr::HandleBossDeath(Session* session)
 {
-    if (!session) return;
-    for (const auto& pd : session->Players)
-        if (Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid))
-        {
-            if (session->BossesKilled < session->TotalBosses && p->GetSession())
-            {
-                char buf[128];
-                snprintf(buf, sizeof(buf),
-                    "|cFFFFFF00[Dungeon Master]|r Boss defeated! |cFFFFFFFF%u|r remaining.",
-                    session->TotalBosses - session->BossesKilled);
-                ChatHandler(p->GetSession()).SendSysMessage(buf);
-            }
-        }
+    if (!session || session->BossesKilled >= session->TotalBosses) return;
+
+    char buf[128];
+    snprintf(buf, sizeof(buf),
+        "|cFFFFFF00[Dungeon Master]|r Boss defeated! |cFFFFFFFF%u|r remaining.",
+        session->TotalBosses - session->BossesKilled);
+    DMChatPacket(buf).SendToMembers(GetMembers(*session));
 }
 
     // Called from JustDied hook — fills loot before corpse is opened
@@ -1887,10 +1963,10 @@ void DungeonMasterMgr::OnCreatureDeathHook(Creature* creature)
 {
     if (!creature) return;
 
-    LOG_INFO("module", "DungeonMaster: OnCreatureDeathHook called for {} (GUID: {})",
+    DM_LOG_DEBUG("DungeonMaster: OnCreatureDeathHook called for {} (GUID: {})",
         creature->GetName(), creature->GetGUID().GetCounter());
 
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
 
     for (auto& [sid, session] : _activeSessions)
     {
@@ -1899,67 +1975,70 @@ void DungeonMasterMgr::OnCreatureDeathHook(Creature* creature)
         if (creature->GetMapId() != session.MapId)
             continue;
 
-        for (auto& sc : session.SpawnedCreatures)
-        {
-            if (sc.Guid == creature->GetGUID())
-            {
-                if (sc.IsDead)
-                {
-                    LOG_WARN("module", "DungeonMaster: OnCreatureDeathHook - creature {} already marked as dead",
-                        creature->GetGUID().GetCounter());
-                    return;
-                }
-
-                sc.IsDead = true;
-                LOG_INFO("module", "DungeonMaster: OnCreatureDeathHook processing death for {} (Boss: {}, Elite: {})",
-                    creature->GetName(), sc.IsBoss, sc.IsElite);
-
-                // ----------------------------------------------------------
-                // IMPORTANT: Do NOT call FillCreatureLoot here!
-                // This hook fires from JustDied, which runs INSIDE
-                // Creature::setDeathState / Unit::Kill.  After JustDied
-                // returns, the core clears creature->loot and removes
-                // UNIT_DYNFLAG_LOOTABLE for creatures with no template loot
-                // table, wiping everything we added.
-                //
-                // Loot is filled in HandleCreatureDeath (OnUnitDeath hook)
-                // which fires AFTER the core's death processing completes.
-                // ----------------------------------------------------------
-
-                // Credit kill XP now (safe — doesn't depend on loot timing)
-                if (!sc.KillCredited)
-                {
-                    sc.KillCredited = true;
-                    GiveKillXP(&session, sc.IsBoss, sc.IsElite);
+        SessionCreatureSet& creatures = session.Creatures;
+        uint32 idx = creatures.Find(creature->GetGUID());
+        if (idx == SessionCreatureSet::NPOS)
+            continue;
 
-                    if (sc.IsBoss)
-                    {
-                        PendingPhaseCheck ppc;
-                        ppc.DeathPos   = { creature->GetPositionX(), creature->GetPositionY(),
-                                           creature->GetPositionZ(), creature->GetOrientation() };
-                        ppc.DeathTime  = GameTime::GetGameTime().count();
-                        ppc.OrigEntry  = creature->GetEntry();
-                        ppc.Resolved   = false;
-                        session.PendingPhaseChecks.push_back(ppc);
-
-                        LOG_INFO("module", "DungeonMaster: Boss '{}' died — deferring kill count for phase check (entry {})",
-                            creature->GetName(), creature->GetEntry());
-                    }
-                    else
-                    {
-                        ++session.MobsKilled;
-                        for (auto& pd : session.Players)
-                            ++pd.MobsKilled;
-                    }
-                }
+        if (creatures.Test(idx, SPAWN_FLAG_DEAD))
+        {
+            DM_LOG_WARN_RL("DungeonMaster: OnCreatureDeathHook - creature {} already marked as dead",
+                creature->GetGUID().GetCounter());
+            return;
+        }
 
-                LOG_DEBUG("module", "DungeonMaster: Creature {} (entry {}) death handled via hook "
-                    "(session {}, boss={}).  Loot deferred to OnUnitDeath.",
-                    creature->GetGUID().ToString(), creature->GetEntry(),
-                    sid, sc.IsBoss);
-                return;
+        bool isBoss  = creatures.Test(idx, SPAWN_FLAG_BOSS);
+        bool isElite = creatures.Test(idx, SPAWN_FLAG_ELITE);
+
+        creatures.Set(idx, SPAWN_FLAG_DEAD);
+        TrackCorpse(session, idx, creature);
+        DM_LOG_DEBUG("DungeonMaster: OnCreatureDeathHook processing death for {} (Boss: {}, Elite: {})",
+            creature->GetName(), isBoss, isElite);
+
+        // ----------------------------------------------------------
+        // IMPORTANT: Do NOT call FillCreatureLoot here!
+        // This hook fires from JustDied, which runs INSIDE
+        // Creature::setDeathState / Unit::Kill.  After JustDied
+        // returns, the core clears creature->loot and removes
+        // UNIT_DYNFLAG_LOOTABLE for creatures with no template loot
+        // table, wiping everything we added.
+        //
+        // Loot is filled in HandleCreatureDeath (OnUnitDeath hook)
+        // which fires AFTER the core's death processing completes.
+        // ----------------------------------------------------------
+
+        // Credit kill XP now (safe — doesn't depend on loot timing)
+        if (!creatures.Test(idx, SPAWN_FLAG_KILL_CREDITED))
+        {
+            creatures.Set(idx, SPAWN_FLAG_KILL_CREDITED);
+            GiveKillXP(&session, isBoss, isElite);
+
+            if (isBoss)
+            {
+                PendingPhaseCheck ppc;
+                ppc.DeathPos   = { creature->GetPositionX(), creature->GetPositionY(),
+                                   creature->GetPositionZ(), creature->GetOrientation() };
+                ppc.DeathTime  = GameTime::GetGameTime().count();
+                ppc.OrigEntry  = creature->GetEntry();
+                ppc.Resolved   = false;
+                session.PendingPhaseChecks.push_back(ppc);
+
+                LOG_INFO("module", "DungeonMaster: Boss '{}' died — deferring kill count for phase check (entry {})",
+                    creature->GetName(), creature->GetEntry());
+            }
+            else
+            {
+                ++session.MobsKilled;
+                for (auto& pd : session.Players)
+                    ++pd.MobsKilled;
             }
         }
+
+        DM_LOG_DEBUG("DungeonMaster: Creature {} (entry {}) death handled via hook "
+            "(session {}, boss={}).  Loot deferred to OnUnitDeath.",
+            creature->GetGUID().ToString(), creature->GetEntry(),
+            sid, isBoss);
+        return;
     }
 }
 
@@ -1967,38 +2046,43 @@ void DungeonMasterMgr::HandlePlayerDeath(Player* player, Session* session)
 {
     if (!player || !session) return;
 
-    if (PlayerSessionData* pd = session->GetPlayerData(player->GetGUID()))
-        ++pd->Deaths;
-
     // Block release-spirit; auto-rez instead
     player->SetFlag(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTE_NO_RELEASE_WINDOW);
     player->RemoveFlag(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTE_RELEASE_TIMER);
 
-    if (session->IsPartyWiped())
+    // Counters and the Failed transition are read by the world thread.
+    bool wiped = false;
     {
-        ++session->Wipes;
+        DMLockGuard lock(_sessionMutex);
+        if (PlayerSessionData* pd = session->GetPlayerData(player->GetGUID()))
+            ++pd->Deaths;
 
-        // --- Roguelike: delegate wipe handling to RoguelikeMgr ---
-        if (session->RoguelikeRunId != 0)
+        wiped = session->IsPartyWiped();
+        if (wiped)
         {
+            ++session->Wipes;
             session->State   = SessionState::Failed;
             session->EndTime = GameTime::GetGameTime().count();
-            sRoguelikeMgr->OnPartyWipe(session->RoguelikeRunId);
-            return;
         }
+    }
 
-        session->State   = SessionState::Failed;
-        session->EndTime = GameTime::GetGameTime().count();
+    if (wiped)
+    {
+        // --- Roguelike: RoguelikeMgr tears the run down from Update ---
+        // This runs on the map thread; the run teardown detaches the
+        // session, which only the world thread may do (see FindMapSession).
+        if (session->RoguelikeRunId != 0)
+            return;
 
-        for (const auto& psd : session->Players)
+        SessionMembers const& members = GetMembers(*session);
+        for (size_t i = 0; i < members.size(); ++i)
         {
-            Player* p = ObjectAccessor::FindPlayer(psd.PlayerGuid);
+            Player* p = members[i].Ptr;
             if (!p) continue;
+            PlayerSessionData const& psd = session->Players[i];
             p->RemoveFlag(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTE_NO_RELEASE_WINDOW);
             if (!p->IsAlive()) { p->ResurrectPlayer(1.0f); p->SpawnCorpseBones(); }
-            if (p->GetSession())
-                ChatHandler(p->GetSession()).SendSysMessage(
-                    "|cFFFF0000[Dungeon Master]|r Total party wipe! Challenge failed.");
+            GetMessagePacket(DMMessage::PartyWipe).SendTo(p);
             p->TeleportTo(psd.ReturnMapId, psd.ReturnPosition.GetPositionX(),
                 psd.ReturnPosition.GetPositionY(), psd.ReturnPosition.GetPositionZ(),
                 psd.ReturnPosition.GetOrientation());
@@ -2006,48 +2090,193 @@ void DungeonMasterMgr::HandlePlayerDeath(Player* player, Session* session)
     }
     else
     {
-        if (player->GetSession())
-            ChatHandler(player->GetSession()).SendSysMessage(
-                "|cFFFFFF00[Dungeon Master]|r You have fallen! "
-                "You will be revived when your group leaves combat.");
+        GetMessagePacket(DMMessage::PlayerFallen).SendTo(player);
     }
 }
 
-// Rewards
-void DungeonMasterMgr::DistributeRewards(Session* session)
+// Member state tracking
+void DungeonMasterMgr::QueueMemberEvent(Player* player, MemberEvent event)
 {
-    if (!session) return;
-    const DifficultyTier* diff = sDMConfig->GetDifficulty(session->DifficultyId);
-    if (!diff) return;
+    if (!player) return;
 
+    QueuedMemberEvent ev;
+    ev.Guid  = player->GetGUID();
+    ev.MapId = player->GetMapId();
+    ev.State = GetMemberState(player, 0) & ~MEMBER_IN_MAP;
+    ev.Event = event;
 
-    uint32 lvl       = session->EffectiveLevel;
-    uint32 baseGold  = lvl * 500;
-    uint32 mobGold   = session->MobsKilled  * (lvl * 10);
-    uint32 bossGold  = session->BossesKilled * (lvl * 500);
-    uint32 total     = static_cast<uint32>((baseGold + mobGold + bossGold) * diff->RewardMultiplier);
-    uint32 perPlayer = total / std::max<uint32>(1, session->Players.size());
-
-    uint8 rewardLevel = static_cast<uint8>(std::min<uint32>(lvl, 80));
+    DMLockGuard lock(_memberEventMutex);
+    _memberEvents.push_back(ev);
+}
 
-    LOG_INFO("module", "DungeonMaster: DistributeRewards — EffectiveLevel={}, rewardLevel={}, "
-        "rewardPool={} items, players={}",
-        lvl, rewardLevel, _rewardItems.size(), session->Players.size());
+void DungeonMasterMgr::ProcessMemberEvents()
+{
+    _memberEventsDrain.clear();
+    {
+        DMLockGuard lock(_memberEventMutex);
+        if (_memberEvents.empty())
+            return;
+        _memberEvents.swap(_memberEventsDrain);
+    }
 
-    for (const auto& pd : session->Players)
+    auto changed   = sDMTickArena.NewVector<uint32>();
+    auto toAbandon = sDMTickArena.NewVector<uint32>();
     {
-        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-        if (!p || !p->IsInWorld())
+        DMLockGuard lock(_sessionMutex);
+
+        for (QueuedMemberEvent const& ev : _memberEventsDrain)
         {
-            LOG_WARN("module", "DungeonMaster: Player {} not found/not in world for rewards", pd.PlayerGuid.GetCounter());
-            continue;
+            auto pit = _playerToSession.find(ev.Guid);
+            if (pit == _playerToSession.end())
+                continue;
+            auto sit = _activeSessions.find(pit->second);
+            if (sit == _activeSessions.end())
+                continue;
+            PlayerSessionData* pd = sit->second.GetPlayerData(ev.Guid);
+            if (!pd)
+                continue;
+
+            uint8 before = pd->State;
+            ApplyMemberEvent(sit->second, *pd, ev);
+            if (pd->State != before && std::find(changed.begin(), changed.end(), sit->first) == changed.end())
+                changed.push_back(sit->first);
         }
 
-        // Gold goes directly to wallet
-        GiveGoldReward(p, perPlayer);
+        for (uint32 sid : changed)
+        {
+            Session& session = _activeSessions.find(sid)->second;
+            if (!session.IsActive())
+                continue;
 
-        // Completion item: roll epic first, then rare, fallback green
-        // Item goes directly to inventory (mail fallback if bags full)
+            if (!session.AnyMemberIn(MEMBER_IN_MAP))
+            {
+                if (CheckAbandoned(session))
+                    toAbandon.push_back(sid);
+            }
+            else if (!session.AnyMemberIn(MEMBER_IN_COMBAT))
+            {
+                PostToSessionMap(session, [this](Session& s, InstanceMap*)
+                {
+                    if (!s.AnyMemberIn(MEMBER_IN_COMBAT))
+                        ReviveDeadMembers(s);
+                });
+            }
+        }
+    }
+
+    for (uint32 sid : toAbandon)
+        EndSession(sid, false);
+}
+
+void DungeonMasterMgr::ApplyMemberEvent(Session& session, PlayerSessionData& pd, QueuedMemberEvent const& ev)
+{
+    switch (ev.Event)
+    {
+        case MemberEvent::Login:
+        case MemberEvent::MapChanged:
+            pd.State = ev.State;
+            if (ev.MapId == session.MapId)
+                pd.State |= MEMBER_IN_MAP;
+            break;
+        case MemberEvent::Logout:
+            pd.State = 0;
+            break;
+        case MemberEvent::Died:
+            pd.State &= ~(MEMBER_ALIVE | MEMBER_IN_COMBAT);
+            break;
+        case MemberEvent::Resurrected:
+            pd.State |= MEMBER_ALIVE;
+            break;
+        case MemberEvent::EnterCombat:
+            if (pd.State & MEMBER_ALIVE)
+                pd.State |= MEMBER_IN_COMBAT;
+            break;
+        case MemberEvent::LeaveCombat:
+            pd.State &= ~MEMBER_IN_COMBAT;
+            break;
+    }
+}
+
+// Out-of-combat edge: bring dead members on the map back at the entrance.
+void DungeonMasterMgr::ReviveDeadMembers(Session& session)
+{
+    for (auto& pd : session.Players)
+    {
+        if ((pd.State & (MEMBER_IN_MAP | MEMBER_ALIVE)) != MEMBER_IN_MAP)
+            continue;
+
+        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
+        if (!p || p->IsAlive() || p->GetMapId() != session.MapId)
+            continue;
+
+        p->RemoveFlag(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTE_NO_RELEASE_WINDOW);
+        p->ResurrectPlayer(1.0f);
+        p->SpawnCorpseBones();
+        p->TeleportTo(session.MapId,
+            session.EntrancePos.GetPositionX(),
+            session.EntrancePos.GetPositionY(),
+            session.EntrancePos.GetPositionZ(),
+            session.EntrancePos.GetOrientation());
+        GetMessagePacket(DMMessage::RevivedAtEntrance).SendTo(p);
+        pd.State |= MEMBER_ALIVE;
+    }
+}
+
+// No member on the map: abandoned once the arrival grace period is over,
+// otherwise watched until it is (or somebody arrives).
+bool DungeonMasterMgr::CheckAbandoned(Session& session)
+{
+    if (GameTime::GetGameTime().count() - session.StartTime < ABANDON_GRACE)
+    {
+        if (std::find(_abandonWatch.begin(), _abandonWatch.end(), session.SessionId) == _abandonWatch.end())
+            _abandonWatch.push_back(session.SessionId);
+        return false;
+    }
+
+    LOG_INFO("module", "DungeonMaster: Session {} abandoned — no players on map {} after grace period",
+        session.SessionId, session.MapId);
+    session.State = SessionState::Abandoned;
+    return true;
+}
+
+// Rewards
+void DungeonMasterMgr::DistributeRewards(Session* session)
+{
+    if (!session) return;
+    DMTraceSpan span("DistributeRewards", session->SessionId);
+    const DifficultyTier* diff = sDMConfig->GetDifficulty(session->DifficultyId);
+    if (!diff) return;
+
+
+    uint32 lvl       = session->EffectiveLevel;
+    uint32 baseGold  = lvl * 500;
+    uint32 mobGold   = static_cast<uint32>(session->MobsKilled * (lvl * 10) * session->TrashGoldMult);
+    uint32 bossGold  = session->BossesKilled * (lvl * 500);
+    uint32 total     = static_cast<uint32>((baseGold + mobGold + bossGold) * diff->RewardMultiplier);
+    uint32 perPlayer = total / std::max<uint32>(1, session->Players.size());
+
+    uint8 rewardLevel = static_cast<uint8>(std::min<uint32>(lvl, 80));
+
+    LOG_INFO("module", "DungeonMaster: DistributeRewards — EffectiveLevel={}, rewardLevel={}, "
+        "rewardPool={} items, players={}",
+        lvl, rewardLevel, _rewardItems.size(), session->Players.size());
+
+    SessionMembers const& members = GetMembers(*session);
+    for (size_t i = 0; i < members.size(); ++i)
+    {
+        Player* p = members[i].Ptr;
+        if (!members[i].Is(MEMBER_IN_WORLD))
+        {
+            DM_LOG_WARN_RL("DungeonMaster: Player {} not found/not in world for rewards",
+                session->Players[i].PlayerGuid.GetCounter());
+            continue;
+        }
+
+        // Gold goes directly to wallet
+        GiveGoldReward(p, perPlayer);
+
+        // Completion item: roll epic first, then rare, fallback green
+        // Item goes directly to inventory (mail fallback if bags full)
         uint8 quality = 2;  // green baseline
         if (RandInt<uint32>(1, 100) <= sDMConfig->GetEpicChance())
             quality = 4;
@@ -2063,17 +2292,19 @@ void DungeonMasterMgr::GiveKillXP(Session* session, bool isBoss, bool isElite)
 {
     if (!session) return;
 
-    for (const auto& pd : session->Players)
+    for (auto const& m : GetMembers(*session))
     {
-        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-        if (!p || !p->IsAlive()) continue;
+        if (!m.Is(MEMBER_ALIVE | MEMBER_IN_MAP)) continue;
+        Player* p = m.Ptr;
         if (p->GetLevel() >= sWorld->getIntConfig(CONFIG_MAX_PLAYER_LEVEL)) continue;
 
         uint32 baseXP = (p->GetLevel() * 5) + 45;
 
         float mult = 1.0f;
-        if (isBoss)       mult = 10.0f;
-        else if (isElite) mult = 2.0f;
+        if (isBoss)       mult = BOSS_KILL_XP_MULT;
+        else if (isElite) mult = ELITE_KILL_XP_MULT;
+        if (!isBoss)
+            mult *= session->TrashXpMult;
 
         uint32 xp = static_cast<uint32>(baseXP * mult);
         p->GiveXP(xp, nullptr);
@@ -2104,7 +2335,7 @@ void DungeonMasterMgr::GiveItemReward(Player* player, uint8 level, uint8 quality
     // but still maintain level appropriateness
     if (!itemEntry && quality > 2)
     {
-        LOG_WARN("module", "DungeonMaster: No quality {} items for level {}, class {}. Trying lower quality...",
+        DM_LOG_WARN_RL("DungeonMaster: No quality {} items for level {}, class {}. Trying lower quality...",
             quality, level, playerClass);
         for (uint8 q = quality - 1; q >= 2 && !itemEntry; --q)
             itemEntry = SelectRewardItem(level, q, playerClass);
@@ -2112,7 +2343,7 @@ void DungeonMasterMgr::GiveItemReward(Player* player, uint8 level, uint8 quality
 
     if (!itemEntry)
     {
-        LOG_ERROR("module", "DungeonMaster: No suitable reward item for player {} (level {}, class {}, quality {}). "
+        DM_LOG_ERROR_RL("DungeonMaster: No suitable reward item for player {} (level {}, class {}, quality {}). "
             "Reward pool has {} items total. Gold only.",
             player->GetName(), level, playerClass, quality, _rewardItems.size());
         if (player->GetSession())
@@ -2121,7 +2352,7 @@ void DungeonMasterMgr::GiveItemReward(Player* player, uint8 level, uint8 quality
         return;
     }
 
-    LOG_INFO("module", "DungeonMaster: Giving item {} to {} (level {}, quality {}, class {})",
+    DM_LOG_DEBUG("DungeonMaster: Giving item {} to {} (level {}, quality {}, class {})",
         itemEntry, player->GetName(), level, quality, playerClass);
 
     ItemPosCountVec dest;
@@ -2297,48 +2528,7 @@ void DungeonMasterMgr::DistributeRoguelikeRewards(uint32 tier, uint8 effectiveLe
         for (uint32 i = 0; i < greenItems; ++i)
             GiveItemReward(p, rewardLevel, 2);
 
-        if (p->GetSession())
-            ChatHandler(p->GetSession()).SendSysMessage(
-                "|cFF00FFFF[Roguelike]|r Rewards added to your inventory!");
-    }
-}
-
-// Armor type by class
-static uint8 GetMaxArmorSubclass(uint32 playerClass)
-{
-    switch (playerClass)
-    {
-        case 5: case 8: case 9:              return 1;  // cloth: Priest, Mage, Warlock
-        case 4: case 11:                     return 2;  // leather: Rogue, Druid
-        case 3: case 7:                      return 3;  // mail: Hunter, Shaman
-        case 1: case 2: case 6:              return 4;  // plate: Warrior, Paladin, DK
-        default:                             return 4;
-    }
-}
-
-static uint32 GetClassBitmask(uint32 playerClass)
-{
-    if (playerClass == 0 || playerClass > 11) return 0x7FF;  // all classes
-    return 1 << (playerClass - 1);
-}
-
-// Primary stat for class-based reward weighting
-// Returns: ITEM_MOD_AGILITY(3), ITEM_MOD_STRENGTH(4), ITEM_MOD_INTELLECT(5)
-static uint32 GetPrimaryStatForClass(uint32 playerClass)
-{
-    switch (playerClass)
-    {
-        case 1:  return 4;  // Warrior  -> STR
-        case 2:  return 4;  // Paladin  -> STR
-        case 3:  return 3;  // Hunter   -> AGI
-        case 4:  return 3;  // Rogue    -> AGI
-        case 5:  return 5;  // Priest   -> INT
-        case 6:  return 4;  // DK       -> STR
-        case 7:  return 5;  // Shaman   -> INT
-        case 8:  return 5;  // Mage     -> INT
-        case 9:  return 5;  // Warlock  -> INT
-        case 11: return 3;  // Druid    -> AGI
-        default: return 4;
+        GetMessagePacket(DMMessage::RoguelikeRewardsAdded).SendTo(p);
     }
 }
 
@@ -2347,95 +2537,29 @@ static float ScoreItemForClass(uint32 itemEntry, uint32 playerClass)
 {
     const ItemTemplate* proto = sObjectMgr->GetItemTemplate(itemEntry);
     if (!proto) return 0.0f;
-
-    uint32 primaryStat = GetPrimaryStatForClass(playerClass);
-    float totalStats = 0.0f;
-    float primaryTotal = 0.0f;
-
-    for (uint8 i = 0; i < MAX_ITEM_PROTO_STATS; ++i)
-    {
-        int32 val = proto->ItemStat[i].ItemStatValue;
-        uint32 type = proto->ItemStat[i].ItemStatType;
-        if (val <= 0) continue;
-
-        totalStats += static_cast<float>(val);
-        if (type == primaryStat)
-            primaryTotal += static_cast<float>(val);
-    }
-
-    if (totalStats <= 0.0f) return 0.5f;  // No stats (trinket, etc.) = neutral
-    return primaryTotal / totalStats;
+    return Core::ScoreItemForClass(proto->ItemStat, MAX_ITEM_PROTO_STATS, playerClass);
 }
 
 uint32 DungeonMasterMgr::SelectRewardItem(uint8 level, uint8 quality, uint32 playerClass)
 {
-    uint8  maxArmor   = GetMaxArmorSubclass(playerClass);
-    uint32 classMask  = GetClassBitmask(playerClass);
-
-    // Try progressively wider level windows, but always prefer closer to player level
-    struct { uint8 below; uint8 above; } windows[] = {
-        { 3, 0 },    // strict: [level-3, level]
-        { 8, 0 },    // medium: [level-8, level]
-        { 15, 0 },   // wide: [level-15, level]
-        { 25, 0 },   // very wide: [level-25, level]
-        { 80, 0 },   // last resort: [1, level] (never items above player level)
-    };
-
-    for (const auto& win : windows)
+    std::vector<uint32> cands;
+    Core::LevelWindow win;
+    if (Core::CollectRewardCandidates(_rewardItems, level, quality, playerClass, cands, win))
     {
-        std::vector<uint32> cands;
-        uint8 lo = (level > win.below) ? (level - win.below) : 1;
-        uint8 hi = level;  // Never give items above player level
-
-        for (const auto& ri : _rewardItems)
-        {
-            // Quality filter
-            if (ri.Quality != quality) continue;
-
-            // Level filter: item RequiredLevel must be within window
-            if (ri.MinLevel < lo || ri.MinLevel > hi) continue;
-
-            // Class restriction: AllowableClass bitmask check
-            if (ri.AllowableClass != -1 && !(ri.AllowableClass & classMask))
-                continue;
-
-            // Armor subclass: player can only wear their class's max armor or lower
-            if (ri.Class == 4 && ri.SubClass > 0 && ri.SubClass <= 4)
-            {
-                if (ri.SubClass > maxArmor) continue;
-            }
-
-            cands.push_back(ri.Entry);
-        }
-
-        if (!cands.empty())
-        {
-            LOG_INFO("module", "DungeonMaster: SelectRewardItem(level={}, quality={}, class={}) "
-                "-> {} candidates in window [{}, {}]",
-                level, quality, playerClass, cands.size(), lo, hi);
-
-            // 75% chance: bias toward items with matching primary stat
-            if (cands.size() > 3 && playerClass > 0 && RandInt<uint32>(1, 100) <= 75)
-            {
-                std::vector<std::pair<uint32, float>> scored;
-                scored.reserve(cands.size());
-                for (uint32 entry : cands)
-                    scored.push_back({entry, ScoreItemForClass(entry, playerClass)});
+        DM_LOG_TRACE("DungeonMaster: SelectRewardItem(level={}, quality={}, class={}) "
+            "-> {} candidates in window [{}, {}]",
+            level, quality, playerClass, cands.size(), win.Lo, win.Hi);
 
-                std::sort(scored.begin(), scored.end(),
-                    [](const auto& a, const auto& b) { return a.second > b.second; });
+        // 75% chance: bias toward items with matching primary stat
+        if (cands.size() > 3 && playerClass > 0 && RandInt<uint32>(1, 100) <= 75)
+            return Core::PickTopScored(cands,
+                [playerClass](uint32 entry) { return ScoreItemForClass(entry, playerClass); }, tRng);
 
-                // Pick from the top third (at least 3 items)
-                size_t topN = std::max<size_t>(3, scored.size() / 3);
-                return scored[RandInt<size_t>(0, topN - 1)].first;
-            }
-
-            // 25% chance: purely random from valid pool
-            return cands[RandInt<size_t>(0, cands.size() - 1)];
-        }
+        // 25% chance: purely random from valid pool
+        return cands[RandInt<size_t>(0, cands.size() - 1)];
     }
 
-    LOG_WARN("module", "DungeonMaster: SelectRewardItem(level={}, quality={}, class={}) "
+    DM_LOG_WARN_RL("DungeonMaster: SelectRewardItem(level={}, quality={}, class={}) "
         "-> NO candidates found in reward pool ({} items total)",
         level, quality, playerClass, _rewardItems.size());
 
@@ -2445,85 +2569,25 @@ uint32 DungeonMasterMgr::SelectRewardItem(uint8 level, uint8 quality, uint32 pla
 uint32 DungeonMasterMgr::SelectLootItem(uint8 level, uint8 minQuality, uint8 maxQuality,
                                         bool equipmentOnly, uint32 playerClass)
 {
-    // Expected ItemLevel range for this level
-    uint16 expectedMaxIlvl = static_cast<uint16>(level) * 2 + 10;
-
-    uint8  maxArmor  = playerClass ? GetMaxArmorSubclass(playerClass) : 4;
-    uint32 classMask = playerClass ? GetClassBitmask(playerClass) : 0x7FF;
-
-    // Progressively widen level windows, always preferring items closer to player level
-    struct { uint8 below; uint8 above; } windows[] = {
-        { 3, 1 },   // strict: RequiredLevel in [level-3, level+1]
-        { 5, 2 },   // medium
-        { 8, 3 },   // wide
-        { 15, 5 },  // very wide
-        { 25, 8 },  // extremely wide (last resort)
-    };
-
-    for (const auto& win : windows)
+    std::vector<uint32> cands;
+    Core::LevelWindow win;
+    if (Core::CollectLootCandidates(_lootPool, level, minQuality, maxQuality, equipmentOnly,
+                                    playerClass, cands, win))
     {
-        uint8 lo = (level > win.below) ? (level - win.below) : 0;
-        uint8 hi = std::min<uint16>(level + win.above, 83);
+        DM_LOG_TRACE("DungeonMaster: SelectLootItem(level={}, quality={}-{}, eqOnly={}, class={}) "
+            "-> {} candidates in window [{}, {}]",
+            level, minQuality, maxQuality, equipmentOnly, playerClass, cands.size(), win.Lo, win.Hi);
 
-        std::vector<uint32> cands;
-        for (const auto& li : _lootPool)
-        {
-            if (li.Quality < minQuality || li.Quality > maxQuality) continue;
-            if (equipmentOnly && li.ItemClass != 2 && li.ItemClass != 4) continue;
+        // Bias equipment loot toward matching primary stat (75% chance)
+        if (equipmentOnly && playerClass > 0 && cands.size() > 3
+            && RandInt<uint32>(1, 100) <= 75)
+            return Core::PickTopScored(cands,
+                [playerClass](uint32 entry) { return ScoreItemForClass(entry, playerClass); }, tRng);
 
-            // Level filter for items with RequiredLevel > 0
-            if (li.MinLevel > 0)
-            {
-                if (li.MinLevel < lo || li.MinLevel > hi) continue;
-            }
-            else
-            {
-                // RequiredLevel = 0: use ItemLevel as a sanity check
-                if (li.ItemLevel > expectedMaxIlvl) continue;
-            }
-
-            // Class restriction for equipment items
-            if (equipmentOnly || (li.ItemClass == 2 || li.ItemClass == 4))
-            {
-                // AllowableClass bitmask check
-                if (li.AllowableClass != -1 && !(li.AllowableClass & classMask))
-                    continue;
-
-                // Armor subclass check (only for armor, not weapons)
-                if (li.ItemClass == 4 && li.SubClass > 0 && li.SubClass <= 4)
-                    if (li.SubClass > maxArmor) continue;
-            }
-
-            cands.push_back(li.Entry);
-        }
-
-        if (!cands.empty())
-        {
-            LOG_INFO("module", "DungeonMaster: SelectLootItem(level={}, quality={}-{}, eqOnly={}, class={}) "
-                "-> {} candidates in window [{}, {}]",
-                level, minQuality, maxQuality, equipmentOnly, playerClass, cands.size(), lo, hi);
-
-            // Bias equipment loot toward matching primary stat (75% chance)
-            if (equipmentOnly && playerClass > 0 && cands.size() > 3
-                && RandInt<uint32>(1, 100) <= 75)
-            {
-                std::vector<std::pair<uint32, float>> scored;
-                scored.reserve(cands.size());
-                for (uint32 entry : cands)
-                    scored.push_back({entry, ScoreItemForClass(entry, playerClass)});
-
-                std::sort(scored.begin(), scored.end(),
-                    [](const auto& a, const auto& b) { return a.second > b.second; });
-
-                size_t topN = std::max<size_t>(3, scored.size() / 3);
-                return scored[RandInt<size_t>(0, topN - 1)].first;
-            }
-
-            return cands[RandInt<size_t>(0, cands.size() - 1)];
-        }
+        return cands[RandInt<size_t>(0, cands.size() - 1)];
     }
 
-    LOG_WARN("module", "DungeonMaster: SelectLootItem(level={}, quality={}-{}, eqOnly={}, class={}) "
+    DM_LOG_WARN_RL("DungeonMaster: SelectLootItem(level={}, quality={}-{}, eqOnly={}, class={}) "
         "-> NO candidates found in loot pool ({} items total)",
         level, minQuality, maxQuality, equipmentOnly, playerClass, _lootPool.size());
 
@@ -2540,30 +2604,18 @@ void DungeonMasterMgr::FillCreatureLoot(Creature* creature, Session* session, bo
 
     uint8 level = session->EffectiveLevel;
 
-    // Pick a random party member's class for loot filtering
+    SessionMembers const& members = GetMembers(*session);
+
+    // Pick a random alive party member's class for loot filtering
     uint32 lootClass = 0;
-    if (!session->Players.empty())
+    if (uint32 alive = members.Count(MEMBER_ALIVE))
     {
-        // Try to pick a random alive player's class
-        std::vector<uint32> classes;
-        for (const auto& pd : session->Players)
-        {
-            Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-            if (p && p->IsAlive())
-                classes.push_back(p->getClass());
-        }
-        if (classes.empty())
-        {
-            // All dead? Just pick from any player
-            for (const auto& pd : session->Players)
-            {
-                Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-                if (p) { classes.push_back(p->getClass()); break; }
-            }
-        }
-        if (!classes.empty())
-            lootClass = classes[RandInt<size_t>(0, classes.size() - 1)];
+        uint32 pick = RandInt<uint32>(0, alive - 1);
+        for (auto const& m : members)
+            if (m.Is(MEMBER_ALIVE) && pick-- == 0) { lootClass = m.Ptr->getClass(); break; }
     }
+    else if (Player* p = members.First(0))
+        lootClass = p->getClass();   // All dead? Just pick from any player
 
     // Gold drop
     uint32 baseGold = isBoss ? (level * 2000u) : (level * 200u);
@@ -2576,7 +2628,7 @@ void DungeonMasterMgr::FillCreatureLoot(Creature* creature, Session* session, bo
         uint32 entry = SelectLootItem(level, minQ, maxQ, eqOnly, eqOnly ? lootClass : 0);
         if (!entry)
         {
-            LOG_WARN("module", "DungeonMaster: FillCreatureLoot failed to find item (level={}, quality={}-{}, eqOnly={}, class={})",
+            DM_LOG_WARN_RL("DungeonMaster: FillCreatureLoot failed to find item (level={}, quality={}-{}, eqOnly={}, class={})",
                 level, minQ, maxQ, eqOnly, lootClass);
             return false;
         }
@@ -2584,7 +2636,7 @@ void DungeonMasterMgr::FillCreatureLoot(Creature* creature, Session* session, bo
         LootStoreItem storeItem(entry, 0, 100.0f, false, 1, 0, 1, 1);
         loot.AddItem(storeItem);
         ++itemsAdded;
-        LOG_INFO("module", "DungeonMaster: Added loot item {} (quality {}-{}) to {} (boss={})",
+        DM_LOG_DEBUG("DungeonMaster: Added loot item {} (quality {}-{}) to {} (boss={})",
             entry, minQ, maxQ, creature->GetName(), isBoss);
         return true;
     };
@@ -2599,17 +2651,9 @@ void DungeonMasterMgr::FillCreatureLoot(Creature* creature, Session* session, bo
     }
     else
     {
-        bool isElite = false;
-        bool isRare  = false;
-        for (const auto& sc : session->SpawnedCreatures)
-        {
-            if (sc.Guid == creature->GetGUID())
-            {
-                isElite = sc.IsElite;
-                isRare  = sc.IsRare;
-                break;
-            }
-        }
+        uint32 idx   = session->Creatures.Find(creature->GetGUID());
+        bool isElite = idx != SessionCreatureSet::NPOS && session->Creatures.Test(idx, SPAWN_FLAG_ELITE);
+        bool isRare  = idx != SessionCreatureSet::NPOS && session->Creatures.Test(idx, SPAWN_FLAG_RARE);
 
         if (isRare)
         {
@@ -2645,13 +2689,12 @@ void DungeonMasterMgr::FillCreatureLoot(Creature* creature, Session* session, bo
     loot.loot_type = LOOT_CORPSE;
     Player* looter = nullptr;
     Group*  group  = nullptr;
-    for (const auto& pd : session->Players)
+    for (auto const& m : members)
     {
-        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-        if (p && p->IsInWorld() && p->GetGroup())
+        if (m.Is(MEMBER_IN_WORLD) && m.Ptr->GetGroup())
         {
-            looter = p;
-            group  = p->GetGroup();
+            looter = m.Ptr;
+            group  = m.Ptr->GetGroup();
             break;
         }
     }
@@ -2677,12 +2720,9 @@ void DungeonMasterMgr::FillCreatureLoot(Creature* creature, Session* session, bo
         group->GroupLoot(&loot, creature);
 
         // Force dynamic flag update to all session players so they see the lootable corpse
-        for (const auto& pd : session->Players)
-        {
-            Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-            if (p && p->IsInWorld() && p->GetMapId() == session->MapId)
-                creature->SendUpdateToPlayer(p);
-        }
+        for (auto const& m : members)
+            if (m.Is(MEMBER_IN_WORLD | MEMBER_IN_MAP))
+                creature->SendUpdateToPlayer(m.Ptr);
 
         LOG_INFO("module", "DungeonMaster: Group loot triggered for {} — {} items, "
             "lootMethod={}, threshold={}, groupSize={}",
@@ -2699,82 +2739,83 @@ void DungeonMasterMgr::FillCreatureLoot(Creature* creature, Session* session, bo
 }
 
 // Session end / cleanup
+// Ending is split in two: a short locked transition that takes the session
+// out of the active set and every index, then the slow part (rewards, mail,
+// stats, teleports) on the detached session with no manager lock held.
+// A session bound to an instance is its map thread's until the next world
+// phase (see FindMapSession), so outside Update its slow part is queued
+// for DrainEndingSessions instead of racing that thread.
+static thread_local bool tWorldPhase = false;
+
 void DungeonMasterMgr::EndSession(uint32 sessionId, bool success)
 {
-    // Check if roguelike session
-    uint32 roguelikeRunId = 0;
+    SessionMap::node_type node;
     {
-        std::lock_guard<std::mutex> lock(_sessionMutex);
+        DMLockGuard lock(_sessionMutex);
         auto it = _activeSessions.find(sessionId);
         if (it == _activeSessions.end()) return;
+        node = DetachSession(it);
+        if (!tWorldPhase && node.mapped().InstanceId != 0)
+        {
+            _endingSessions.push_back({ std::move(node), success, false });
+            return;
+        }
+    } // lock released
 
-        Session& s = it->second;
-        roguelikeRunId = s.RoguelikeRunId;
+    FinishSession(std::move(node), success);
+}
 
-        if (roguelikeRunId != 0)
-        {
-            LOG_INFO("module", "DungeonMaster: EndSession {} — roguelike run {}, delegating to RoguelikeMgr.",
-                sessionId, roguelikeRunId);
+void DungeonMasterMgr::FinishSession(SessionMap::node_type node, bool success)
+{
+    Session& s = node.mapped();
+    uint32 sessionId = s.SessionId;
+    DMTraceSpan span("EndSession", sessionId);
 
-            // Persist stats while session is still alive
-            UpdatePlayerStatsFromSession(s, success);
+    uint32 savedInstanceId = s.InstanceId;
 
-            // Clean up mappings
-            uint32 savedInstanceId = s.InstanceId;
-            if (savedInstanceId != 0)
-                _instanceToSession.erase(savedInstanceId);
-            for (const auto& pd : s.Players)
-                _playerToSession.erase(pd.PlayerGuid);
+    if (s.RoguelikeRunId != 0)
+    {
+        LOG_INFO("module", "DungeonMaster: EndSession {} — roguelike run {}, delegating to RoguelikeMgr.",
+            sessionId, s.RoguelikeRunId);
 
-            _activeSessions.erase(it);
+        // Stats only; floor leaderboard rows come from CleanupRoguelikeSession
+        SaveSessionResults(s, success, false);
+        uint32 roguelikeRunId = s.RoguelikeRunId;
+
+        sDMTrace->SessionEnd(sessionId, success);
+        RecordSessionEnd(sessionId, savedInstanceId, success);
+        {
+            DMLockGuard lock(_sessionMutex);
+            ReleaseSession(std::move(node));
         }
-    } // lock released
 
-    if (roguelikeRunId != 0)
-    {
         sRoguelikeMgr->EndRun(roguelikeRunId, false);
         return;
     }
 
     // --- Normal (non-roguelike) session ---
-    std::lock_guard<std::mutex> lock(_sessionMutex);
-    auto it = _activeSessions.find(sessionId);
-    if (it == _activeSessions.end()) return;
-
-    Session& s = it->second;
-
     LOG_INFO("module", "DungeonMaster: EndSession {} — success={}, state={}, players={}",
         sessionId, success, static_cast<int>(s.State), s.Players.size());
 
-    for (const auto& pd : s.Players)
-        if (Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid))
-            if (p->GetSession())
-                ChatHandler(p->GetSession()).SendSysMessage(
-                    success ? "|cFF00FF00[Dungeon Master]|r Challenge complete! Distributing rewards..."
-                            : "|cFFFF0000[Dungeon Master]|r Challenge ended. No rewards given.");
+    GetMessagePacket(success ? DMMessage::ChallengeComplete : DMMessage::ChallengeEnded)
+        .SendToMembers(GetMembers(s));
 
     if (success && s.State == SessionState::Completed)
         DistributeRewards(&s);
 
-    UpdatePlayerStatsFromSession(s, success);
-    if (success && s.State == SessionState::Completed)
-        SaveLeaderboardEntry(s);
+    SaveSessionResults(s, success);
 
     TeleportPartyOut(&s);
-
-    // Save instance ID before cleanup
-    uint32 savedInstanceId = s.InstanceId;
     CleanupSession(s);
 
     for (const auto& pd : s.Players)
         SetCooldown(pd.PlayerGuid);
 
-    if (savedInstanceId != 0)
-        _instanceToSession.erase(savedInstanceId);
-    for (const auto& pd : s.Players)
-        _playerToSession.erase(pd.PlayerGuid);
+    sDMTrace->SessionEnd(sessionId, success);
+    RecordSessionEnd(sessionId, savedInstanceId, success);
 
-    _activeSessions.erase(it);
+    DMLockGuard lock(_sessionMutex);
+    ReleaseSession(std::move(node));
 }
 
 void DungeonMasterMgr::AbandonSession(uint32 id) { EndSession(id, false); }
@@ -2782,38 +2823,186 @@ void DungeonMasterMgr::AbandonSession(uint32 id) { EndSession(id, false); }
 
 void DungeonMasterMgr::CleanupRoguelikeSession(uint32 sessionId, bool success)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
-    auto it = _activeSessions.find(sessionId);
-    if (it == _activeSessions.end()) return;
+    SessionMap::node_type node;
+    {
+        DMLockGuard lock(_sessionMutex);
+        auto it = _activeSessions.find(sessionId);
+        if (it == _activeSessions.end()) return;
+        node = DetachSession(it);
+        if (!tWorldPhase && node.mapped().InstanceId != 0)
+        {
+            _endingSessions.push_back({ std::move(node), success, true });
+            return;
+        }
+    }
 
-    Session& s = it->second;
+    FinishRoguelikeSession(std::move(node), success);
+}
 
+void DungeonMasterMgr::FinishRoguelikeSession(SessionMap::node_type node, bool success)
+{
+    // No teleport/cooldowns for roguelike
+    Session& s = node.mapped();
+    uint32 sessionId = s.SessionId;
+    uint32 savedInstanceId = s.InstanceId;
+    SaveSessionResults(s, success);
 
-    UpdatePlayerStatsFromSession(s, success);
-    if (success && s.State == SessionState::Completed)
-        SaveLeaderboardEntry(s);
+    sDMTrace->SessionEnd(sessionId, success);
+    RecordSessionEnd(sessionId, savedInstanceId, success);
+    {
+        DMLockGuard lock(_sessionMutex);
+        ReleaseSession(std::move(node));
+    }
 
+    LOG_DEBUG("module", "DungeonMaster: Roguelike session {} cleaned up (success={}).",
+        sessionId, success);
+}
 
-    uint32 savedInstanceId = s.InstanceId;
+// World phase only: no map thread is running, so the sessions ended
+// from one since the last call can be torn down.
+void DungeonMasterMgr::DrainEndingSessions()
+{
+    std::vector<EndingSession> ending;
+    {
+        DMLockGuard lock(_sessionMutex);
+        if (_endingSessions.empty())
+            return;
+        ending.swap(_endingSessions);
+    }
 
-    // Clean up mappings (no teleport/cooldowns for roguelike)
-    if (savedInstanceId != 0)
-        _instanceToSession.erase(savedInstanceId);
-    for (const auto& pd : s.Players)
-        _playerToSession.erase(pd.PlayerGuid);
+    for (EndingSession& e : ending)
+    {
+        if (e.Roguelike)
+            FinishRoguelikeSession(std::move(e.Node), e.Success);
+        else
+            FinishSession(std::move(e.Node), e.Success);
+    }
+}
 
-    _activeSessions.erase(it);
+// Stats and the leaderboard row go out as one async transaction.
+void DungeonMasterMgr::SaveSessionResults(const Session& s, bool success, bool withLeaderboard)
+{
+    CharacterDatabaseTransaction trans = CharacterDatabase.BeginTransaction();
+    UpdatePlayerStatsFromSession(s, success, trans);
+    if (withLeaderboard && success && s.State == SessionState::Completed)
+        SaveLeaderboardEntry(s, trans);
+    SaveSessionTelemetry(s, success, trans);
+    CharacterDatabase.CommitTransaction(trans);
+}
 
-    LOG_DEBUG("module", "DungeonMaster: Roguelike session {} cleaned up (success={}).",
-        sessionId, success);
+void DungeonMasterMgr::SaveSessionTelemetry(const Session& s, bool success, CharacterDatabaseTransaction trans)
+{
+    if (!s.Telemetry || !s.StartTime)
+        return;
+
+    uint64 endTime  = s.EndTime > s.StartTime ? s.EndTime : GameTime::GetGameTime().count();
+    SessionTelemetry const& t = *s.Telemetry;
+
+    char query[512];
+    snprintf(query, sizeof(query),
+        "INSERT INTO dm_session_telemetry "
+        "(guid, map_id, difficulty_id, roguelike, success, duration, party_size, "
+        "damage_dealt, damage_taken, damage_taken_raw, healing, overkill) "
+        "VALUES (%u, %u, %u, %u, %u, %u, %u, %llu, %llu, %llu, %llu, %llu)",
+        s.LeaderGuid.GetCounter(), s.MapId, s.DifficultyId,
+        s.RoguelikeRunId != 0 ? 1u : 0u, success ? 1u : 0u,
+        static_cast<uint32>(endTime - s.StartTime), static_cast<uint32>(s.Players.size()),
+        (unsigned long long)t.Get(CombatStat::DamageDealt),
+        (unsigned long long)t.Get(CombatStat::DamageTaken),
+        (unsigned long long)t.Get(CombatStat::DamageTakenRaw),
+        (unsigned long long)t.Get(CombatStat::Healing),
+        (unsigned long long)t.Get(CombatStat::Overkill));
+    trans->Append(query);
 }
 
 void DungeonMasterMgr::CleanupSession(Session& s) { s.InstanceId = 0; }
 
+// Non-zero while this thread is inside Update's locked pass; session
+// Members stamped with it are current. Every other caller resolves fresh.
+static thread_local uint64 tUpdatePass = 0;
+
+SessionMembers const& DungeonMasterMgr::GetMembers(Session const& s)
+{
+    if (tUpdatePass && s.Members.GetPass() == tUpdatePass)
+        return s.Members;
+
+    static thread_local SessionMembers tMembers;
+    tMembers.Resolve(s.Players, s.MapId);
+    return tMembers;
+}
+
+// Session storage is recycled: ended sessions keep their map node and
+// container capacity, so steady-state churn (and roguelike floors) reuse
+// them instead of allocating. All three need _sessionMutex held.
+DungeonMasterMgr::SessionMap::iterator DungeonMasterMgr::AcquireSession(uint32 sessionId)
+{
+    SessionMap::iterator it;
+    if (!_sessionPool.empty())
+    {
+        SessionMap::node_type node = std::move(_sessionPool.back());
+        _sessionPool.pop_back();
+        node.key() = sessionId;
+        it = _activeSessions.insert(std::move(node)).position;
+    }
+    else
+        it = _activeSessions.try_emplace(sessionId).first;
+
+    it->second.SessionId = sessionId;
+    if (!it->second.Commands)
+        it->second.Commands = std::make_unique<SessionCommandQueue>();
+    if (!it->second.Telemetry)
+        it->second.Telemetry = std::make_unique<SessionTelemetry>();
+    return it;
+}
+
+DungeonMasterMgr::SessionMap::node_type DungeonMasterMgr::DetachSession(SessionMap::iterator it)
+{
+    Session const& s = it->second;
+    if (s.InstanceId != 0 && _instanceToSession.erase(s.InstanceId))
+        _mapSessionsDirty = true;
+    for (const auto& pd : s.Players)
+        _playerToSession.erase(pd.PlayerGuid);
+    return _activeSessions.extract(it);
+}
+
+// A detached session may still be in the map-thread index (sessions can
+// end on a map thread, mid map phase), so its node is only recycled by
+// RefreshMapSessions once the index has been republished without it.
+void DungeonMasterMgr::ReleaseSession(SessionMap::node_type node)
+{
+    _retiredSessions.push_back(std::move(node));
+}
+
+void DungeonMasterMgr::RefreshMapSessions()
+{
+    DMLockGuard lock(_sessionMutex);
+    if (_mapSessionsDirty)
+    {
+        _mapSessionsDirty = false;
+        _mapSessions.clear();
+        for (auto const& [instanceId, sessionId] : _instanceToSession)
+        {
+            auto sit = _activeSessions.find(sessionId);
+            if (sit != _activeSessions.end())
+                _mapSessions.emplace(instanceId, &sit->second);
+        }
+        ++_mapSessionsGen;
+    }
+
+    for (SessionMap::node_type& node : _retiredSessions)
+    {
+        if (_sessionPool.size() >= sDMConfig->GetMaxConcurrentRuns())
+            break;
+        node.mapped().Reset();
+        _sessionPool.push_back(std::move(node));
+    }
+    _retiredSessions.clear();
+}
+
 // Cooldowns
 bool DungeonMasterMgr::IsOnCooldown(ObjectGuid g) const
 {
-    std::lock_guard<std::mutex> lock(_cooldownMutex);
+    DMLockGuard lock(_cooldownMutex);
     auto it = _cooldowns.find(g);
     return it != _cooldowns.end()
         && GameTime::GetGameTime().count() < static_cast<time_t>(it->second);
@@ -2821,19 +3010,19 @@ bool DungeonMasterMgr::IsOnCooldown(ObjectGuid g) const
 
 void DungeonMasterMgr::SetCooldown(ObjectGuid g)
 {
-    std::lock_guard<std::mutex> lock(_cooldownMutex);
+    DMLockGuard lock(_cooldownMutex);
     _cooldowns[g] = GameTime::GetGameTime().count() + sDMConfig->GetCooldownMinutes() * 60;
 }
 
 void DungeonMasterMgr::ClearCooldown(ObjectGuid g)
 {
-    std::lock_guard<std::mutex> lock(_cooldownMutex);
+    DMLockGuard lock(_cooldownMutex);
     _cooldowns.erase(g);
 }
 
 uint32 DungeonMasterMgr::GetRemainingCooldown(ObjectGuid g) const
 {
-    std::lock_guard<std::mutex> lock(_cooldownMutex);
+    DMLockGuard lock(_cooldownMutex);
     auto it = _cooldowns.find(g);
     if (it == _cooldowns.end()) return 0;
     time_t now = GameTime::GetGameTime().count();
@@ -2850,7 +3039,7 @@ bool DungeonMasterMgr::CanCreateNewSession() const
 
 void DungeonMasterMgr::LoadAllPlayerStats()
 {
-    std::lock_guard<std::mutex> lock(_statsMutex);
+    DMLockGuard lock(_statsMutex);
     _playerStats.clear();
 
     QueryResult result = CharacterDatabase.Query(
@@ -2888,7 +3077,7 @@ void DungeonMasterMgr::LoadAllPlayerStats()
 
 PlayerStats DungeonMasterMgr::GetPlayerStats(ObjectGuid guid) const
 {
-    std::lock_guard<std::mutex> lock(_statsMutex);
+    DMLockGuard lock(_statsMutex);
     uint32 guidLow = guid.GetCounter();
     auto it = _playerStats.find(guidLow);
     if (it != _playerStats.end())
@@ -2896,11 +3085,11 @@ PlayerStats DungeonMasterMgr::GetPlayerStats(ObjectGuid guid) const
     return {};
 }
 
-void DungeonMasterMgr::SavePlayerStats(uint32 guidLow)
+void DungeonMasterMgr::SavePlayerStats(uint32 guidLow, CharacterDatabaseTransaction trans)
 {
     PlayerStats ps;
     {
-        std::lock_guard<std::mutex> lock(_statsMutex);
+        DMLockGuard lock(_statsMutex);
         auto it = _playerStats.find(guidLow);
         if (it == _playerStats.end()) return;
         ps = it->second;
@@ -2914,10 +3103,11 @@ void DungeonMasterMgr::SavePlayerStats(uint32 guidLow)
         "VALUES (%u, %u, %u, %u, %u, %u, %u, %u)",
         guidLow, ps.TotalRuns, ps.CompletedRuns, ps.FailedRuns,
         ps.TotalMobsKilled, ps.TotalBossesKilled, ps.TotalDeaths, ps.FastestClear);
-    CharacterDatabase.Execute(query);
+    trans->Append(query);
 }
 
-void DungeonMasterMgr::UpdatePlayerStatsFromSession(const Session& session, bool success)
+void DungeonMasterMgr::UpdatePlayerStatsFromSession(const Session& session, bool success,
+                                                    CharacterDatabaseTransaction trans)
 {
     uint32 clearTime = 0;
     if (session.EndTime > session.StartTime)
@@ -2930,7 +3120,7 @@ void DungeonMasterMgr::UpdatePlayerStatsFromSession(const Session& session, bool
         uint32 guidLow = pd.PlayerGuid.GetCounter();
 
         {
-            std::lock_guard<std::mutex> lock(_statsMutex);
+            DMLockGuard lock(_statsMutex);
             auto& ps = _playerStats[guidLow];
             ps.TotalRuns++;
             if (success)
@@ -2947,11 +3137,11 @@ void DungeonMasterMgr::UpdatePlayerStatsFromSession(const Session& session, bool
             ps.TotalDeaths       += pd.Deaths;
         }
 
-        SavePlayerStats(guidLow);
+        SavePlayerStats(guidLow, trans);
     }
 }
 
-void DungeonMasterMgr::SaveLeaderboardEntry(const Session& session)
+void DungeonMasterMgr::SaveLeaderboardEntry(const Session& session, CharacterDatabaseTransaction trans)
 {
     uint32 clearTime = 0;
     if (session.EndTime > session.StartTime)
@@ -2995,7 +3185,7 @@ void DungeonMasterMgr::SaveLeaderboardEntry(const Session& session)
         partySize, session.ScaleToParty ? 1u : 0u,
         static_cast<uint32>(session.EffectiveLevel),
         totalMobs, totalBosses, totalDeaths);
-    CharacterDatabase.Execute(query);
+    trans->Append(query);
 }
 
 std::vector<LeaderboardEntry> DungeonMasterMgr::GetLeaderboard(
@@ -3083,17 +3273,12 @@ float DungeonMasterMgr::CalculateHealthMultiplier(const Session* s) const
     const DifficultyTier* d = sDMConfig->GetDifficulty(s->DifficultyId);
     if (!d) return 1.0f;
 
-    float base = d->HealthMultiplier;
-    uint32 n   = s->Players.size();
-    float mult;
-    if (n <= 1) mult = base * sDMConfig->GetSoloMultiplier();
-    else        mult = base * (1.0f + (n - 1) * sDMConfig->GetPerPlayerHealthMult());
-
     // Roguelike tier scaling
-    if (s->RoguelikeRunId != 0)
-        mult *= sRoguelikeMgr->GetTierHealthMultiplier(s->RoguelikeRunId);
+    float tierMult = s->RoguelikeRunId != 0
+        ? sRoguelikeMgr->GetTierHealthMultiplier(s->RoguelikeRunId) : 1.0f;
 
-    return mult;
+    return Core::SessionMultiplier(d->HealthMultiplier, s->Players.size(),
+        sDMConfig->GetSoloMultiplier(), sDMConfig->GetPerPlayerHealthMult(), tierMult);
 }
 
 float DungeonMasterMgr::CalculateDamageMultiplier(const Session* s) const
@@ -3102,23 +3287,18 @@ float DungeonMasterMgr::CalculateDamageMultiplier(const Session* s) const
     const DifficultyTier* d = sDMConfig->GetDifficulty(s->DifficultyId);
     if (!d) return 1.0f;
 
-    float base = d->DamageMultiplier;
-    uint32 n   = s->Players.size();
-    float mult;
-    if (n <= 1) mult = base * sDMConfig->GetSoloMultiplier();
-    else        mult = base * (1.0f + (n - 1) * sDMConfig->GetPerPlayerDamageMult());
-
     // Roguelike tier scaling
-    if (s->RoguelikeRunId != 0)
-        mult *= sRoguelikeMgr->GetTierDamageMultiplier(s->RoguelikeRunId);
+    float tierMult = s->RoguelikeRunId != 0
+        ? sRoguelikeMgr->GetTierDamageMultiplier(s->RoguelikeRunId) : 1.0f;
 
-    return mult;
+    return Core::SessionMultiplier(d->DamageMultiplier, s->Players.size(),
+        sDMConfig->GetSoloMultiplier(), sDMConfig->GetPerPlayerDamageMult(), tierMult);
 }
 
 // Check if creature belongs to an active session
 bool DungeonMasterMgr::IsSessionCreature(ObjectGuid playerGuid, ObjectGuid creatureGuid)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
     auto pit = _playerToSession.find(playerGuid);
     if (pit == _playerToSession.end())
         return false;
@@ -3133,7 +3313,7 @@ bool DungeonMasterMgr::IsSessionCreature(ObjectGuid playerGuid, ObjectGuid creat
 // Check if creature is a session boss
 bool DungeonMasterMgr::IsSessionBoss(ObjectGuid playerGuid, ObjectGuid creatureGuid)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
     auto pit = _playerToSession.find(playerGuid);
     if (pit == _playerToSession.end())
         return false;
@@ -3142,11 +3322,9 @@ bool DungeonMasterMgr::IsSessionBoss(ObjectGuid playerGuid, ObjectGuid creatureG
     if (sit == _activeSessions.end())
         return false;
 
-    for (const auto& sc : sit->second.SpawnedCreatures)
-        if (sc.Guid == creatureGuid)
-            return sc.IsBoss;
-
-    return false;
+    SessionCreatureSet const& creatures = sit->second.Creatures;
+    uint32 idx = creatures.Find(creatureGuid);
+    return idx != SessionCreatureSet::NPOS && creatures.Test(idx, SPAWN_FLAG_BOSS);
 }
 
 // Compute damage scale for a session creature attacking a session player.
@@ -3155,7 +3333,7 @@ bool DungeonMasterMgr::IsSessionBoss(ObjectGuid playerGuid, ObjectGuid creatureG
 float DungeonMasterMgr::GetSessionCreatureDamageScale(
     ObjectGuid playerGuid, ObjectGuid creatureGuid)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
     auto pit = _playerToSession.find(playerGuid);
     if (pit == _playerToSession.end())
         return 1.0f;
@@ -3167,22 +3345,12 @@ float DungeonMasterMgr::GetSessionCreatureDamageScale(
     const Session& session = sit->second;
 
     // Verify this creature belongs to the session
-    bool isBoss = false;
-    bool found  = false;
-    for (const auto& sc : session.SpawnedCreatures)
-    {
-        if (sc.Guid == creatureGuid)
-        {
-            found  = true;
-            isBoss = sc.IsBoss;
-            break;
-        }
-    }
-    if (!found)
+    uint32 idx = session.Creatures.Find(creatureGuid);
+    if (idx == SessionCreatureSet::NPOS)
         return 1.0f;
 
     // Trash mobs use our custom AI — melee is already scaled, no spells.
-    if (!isBoss)
+    if (!session.Creatures.Test(idx, SPAWN_FLAG_BOSS))
         return 1.0f;
 
     // For bosses: compare session target level to the boss's original template level.
@@ -3192,12 +3360,11 @@ float DungeonMasterMgr::GetSessionCreatureDamageScale(
     // We need the creature's original template maxlevel.  Find a player reference
     // to resolve the creature GUID.
     Creature* creature = nullptr;
-    for (const auto& pd : session.Players)
+    for (auto const& m : GetMembers(session))
     {
-        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-        if (p && p->IsInWorld())
+        if (m.Is(MEMBER_IN_WORLD))
         {
-            creature = ObjectAccessor::GetCreature(*p, creatureGuid);
+            creature = ObjectAccessor::GetCreature(*m.Ptr, creatureGuid);
             if (creature) break;
         }
     }
@@ -3211,32 +3378,18 @@ float DungeonMasterMgr::GetSessionCreatureDamageScale(
     if (targetLevel >= templateLevel)
         return 1.0f;
 
-    // Use classlevelstats to get the proper damage ratio between levels.
+    // Use classlevelstats to get the proper damage ratio between levels;
+    // falls back to the squared level ratio when a row is missing.
     uint8 unitClass = creature->GetCreatureTemplate()->unit_class;
     const ClassLevelStatEntry* targetStats   = GetBaseStatsForLevel(unitClass, targetLevel);
     const ClassLevelStatEntry* templateStats = GetBaseStatsForLevel(unitClass, templateLevel);
 
-    float scale;
-    if (targetStats && templateStats && templateStats->BaseDamage > 1.0f)
-    {
-        scale = targetStats->BaseDamage / templateStats->BaseDamage;
-    }
-    else
-    {
-        // Fallback: level ratio squared (spell damage scales ~quadratically)
-        float lvlRatio = static_cast<float>(targetLevel) / static_cast<float>(templateLevel);
-        scale = lvlRatio * lvlRatio;
-    }
-
-    // Apply solo/party multiplier so boss spells feel consistent with melee
-    uint32 n = session.Players.size();
-    if (n <= 1)
-        scale *= sDMConfig->GetSoloMultiplier();
-
-    // Clamp: never fully negate, never amplify
-    scale = std::max(0.03f, std::min(1.0f, scale));
+    float scale = Core::BossSpellDamageScale(targetLevel, templateLevel,
+        (targetStats && templateStats) ? targetStats->BaseDamage : -1.0f,
+        templateStats ? templateStats->BaseDamage : -1.0f,
+        session.Players.size(), sDMConfig->GetSoloMultiplier());
 
-    LOG_DEBUG("module", "DungeonMaster: Boss spell damage scale for session {} — "
+    DM_LOG_TRACE("DungeonMaster: Boss spell damage scale for session {} — "
         "targetLvl={}, templateLvl={}, scale={:.3f}",
         session.SessionId, targetLevel, templateLevel, scale);
 
@@ -3246,7 +3399,7 @@ float DungeonMasterMgr::GetSessionCreatureDamageScale(
 // Scale environmental damage to party level
 float DungeonMasterMgr::GetEnvironmentalDamageScale(ObjectGuid playerGuid)
 {
-    std::lock_guard<std::mutex> lock(_sessionMutex);
+    DMLockGuard lock(_sessionMutex);
     auto pit = _playerToSession.find(playerGuid);
     if (pit == _playerToSession.end())
         return 1.0f;
@@ -3264,309 +3417,541 @@ float DungeonMasterMgr::GetEnvironmentalDamageScale(ObjectGuid playerGuid)
     if (!dg)
         return 1.0f;
 
-    uint8 dungeonLevel = dg->MaxLevel;
-    uint8 partyLevel   = session.EffectiveLevel;
+    return Core::EnvironmentalDamageScale(session.EffectiveLevel, dg->MaxLevel);
+}
 
-    if (partyLevel >= dungeonLevel)
-        return 1.0f;
+// Hook recorder: creature ownership + the inputs dm_replay needs to
+// recompute boss spell scaling without a world database.
+void DungeonMasterMgr::RecordCreatureSpawn(const Session& session, Creature* c,
+                                           uint32 creatureIdx, uint32 instanceId)
+{
+    if (!c || !sDMHookRecorder->IsEnabled())
+        return;
 
-    float ratio = static_cast<float>(partyLevel) / static_cast<float>(dungeonLevel);
-    float scale = std::pow(ratio, 1.5f);
-    if (scale < 0.05f)
-        scale = 0.05f;
+    const CreatureTemplate* tmpl = c->GetCreatureTemplate();
+    uint8 templateLevel = tmpl ? tmpl->maxlevel : 0;
+    uint8 unitClass     = tmpl ? tmpl->unit_class : 0;
+    const ClassLevelStatEntry* targetStats   = GetBaseStatsForLevel(unitClass, session.EffectiveLevel);
+    const ClassLevelStatEntry* templateStats = GetBaseStatsForLevel(unitClass, templateLevel);
 
-    return scale;
+    Core::HookRecord rec;
+    rec.Type       = uint8(Core::HookType::CreatureSpawn);
+    SessionCreatureSet const& creatures = session.Creatures;
+    rec.Actor      = creatures.GetGuid(creatureIdx).GetRawValue();
+    rec.MapId      = session.MapId;
+    rec.InstanceId = instanceId;
+    rec.SessionId  = session.SessionId;
+    rec.Amount     = creatures.GetEntry(creatureIdx);
+    rec.Extra      = templateLevel;
+    rec.F0         = targetStats   ? targetStats->BaseDamage   : -1.0f;
+    rec.F1         = templateStats ? templateStats->BaseDamage : -1.0f;
+    rec.Flags      = (creatures.Test(creatureIdx, SPAWN_FLAG_BOSS)  ? Core::HOOK_FLAG_BOSS  : 0)
+                   | (creatures.Test(creatureIdx, SPAWN_FLAG_ELITE) ? Core::HOOK_FLAG_ELITE : 0)
+                   | (creatures.Test(creatureIdx, SPAWN_FLAG_RARE)  ? Core::HOOK_FLAG_RARE  : 0);
+    sDMHookRecorder->Record(rec);
+}
+
+void DungeonMasterMgr::RecordSessionEnd(uint32 sessionId, uint32 instanceId, bool success)
+{
+    if (!sDMHookRecorder->IsEnabled())
+        return;
+
+    Core::HookRecord rec;
+    rec.Type       = uint8(Core::HookType::SessionEnd);
+    rec.InstanceId = instanceId;
+    rec.SessionId  = sessionId;
+    rec.Amount     = success ? 1 : 0;
+    sDMHookRecorder->Record(rec);
 }
 
-// Main update tick (1s interval)
-void DungeonMasterMgr::Update(uint32 diff)
+// Map-thread supervision
+// During the map phase a session belongs to its instance map's update
+// thread: only that thread touches its creatures and players, and reads
+// the session unlocked. _sessionMutex is taken just to publish the
+// bookkeeping other threads read (creature set, progress, state).
+// Sessions can be created and ended from map threads too (gossip,
+// deaths), so map threads never look at _activeSessions or
+// _instanceToSession: they read _mapSessions, which only
+// RefreshMapSessions writes, in the world phase.
+Session* DungeonMasterMgr::FindMapSession(uint32 instanceId)
 {
-    _updateTimer += diff;
-    if (_updateTimer < UPDATE_INTERVAL)
+    auto it = _mapSessions.find(instanceId);
+    return it != _mapSessions.end() ? it->second : nullptr;
+}
+
+// Damage and heal hooks arrive in runs from one map's update, so the
+// index is only consulted when the thread moves to another instance or
+// RefreshMapSessions has rebuilt it; misses are remembered as well.
+SessionTelemetry* DungeonMasterMgr::GetSessionTelemetry(uint32 instanceId)
+{
+    struct CachedTelemetry
+    {
+        uint32            InstanceId = 0;
+        uint64            Gen        = 0;
+        SessionTelemetry* Telemetry  = nullptr;
+    };
+    static thread_local CachedTelemetry tCached;
+
+    if (!instanceId)
+        return nullptr;
+
+    if (tCached.InstanceId != instanceId || tCached.Gen != _mapSessionsGen)
+    {
+        Session* session   = FindMapSession(instanceId);
+        tCached.InstanceId = instanceId;
+        tCached.Gen        = _mapSessionsGen;
+        tCached.Telemetry  = session ? session->Telemetry.get() : nullptr;
+    }
+    return tCached.Telemetry;
+}
+
+std::vector<DungeonMasterMgr::SessionCombatStats> DungeonMasterMgr::GetActiveCombatStats() const
+{
+    std::vector<SessionCombatStats> result;
+    {
+        DMLockGuard lock(_sessionMutex);
+        result.reserve(_activeSessions.size());
+        for (auto const& [id, session] : _activeSessions)
+        {
+            SessionCombatStats& row = result.emplace_back();
+            row.SessionId = id;
+            row.MapId     = session.MapId;
+            if (session.Telemetry)
+                for (size_t i = 0; i < size_t(CombatStat::Count); ++i)
+                    row.Stats[i] = session.Telemetry->Get(CombatStat(i));
+        }
+    }
+    std::sort(result.begin(), result.end(),
+        [](SessionCombatStats const& a, SessionCombatStats const& b) { return a.SessionId < b.SessionId; });
+    return result;
+}
+
+void DungeonMasterMgr::UpdateSessionMap(InstanceMap* map, uint32 diff)
+{
+    Session* session = FindMapSession(map->GetInstanceId());
+    if (!session)
         return;
-    _updateTimer = 0;
 
-    std::vector<std::pair<uint32, bool>> toEnd;
-    std::vector<std::pair<uint32, uint32>> roguelikeCompleted; // {runId, sessionId}
+    SessionCommand command;
+    while (session->Commands->Pop(command))
+        command(*session, map);
+
+    session->MapUpdateTimer += diff;
+    if (session->MapUpdateTimer < UPDATE_INTERVAL)
+        return;
+    session->MapUpdateTimer = 0;
+
+    if (!session->IsActive())
+        return;
 
+    // Any member inside serves as the grid-search origin
+    Player* ref = nullptr;
+    for (auto const& itr : map->GetPlayers())
     {
-        std::lock_guard<std::mutex> lock(_sessionMutex);
+        Player* p = itr.GetSource();
+        if (p && p->IsInWorld() && session->HasPlayer(p->GetGUID()))
+        {
+            ref = p;
+            break;
+        }
+    }
+    if (!ref)
+        return;
 
-        for (auto& [sid, session] : _activeSessions)
+    // ---- Populate if not yet done ----
+    if (session->TotalMobs == 0 && session->TotalBosses == 0)
+    {
+        SessionMembers const& members = GetMembers(*session);
+        GetMessagePacket(DMMessage::PreparingChallenge).SendToMembers(members);
+
+        PopulateDungeon(session, map);
+
+        LOG_INFO("module", "DungeonMaster: Session {} — populated (map {}, mobs={}, bosses={})",
+            session->SessionId, session->MapId,
+            session->TotalMobs, session->TotalBosses);
+
+        char buf[256];
+        snprintf(buf, sizeof(buf),
+            "|cFF00FF00[Dungeon Master]|r |cFFFFFFFF%u|r enemies and "
+            "|cFFFFFFFF%u|r boss(es) spawned. Creature levels: "
+            "|cFFFFFFFF%u-%u|r. Good luck!",
+            session->TotalMobs, session->TotalBosses,
+            session->LevelBandMin, session->LevelBandMax);
+        DMChatPacket(buf).SendToMembers(members);
+    }
+
+    PollCreatureDeaths(*session, map);
+    CleanupCorpses(*session, map);
+    ResolvePhaseChecks(*session, map, ref);
+    SweepStrayCreatures(*session, map);
+}
+
+void DungeonMasterMgr::PostToSessionMap(Session& session, SessionCommand command)
+{
+    session.Commands->Push(std::move(command));
+}
+
+// Poll only creatures not yet fully processed (dead, looted, credited)
+void DungeonMasterMgr::PollCreatureDeaths(Session& session, InstanceMap* map)
+{
+    struct DeadCreature
+    {
+        uint32    Idx;
+        Creature* Ptr;
+        bool      FillLoot;
+        bool      Credit;
+    };
+    static thread_local std::vector<DeadCreature> tDead;
+    tDead.clear();
+
+    SessionCreatureSet& creatures = session.Creatures;
+    creatures.ForEachUnprocessed([&](uint32 idx)
+    {
+        Creature* c = map->GetCreature(creatures.GetGuid(idx));
+        if (!c || !c->IsAlive())
+            tDead.push_back({ idx, c, false, false });
+    });
+    if (tDead.empty())
+        return;
+
+    {
+        DMLockGuard lock(_sessionMutex);
+        for (DeadCreature& d : tDead)
         {
-            // ---- Poll creature deaths ----
-            if (session.IsActive())
+            creatures.Set(d.Idx, SPAWN_FLAG_DEAD);
+            TrackCorpse(session, d.Idx, d.Ptr);
+
+            d.FillLoot = d.Ptr && !creatures.Test(d.Idx, SPAWN_FLAG_LOOT_FILLED);
+            if (d.FillLoot)
+                creatures.Set(d.Idx, SPAWN_FLAG_LOOT_FILLED);
+
+            d.Credit = !creatures.Test(d.Idx, SPAWN_FLAG_KILL_CREDITED);
+            if (!d.Credit)
+                continue;
+            creatures.Set(d.Idx, SPAWN_FLAG_KILL_CREDITED);
+
+            if (creatures.Test(d.Idx, SPAWN_FLAG_BOSS))
+            {
+                PendingPhaseCheck ppc;
+                if (d.Ptr)
+                    ppc.DeathPos = { d.Ptr->GetPositionX(), d.Ptr->GetPositionY(),
+                                     d.Ptr->GetPositionZ(), d.Ptr->GetOrientation() };
+                ppc.DeathTime = GameTime::GetGameTime().count();
+                ppc.OrigEntry = creatures.GetEntry(d.Idx);
+                ppc.Resolved  = false;
+                session.PendingPhaseChecks.push_back(ppc);
+            }
+            else
+            {
+                ++session.MobsKilled;
+                for (auto& pd : session.Players)
+                    ++pd.MobsKilled;
+            }
+        }
+    }
+
+    for (DeadCreature const& d : tDead)
+    {
+        bool isBoss = creatures.Test(d.Idx, SPAWN_FLAG_BOSS);
+        if (d.FillLoot)
+            FillCreatureLoot(d.Ptr, &session, isBoss);
+        if (d.Credit)
+            GiveKillXP(&session, isBoss, creatures.Test(d.Idx, SPAWN_FLAG_ELITE));
+    }
+}
+
+// Every session kill is tracked from the first place it is seen dead,
+// whether or not its loot is ever filled.
+void DungeonMasterMgr::TrackCorpse(Session& session, uint32 idx, Creature* creature)
+{
+    SessionCreatureSet& creatures = session.Creatures;
+    if (!creature || creatures.Test(idx, SPAWN_FLAG_CORPSE_TRACKED))
+        return;
+
+    creatures.Set(idx, SPAWN_FLAG_CORPSE_TRACKED);
+    session.Corpses.push_back({ creature->GetGUID(), uint64(GameTime::GetGameTime().count()), 0,
+        creatures.Test(idx, SPAWN_FLAG_BOSS) || creatures.Test(idx, SPAWN_FLAG_RARE) });
+}
+
+static bool HasUnlootedItems(Loot const& loot)
+{
+    return std::any_of(loot.items.begin(), loot.items.end(),
+        [](LootItem const& li) { return !li.is_looted; });
+}
+
+// Corpses go as soon as their loot is gone (taken, or nothing was
+// generated) plus a short grace, and the session never keeps more than
+// its budget: the oldest looted corpses are evicted first, then the
+// oldest trash corpses left with only gold. Boss and rare corpses, and
+// any corpse still holding items, stay until looted or the core's own
+// corpse delay. Instance object count then tracks living mobs.
+void DungeonMasterMgr::CleanupCorpses(Session& session, InstanceMap* map)
+{
+    std::vector<SessionCorpse>& corpses = session.Corpses;
+    if (corpses.empty())
+        return;
+
+    uint64 now   = GameTime::GetGameTime().count();
+    uint32 grace = sDMConfig->GetCorpseLootedGrace();
+
+    size_t kept = 0;
+    for (SessionCorpse& corpse : corpses)
+    {
+        Creature* c = map->GetCreature(corpse.Guid);
+        if (!c || !c->IsInWorld() || c->IsAlive())
+            continue;   // already despawned (or revived) — stop tracking
+
+        if (c->loot.isLooted())
+        {
+            if (!corpse.EmptySince)
+                corpse.EmptySince = now;
+            if (now - corpse.EmptySince >= grace)
+            {
+                c->DespawnOrUnsummon();
+                continue;
+            }
+        }
+        else
+            corpse.EmptySince = 0;  // seen before its loot was filled
+        corpses[kept++] = corpse;
+    }
+    corpses.resize(kept);
+
+    uint32 budget = sDMConfig->GetCorpseBudget();
+    if (!budget || corpses.size() <= budget)
+        return;
+
+    size_t excess = corpses.size() - budget;
+    auto evict = [&](bool lootedOnly)
+    {
+        for (auto it = corpses.begin(); excess && it != corpses.end();)
+        {
+            Creature* c = map->GetCreature(it->Guid);
+            bool keep = lootedOnly ? !it->EmptySince
+                                   : it->BossOrRare || (c && HasUnlootedItems(c->loot));
+            if (keep)
             {
-                Player* ref = nullptr;
-                for (const auto& pd : session.Players)
+                ++it;
+                continue;
+            }
+            if (c)
+                c->DespawnOrUnsummon();
+            it = corpses.erase(it);
+            --excess;
+        }
+    };
+    evict(true);
+    evict(false);
+}
+
+// ---- Multi-phase boss resolution ----
+// After 5 seconds, check if new creatures spawned near the boss death location.
+// If found, promote them to boss status. If not, confirm the boss kill.
+void DungeonMasterMgr::ResolvePhaseChecks(Session& session, InstanceMap* map, Player* ref)
+{
+    if (session.PendingPhaseChecks.empty())
+        return;
+
+    SessionCreatureSet& creatures = session.Creatures;
+    uint64 nowTime = GameTime::GetGameTime().count();
+    for (auto& ppc : session.PendingPhaseChecks)
+    {
+        if (ppc.Resolved) continue;
+        if (nowTime - ppc.DeathTime < 5) continue;  // Wait 5 seconds for phase transitions
+
+        ppc.Resolved = true;
+
+        // Scan for new non-tracked creatures near the boss death position
+        bool phaseCreatureFound = false;
+        if (ppc.DeathPos.GetPositionX() != 0.0f)
+        {
+            std::list<Creature*> nearby;
+            ref->GetCreatureListWithEntryInGrid(nearby, 0, 5000.0f);
+
+            for (Creature* nc : nearby)
+            {
+                if (!nc || !nc->IsAlive() || nc->IsPet() || nc->IsGuardian())
+                    continue;
+                if (nc->GetEntry() == sDMConfig->GetNpcEntry())
+                    continue;
+                if (creatures.Contains(nc->GetGUID()))
+                    continue;  // Already tracked
+
+                // Check distance from boss death position (within 40 yards)
+                float dx = nc->GetPositionX() - ppc.DeathPos.GetPositionX();
+                float dy = nc->GetPositionY() - ppc.DeathPos.GetPositionY();
+                float dz = nc->GetPositionZ() - ppc.DeathPos.GetPositionZ();
+                float dist = std::sqrt(dx*dx + dy*dy + dz*dz);
+
+                if (dist > 40.0f) continue;
+
+                // Check if it's an elite/boss creature (likely phase 2)
+                const CreatureTemplate* tmpl = nc->GetCreatureTemplate();
+                if (!tmpl || (tmpl->rank != 1 && tmpl->rank != 2 && tmpl->rank != 4))
+                    continue;
+
+                // Promote to boss creature
+                DM_LOG_INFO_RL("DungeonMaster: Phase creature detected! '{}' (entry {}) "
+                    "spawned {:.1f} yds from boss death location — promoting to boss",
+                    nc->GetName(), nc->GetEntry(), dist);
+
+                nc->SetFaction(14);
+                nc->SetReactState(REACT_AGGRESSIVE);
+                nc->RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE | UNIT_FLAG_IMMUNE_TO_PC
+                                                | UNIT_FLAG_IMMUNE_TO_NPC | UNIT_FLAG_PACIFIED);
+                nc->SetImmuneToPC(false);
+                nc->SetImmuneToNPC(false);
+
                 {
-                    Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-                    if (p && p->GetMapId() == session.MapId) { ref = p; break; }
+                    DMLockGuard lock(_sessionMutex);
+                    uint32 idx = creatures.Add(nc->GetGUID(), nc->GetEntry(), true, true, false);
+                    RecordCreatureSpawn(session, nc, idx, map->GetInstanceId());
+
+                    // Track the GUID for cleanup
+                    TrackInstanceCreatures(map->GetInstanceId()).push_back(nc->GetGUID());
                 }
 
-                if (ref)
+                phaseCreatureFound = true;
+
+                GetMessagePacket(DMMessage::BossNewPhase).SendToMembers(GetMembers(session));
+                break;  // Only promote one phase creature per check
+            }
+        }
+
+        if (!phaseCreatureFound)
+        {
+            // No phase creature found — confirm the boss kill
+            bool completed = false;
+            {
+                DMLockGuard lock(_sessionMutex);
+                ++session.BossesKilled;
+                for (auto& pd : session.Players)
+                    ++pd.BossesKilled;
+
+                if (session.IsActive() && session.TotalBosses > 0
+                    && session.BossesKilled >= session.TotalBosses)
                 {
-                    // ---- Ensure instance mapping is registered ----
-                    if (session.InstanceId == 0)
-                    {
-                        Map* m2 = ref->GetMap();
-                        if (m2 && m2->IsDungeon())
-                        {
-                            session.InstanceId = m2->ToInstanceMap()->GetInstanceId();
-                        }
-                    }
-                    if (session.InstanceId != 0 &&
-                        _instanceToSession.find(session.InstanceId) == _instanceToSession.end())
-                    {
-                        _instanceToSession[session.InstanceId] = session.SessionId;
-                    }
+                    session.State   = SessionState::Completed;
+                    session.EndTime = GameTime::GetGameTime().count();
+                    completed = true;
+                }
+            }
 
-                    // ---- Populate if not yet done ----
-                    if (session.TotalMobs == 0 && session.TotalBosses == 0)
-                    {
-                        Map* m = ref->GetMap();
-                        if (m && m->IsDungeon())
-                        {
-                            InstanceMap* inst = m->ToInstanceMap();
-                            if (inst)
-                            {
-                                session.InstanceId = inst->GetInstanceId();
-                                _instanceToSession[session.InstanceId] = session.SessionId;
-
-                                for (const auto& pd2 : session.Players)
-                                    if (Player* p2 = ObjectAccessor::FindPlayer(pd2.PlayerGuid))
-                                        ChatHandler(p2->GetSession()).SendSysMessage(
-                                            "|cFF00FF00[Dungeon Master]|r Preparing the challenge...");
-
-                                PopulateDungeon(&session, inst);
-
-                                LOG_INFO("module", "DungeonMaster: Session {} — populated (map {}, mobs={}, bosses={})",
-                                    session.SessionId, session.MapId,
-                                    session.TotalMobs, session.TotalBosses);
-
-                                char buf[256];
-                                snprintf(buf, sizeof(buf),
-                                    "|cFF00FF00[Dungeon Master]|r |cFFFFFFFF%u|r enemies and "
-                                    "|cFFFFFFFF%u|r boss(es) spawned. Creature levels: "
-                                    "|cFFFFFFFF%u-%u|r. Good luck!",
-                                    session.TotalMobs, session.TotalBosses,
-                                    session.LevelBandMin, session.LevelBandMax);
-                                for (const auto& pd2 : session.Players)
-                                    if (Player* p2 = ObjectAccessor::FindPlayer(pd2.PlayerGuid))
-                                        ChatHandler(p2->GetSession()).SendSysMessage(buf);
-                            }
-                        }
-                    }
+            LOG_INFO("module", "DungeonMaster: Boss kill confirmed (entry {}) — progress: {}/{}",
+                ppc.OrigEntry, session.BossesKilled, session.TotalBosses);
+            HandleBossDeath(&session);
 
-                    // Build set of our known GUIDs for stray detection
-                    std::set<ObjectGuid> ourGuids;
-                    for (const auto& sc : session.SpawnedCreatures)
-                        ourGuids.insert(sc.Guid);
+            // Check completion
+            if (completed)
+            {
+                uint32 delay = (session.RoguelikeRunId != 0)
+                    ? sDMConfig->GetRoguelikeTransitionDelay()
+                    : sDMConfig->GetCompletionTeleportDelay();
 
-                    for (auto& sc : session.SpawnedCreatures)
-                    {
-                        if (sc.IsDead && sc.LootFilled && sc.KillCredited)
-                            continue;   // fully processed
-                        Creature* c = ObjectAccessor::GetCreature(*ref, sc.Guid);
-                        if (!c || !c->IsAlive())
-                        {
-                            sc.IsDead = true;
-
-                            if (!sc.LootFilled && c)
-                            {
-                                sc.LootFilled = true;
-                                FillCreatureLoot(c, &session, sc.IsBoss);
-                            }
-
-                            if (!sc.KillCredited)
-                            {
-                                sc.KillCredited = true;
-                                GiveKillXP(&session, sc.IsBoss, sc.IsElite);
-
-                                if (sc.IsBoss)
-                                {
-                                    PendingPhaseCheck ppc;
-                                    if (c)
-                                        ppc.DeathPos = { c->GetPositionX(), c->GetPositionY(),
-                                                         c->GetPositionZ(), c->GetOrientation() };
-                                    ppc.DeathTime = GameTime::GetGameTime().count();
-                                    ppc.OrigEntry = sc.Entry;
-                                    ppc.Resolved  = false;
-                                    session.PendingPhaseChecks.push_back(ppc);
-                                }
-                                else
-                                {
-                                    ++session.MobsKilled;
-                                    for (auto& pd : session.Players)
-                                        ++pd.MobsKilled;
-                                }
-                            }
-                        }
-                    }
+                char buf[256];
+                snprintf(buf, sizeof(buf),
+                    "|cFF00FF00[Dungeon Master]|r %s "
+                    "Rewards in |cFFFFFFFF%u|r seconds...",
+                    session.RoguelikeRunId != 0
+                        ? "Floor cleared!" : "Dungeon complete!",
+                    delay);
+                DMChatPacket(buf).SendToMembers(GetMembers(session));
+                break;
+            }
+        }
+    }
 
-                    // ---- Multi-phase boss resolution ----
-                    // After 5 seconds, check if new creatures spawned near the boss death location.
-                    // If found, promote them to boss status. If not, confirm the boss kill.
-                    uint64 nowTime = GameTime::GetGameTime().count();
-                    for (auto& ppc : session.PendingPhaseChecks)
-                    {
-                        if (ppc.Resolved) continue;
-                        if (nowTime - ppc.DeathTime < 5) continue;  // Wait 5 seconds for phase transitions
+    // Clean up resolved phase checks
+    DMLockGuard lock(_sessionMutex);
+    session.PendingPhaseChecks.erase(
+        std::remove_if(session.PendingPhaseChecks.begin(), session.PendingPhaseChecks.end(),
+            [](const PendingPhaseCheck& p) { return p.Resolved; }),
+        session.PendingPhaseChecks.end());
+}
 
-                        ppc.Resolved = true;
+// ---- Sweep for stray creatures (script-spawned, respawned) ----
+void DungeonMasterMgr::SweepStrayCreatures(Session& session, InstanceMap* map)
+{
+    uint32 npcEntry = sDMConfig->GetNpcEntry();
+    for (auto const& pair : map->GetCreatureBySpawnIdStore())
+    {
+        Creature* stray = pair.second;
+        if (stray && stray->IsInWorld() && stray->IsAlive()
+            && stray->GetEntry() != npcEntry
+            && !stray->IsPet() && !stray->IsGuardian() && !stray->IsTotem()
+            && !session.Creatures.Contains(stray->GetGUID()))
+        {
+            stray->SetRespawnTime(7 * DAY);
+            stray->DespawnOrUnsummon();
+        }
+    }
+}
 
-                        // Scan for new non-tracked creatures near the boss death position
-                        bool phaseCreatureFound = false;
-                        Map* scanMap = ref->GetMap();
-                        if (scanMap && scanMap->IsDungeon() && ppc.DeathPos.GetPositionX() != 0.0f)
-                        {
-                            std::list<Creature*> nearby;
-                            ref->GetCreatureListWithEntryInGrid(nearby, 0, 5000.0f);
-
-                            for (Creature* nc : nearby)
-                            {
-                                if (!nc || !nc->IsAlive() || nc->IsPet() || nc->IsGuardian())
-                                    continue;
-                                if (nc->GetEntry() == sDMConfig->GetNpcEntry())
-                                    continue;
-                                if (ourGuids.count(nc->GetGUID()) > 0)
-                                    continue;  // Already tracked
-
-                                // Check distance from boss death position (within 40 yards)
-                                float dx = nc->GetPositionX() - ppc.DeathPos.GetPositionX();
-                                float dy = nc->GetPositionY() - ppc.DeathPos.GetPositionY();
-                                float dz = nc->GetPositionZ() - ppc.DeathPos.GetPositionZ();
-                                float dist = std::sqrt(dx*dx + dy*dy + dz*dz);
-
-                                if (dist > 40.0f) continue;
-
-                                // Check if it's an elite/boss creature (likely phase 2)
-                                const CreatureTemplate* tmpl = nc->GetCreatureTemplate();
-                                if (!tmpl || (tmpl->rank != 1 && tmpl->rank != 2 && tmpl->rank != 4))
-                                    continue;
-
-                                // Promote to boss creature
-                                LOG_INFO("module", "DungeonMaster: Phase creature detected! '{}' (entry {}) "
-                                    "spawned {:.1f} yds from boss death location — promoting to boss",
-                                    nc->GetName(), nc->GetEntry(), dist);
-
-                                nc->SetFaction(14);
-                                nc->SetReactState(REACT_AGGRESSIVE);
-                                nc->RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_NON_ATTACKABLE | UNIT_FLAG_IMMUNE_TO_PC
-                                                                | UNIT_FLAG_IMMUNE_TO_NPC | UNIT_FLAG_PACIFIED);
-                                nc->SetImmuneToPC(false);
-                                nc->SetImmuneToNPC(false);
-
-                                SpawnedCreature nsc;
-                                nsc.Guid = nc->GetGUID();
-                                nsc.Entry = nc->GetEntry();
-                                nsc.IsElite = true;
-                                nsc.IsBoss = true;
-                                session.SpawnedCreatures.push_back(nsc);
-                                ourGuids.insert(nc->GetGUID());
-
-                                // Track the GUID for cleanup
-                                auto& gl = _instanceCreatureGuids[session.InstanceId];
-                                gl.push_back(nc->GetGUID());
-
-                                phaseCreatureFound = true;
-
-                                for (const auto& pd3 : session.Players)
-                                    if (Player* p3 = ObjectAccessor::FindPlayer(pd3.PlayerGuid))
-                                        if (p3->GetSession())
-                                            ChatHandler(p3->GetSession()).SendSysMessage(
-                                                "|cFFFF8000[Dungeon Master]|r The boss enters a new phase!");
-                                break;  // Only promote one phase creature per check
-                            }
-                        }
+// Main update tick (1s interval)
+void DungeonMasterMgr::Update(uint32 diff)
+{
+    // Smoothed over ~16 world ticks; read by PopulateDungeon on map threads
+    uint32 avgTick = _avgWorldTickMs.load(std::memory_order_relaxed);
+    _avgWorldTickMs.store(avgTick ? (avgTick * 15 + diff) / 16 : diff, std::memory_order_relaxed);
 
-                        if (!phaseCreatureFound)
-                        {
-                            // No phase creature found — confirm the boss kill
-                            ++session.BossesKilled;
-                            for (auto& pd : session.Players)
-                                ++pd.BossesKilled;
-
-                            LOG_INFO("module", "DungeonMaster: Boss kill confirmed (entry {}) — progress: {}/{}",
-                                ppc.OrigEntry, session.BossesKilled, session.TotalBosses);
-                            HandleBossDeath(&session);
-
-                            // Check completion
-                            if (session.IsActive() && session.TotalBosses > 0
-                                && session.BossesKilled >= session.TotalBosses)
-                            {
-                                session.State   = SessionState::Completed;
-                                session.EndTime = GameTime::GetGameTime().count();
-
-                                uint32 delay = (session.RoguelikeRunId != 0)
-                                    ? sDMConfig->GetRoguelikeTransitionDelay()
-                                    : sDMConfig->GetCompletionTeleportDelay();
-
-                                for (const auto& pd2 : session.Players)
-                                    if (Player* p = ObjectAccessor::FindPlayer(pd2.PlayerGuid))
-                                        if (p->GetSession())
-                                        {
-                                            char buf[256];
-                                            snprintf(buf, sizeof(buf),
-                                                "|cFF00FF00[Dungeon Master]|r %s "
-                                                "Rewards in |cFFFFFFFF%u|r seconds...",
-                                                session.RoguelikeRunId != 0
-                                                    ? "Floor cleared!" : "Dungeon complete!",
-                                                delay);
-                                            ChatHandler(p->GetSession()).SendSysMessage(buf);
-                                        }
-                                break;
-                            }
-                        }
-                    }
+    struct WorldPhaseScope
+    {
+        WorldPhaseScope()  { tWorldPhase = true; }
+        ~WorldPhaseScope() { tWorldPhase = false; }
+    } worldPhase;
 
-                    // Clean up resolved phase checks
-                    session.PendingPhaseChecks.erase(
-                        std::remove_if(session.PendingPhaseChecks.begin(), session.PendingPhaseChecks.end(),
-                            [](const PendingPhaseCheck& p) { return p.Resolved; }),
-                        session.PendingPhaseChecks.end());
+    ProcessMemberEvents();
+    RefreshMapSessions();
+    DrainEndingSessions();
 
-                    // ---- Sweep for stray creatures (script-spawned, respawned) ----
-                    Map* m = ref->GetMap();
-                    if (m && m->IsDungeon())
-                    {
-                        uint32 npcEntry = sDMConfig->GetNpcEntry();
-                        auto const& dbStore = static_cast<InstanceMap*>(m)->GetCreatureBySpawnIdStore();
-                        for (auto const& pair : dbStore)
-                        {
-                            Creature* stray = pair.second;
-                            if (stray && stray->IsInWorld() && stray->IsAlive()
-                                && stray->GetEntry() != npcEntry
-                                && !stray->IsPet() && !stray->IsGuardian() && !stray->IsTotem()
-                                && ourGuids.count(stray->GetGUID()) == 0)
-                            {
-                                stray->SetRespawnTime(7 * DAY);
-                                stray->DespawnOrUnsummon();
-                            }
-                        }
-                    }
-                }
+    _updateTimer += diff;
+    if (_updateTimer < UPDATE_INTERVAL)
+        return;
+    _updateTimer = 0;
+
+    // Update-scoped scratch lives in the tick arena (reset by dm_world_script)
+    auto toEnd              = sDMTickArena.NewVector<std::pair<uint32, bool>>();
+    auto roguelikeCompleted = sDMTickArena.NewVector<std::pair<uint32, uint32>>(); // {runId, sessionId}
+    auto roguelikeWiped     = sDMTickArena.NewVector<uint32>();                     // runId
+
+    {
+        DMLockGuard lock(_sessionMutex);
+        tUpdatePass = ++_updatePasses;
+
+        uint32 liveCreatures = 0;
+        for (auto const& [sid, session] : _activeSessions)
+        {
+            uint32 spawned = session.TotalMobs + session.TotalBosses;
+            uint32 killed  = session.MobsKilled + session.BossesKilled;
+            liveCreatures += spawned > killed ? spawned - killed : 0;
+        }
+        _liveCreatures.store(liveCreatures, std::memory_order_relaxed);
+        _populatedCreatures.store(0, std::memory_order_relaxed);
 
-                // ---- Auto-rez when out of combat ----
-                if (session.IsActive() && !session.IsGroupInCombat())
+        for (auto& [sid, session] : _activeSessions)
+        {
+            // Resolve members once; every sub-step below (and helpers
+            // reached through GetMembers) reads this array.
+            session.Members.Resolve(session.Players, session.MapId, tUpdatePass);
+            SessionMembers const& members = session.Members;
+
+            // ---- Bind the instance once a member is inside ----
+            // Everything that touches the instance's creatures (population,
+            // kill tracking, phase checks, stray sweeps, revives) runs on
+            // its map thread from UpdateSessionMap once this binding exists.
+            if (session.IsActive())
+            {
+                if (Player* ref = members.First(MEMBER_IN_MAP))
                 {
-                    for (const auto& pd : session.Players)
+                    if (session.InstanceId == 0)
                     {
-                        Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-                        if (p && !p->IsAlive() && p->GetMapId() == session.MapId)
-                        {
-                            p->RemoveFlag(PLAYER_FIELD_BYTES, PLAYER_FIELD_BYTE_NO_RELEASE_WINDOW);
-                            p->ResurrectPlayer(1.0f);
-                            p->SpawnCorpseBones();
-                            p->TeleportTo(session.MapId,
-                                session.EntrancePos.GetPositionX(),
-                                session.EntrancePos.GetPositionY(),
-                                session.EntrancePos.GetPositionZ(),
-                                session.EntrancePos.GetOrientation());
-                            ChatHandler(p->GetSession()).SendSysMessage(
-                                "|cFF00FF00[Dungeon Master]|r Revived at entrance. Get back in there!");
-                        }
+                        Map* m = ref->GetMap();
+                        if (m && m->IsDungeon())
+                            session.InstanceId = m->ToInstanceMap()->GetInstanceId();
                     }
+                    if (session.InstanceId != 0
+                        && _instanceToSession.emplace(session.InstanceId, session.SessionId).second)
+                        _mapSessionsDirty = true;
                 }
             }
 
@@ -3578,10 +3963,7 @@ void DungeonMasterMgr::Update(uint32 diff)
                 {
                     session.State = SessionState::Failed;
                     toEnd.emplace_back(sid, false);
-                    for (const auto& pd : session.Players)
-                        if (Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid))
-                            ChatHandler(p->GetSession()).SendSysMessage(
-                                "|cFFFF0000[Dungeon Master]|r Time's up! Challenge failed.");
+                    GetMessagePacket(DMMessage::TimeUp).SendToMembers(members);
                     continue;
                 }
             }
@@ -3607,10 +3989,7 @@ void DungeonMasterMgr::Update(uint32 diff)
                             snprintf(cbuf, sizeof(cbuf),
                                 "|cFF00FFFF[Roguelike]|r Next dungeon in |cFFFFFFFF%u|r second%s...",
                                 remaining, remaining != 1 ? "s" : "");
-                            for (const auto& pd3 : session.Players)
-                                if (Player* p3 = ObjectAccessor::FindPlayer(pd3.PlayerGuid))
-                                    if (p3->GetSession())
-                                        ChatHandler(p3->GetSession()).SendSysMessage(cbuf);
+                            DMChatPacket(cbuf).SendToMembers(members);
                             break;
                         }
                     }
@@ -3629,9 +4008,12 @@ void DungeonMasterMgr::Update(uint32 diff)
             // ---- Failed cleanup ----
             if (session.State == SessionState::Failed)
             {
-                // Roguelike sessions: wipe is handled by RoguelikeMgr::OnPartyWipe
+                // Roguelike wipes (flagged by HandlePlayerDeath) end the run
                 if (session.RoguelikeRunId != 0)
+                {
+                    roguelikeWiped.push_back(session.RoguelikeRunId);
                     continue;
+                }
 
                 if (session.EndTime == 0)
                     session.EndTime = GameTime::GetGameTime().count();
@@ -3641,24 +4023,28 @@ void DungeonMasterMgr::Update(uint32 diff)
                     continue;
                 }
             }
+        }
+        tUpdatePass = 0;
 
-            // ---- Abandoned detection ----
-            if (session.IsActive()
-                && (GameTime::GetGameTime().count() - session.StartTime) >= 15)
+        // ---- Abandon deadlines ----
+        // Sessions left empty inside the grace period; everything else
+        // is decided on the transition in ProcessMemberEvents.
+        for (size_t i = 0; i < _abandonWatch.size();)
+        {
+            auto it = _activeSessions.find(_abandonWatch[i]);
+            bool keep = it != _activeSessions.end() && it->second.IsActive()
+                && !it->second.AnyMemberIn(MEMBER_IN_MAP);
+            if (keep && CheckAbandoned(it->second))
             {
-                bool anyone = false;
-                for (const auto& pd : session.Players)
-                {
-                    Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-                    if (p && p->GetMapId() == session.MapId) { anyone = true; break; }
-                }
-                if (!anyone)
-                {
-                    LOG_INFO("module", "DungeonMaster: Session {} abandoned — no players on map {} after grace period",
-                        sid, session.MapId);
-                    session.State = SessionState::Abandoned;
-                    toEnd.emplace_back(sid, false);
-                }
+                toEnd.emplace_back(it->first, false);
+                keep = false;
+            }
+            if (keep)
+                ++i;
+            else
+            {
+                _abandonWatch[i] = _abandonWatch.back();
+                _abandonWatch.pop_back();
             }
         }
     } // release lock
@@ -3669,10 +4055,13 @@ void DungeonMasterMgr::Update(uint32 diff)
     // Process roguelike completions outside session lock
     for (const auto& [runId, sessId] : roguelikeCompleted)
         sRoguelikeMgr->OnDungeonCompleted(runId, sessId);
+    for (uint32 runId : roguelikeWiped)
+        sRoguelikeMgr->OnPartyWipe(runId);
 
+    RefreshMapSessions();
 
     {
-        std::lock_guard<std::mutex> lock(_cooldownMutex);
+        DMLockGuard lock(_cooldownMutex);
         time_t now = GameTime::GetGameTime().count();
         for (auto it = _cooldowns.begin(); it != _cooldowns.end(); )
             (now >= static_cast<time_t>(it->second)) ? it = _cooldowns.erase(it) : ++it;
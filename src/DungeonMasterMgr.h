@@ -8,7 +8,9 @@
 
 #include "DMTypes.h"
 #include "DMConfig.h"
-#include <mutex>
+#include "DMMutex.h"
+#include "DatabaseEnv.h"
+#include <atomic>
 #include <map>
 #include <unordered_map>
 
@@ -50,8 +52,13 @@ public:
     void HandleBossDeath(Session* session);
     void OnCreatureDeathHook(Creature* creature);
 
+    // Member state transitions from PlayerScript hooks. Safe from any
+    // thread; applied (and acted on) at the start of the next Update.
+    void QueueMemberEvent(Player* player, MemberEvent event);
+
     // Dungeon population
     void ClearDungeonCreatures(InstanceMap* map);
+    void OnInstanceDestroyed(uint32 instanceId);
     void OpenAllDoors(InstanceMap* map);
     void PopulateDungeon(Session* session, InstanceMap* map);
 
@@ -68,15 +75,44 @@ public:
     // Stats & leaderboard
     PlayerStats GetPlayerStats(ObjectGuid guid) const;
     void        LoadAllPlayerStats();
-    void        SavePlayerStats(uint32 guidLow);
-    void        UpdatePlayerStatsFromSession(const Session& session, bool success);
-    void        SaveLeaderboardEntry(const Session& session);
+    void        SavePlayerStats(uint32 guidLow, CharacterDatabaseTransaction trans);
+    void        UpdatePlayerStatsFromSession(const Session& session, bool success,
+                                             CharacterDatabaseTransaction trans);
+    void        SaveLeaderboardEntry(const Session& session, CharacterDatabaseTransaction trans);
     std::vector<LeaderboardEntry> GetLeaderboard(uint32 mapId, uint32 difficultyId, uint32 limit = 10) const;
     std::vector<LeaderboardEntry> GetOverallLeaderboard(uint32 limit = 10) const;
 
     void Update(uint32 diff);
 
+    // Per-session supervision (population, kill credit, boss phases,
+    // stray sweep) on the instance's own map update thread.
+    void UpdateSessionMap(InstanceMap* map, uint32 diff);
+
+    // Combat counters of the session bound to an instance, or null. From
+    // map threads; each remembers its last answer until the index changes.
+    SessionTelemetry* GetSessionTelemetry(uint32 instanceId);
+
+    struct SessionCombatStats
+    {
+        uint32 SessionId = 0;
+        uint32 MapId     = 0;
+        uint64 Stats[size_t(CombatStat::Count)] = {};
+    };
+    // Every active session's counters, copied in one locked pass.
+    std::vector<SessionCombatStats> GetActiveCombatStats() const;
+
     uint32 GetActiveSessionCount() const { return static_cast<uint32>(_activeSessions.size()); }
+    uint32 GetTrackedInstanceCount() const;
+
+    // Share of trash points new populations fill, from the load signals
+    // Update samples: average world tick time and live session creatures
+    // (plus those populated since the last sample).
+    float  GetSpawnDensity()        const;
+    uint32 GetAverageWorldTickMs()  const { return _avgWorldTickMs.load(std::memory_order_relaxed); }
+    uint32 GetLiveCreatureCount()   const
+    {
+        return _liveCreatures.load(std::memory_order_relaxed) + _populatedCreatures.load(std::memory_order_relaxed);
+    }
     bool   CanCreateNewSession()   const;
 
     // Env damage scaling
@@ -93,7 +129,7 @@ public:
                                        const std::vector<ObjectGuid>& playerGuids);
 
 private:
-    std::vector<SpawnPoint> GetSpawnPointsForMap(uint32 mapId);
+    void GetSpawnPointsForMap(uint32 mapId, std::vector<SpawnPoint>& points);
     uint32 SelectCreatureForTheme(const Theme* theme, bool isBoss);
     uint32 SelectDungeonBoss(const Theme* theme);
 
@@ -116,30 +152,120 @@ private:
     void LoadLootPool();
     void CleanupSession(Session& session);
 
-    std::unordered_map<uint32, Session>      _activeSessions;
+    // Session members resolved for this Update pass, or freshly into a
+    // per-thread scratch (valid until the next call on the thread).
+    SessionMembers const& GetMembers(Session const& session);
+
+    using SessionMap = std::unordered_map<uint32, Session>;
+    SessionMap::iterator  AcquireSession(uint32 sessionId);
+    SessionMap::node_type DetachSession(SessionMap::iterator it);  // out of the active set + indexes
+    void                  ReleaseSession(SessionMap::node_type node);
+
+    // Slow half of EndSession / CleanupRoguelikeSession on a detached session.
+    void FinishSession(SessionMap::node_type node, bool success);
+    void FinishRoguelikeSession(SessionMap::node_type node, bool success);
+
+    // Detached sessions whose map thread may still be using them; torn
+    // down by DrainEndingSessions at the start of the next Update.
+    struct EndingSession
+    {
+        SessionMap::node_type Node;
+        bool                  Success   = false;
+        bool                  Roguelike = false;
+    };
+    void DrainEndingSessions();
+
+    // World phase only: republishes _mapSessions if a binding changed,
+    // then recycles the sessions released since the last call.
+    void RefreshMapSessions();
+
+    // Player stats + leaderboard for a detached session; no lock needed.
+    void SaveSessionResults(const Session& session, bool success, bool withLeaderboard = true);
+    void SaveSessionTelemetry(const Session& session, bool success, CharacterDatabaseTransaction trans);
+
+    // Session bound to the instance, from the map-thread index.
+    Session* FindMapSession(uint32 instanceId);
+
+    struct QueuedMemberEvent
+    {
+        ObjectGuid  Guid;
+        uint32      MapId = 0;
+        uint8       State = 0;      // live MemberState at the hook (no IN_MAP)
+        MemberEvent Event = MemberEvent::Login;
+    };
+
+    // Member transitions: applied every world tick, then rez on the
+    // out-of-combat edge and abandon when nobody is left on the map.
+    // Callers below hold _sessionMutex.
+    void ProcessMemberEvents();
+    void ApplyMemberEvent(Session& session, PlayerSessionData& pd, QueuedMemberEvent const& ev);
+    bool CheckAbandoned(Session& session);
+
+    // Posted to the session's map thread by ProcessMemberEvents.
+    void ReviveDeadMembers(Session& session);
+
+    // Runs the command on the session's map thread before its next
+    // UpdateSessionMap pass. Caller holds _sessionMutex.
+    void PostToSessionMap(Session& session, SessionCommand command);
+    void PollCreatureDeaths(Session& session, InstanceMap* map);
+    void TrackCorpse(Session& session, uint32 creatureIdx, Creature* creature);
+    void CleanupCorpses(Session& session, InstanceMap* map);
+    void ResolvePhaseChecks(Session& session, InstanceMap* map, Player* ref);
+    void SweepStrayCreatures(Session& session, InstanceMap* map);
+
+    void RecordCreatureSpawn(const Session& session, Creature* c, uint32 creatureIdx, uint32 instanceId);
+    void RecordSessionEnd(uint32 sessionId, uint32 instanceId, bool success);
+
+    SessionMap                               _activeSessions;
+    std::vector<SessionMap::node_type>       _sessionPool;   // ended sessions, capacity kept
+    std::vector<SessionMap::node_type>       _retiredSessions;  // ended, maybe still in _mapSessions
+    std::vector<EndingSession>               _endingSessions;   // _sessionMutex
     std::unordered_map<uint32, uint32>       _instanceToSession;
+    // Copy of the instance index for map threads: written by
+    // RefreshMapSessions in the world phase, read unlocked in the map phase.
+    std::unordered_map<uint32, Session*>     _mapSessions;
+    uint64 _mapSessionsGen   = 0;         // bumped by each rebuild
+    bool   _mapSessionsDirty = false;     // _sessionMutex
     std::unordered_map<ObjectGuid, uint32>   _playerToSession;
     uint32 _nextSessionId = 1;
-    mutable std::mutex _sessionMutex;
+    uint64 _updatePasses  = 0;
+    std::vector<uint32>                      _abandonWatch;  // empty sessions inside the grace period
+    mutable DMMutex _sessionMutex{ "_sessionMutex" };
+
+    std::vector<QueuedMemberEvent>           _memberEvents;
+    std::vector<QueuedMemberEvent>           _memberEventsDrain;   // Update only
+    mutable DMMutex _memberEventMutex{ "_memberEventMutex" };
 
     std::unordered_map<ObjectGuid, uint64>   _cooldowns;
-    mutable std::mutex _cooldownMutex;
+    mutable DMMutex _cooldownMutex{ "_cooldownMutex" };
 
     std::unordered_map<uint32, PlayerStats>  _playerStats;
-    mutable std::mutex _statsMutex;
+    mutable DMMutex _statsMutex{ "_statsMutex" };
 
     std::unordered_map<uint32, std::vector<CreaturePoolEntry>> _creaturesByType;
     std::unordered_map<uint32, std::vector<CreaturePoolEntry>> _bossCreatures;
     std::unordered_map<uint32, std::vector<CreaturePoolEntry>> _dungeonBossPool;
 
     std::map<std::pair<uint8,uint8>, ClassLevelStatEntry> _classLevelStats;
+    // Spawned creature GUIDs per instance, dropped when the instance is
+    // destroyed. Never more than MAX_TRACKED_INSTANCES entries: past that,
+    // instances no session owns any more are forgotten first.
     std::unordered_map<uint32, std::vector<ObjectGuid>> _instanceCreatureGuids;
+    // _sessionMutex held; the reference is only good while it stays held.
+    std::vector<ObjectGuid>& TrackInstanceCreatures(uint32 instanceId);
 
     std::vector<RewardItem> _rewardItems;
     std::vector<LootPoolItem> _lootPool;
 
     uint32 _updateTimer = 0;
+    std::atomic<uint32> _avgWorldTickMs{ 0 };   // written by Update only
+    std::atomic<uint32> _liveCreatures{ 0 };       // Update's 1s sample, _sessionMutex held
+    std::atomic<uint32> _populatedCreatures{ 0 };  // spawned by populates since that sample
     static constexpr uint32 UPDATE_INTERVAL = 1000;
+    static constexpr uint64 ABANDON_GRACE   = 15;   // seconds from StartTime
+    static constexpr size_t MAX_TRACKED_INSTANCES = 512;
+    static constexpr float  ELITE_KILL_XP_MULT    = 2.0f;
+    static constexpr float  BOSS_KILL_XP_MULT     = 10.0f;
 };
 
 } // namespace DungeonMaster
@@ -5,7 +5,11 @@
 
 #include "RoguelikeMgr.h"
 #include "DungeonMasterMgr.h"
+#include "DMArena.h"
+#include "DMBroadcast.h"
 #include "DMConfig.h"
+#include "DMTrace.h"
+#include "DMRoguelikeMath.h"
 #include "Player.h"
 #include "Group.h"
 #include "Creature.h"
@@ -56,60 +60,16 @@ void RoguelikeMgr::BuildAffixPool()
 {
     _affixDefs.clear();
 
-    // Fortified — trash mobs are significantly harder
+    for (const auto& src : Core::AFFIX_SCALING)
     {
         AffixDef a;
-        a.Id           = AFFIX_FORTIFIED;
-        a.Name         = "Fortified";
-        a.TrashHpMult  = 1.30f;
-        a.TrashDmgMult = 1.15f;
-        a.BossHpMult   = 1.0f;
-        a.BossDmgMult  = 1.0f;
-        _affixDefs.push_back(a);
-    }
-    // Tyrannical — bosses are significantly harder
-    {
-        AffixDef a;
-        a.Id           = AFFIX_TYRANNICAL;
-        a.Name         = "Tyrannical";
-        a.TrashHpMult  = 1.0f;
-        a.TrashDmgMult = 1.0f;
-        a.BossHpMult   = 1.40f;
-        a.BossDmgMult  = 1.20f;
-        _affixDefs.push_back(a);
-    }
-    // Raging — everything hits harder
-    {
-        AffixDef a;
-        a.Id           = AFFIX_RAGING;
-        a.Name         = "Raging";
-        a.TrashHpMult  = 1.0f;
-        a.TrashDmgMult = 1.25f;
-        a.BossHpMult   = 1.0f;
-        a.BossDmgMult  = 1.25f;
-        _affixDefs.push_back(a);
-    }
-    // Bolstering — everything has more health
-    {
-        AffixDef a;
-        a.Id           = AFFIX_BOLSTERING;
-        a.Name         = "Bolstering";
-        a.TrashHpMult  = 1.20f;
-        a.TrashDmgMult = 1.0f;
-        a.BossHpMult   = 1.20f;
-        a.BossDmgMult  = 1.0f;
-        _affixDefs.push_back(a);
-    }
-    // Savage — more elites, elites are nastier
-    {
-        AffixDef a;
-        a.Id              = AFFIX_SAVAGE;
-        a.Name            = "Savage";
-        a.TrashHpMult     = 1.0f;
-        a.TrashDmgMult    = 1.10f;
-        a.BossHpMult      = 1.0f;
-        a.BossDmgMult     = 1.0f;
-        a.EliteChanceMult = 2.0f;
+        a.Id              = static_cast<RoguelikeAffix>(src.Id);
+        a.Name            = src.Name;
+        a.TrashHpMult     = src.TrashHpMult;
+        a.TrashDmgMult    = src.TrashDmgMult;
+        a.BossHpMult      = src.BossHpMult;
+        a.BossDmgMult     = src.BossDmgMult;
+        a.EliteChanceMult = src.EliteChanceMult;
         _affixDefs.push_back(a);
     }
 }
@@ -167,7 +127,7 @@ bool RoguelikeMgr::StartRun(Player* leader, uint32 difficultyId, uint32 themeId,
     // Build the run
     RoguelikeRun run;
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         run.RunId          = _nextRunId++;
     }
     run.LeaderGuid     = leader->GetGUID();
@@ -272,7 +232,7 @@ bool RoguelikeMgr::StartRun(Player* leader, uint32 difficultyId, uint32 themeId,
 
     // Register the run
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         _activeRuns[run.RunId] = run;
         _sessionToRun[run.CurrentSessionId] = run.RunId;
         for (const auto& pd : run.Players)
@@ -288,9 +248,7 @@ bool RoguelikeMgr::StartRun(Player* leader, uint32 difficultyId, uint32 themeId,
         leader->GetName().c_str(),
         theme ? theme->Name.c_str() : "Random");
 
-    for (const auto& pd : run.Players)
-        if (Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid))
-            ChatHandler(p->GetSession()).SendSysMessage(buf);
+    DMChatPacket(buf).SendToMembers(run.Players);
 
     // Announce active affixes if any are present at tier 1
     if (!run.ActiveAffixes.empty())
@@ -302,9 +260,7 @@ bool RoguelikeMgr::StartRun(Player* leader, uint32 difficultyId, uint32 themeId,
             snprintf(affixBuf, sizeof(affixBuf),
                 "|cFF00FFFF[Roguelike]|r Active affixes: %s",
                 affixNames.c_str());
-            for (const auto& pd : run.Players)
-                if (Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid))
-                    ChatHandler(p->GetSession()).SendSysMessage(affixBuf);
+            DMChatPacket(affixBuf).SendToMembers(run.Players);
         }
     }
 
@@ -318,9 +274,11 @@ bool RoguelikeMgr::StartRun(Player* leader, uint32 difficultyId, uint32 themeId,
 
 void RoguelikeMgr::OnDungeonCompleted(uint32 runId, uint32 sessionId)
 {
+    DMTraceSpan span("Roguelike.FloorCleared", sessionId);
+
     RoguelikeRun* run = nullptr;
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         auto it = _activeRuns.find(runId);
         if (it == _activeRuns.end()) return;
         run = &it->second;
@@ -366,7 +324,7 @@ void RoguelikeMgr::OnDungeonCompleted(uint32 runId, uint32 sessionId)
 
     // Remove old session mapping
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         _sessionToRun.erase(sessionId);
     }
 
@@ -430,7 +388,7 @@ void RoguelikeMgr::OnPartyWipe(uint32 runId)
 {
     RoguelikeRun* run = nullptr;
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         auto it = _activeRuns.find(runId);
         if (it == _activeRuns.end()) return;
         run = &it->second;
@@ -510,7 +468,7 @@ void RoguelikeMgr::OnPartyWipe(uint32 runId)
 
     // Clean up run
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         _sessionToRun.erase(savedSessId);
         for (const auto& pd : run->Players)
             _playerToRun.erase(pd.PlayerGuid);
@@ -527,7 +485,7 @@ void RoguelikeMgr::EndRun(uint32 runId, bool announceResults)
 {
     RoguelikeRun* run = nullptr;
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         auto it = _activeRuns.find(runId);
         if (it == _activeRuns.end()) return;
         run = &it->second;
@@ -611,7 +569,7 @@ void RoguelikeMgr::EndRun(uint32 runId, bool announceResults)
 
     // Erase run
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         _sessionToRun.erase(savedSessId);
         for (const auto& pd : run->Players)
             _playerToRun.erase(pd.PlayerGuid);
@@ -632,7 +590,7 @@ void RoguelikeMgr::QuitRun(ObjectGuid playerGuid)
 {
     uint32 runId = 0;
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         auto it = _playerToRun.find(playerGuid);
         if (it != _playerToRun.end())
             runId = it->second;
@@ -641,18 +599,41 @@ void RoguelikeMgr::QuitRun(ObjectGuid playerGuid)
         AbandonRun(runId);
 }
 
+// Login / logout hook. The run is abandoned on the next Update once
+// its last member has gone offline.
+void RoguelikeMgr::SetPlayerOnline(ObjectGuid playerGuid, bool online)
+{
+    DMLockGuard lock(_runMutex);
+    auto it = _playerToRun.find(playerGuid);
+    if (it == _playerToRun.end())
+        return;
+    auto rit = _activeRuns.find(it->second);
+    if (rit == _activeRuns.end())
+        return;
+
+    RoguelikeRun& run = rit->second;
+    RoguelikePlayerData* pd = run.GetPlayerData(playerGuid);
+    if (!pd)
+        return;
+
+    pd->Online = online;
+    if (!online && !run.AnyOnline()
+        && std::find(_offlineRuns.begin(), _offlineRuns.end(), run.RunId) == _offlineRuns.end())
+        _offlineRuns.push_back(run.RunId);
+}
+
 // QUERIES
 
 RoguelikeRun* RoguelikeMgr::GetRun(uint32 runId)
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     return it != _activeRuns.end() ? &it->second : nullptr;
 }
 
 RoguelikeRun* RoguelikeMgr::GetRunBySession(uint32 sessionId)
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _sessionToRun.find(sessionId);
     if (it != _sessionToRun.end())
     {
@@ -664,7 +645,7 @@ RoguelikeRun* RoguelikeMgr::GetRunBySession(uint32 sessionId)
 
 RoguelikeRun* RoguelikeMgr::GetRunByPlayer(ObjectGuid guid)
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _playerToRun.find(guid);
     if (it != _playerToRun.end())
     {
@@ -676,20 +657,20 @@ RoguelikeRun* RoguelikeMgr::GetRunByPlayer(ObjectGuid guid)
 
 uint32 RoguelikeMgr::GetRunIdBySession(uint32 sessionId) const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _sessionToRun.find(sessionId);
     return it != _sessionToRun.end() ? it->second : 0;
 }
 
 bool RoguelikeMgr::IsPlayerInRun(ObjectGuid guid) const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     return _playerToRun.count(guid) > 0;
 }
 
 uint32 RoguelikeMgr::GetActiveRunCount() const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     return static_cast<uint32>(_activeRuns.size());
 }
 
@@ -697,64 +678,31 @@ uint32 RoguelikeMgr::GetActiveRunCount() const
 
 float RoguelikeMgr::GetTierHealthMultiplier(uint32 runId) const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     if (it == _activeRuns.end()) return 1.0f;
 
-    uint32 tier = it->second.CurrentTier;
-    if (tier <= 1) return 1.0f;
-
-    float baseScale = sDMConfig->GetRoguelikeHpScaling();
-    uint32 expThresh = sDMConfig->GetRoguelikeExpThreshold();
-    float  expFactor = sDMConfig->GetRoguelikeExpFactor();
-
-    if (tier <= expThresh)
-        return 1.0f + (tier - 1) * baseScale;
-
-    // Exponential scaling past threshold
-    float linearPart = (expThresh - 1) * baseScale;
-    float expPart    = 0.0f;
-    for (uint32 t = expThresh; t < tier; ++t)
-        expPart += baseScale * std::pow(expFactor, static_cast<float>(t - expThresh + 1));
-
-    return 1.0f + linearPart + expPart;
+    return Core::TierScalingMultiplier(it->second.CurrentTier, sDMConfig->GetRoguelikeHpScaling(),
+        sDMConfig->GetRoguelikeExpThreshold(), sDMConfig->GetRoguelikeExpFactor());
 }
 
 float RoguelikeMgr::GetTierDamageMultiplier(uint32 runId) const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     if (it == _activeRuns.end()) return 1.0f;
 
-    uint32 tier = it->second.CurrentTier;
-    if (tier <= 1) return 1.0f;
-
-    float baseScale = sDMConfig->GetRoguelikeDmgScaling();
-    uint32 expThresh = sDMConfig->GetRoguelikeExpThreshold();
-    float  expFactor = sDMConfig->GetRoguelikeExpFactor();
-
-    if (tier <= expThresh)
-        return 1.0f + (tier - 1) * baseScale;
-
-    float linearPart = (expThresh - 1) * baseScale;
-    float expPart    = 0.0f;
-    for (uint32 t = expThresh; t < tier; ++t)
-        expPart += baseScale * std::pow(expFactor, static_cast<float>(t - expThresh + 1));
-
-    return 1.0f + linearPart + expPart;
+    return Core::TierScalingMultiplier(it->second.CurrentTier, sDMConfig->GetRoguelikeDmgScaling(),
+        sDMConfig->GetRoguelikeExpThreshold(), sDMConfig->GetRoguelikeExpFactor());
 }
 
 float RoguelikeMgr::GetTierArmorMultiplier(uint32 runId) const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     if (it == _activeRuns.end()) return 1.0f;
 
-    uint32 tier = it->second.CurrentTier;
-    if (tier <= 1) return 1.0f;
-
-    float baseScale = sDMConfig->GetRoguelikeArmorScaling();
-    return 1.0f + (tier - 1) * baseScale;   // Armor scales linearly only
+    return Core::TierArmorMultiplier(it->second.CurrentTier, sDMConfig->GetRoguelikeArmorScaling());
 }
 
 void RoguelikeMgr::GetAffixMultipliers(
@@ -765,7 +713,7 @@ void RoguelikeMgr::GetAffixMultipliers(
     outDmgMult  = 1.0f;
     outEliteChanceMult = 1.0f;
 
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     if (it == _activeRuns.end()) return;
 
@@ -794,14 +742,14 @@ void RoguelikeMgr::GetAffixMultipliers(
 
 bool RoguelikeMgr::HasActiveAffixes(uint32 runId) const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     return it != _activeRuns.end() && !it->second.ActiveAffixes.empty();
 }
 
 std::string RoguelikeMgr::GetActiveAffixNames(uint32 runId) const
 {
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     if (it == _activeRuns.end()) return "";
 
@@ -849,7 +797,7 @@ void RoguelikeMgr::IncrementBuffStacks(uint32 runId)
 {
     RoguelikeRun* run = nullptr;
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         auto it = _activeRuns.find(runId);
         if (it == _activeRuns.end()) return;
         run = &it->second;
@@ -877,7 +825,7 @@ void RoguelikeMgr::ApplyBuffStacks(Player* player, uint32 runId)
 {
     if (!player || !player->IsInWorld()) return;
 
-    std::lock_guard<std::mutex> lock(_runMutex);
+    DMLockGuard lock(_runMutex);
     auto it = _activeRuns.find(runId);
     if (it == _activeRuns.end()) return;
 
@@ -897,20 +845,13 @@ void RoguelikeMgr::SelectAffixesForTier(RoguelikeRun& run)
 {
     run.ActiveAffixes.clear();
 
-    uint32 affixStart  = sDMConfig->GetRoguelikeAffixStartTier();
-    uint32 secondAffix = sDMConfig->GetRoguelikeSecondAffixTier();
-    uint32 thirdAffix  = sDMConfig->GetRoguelikeThirdAffixTier();
+    uint32 numAffixes = Core::AffixCountForTier(run.CurrentTier,
+        sDMConfig->GetRoguelikeAffixStartTier(), sDMConfig->GetRoguelikeSecondAffixTier(),
+        sDMConfig->GetRoguelikeThirdAffixTier());
 
-    if (run.CurrentTier < affixStart || _affixDefs.empty())
+    if (numAffixes == 0 || _affixDefs.empty())
         return;
 
-    uint32 numAffixes = 1;
-    if (run.CurrentTier >= thirdAffix)
-        numAffixes = 3;
-    else if (run.CurrentTier >= secondAffix)
-        numAffixes = 2;
-
-
     std::vector<RoguelikeAffix> pool;
     for (const auto& def : _affixDefs)
         if (def.Id != AFFIX_NONE)
@@ -930,24 +871,27 @@ uint32 RoguelikeMgr::SelectRandomDungeon(const RoguelikeRun& run) const
     if (!diff)
     {
         // Fallback: use broadest range
-        auto dgs = sDMConfig->GetDungeonsForLevel(1, 80);
+        DungeonSpan dgs = sDMConfig->GetAvailableDungeons();
         if (dgs.empty()) return 0;
         return dgs[RandInt<size_t>(0, dgs.size() - 1)]->MapId;
     }
 
-    auto dgs = sDMConfig->GetDungeonsForLevel(diff->MinLevel, diff->MaxLevel);
+    DungeonSpan dgs = sDMConfig->GetDungeonsForDifficulty(diff->Id);
     if (dgs.empty()) return 0;
 
-    // Try to avoid repeating the same dungeon
+    // Try to avoid repeating the same dungeon: pick among the others
+    // (the span holds each map once) without building a filtered copy
     if (dgs.size() > 1 && run.PreviousMapId != 0)
     {
-        std::vector<const DungeonInfo*> filtered;
-        for (const auto* d : dgs)
-            if (d->MapId != run.PreviousMapId)
-                filtered.push_back(d);
+        size_t prev = dgs.size();
+        for (size_t i = 0; i < dgs.size(); ++i)
+            if (dgs[i]->MapId == run.PreviousMapId) { prev = i; break; }
 
-        if (!filtered.empty())
-            return filtered[RandInt<size_t>(0, filtered.size() - 1)]->MapId;
+        if (prev != dgs.size())
+        {
+            size_t pick = RandInt<size_t>(0, dgs.size() - 2);
+            return dgs[pick < prev ? pick : pick + 1]->MapId;
+        }
     }
 
     return dgs[RandInt<size_t>(0, dgs.size() - 1)]->MapId;
@@ -957,6 +901,8 @@ uint32 RoguelikeMgr::SelectRandomDungeon(const RoguelikeRun& run) const
 
 bool RoguelikeMgr::TransitionToNextDungeon(RoguelikeRun& run)
 {
+    DMTraceSpan span("Roguelike.Transition");
+
     uint32 mapId = SelectRandomDungeon(run);
     if (!mapId)
     {
@@ -1006,12 +952,13 @@ bool RoguelikeMgr::TransitionToNextDungeon(RoguelikeRun& run)
     }
 
     // Tag as roguelike
+    span.SetSession(session->SessionId);
     session->RoguelikeRunId = run.RunId;
     run.CurrentSessionId    = session->SessionId;
 
     // Register session mapping
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
         _sessionToRun[session->SessionId] = run.RunId;
     }
 
@@ -1021,7 +968,7 @@ bool RoguelikeMgr::TransitionToNextDungeon(RoguelikeRun& run)
         LOG_ERROR("module", "RoguelikeMgr: StartDungeon failed for run {}", run.RunId);
         sDungeonMasterMgr->CleanupRoguelikeSession(session->SessionId, false);
         {
-            std::lock_guard<std::mutex> lock2(_runMutex);
+            DMLockGuard lock2(_runMutex);
             _sessionToRun.erase(session->SessionId);
         }
         return false;
@@ -1032,7 +979,7 @@ bool RoguelikeMgr::TransitionToNextDungeon(RoguelikeRun& run)
         LOG_ERROR("module", "RoguelikeMgr: Teleport failed for run {}", run.RunId);
         sDungeonMasterMgr->CleanupRoguelikeSession(session->SessionId, false);
         {
-            std::lock_guard<std::mutex> lock2(_runMutex);
+            DMLockGuard lock2(_runMutex);
             _sessionToRun.erase(session->SessionId);
         }
         return false;
@@ -1084,10 +1031,7 @@ void RoguelikeMgr::TeleportRunPlayersOut(RoguelikeRun& run)
 
 void RoguelikeMgr::AnnounceToRun(const RoguelikeRun& run, const char* msg)
 {
-    for (const auto& pd : run.Players)
-        if (Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid))
-            if (p->GetSession())
-                ChatHandler(p->GetSession()).SendSysMessage(msg);
+    DMChatPacket(msg).SendToMembers(run.Players);
 }
 
 void RoguelikeMgr::AnnounceCountdown(const RoguelikeRun& run, uint32 remainingSec)
@@ -1107,10 +1051,19 @@ void RoguelikeMgr::Update(uint32 diff)
         return;
     _updateTimer = 0;
 
-    std::vector<uint32> toAbandon;
+    auto toAbandon = sDMTickArena.NewVector<uint32>();
 
     {
-        std::lock_guard<std::mutex> lock(_runMutex);
+        DMLockGuard lock(_runMutex);
+
+        // ---- Abandoned: last member logged out (see SetPlayerOnline) ----
+        for (uint32 rid : _offlineRuns)
+        {
+            auto it = _activeRuns.find(rid);
+            if (it != _activeRuns.end() && !it->second.AnyOnline())
+                toAbandon.push_back(rid);
+        }
+        _offlineRuns.clear();
 
         for (auto& [rid, run] : _activeRuns)
         {
@@ -1124,31 +1077,13 @@ void RoguelikeMgr::Update(uint32 diff)
                 run.TransitionStartTime = 0;
             }
 
-            // ---- Abandoned detection: all players offline ----
-            bool anyOnline = false;
-            for (const auto& pd : run.Players)
-            {
-                Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-                if (p && p->IsInWorld()) { anyOnline = true; break; }
-            }
-
-            if (!anyOnline)
-            {
-                toAbandon.push_back(rid);
-                continue;
-            }
-
             // ---- Re-apply buff aura after death ----
             if (run.State == RoguelikeRunState::Active && run.BuffStacks > 0)
             {
-                for (const auto& pd : run.Players)
-                {
-                    Player* p = ObjectAccessor::FindPlayer(pd.PlayerGuid);
-                    if (!p || !p->IsInWorld() || !p->IsAlive()) continue;
-
-                    if (!p->HasAura(BUFF_SPELL_ID))
-                        ApplyBuffAura(p, run.BuffStacks);
-                }
+                _runMembers.Resolve(run.Players, 0);
+                for (auto const& m : _runMembers)
+                    if (m.Is(MEMBER_IN_WORLD | MEMBER_ALIVE) && !m.Ptr->HasAura(BUFF_SPELL_ID))
+                        ApplyBuffAura(m.Ptr, run.BuffStacks);
             }
         }
     }
@@ -1249,7 +1184,7 @@ std::vector<RoguelikeLeaderboardEntry> RoguelikeMgr::GetRoguelikeLeaderboard(
 
 void RoguelikeMgr::LoadAllRoguelikePlayerStats()
 {
-    std::lock_guard<std::mutex> lock(_rlStatsMutex);
+    DMLockGuard lock(_rlStatsMutex);
     _roguelikeStats.clear();
 
     QueryResult result = CharacterDatabase.Query(
@@ -1289,7 +1224,7 @@ void RoguelikeMgr::LoadAllRoguelikePlayerStats()
 
 RoguelikePlayerStats RoguelikeMgr::GetRoguelikePlayerStats(ObjectGuid guid) const
 {
-    std::lock_guard<std::mutex> lock(_rlStatsMutex);
+    DMLockGuard lock(_rlStatsMutex);
     uint32 guidLow = guid.GetCounter();
     auto it = _roguelikeStats.find(guidLow);
     if (it != _roguelikeStats.end())
@@ -1308,7 +1243,7 @@ void RoguelikeMgr::UpdateRoguelikePlayerStats(const RoguelikeRun& run)
         uint32 guidLow = pd.PlayerGuid.GetCounter();
 
         {
-            std::lock_guard<std::mutex> lock(_rlStatsMutex);
+            DMLockGuard lock(_rlStatsMutex);
             auto& ps = _roguelikeStats[guidLow];
             ps.TotalRuns++;
             if (run.CurrentTier > ps.HighestTier)
@@ -1326,7 +1261,7 @@ void RoguelikeMgr::UpdateRoguelikePlayerStats(const RoguelikeRun& run)
         // Persist
         RoguelikePlayerStats ps;
         {
-            std::lock_guard<std::mutex> lock(_rlStatsMutex);
+            DMLockGuard lock(_rlStatsMutex);
             ps = _roguelikeStats[guidLow];
         }
 
@@ -7,7 +7,8 @@
 #define ROGUELIKE_MGR_H
 
 #include "RoguelikeTypes.h"
-#include <mutex>
+#include "DMTypes.h"
+#include "DMMutex.h"
 #include <unordered_map>
 
 class Player;
@@ -33,6 +34,7 @@ public:
     void EndRun(uint32 runId, bool announceResults);
     void AbandonRun(uint32 runId);
     void QuitRun(ObjectGuid playerGuid);
+    void SetPlayerOnline(ObjectGuid playerGuid, bool online);
 
     // Queries
     RoguelikeRun* GetRun(uint32 runId);
@@ -56,7 +58,7 @@ public:
     void RemoveBuffStacks(Player* player, uint32 runId);
     void ApplyBuffAura(Player* player, uint32 stacks);
 
-    static constexpr float BUFF_PCT_PER_STACK = 10.0f;
+    static constexpr float BUFF_PCT_PER_STACK = ROGUELIKE_BUFF_PCT_PER_STACK;
 
     void Update(uint32 diff);
 
@@ -85,12 +87,14 @@ private:
     std::unordered_map<uint32, uint32>          _sessionToRun;  // sessionId -> runId
     std::unordered_map<ObjectGuid, uint32>      _playerToRun;   // guid -> runId
     uint32 _nextRunId = 1;
-    mutable std::mutex _runMutex;
+    mutable DMMutex _runMutex{ "_runMutex" };
+    SessionMembers _runMembers;     // Update scratch, guarded by _runMutex
+    std::vector<uint32> _offlineRuns;   // every member logged out, guarded by _runMutex
 
     std::vector<AffixDef> _affixDefs;
 
     std::unordered_map<uint32, RoguelikePlayerStats> _roguelikeStats;  // guidLow -> stats
-    mutable std::mutex _rlStatsMutex;
+    mutable DMMutex _rlStatsMutex{ "_rlStatsMutex" };
 
     uint32 _updateTimer = 0;
     static constexpr uint32 UPDATE_INTERVAL = 1000;
@@ -9,6 +9,7 @@
 #include "Define.h"
 #include "ObjectGuid.h"
 #include "Position.h"
+#include "DMRoguelikeMath.h"
 #include <string>
 #include <vector>
 
@@ -17,7 +18,7 @@ namespace DungeonMaster
 
 constexpr uint32 MAX_ROGUELIKE_BUFFS   = 30;
 constexpr uint32 MAX_ROGUELIKE_AFFIXES = 10;
-constexpr float ROGUELIKE_BUFF_PCT_PER_STACK = 10.0f;
+constexpr float ROGUELIKE_BUFF_PCT_PER_STACK = Core::BUFF_PCT_PER_STACK;
 
 enum class RoguelikeRunState : uint8
 {
@@ -61,6 +62,7 @@ struct RoguelikePlayerData
     ObjectGuid  PlayerGuid;
     Position    OriginalPosition;
     uint32      OriginalMapId = 0;
+    bool        Online        = true;   // login / logout hooks
 };
 
 struct RoguelikeRun
@@ -106,6 +108,13 @@ struct RoguelikeRun
             if (p.PlayerGuid == guid) return &p;
         return nullptr;
     }
+
+    bool AnyOnline() const
+    {
+        for (const auto& p : Players)
+            if (p.Online) return true;
+        return false;
+    }
 };
 
 struct RoguelikePlayerStats
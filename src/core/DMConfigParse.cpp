@@ -0,0 +1,125 @@
+/*
+ * mod-dungeon-master — DMConfigParse.cpp
+ * Config value parsing shared by DMConfig and the offline tools.
+ */
+
+#include "DMConfigParse.h"
+#include <fstream>
+#include <sstream>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+std::vector<std::string> SplitString(std::string const& str, char delim)
+{
+    std::vector<std::string> tokens;
+    std::stringstream ss(str);
+    std::string token;
+    while (std::getline(ss, token, delim))
+    {
+        size_t start = token.find_first_not_of(" \t");
+        size_t end   = token.find_last_not_of(" \t");
+        if (start != std::string::npos && end != std::string::npos)
+            tokens.push_back(token.substr(start, end - start + 1));
+        else if (!token.empty())
+            tokens.push_back(token);
+    }
+    return tokens;
+}
+
+std::string StripQuotes(std::string const& s)
+{
+    std::string out = s;
+    if (!out.empty() && out.front() == '"') out.erase(out.begin());
+    if (!out.empty() && out.back()  == '"') out.pop_back();
+    return out;
+}
+
+bool LoadConfFile(std::string const& path, std::unordered_map<std::string, std::string>& out)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        size_t start = line.find_first_not_of(" \t\r");
+        if (start == std::string::npos || line[start] == '#' || line[start] == '[')
+            continue;
+
+        size_t eq = line.find('=', start);
+        if (eq == std::string::npos || eq == start)
+            continue;
+
+        size_t keyEnd = line.find_last_not_of(" \t", eq - 1);
+        size_t valBeg = line.find_first_not_of(" \t", eq + 1);
+        size_t valEnd = line.find_last_not_of(" \t\r");
+
+        std::string value = (valBeg == std::string::npos || valBeg > valEnd)
+            ? std::string() : line.substr(valBeg, valEnd - valBeg + 1);
+        out[line.substr(start, keyEnd - start + 1)] = value;
+    }
+    return true;
+}
+
+bool ParseDifficultyTier(std::string const& value, uint32_t id, DifficultyTier& out)
+{
+    auto parts = SplitString(StripQuotes(value), ',');
+    if (parts.size() < 7)
+        return false;
+
+    DifficultyTier t;
+    t.Id = id;
+    t.Name = parts[0];
+    try {
+        t.MinLevel         = static_cast<uint8_t>(std::stoi(parts[1]));
+        t.MaxLevel         = static_cast<uint8_t>(std::stoi(parts[2]));
+        t.HealthMultiplier = std::stof(parts[3]);
+        t.DamageMultiplier = std::stof(parts[4]);
+        t.RewardMultiplier = std::stof(parts[5]);
+        t.MobCountMultiplier = std::stof(parts[6]);
+    } catch (...) {
+        return false;
+    }
+
+    out = std::move(t);
+    return true;
+}
+
+bool ParseTheme(std::string const& value, uint32_t id, Theme& out)
+{
+    auto parts = SplitString(StripQuotes(value), ',');
+    if (parts.size() < 2)
+        return false;
+
+    Theme theme;
+    theme.Id   = id;
+    theme.Name = parts[0];
+
+    for (size_t j = 1; j < parts.size(); ++j)
+    {
+        try {
+            theme.CreatureTypes.push_back(
+                static_cast<uint32_t>(std::stoi(parts[j])));
+        } catch (...) { /* skip bad token */ }
+    }
+
+    out = std::move(theme);
+    return true;
+}
+
+void ParseIdList(std::string const& str, std::unordered_set<uint32_t>& outSet)
+{
+    if (str.empty()) return;
+    for (auto const& tok : SplitString(str, ','))
+    {
+        try { outSet.insert(static_cast<uint32_t>(std::stoul(tok))); }
+        catch (...) { /* skip */ }
+    }
+}
+
+} // namespace Core
+} // namespace DungeonMaster
@@ -0,0 +1,60 @@
+/*
+ * mod-dungeon-master — DMConfigParse.h
+ * Parsing of the comma-separated config values (difficulties, themes, id
+ * lists) and the lookups DMConfig serves from the parsed tables.
+ * Standard library only.
+ */
+
+#ifndef DM_CONFIG_PARSE_H
+#define DM_CONFIG_PARSE_H
+
+#include "DMCoreTypes.h"
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+// Splits on delim and trims spaces/tabs from every token.
+std::vector<std::string> SplitString(std::string const& str, char delim);
+
+// Removes one leading and one trailing double quote, if present.
+std::string StripQuotes(std::string const& s);
+
+// Reads "Key = Value" lines of a .conf file into out (later lines win).
+// Comments (#) and blank lines are skipped; surrounding quotes are kept so
+// values parse the same way as ConfigMgr's. False if the file can't be read.
+bool LoadConfFile(std::string const& path, std::unordered_map<std::string, std::string>& out);
+
+// "Name, MinLvl, MaxLvl, HpMult, DmgMult, RewardMult, MobCountMult".
+// Returns false (and leaves out untouched) on a short or malformed entry.
+bool ParseDifficultyTier(std::string const& value, uint32_t id, DifficultyTier& out);
+
+// "Name, CreatureType[, CreatureType...]"; unparsable type tokens are skipped.
+bool ParseTheme(std::string const& value, uint32_t id, Theme& out);
+
+// "1, 2, 3" -> outSet; unparsable tokens are skipped.
+void ParseIdList(std::string const& str, std::unordered_set<uint32_t>& outSet);
+
+inline DifficultyTier const* FindDifficulty(std::vector<DifficultyTier> const& tiers, uint32_t id)
+{
+    for (auto const& d : tiers)
+        if (d.Id == id) return &d;
+    return nullptr;
+}
+
+inline Theme const* FindTheme(std::vector<Theme> const& themes, uint32_t id)
+{
+    for (auto const& t : themes)
+        if (t.Id == id) return &t;
+    return nullptr;
+}
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_CONFIG_PARSE_H
@@ -0,0 +1,91 @@
+/*
+ * mod-dungeon-master — DMCoreTypes.h
+ * Config and pool records used by the pure-logic core (dm_core).
+ * Standard library only; DMTypes.h re-exports these into DungeonMaster.
+ */
+
+#ifndef DM_CORE_TYPES_H
+#define DM_CORE_TYPES_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+struct DifficultyTier
+{
+    uint32_t    Id               = 0;
+    std::string Name;
+    uint8_t     MinLevel         = 1;
+    uint8_t     MaxLevel         = 80;
+    float       HealthMultiplier = 1.0f;
+    float       DamageMultiplier = 1.0f;
+    float       RewardMultiplier = 1.0f;
+    float       MobCountMultiplier = 1.0f;
+
+    bool IsValidForLevel(uint8_t level) const { return level >= MinLevel; }
+    bool IsOnLevelFor(uint8_t level) const { return level >= MinLevel && level <= MaxLevel; }
+};
+
+// Groups creature types for themed spawns; -1 = any type
+struct Theme
+{
+    uint32_t                Id = 0;
+    std::string             Name;
+    std::vector<uint32_t>   CreatureTypes;
+
+    bool IsRandom() const
+    {
+        return CreatureTypes.size() == 1 && CreatureTypes[0] == uint32_t(-1);
+    }
+};
+
+struct CreaturePoolEntry
+{
+    uint32_t Entry    = 0;
+    uint32_t Type     = 0;
+    uint8_t  MinLevel = 1;
+    uint8_t  MaxLevel = 80;
+};
+
+struct RewardItem
+{
+    uint32_t Entry         = 0;
+    uint32_t MinLevel      = 1;
+    uint32_t MaxLevel      = 80;
+    uint16_t ItemLevel     = 0;
+    uint8_t  Quality       = 0;       // 0=Poor .. 4=Epic
+    uint32_t InventoryType = 0;
+    uint32_t Class         = 0;       // 2=Weapon, 4=Armor
+    uint32_t SubClass      = 0;
+    int32_t  AllowableClass = -1;
+};
+
+struct LootPoolItem
+{
+    uint32_t Entry          = 0;
+    uint8_t  MinLevel       = 0;
+    uint16_t ItemLevel      = 0;
+    uint8_t  Quality        = 0;
+    uint8_t  ItemClass      = 0;
+    uint8_t  SubClass       = 0;
+    int32_t  AllowableClass = -1;
+};
+
+// creature_classlevelstats row for one (unit class, level)
+struct ClassLevelStatEntry
+{
+    uint32_t BaseHP      = 1;
+    float    BaseDamage  = 1.0f;
+    uint32_t BaseArmor   = 0;
+    uint32_t AttackPower = 0;
+};
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_CORE_TYPES_H
@@ -0,0 +1,80 @@
+/*
+ * mod-dungeon-master — DMDungeonTable.h
+ * The 5-man instances the module can generate, with their level ranges.
+ * Standard library only; DMConfig filters it by the allow/deny lists.
+ */
+
+#ifndef DM_DUNGEON_TABLE_H
+#define DM_DUNGEON_TABLE_H
+
+#include <cstdint>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+struct DungeonDef
+{
+    uint32_t    Map;
+    char const* Name;
+    uint8_t     MinLevel;
+    uint8_t     MaxLevel;
+};
+
+inline constexpr DungeonDef DUNGEON_TABLE[] =
+{
+    // Classic
+    { 389, "Ragefire Chasm",       13, 20 },
+    {  36, "Deadmines",            15, 25 },
+    {  33, "Shadowfang Keep",      18, 28 },
+    {  34, "The Stockade",         20, 30 },
+    {  43, "Wailing Caverns",      15, 28 },
+    {  48, "Blackfathom Deeps",    20, 32 },
+    {  47, "Razorfen Kraul",       25, 35 },
+    {  90, "Gnomeregan",           25, 38 },
+    { 129, "Razorfen Downs",       35, 45 },
+    { 189, "Scarlet Monastery",    30, 45 },
+    {  70, "Uldaman",              38, 50 },
+    { 209, "Zul'Farrak",           42, 52 },
+    { 349, "Maraudon",             40, 52 },
+    { 109, "Sunken Temple",        45, 55 },
+    { 230, "Blackrock Depths",     48, 60 },
+    { 229, "Blackrock Spire",      52, 60 },
+    { 289, "Scholomance",          55, 60 },
+    { 329, "Stratholme",           55, 60 },
+    // TBC
+    { 543, "Hellfire Ramparts",    58, 70 },
+    { 542, "Blood Furnace",        59, 70 },
+    { 547, "Slave Pens",           60, 70 },
+    { 546, "Underbog",             61, 70 },
+    { 557, "Mana-Tombs",           62, 70 },
+    { 558, "Auchenai Crypts",      63, 70 },
+    { 556, "Sethekk Halls",        65, 70 },
+    { 555, "Shadow Labyrinth",     68, 70 },
+    { 540, "Shattered Halls",      68, 70 },
+    { 553, "Botanica",             68, 70 },
+    { 554, "Mechanar",             68, 70 },
+    { 552, "Arcatraz",             68, 70 },
+    // WotLK
+    { 574, "Utgarde Keep",         68, 80 },
+    { 576, "The Nexus",            69, 80 },
+    { 601, "Azjol-Nerub",          70, 80 },
+    { 619, "Ahn'kahet",            71, 80 },
+    { 600, "Drak'Tharon Keep",     72, 80 },
+    { 608, "Violet Hold",          73, 80 },
+    { 604, "Gundrak",              74, 80 },
+    { 599, "Halls of Stone",       75, 80 },
+    { 602, "Halls of Lightning",   77, 80 },
+    { 578, "The Oculus",           77, 80 },
+    { 575, "Utgarde Pinnacle",     78, 80 },
+    { 595, "Culling of Stratholme",78, 80 },
+    { 632, "Forge of Souls",       79, 80 },
+    { 658, "Pit of Saron",         79, 80 },
+    { 668, "Halls of Reflection",  79, 80 },
+};
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_DUNGEON_TABLE_H
@@ -0,0 +1,89 @@
+/*
+ * mod-dungeon-master — DMHookTrace.h
+ * On-disk format of the hook recorder (.dmhk) shared with tools/dm_replay.
+ * Standard library only.
+ *
+ * Layout: one HookTraceHeader followed by fixed-size HookRecord entries,
+ * little-endian, packed. Readers must check Magic, Version and RecordSize.
+ */
+
+#ifndef DM_HOOK_TRACE_H
+#define DM_HOOK_TRACE_H
+
+#include <cstdint>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+constexpr uint32_t HOOK_TRACE_MAGIC   = 0x4B484D44;   // "DMHK"
+constexpr uint32_t HOOK_TRACE_VERSION = 1;
+
+enum class HookType : uint8_t
+{
+    // dm_unit_script callbacks. Actor = target player, Other = attacker (0 if none),
+    // Amount = incoming damage, Result = damage after scaling, Extra = target max HP.
+    PeriodicDamage = 1,
+    SpellDamage    = 2,
+    MeleeDamage    = 3,
+    // Actor = dying creature, Other = killer.
+    UnitDeath      = 4,
+
+    // Session lifecycle.
+    // SessionStart:  Actor = leader, Amount = effective level, Extra = dungeon max level,
+    //                F0 = solo multiplier, Flags & HOOK_FLAG_SCALE_TO_PARTY.
+    SessionStart   = 10,
+    // PlayerJoin:    Actor = player.
+    PlayerJoin     = 11,
+    // InstanceBind:  InstanceId = instance the session populated.
+    InstanceBind   = 12,
+    // CreatureSpawn: Actor = creature, Amount = entry, Extra = template max level,
+    //                F0 / F1 = classlevelstats base damage at session / template level
+    //                (negative when missing), Flags = HOOK_FLAG_BOSS | ELITE | RARE.
+    CreatureSpawn  = 13,
+    // SessionEnd:    Amount = 1 on success.
+    SessionEnd     = 14,
+};
+
+constexpr uint8_t HOOK_FLAG_BOSS           = 0x01;
+constexpr uint8_t HOOK_FLAG_ELITE          = 0x02;
+constexpr uint8_t HOOK_FLAG_RARE           = 0x04;
+constexpr uint8_t HOOK_FLAG_SCALE_TO_PARTY = 0x01;
+
+#pragma pack(push, 1)
+struct HookTraceHeader
+{
+    uint32_t Magic      = HOOK_TRACE_MAGIC;
+    uint32_t Version    = HOOK_TRACE_VERSION;
+    uint32_t RecordSize = 0;
+    uint32_t Reserved   = 0;
+    uint64_t StartUnixMs = 0;
+};
+
+struct HookRecord
+{
+    uint64_t TimeUs     = 0;    // since recording start
+    uint64_t Actor      = 0;    // raw ObjectGuid
+    uint64_t Other      = 0;    // raw ObjectGuid
+    uint32_t MapId      = 0;
+    uint32_t InstanceId = 0;
+    uint32_t SessionId  = 0;
+    uint32_t Amount     = 0;
+    uint32_t Result     = 0;
+    uint32_t Extra      = 0;
+    float    F0         = 0.0f;
+    float    F1         = 0.0f;
+    uint8_t  Type       = 0;
+    uint8_t  Flags      = 0;
+    uint8_t  Reserved[6] = {};
+};
+#pragma pack(pop)
+
+static_assert(sizeof(HookTraceHeader) == 24, "HookTraceHeader layout changed");
+static_assert(sizeof(HookRecord) == 64, "HookRecord layout changed");
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_HOOK_TRACE_H
@@ -0,0 +1,95 @@
+/*
+ * mod-dungeon-master — DMLookupTable.h
+ * Load-time lookup structures for config data: a dense id -> slot index
+ * and grouped pointer spans. Built once per config load, read without
+ * allocating. Standard library only.
+ */
+
+#ifndef DM_LOOKUP_TABLE_H
+#define DM_LOOKUP_TABLE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+// Read-only view over contiguous elements (std::span stand-in for C++17).
+template<typename T>
+class Span
+{
+public:
+    Span() = default;
+    Span(T const* data, size_t size) : _data(data), _size(size) {}
+
+    T const* begin() const { return _data; }
+    T const* end()   const { return _data + _size; }
+    size_t   size()  const { return _size; }
+    bool     empty() const { return _size == 0; }
+    T const& operator[](size_t i) const { return _data[i]; }
+
+private:
+    T const* _data = nullptr;
+    size_t   _size = 0;
+};
+
+// id -> slot in a parallel vector, for small id spaces (config ids, map ids).
+class DenseIndex
+{
+public:
+    static constexpr uint32_t NPOS   = 0xFFFF;
+    static constexpr uint32_t MAX_ID = 0xFFFF;
+
+    void Clear() { _slots.clear(); }
+
+    // False if the id is too large to index.
+    bool Set(uint32_t id, size_t slot)
+    {
+        if (id > MAX_ID || slot >= NPOS)
+            return false;
+        if (id >= _slots.size())
+            _slots.resize(id + 1, uint16_t(NPOS));
+        _slots[id] = uint16_t(slot);
+        return true;
+    }
+
+    uint32_t Find(uint32_t id) const { return id < _slots.size() ? _slots[id] : NPOS; }
+
+private:
+    std::vector<uint16_t> _slots;
+};
+
+// Numbered groups of elements stored back to back. Groups are appended in
+// key order (0, 1, 2, ...); a key past the last group is an empty span.
+template<typename T>
+class SpanTable
+{
+public:
+    void Clear()
+    {
+        _items.clear();
+        _offsets.assign(1, 0);
+    }
+
+    void Add(T const& item) { _items.push_back(item); }
+    void EndGroup()         { _offsets.push_back(uint32_t(_items.size())); }
+
+    Span<T> Get(size_t key) const
+    {
+        if (key + 1 >= _offsets.size())
+            return {};
+        return { _items.data() + _offsets[key], size_t(_offsets[key + 1] - _offsets[key]) };
+    }
+
+private:
+    std::vector<T>        _items;
+    std::vector<uint32_t> _offsets{ 0 };
+};
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_LOOKUP_TABLE_H
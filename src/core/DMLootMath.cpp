@@ -0,0 +1,168 @@
+/*
+ * mod-dungeon-master — DMLootMath.cpp
+ * Reward/loot candidate filtering.
+ */
+
+#include "DMLootMath.h"
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+uint8_t GetMaxArmorSubclass(uint32_t playerClass)
+{
+    switch (playerClass)
+    {
+        case 5: case 8: case 9:              return 1;  // cloth: Priest, Mage, Warlock
+        case 4: case 11:                     return 2;  // leather: Rogue, Druid
+        case 3: case 7:                      return 3;  // mail: Hunter, Shaman
+        case 1: case 2: case 6:              return 4;  // plate: Warrior, Paladin, DK
+        default:                             return 4;
+    }
+}
+
+uint32_t GetClassBitmask(uint32_t playerClass)
+{
+    if (playerClass == 0 || playerClass > 11) return 0x7FF;  // all classes
+    return 1 << (playerClass - 1);
+}
+
+uint32_t GetPrimaryStatForClass(uint32_t playerClass)
+{
+    switch (playerClass)
+    {
+        case 1:  return 4;  // Warrior  -> STR
+        case 2:  return 4;  // Paladin  -> STR
+        case 3:  return 3;  // Hunter   -> AGI
+        case 4:  return 3;  // Rogue    -> AGI
+        case 5:  return 5;  // Priest   -> INT
+        case 6:  return 4;  // DK       -> STR
+        case 7:  return 5;  // Shaman   -> INT
+        case 8:  return 5;  // Mage     -> INT
+        case 9:  return 5;  // Warlock  -> INT
+        case 11: return 3;  // Druid    -> AGI
+        default: return 4;
+    }
+}
+
+bool CollectRewardCandidates(std::vector<RewardItem> const& pool, uint8_t level, uint8_t quality,
+                             uint32_t playerClass, std::vector<uint32_t>& out, LevelWindow& window)
+{
+    uint8_t  maxArmor  = GetMaxArmorSubclass(playerClass);
+    uint32_t classMask = GetClassBitmask(playerClass);
+
+    // Try progressively wider level windows, but always prefer closer to player level
+    static constexpr uint8_t kBelow[] = {
+        3,     // strict: [level-3, level]
+        8,     // medium: [level-8, level]
+        15,    // wide: [level-15, level]
+        25,    // very wide: [level-25, level]
+        80,    // last resort: [1, level] (never items above player level)
+    };
+
+    for (uint8_t below : kBelow)
+    {
+        out.clear();
+        uint8_t lo = (level > below) ? (level - below) : 1;
+        uint8_t hi = level;  // Never give items above player level
+
+        for (auto const& ri : pool)
+        {
+            // Quality filter
+            if (ri.Quality != quality) continue;
+
+            // Level filter: item RequiredLevel must be within window
+            if (ri.MinLevel < lo || ri.MinLevel > hi) continue;
+
+            // Class restriction: AllowableClass bitmask check
+            if (ri.AllowableClass != -1 && !(ri.AllowableClass & classMask))
+                continue;
+
+            // Armor subclass: player can only wear their class's max armor or lower
+            if (ri.Class == 4 && ri.SubClass > 0 && ri.SubClass <= 4)
+            {
+                if (ri.SubClass > maxArmor) continue;
+            }
+
+            out.push_back(ri.Entry);
+        }
+
+        if (!out.empty())
+        {
+            window = { lo, hi };
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CollectLootCandidates(std::vector<LootPoolItem> const& pool, uint8_t level,
+                           uint8_t minQuality, uint8_t maxQuality, bool equipmentOnly,
+                           uint32_t playerClass, std::vector<uint32_t>& out, LevelWindow& window)
+{
+    // Expected ItemLevel range for this level
+    uint16_t expectedMaxIlvl = static_cast<uint16_t>(level) * 2 + 10;
+
+    uint8_t  maxArmor  = playerClass ? GetMaxArmorSubclass(playerClass) : 4;
+    uint32_t classMask = playerClass ? GetClassBitmask(playerClass) : 0x7FF;
+
+    // Progressively widen level windows, always preferring items closer to player level
+    static constexpr struct { uint8_t below; uint8_t above; } kWindows[] = {
+        { 3, 1 },   // strict: RequiredLevel in [level-3, level+1]
+        { 5, 2 },   // medium
+        { 8, 3 },   // wide
+        { 15, 5 },  // very wide
+        { 25, 8 },  // extremely wide (last resort)
+    };
+
+    for (auto const& win : kWindows)
+    {
+        out.clear();
+        uint8_t lo = (level > win.below) ? (level - win.below) : 0;
+        uint8_t hi = static_cast<uint8_t>(std::min<uint16_t>(level + win.above, 83));
+
+        for (auto const& li : pool)
+        {
+            if (li.Quality < minQuality || li.Quality > maxQuality) continue;
+            if (equipmentOnly && li.ItemClass != 2 && li.ItemClass != 4) continue;
+
+            // Level filter for items with RequiredLevel > 0
+            if (li.MinLevel > 0)
+            {
+                if (li.MinLevel < lo || li.MinLevel > hi) continue;
+            }
+            else
+            {
+                // RequiredLevel = 0: use ItemLevel as a sanity check
+                if (li.ItemLevel > expectedMaxIlvl) continue;
+            }
+
+            // Class restriction for equipment items
+            if (equipmentOnly || (li.ItemClass == 2 || li.ItemClass == 4))
+            {
+                // AllowableClass bitmask check
+                if (li.AllowableClass != -1 && !(li.AllowableClass & classMask))
+                    continue;
+
+                // Armor subclass check (only for armor, not weapons)
+                if (li.ItemClass == 4 && li.SubClass > 0 && li.SubClass <= 4)
+                    if (li.SubClass > maxArmor) continue;
+            }
+
+            out.push_back(li.Entry);
+        }
+
+        if (!out.empty())
+        {
+            window = { lo, hi };
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace Core
+} // namespace DungeonMaster
@@ -0,0 +1,95 @@
+/*
+ * mod-dungeon-master — DMLootMath.h
+ * Reward/loot candidate filtering and class-aware item scoring.
+ * Standard library only: item templates are passed in by the caller.
+ */
+
+#ifndef DM_LOOT_MATH_H
+#define DM_LOOT_MATH_H
+
+#include "DMCoreTypes.h"
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+// Heaviest armor subclass the class can wear (1 cloth .. 4 plate).
+uint8_t GetMaxArmorSubclass(uint32_t playerClass);
+
+// AllowableClass bit for the class; 0 or unknown = all classes.
+uint32_t GetClassBitmask(uint32_t playerClass);
+
+// Primary stat for class-based reward weighting.
+// Returns: ITEM_MOD_AGILITY(3), ITEM_MOD_STRENGTH(4), ITEM_MOD_INTELLECT(5)
+uint32_t GetPrimaryStatForClass(uint32_t playerClass);
+
+// Score item stat alignment with player class (0.0 = bad, 1.0 = perfect match).
+// StatT is anything with ItemStatType / ItemStatValue members, e.g. the
+// ItemTemplate::ItemStat array.
+template<typename StatT>
+float ScoreItemForClass(StatT const* stats, size_t count, uint32_t playerClass)
+{
+    uint32_t primaryStat = GetPrimaryStatForClass(playerClass);
+    float totalStats = 0.0f;
+    float primaryTotal = 0.0f;
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        int32_t  val  = stats[i].ItemStatValue;
+        uint32_t type = stats[i].ItemStatType;
+        if (val <= 0) continue;
+
+        totalStats += static_cast<float>(val);
+        if (type == primaryStat)
+            primaryTotal += static_cast<float>(val);
+    }
+
+    if (totalStats <= 0.0f) return 0.5f;  // No stats (trinket, etc.) = neutral
+    return primaryTotal / totalStats;
+}
+
+// Level window the candidates were found in, for logging.
+struct LevelWindow
+{
+    uint8_t Lo = 0;
+    uint8_t Hi = 0;
+};
+
+// Fills out with reward pool entries of the given quality the class can use,
+// widening the level window until something matches. Never returns items
+// above the player's level. False if every window is empty.
+bool CollectRewardCandidates(std::vector<RewardItem> const& pool, uint8_t level, uint8_t quality,
+                             uint32_t playerClass, std::vector<uint32_t>& out, LevelWindow& window);
+
+// Same for the creature loot pool: quality range, optional equipment-only,
+// class restrictions applied to weapons and armor.
+bool CollectLootCandidates(std::vector<LootPoolItem> const& pool, uint8_t level,
+                           uint8_t minQuality, uint8_t maxQuality, bool equipmentOnly,
+                           uint32_t playerClass, std::vector<uint32_t>& out, LevelWindow& window);
+
+// Picks uniformly from the top third (at least 3) of cands by score(entry).
+template<typename ScoreFn>
+uint32_t PickTopScored(std::vector<uint32_t> const& cands, ScoreFn&& score, std::mt19937& rng)
+{
+    std::vector<std::pair<uint32_t, float>> scored;
+    scored.reserve(cands.size());
+    for (uint32_t entry : cands)
+        scored.push_back({entry, score(entry)});
+
+    std::sort(scored.begin(), scored.end(),
+        [](auto const& a, auto const& b) { return a.second > b.second; });
+
+    size_t topN = std::min(scored.size(), std::max<size_t>(3, scored.size() / 3));
+    return scored[std::uniform_int_distribution<size_t>(0, topN - 1)(rng)].first;
+}
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_LOOT_MATH_H
@@ -0,0 +1,59 @@
+/*
+ * mod-dungeon-master — DMPopulatePlan.cpp
+ * Level-scaled creature stats for planned spawns.
+ */
+
+#include "DMPopulatePlan.h"
+#include <algorithm>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+CreatureStats ComputeCreatureStats(ClassLevelStatEntry const* base, uint32_t templateMaxHealth,
+                                   uint32_t templateArmor, uint32_t baseAttackTimeMs,
+                                   float hpMult, float extraHpMult,
+                                   float dmgMult, float extraDmgMult, float armorMult)
+{
+    CreatureStats out;
+
+    float finalHP;
+    if (base)
+        finalHP = static_cast<float>(base->BaseHP) * hpMult * extraHpMult;
+    else
+        finalHP = templateMaxHealth * hpMult * extraHpMult;
+    out.MaxHealth = std::max(1u, static_cast<uint32_t>(finalHP));
+
+    if (base)
+    {
+        float dmgBase = base->BaseDamage;
+        float apBonus = static_cast<float>(base->AttackPower) / 14.0f;
+        float atkTime = static_cast<float>(baseAttackTimeMs) / 1000.0f;
+        if (atkTime <= 0.0f) atkTime = 2.0f;
+
+        float minDmg = (dmgBase + apBonus) * atkTime * dmgMult * extraDmgMult;
+        float maxDmg = ((dmgBase * 1.15f) + apBonus) * atkTime * dmgMult * extraDmgMult;
+
+        out.HasWeaponDamage = true;
+        out.MinDamage = std::max(1.0f, minDmg);
+        out.MaxDamage = std::max(out.MinDamage, maxDmg);
+    }
+
+    // Armor from the target level's row, then the roguelike tier on top
+    out.Armor = templateArmor;
+    if (base && base->BaseArmor > 0)
+    {
+        out.HasArmor = true;
+        out.Armor = base->BaseArmor;
+    }
+    if (armorMult > 1.0f)
+    {
+        out.HasArmor = true;
+        out.Armor = static_cast<uint32_t>(out.Armor * armorMult);
+    }
+    return out;
+}
+
+} // namespace Core
+} // namespace DungeonMaster
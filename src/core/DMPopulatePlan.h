@@ -0,0 +1,274 @@
+/*
+ * mod-dungeon-master — DMPopulatePlan.h
+ * Population planning for PopulateDungeon: which spawn point gets which
+ * creature in which role, elite/rare rolls, per-creature multipliers and
+ * the level-scaled stats. The caller summons and applies the plan.
+ * Standard library only.
+ */
+
+#ifndef DM_POPULATE_PLAN_H
+#define DM_POPULATE_PLAN_H
+
+#include "DMCoreTypes.h"
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+// Config and roguelike inputs, read once per population.
+struct PopulateParams
+{
+    uint32_t EliteChance     = 0;       // percent
+    float    EliteHpMult     = 1.0f;
+    float    EliteDmgMult    = 1.5f;
+    uint32_t RareChance      = 0;       // percent, at most one rare
+    float    RareHpMult      = 1.0f;
+    float    RareDmgMult     = 1.0f;
+    uint32_t BossCount       = 1;
+    float    BossHpMult      = 1.0f;
+    float    BossDmgMult     = 1.0f;
+
+    // Roguelike affixes (1.0 outside a run). Rares use the trash affixes.
+    float    TrashAffixHp    = 1.0f;
+    float    TrashAffixDmg   = 1.0f;
+    float    AffixEliteMult  = 1.0f;
+    float    BossAffixHp     = 1.0f;
+    float    BossAffixDmg    = 1.0f;
+
+    // Share of trash points filled (below 1.0 under server load)
+    float    Density         = 1.0f;
+};
+
+enum class SpawnRole : uint8_t
+{
+    Trash,
+    Rare,
+    Boss,
+};
+
+struct PlannedSpawn
+{
+    uint32_t  Point   = 0;      // index into the spawn point list
+    uint32_t  Entry   = 0;
+    SpawnRole Role    = SpawnRole::Trash;
+    bool      IsElite = false;
+    float     HpMult  = 1.0f;   // on top of the session health multiplier
+    float     DmgMult = 1.0f;   // on top of the session/boss damage multiplier
+};
+
+// Spawns in summon order: trash, then the rare, then bosses.
+struct PopulationPlan
+{
+    std::vector<PlannedSpawn> Spawns;
+    uint32_t Trash  = 0;
+    uint32_t Elites = 0;
+    uint32_t Rares  = 0;
+    uint32_t Bosses = 0;
+
+    void Clear() { Spawns.clear(); Trash = Elites = Rares = Bosses = 0; }
+};
+
+// Final stats for one creature; Has* false means leave the template value.
+struct CreatureStats
+{
+    uint32_t MaxHealth       = 1;
+    bool     HasWeaponDamage = false;
+    float    MinDamage       = 0.0f;
+    float    MaxDamage       = 0.0f;
+    bool     HasArmor        = false;
+    uint32_t Armor           = 0;
+};
+
+// Level-scaled stats from creature_classlevelstats (base may be null: HP
+// then scales the template's). hpMult/dmgMult are the session's, extra*
+// the plan's; armorMult is the roguelike tier armor (applied above 1.0).
+CreatureStats ComputeCreatureStats(ClassLevelStatEntry const* base, uint32_t templateMaxHealth,
+                                   uint32_t templateArmor, uint32_t baseAttackTimeMs,
+                                   float hpMult, float extraHpMult,
+                                   float dmgMult, float extraDmgMult, float armorMult);
+
+inline uint32_t RollPercent(std::mt19937& rng)
+{
+    return std::uniform_int_distribution<uint32_t>(1, 100)(rng);
+}
+
+// Elite chance for thinned trash: the base chance over the density, so the
+// kept packs are elite-heavy in proportion.
+inline uint32_t ThinnedEliteChance(PopulateParams const& p)
+{
+    if (p.Density >= 1.0f)
+        return p.EliteChance;
+    return std::min<uint32_t>(100, static_cast<uint32_t>(p.EliteChance / p.Density));
+}
+
+// Share of trash that comes out elite at a chance, including Savage's
+// second roll at chance * affixEliteMult (see PlanTrash).
+inline float ExpectedEliteShare(uint32_t chance, float affixEliteMult)
+{
+    float first = std::min(100u, chance) / 100.0f;
+    if (affixEliteMult <= 1.0f)
+        return first;
+    float second = std::min<uint32_t>(100, static_cast<uint32_t>(chance * affixEliteMult)) / 100.0f;
+    return first + (1.0f - first) * second;
+}
+
+// Factor on a per-creature amount (HP, kill XP, gold) of each kept trash
+// creature, where an elite is worth eliteMult normal ones, so the expected
+// total over the dungeon matches a full-density population.
+inline float ThinnedTotalFactor(PopulateParams const& p, float eliteMult)
+{
+    if (p.Density >= 1.0f)
+        return 1.0f;
+    float e     = ExpectedEliteShare(p.EliteChance, p.AffixEliteMult);
+    float eThin = ExpectedEliteShare(ThinnedEliteChance(p), p.AffixEliteMult);
+    float full  = 1.0f + e * (eliteMult - 1.0f);
+    float thin  = 1.0f + eThin * (eliteMult - 1.0f);
+    return full / (p.Density * thin);
+}
+
+inline float ThinnedHpFactor(PopulateParams const& p)
+{
+    return ThinnedTotalFactor(p, p.EliteHpMult);
+}
+
+// One trash creature per non-boss point. pickTrash() returns an entry or 0
+// to leave the point empty; elite (and Savage's boosted elite) rolls follow.
+// Below full density, points are skipped evenly along the route and the
+// kept creatures take the thinned elite chance and HP factor.
+template<typename Points, typename PickFn>
+void PlanTrash(Points const& points, PopulateParams const& p, PickFn&& pickTrash,
+               std::mt19937& rng, PopulationPlan& plan)
+{
+    bool     thinned     = p.Density < 1.0f;
+    uint32_t eliteChance = ThinnedEliteChance(p);
+    float    hpFactor    = ThinnedHpFactor(p);
+    float    carry       = 0.0f;
+
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        if (points[i].IsBossPosition)
+            continue;
+
+        if (thinned)
+        {
+            carry += p.Density;
+            if (carry < 1.0f)
+                continue;
+            carry -= 1.0f;
+        }
+
+        uint32_t entry = pickTrash();
+        if (!entry)
+            continue;
+
+        bool isElite = RollPercent(rng) <= eliteChance;
+        if (p.AffixEliteMult > 1.0f && !isElite)
+            isElite = RollPercent(rng) <= static_cast<uint32_t>(eliteChance * p.AffixEliteMult);
+
+        PlannedSpawn s;
+        s.Point   = uint32_t(i);
+        s.Entry   = entry;
+        s.Role    = SpawnRole::Trash;
+        s.IsElite = isElite;
+        s.HpMult  = (isElite ? p.EliteHpMult : 1.0f) * hpFactor * p.TrashAffixHp;
+        s.DmgMult = (isElite ? p.EliteDmgMult : 1.0f) * p.TrashAffixDmg;
+        plan.Spawns.push_back(s);
+        ++plan.Trash;
+        if (isElite)
+            ++plan.Elites;
+    }
+}
+
+// At most one rare, on a non-boss point in the middle third of the route.
+template<typename Points, typename PickFn>
+void PlanRare(Points const& points, PopulateParams const& p, PickFn&& pickRare,
+              std::mt19937& rng, PopulationPlan& plan)
+{
+    if (p.RareChance == 0 || RollPercent(rng) > p.RareChance)
+        return;
+
+    size_t valid = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+        if (!points[i].IsBossPosition)
+            ++valid;
+    if (!valid)
+        return;
+
+    size_t startIdx = valid / 3;
+    size_t endIdx   = std::max(startIdx, valid * 2 / 3);
+    if (endIdx >= valid) endIdx = valid - 1;
+    size_t nth = std::uniform_int_distribution<size_t>(startIdx, endIdx)(rng);
+
+    size_t point = 0;
+    for (size_t i = 0; i < points.size(); ++i)
+    {
+        if (points[i].IsBossPosition)
+            continue;
+        if (nth-- == 0)
+        {
+            point = i;
+            break;
+        }
+    }
+
+    uint32_t entry = pickRare();
+    if (!entry)
+        return;
+
+    PlannedSpawn s;
+    s.Point   = uint32_t(point);
+    s.Entry   = entry;
+    s.Role    = SpawnRole::Rare;
+    s.IsElite = true;
+    s.HpMult  = p.RareHpMult * p.TrashAffixHp;
+    s.DmgMult = p.RareDmgMult * p.TrashAffixDmg;
+    plan.Spawns.push_back(s);
+    ++plan.Rares;
+}
+
+// Up to BossCount bosses on the boss points, in point order.
+template<typename Points, typename PickFn>
+void PlanBosses(Points const& points, PopulateParams const& p, PickFn&& pickBoss, PopulationPlan& plan)
+{
+    for (size_t i = 0; i < points.size() && plan.Bosses < p.BossCount; ++i)
+    {
+        if (!points[i].IsBossPosition)
+            continue;
+
+        uint32_t entry = pickBoss();
+        if (!entry)
+            continue;
+
+        PlannedSpawn s;
+        s.Point   = uint32_t(i);
+        s.Entry   = entry;
+        s.Role    = SpawnRole::Boss;
+        s.IsElite = true;
+        s.HpMult  = p.BossHpMult * p.BossAffixHp;
+        s.DmgMult = p.BossDmgMult * p.BossAffixDmg;
+        plan.Spawns.push_back(s);
+        ++plan.Bosses;
+    }
+}
+
+// Whole plan, consuming rng in the same order PopulateDungeon always has.
+template<typename Points, typename TrashFn, typename RareFn, typename BossFn>
+void PlanPopulation(Points const& points, PopulateParams const& p, TrashFn&& pickTrash,
+                    RareFn&& pickRare, BossFn&& pickBoss, std::mt19937& rng, PopulationPlan& plan)
+{
+    plan.Clear();
+    plan.Spawns.reserve(points.size() + 1);
+    PlanTrash(points, p, pickTrash, rng, plan);
+    PlanRare(points, p, pickRare, rng, plan);
+    PlanBosses(points, p, pickBoss, plan);
+}
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_POPULATE_PLAN_H
@@ -0,0 +1,87 @@
+/*
+ * mod-dungeon-master — DMRoguelikeMath.h
+ * Roguelike tier scaling, affix definitions and buff stacking.
+ * Standard library only.
+ */
+
+#ifndef DM_ROGUELIKE_MATH_H
+#define DM_ROGUELIKE_MATH_H
+
+#include <cmath>
+#include <cstdint>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+// Each buff stack is +10% all stats (Greater Blessing of Kings stack amount).
+constexpr float BUFF_PCT_PER_STACK = 10.0f;
+
+// Affix scaling as applied by PopulateDungeon. Id matches RoguelikeAffix.
+struct AffixScaling
+{
+    uint32_t    Id;
+    char const* Name;
+    float       TrashHpMult;
+    float       TrashDmgMult;
+    float       BossHpMult;
+    float       BossDmgMult;
+    float       EliteChanceMult;
+};
+
+inline constexpr AffixScaling AFFIX_SCALING[] =
+{
+    // Fortified — trash mobs are significantly harder
+    { 1, "Fortified",  1.30f, 1.15f, 1.0f,  1.0f,  1.0f },
+    // Tyrannical — bosses are significantly harder
+    { 2, "Tyrannical", 1.0f,  1.0f,  1.40f, 1.20f, 1.0f },
+    // Raging — everything hits harder
+    { 3, "Raging",     1.0f,  1.25f, 1.0f,  1.25f, 1.0f },
+    // Bolstering — everything has more health
+    { 4, "Bolstering", 1.20f, 1.0f,  1.20f, 1.0f,  1.0f },
+    // Savage — more elites, elites are nastier
+    { 5, "Savage",     1.0f,  1.10f, 1.0f,  1.0f,  2.0f },
+};
+
+// Health/damage multiplier for a roguelike tier: linear up to expThreshold,
+// then each further tier adds baseScale * expFactor^n.
+inline float TierScalingMultiplier(uint32_t tier, float baseScale, uint32_t expThreshold, float expFactor)
+{
+    if (tier <= 1) return 1.0f;
+
+    if (tier <= expThreshold)
+        return 1.0f + (tier - 1) * baseScale;
+
+    // Exponential scaling past threshold
+    float linearPart = (expThreshold - 1) * baseScale;
+    float expPart    = 0.0f;
+    for (uint32_t t = expThreshold; t < tier; ++t)
+        expPart += baseScale * std::pow(expFactor, static_cast<float>(t - expThreshold + 1));
+
+    return 1.0f + linearPart + expPart;
+}
+
+// Armor scales linearly only.
+inline float TierArmorMultiplier(uint32_t tier, float baseScale)
+{
+    if (tier <= 1) return 1.0f;
+    return 1.0f + (tier - 1) * baseScale;
+}
+
+// Number of affixes active at a tier (0 before startTier, at most 3).
+inline uint32_t AffixCountForTier(uint32_t tier, uint32_t startTier, uint32_t secondTier, uint32_t thirdTier)
+{
+    if (tier < startTier)
+        return 0;
+    if (tier >= thirdTier)
+        return 3;
+    if (tier >= secondTier)
+        return 2;
+    return 1;
+}
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_ROGUELIKE_MATH_H
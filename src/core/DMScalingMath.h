@@ -0,0 +1,116 @@
+/*
+ * mod-dungeon-master — DMScalingMath.h
+ * Pure scaling math shared by the module and the offline tools.
+ * Standard library only: no AzerothCore headers may be included here.
+ */
+
+#ifndef DM_SCALING_MATH_H
+#define DM_SCALING_MATH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+// How far value sits into [soft, hard], clamped to 0..1; 0 when soft is 0.
+inline float LoadPressure(float value, float soft, float hard)
+{
+    if (soft <= 0.0f || value <= soft)
+        return 0.0f;
+    if (hard <= soft)
+        return 1.0f;
+    return std::min(1.0f, (value - soft) / (hard - soft));
+}
+
+// Trash density for a new population: 1 at no pressure, minDensity at full.
+inline float LoadDensity(float pressure, float minDensity)
+{
+    minDensity = std::clamp(minDensity, 0.1f, 1.0f);
+    return 1.0f - std::clamp(pressure, 0.0f, 1.0f) * (1.0f - minDensity);
+}
+
+// Environmental (non-session) hits are capped at this fraction of max HP.
+constexpr float ENV_DAMAGE_MAX_PCT = 0.03f;
+
+// Difficulty multiplier adjusted for party size: solo runs use the solo
+// multiplier, groups add perPlayer for every member beyond the first.
+inline float PartyMultiplier(float base, uint32_t partySize, float soloMult, float perPlayer)
+{
+    if (partySize <= 1)
+        return base * soloMult;
+    return base * (1.0f + (partySize - 1) * perPlayer);
+}
+
+// Session health/damage multiplier: difficulty scaled for party size, times
+// the roguelike tier multiplier (1.0 outside a run).
+inline float SessionMultiplier(float difficultyMult, uint32_t partySize, float soloMult,
+                               float perPlayer, float tierMult)
+{
+    return PartyMultiplier(difficultyMult, partySize, soloMult, perPlayer) * tierMult;
+}
+
+// Spell damage scale for a session boss fighting below its design level.
+// Base damages come from creature_classlevelstats; pass a negative value
+// when the row is missing to fall back to the squared level ratio.
+inline float BossSpellDamageScale(uint8_t targetLevel, uint8_t templateLevel,
+                                  float targetBaseDamage, float templateBaseDamage,
+                                  uint32_t partySize, float soloMult)
+{
+    if (targetLevel >= templateLevel || templateLevel == 0)
+        return 1.0f;
+
+    float scale;
+    if (targetBaseDamage >= 0.0f && templateBaseDamage > 1.0f)
+        scale = targetBaseDamage / templateBaseDamage;
+    else
+    {
+        float lvlRatio = static_cast<float>(targetLevel) / static_cast<float>(templateLevel);
+        scale = lvlRatio * lvlRatio;
+    }
+
+    if (partySize <= 1)
+        scale *= soloMult;
+
+    // Never fully negate, never amplify
+    return std::max(0.03f, std::min(1.0f, scale));
+}
+
+// Hazard damage scale when the party is below the dungeon's level.
+inline float EnvironmentalDamageScale(uint8_t partyLevel, uint8_t dungeonLevel)
+{
+    if (partyLevel >= dungeonLevel || dungeonLevel == 0)
+        return 1.0f;
+
+    float ratio = static_cast<float>(partyLevel) / static_cast<float>(dungeonLevel);
+    return std::max(0.05f, std::pow(ratio, 1.5f));
+}
+
+// Final damage from a session creature after its spell scale is applied.
+inline uint32_t ApplySessionCreatureScale(uint32_t damage, float scale)
+{
+    if (scale < 1.0f)
+        return std::max(1u, static_cast<uint32_t>(damage * scale));
+    return damage;
+}
+
+// Final damage from a non-session source: level scale, then the max-HP cap.
+inline uint32_t ApplyEnvironmentalScale(uint32_t damage, float envScale, uint32_t maxHp)
+{
+    if (envScale < 1.0f)
+        damage = static_cast<uint32_t>(damage * envScale);
+
+    uint32_t cap = std::max(1u, static_cast<uint32_t>(maxHp * ENV_DAMAGE_MAX_PCT));
+    if (damage > cap)
+        damage = cap;
+
+    return damage ? damage : 1;
+}
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_SCALING_MATH_H
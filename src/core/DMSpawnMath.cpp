@@ -0,0 +1,114 @@
+/*
+ * mod-dungeon-master — DMSpawnMath.cpp
+ * Themed creature selection.
+ */
+
+#include "DMSpawnMath.h"
+#include <set>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+namespace
+{
+
+struct TypeFilter
+{
+    std::set<uint32_t> Types;
+    bool AnyType = false;
+
+    explicit TypeFilter(std::vector<uint32_t> const& themeTypes)
+    {
+        for (uint32_t t : themeTypes)
+        {
+            if (t == uint32_t(-1)) AnyType = true;
+            else Types.insert(t);
+        }
+    }
+
+    bool Matches(uint32_t cType) const { return AnyType || Types.count(cType); }
+};
+
+void Collect(CreaturePoolByType const& pool, TypeFilter const* filter, std::vector<uint32_t>& out)
+{
+    for (auto const& [type, vec] : pool)
+    {
+        if (filter && !filter->Matches(type)) continue;
+        for (auto const& e : vec)
+            out.push_back(e.Entry);
+    }
+}
+
+CreaturePick Pick(std::vector<uint32_t> const& candidates, bool fellBack, std::mt19937& rng)
+{
+    CreaturePick pick;
+    pick.Candidates = candidates.size();
+    pick.AnyTypeFallback = fellBack;
+    if (!candidates.empty())
+        pick.Entry = candidates[std::uniform_int_distribution<size_t>(0, candidates.size() - 1)(rng)];
+    return pick;
+}
+
+} // namespace
+
+CreaturePick SelectCreatureForTheme(std::vector<uint32_t> const& themeTypes,
+                                    CreaturePoolByType const& trash,
+                                    CreaturePoolByType const& bosses,
+                                    bool isBoss, std::mt19937& rng)
+{
+    TypeFilter filter(themeTypes);
+    std::vector<uint32_t> candidates;
+
+    if (isBoss)
+    {
+        // --- Try themed elites first ---
+        Collect(bosses, &filter, candidates);
+
+        // --- Fallback: promote themed trash to boss (stats will be scaled up) ---
+        if (candidates.empty())
+            Collect(trash, &filter, candidates);
+    }
+    else
+    {
+        // --- Themed trash ---
+        Collect(trash, &filter, candidates);
+    }
+
+    // Fallback: any type
+    bool fellBack = false;
+    if (candidates.empty() && !filter.AnyType)
+    {
+        fellBack = true;
+        if (isBoss)
+            Collect(bosses, nullptr, candidates);
+        if (candidates.empty())
+            Collect(trash, nullptr, candidates);
+    }
+
+    return Pick(candidates, fellBack, rng);
+}
+
+CreaturePick SelectDungeonBoss(std::vector<uint32_t> const& themeTypes,
+                               CreaturePoolByType const& dungeonBosses, std::mt19937& rng)
+{
+    TypeFilter filter(themeTypes);
+    std::vector<uint32_t> candidates;
+
+    // Prefer themed dungeon bosses
+    Collect(dungeonBosses, &filter, candidates);
+
+    // Fallback: any dungeon boss
+    bool fellBack = false;
+    if (candidates.empty())
+    {
+        fellBack = true;
+        Collect(dungeonBosses, nullptr, candidates);
+    }
+
+    return Pick(candidates, fellBack, rng);
+}
+
+} // namespace Core
+} // namespace DungeonMaster
@@ -0,0 +1,44 @@
+/*
+ * mod-dungeon-master — DMSpawnMath.h
+ * Themed creature selection over the per-type creature pools.
+ * Standard library only.
+ */
+
+#ifndef DM_SPAWN_MATH_H
+#define DM_SPAWN_MATH_H
+
+#include "DMCoreTypes.h"
+#include <random>
+#include <unordered_map>
+#include <vector>
+
+namespace DungeonMaster
+{
+namespace Core
+{
+
+// creature_template.type -> eligible creatures of that type
+using CreaturePoolByType = std::unordered_map<uint32_t, std::vector<CreaturePoolEntry>>;
+
+struct CreaturePick
+{
+    uint32_t Entry           = 0;
+    size_t   Candidates      = 0;
+    bool     AnyTypeFallback = false;   // theme had no match, any type was used
+};
+
+// Trash: themed trash. Boss: themed elites, else themed trash promoted to
+// boss. If the theme matches nothing, falls back to any type (bosses first).
+CreaturePick SelectCreatureForTheme(std::vector<uint32_t> const& themeTypes,
+                                    CreaturePoolByType const& trash,
+                                    CreaturePoolByType const& bosses,
+                                    bool isBoss, std::mt19937& rng);
+
+// Themed dungeon boss, else any dungeon boss. Entry 0 if the pool is empty.
+CreaturePick SelectDungeonBoss(std::vector<uint32_t> const& themeTypes,
+                               CreaturePoolByType const& dungeonBosses, std::mt19937& rng);
+
+} // namespace Core
+} // namespace DungeonMaster
+
+#endif // DM_SPAWN_MATH_H
@@ -1,13 +1,16 @@
 /*
  * mod-dungeon-master — dm_allmap_script.cpp
- * Triggers dungeon population when a player enters the instance map.
+ * Triggers dungeon population when a player enters the instance map and
+ * drives per-session supervision from the instance's map update.
  */
 
 #include "ScriptMgr.h"
 #include "Map.h"
 #include "Player.h"
 #include "DungeonMasterMgr.h"
+#include "DMBroadcast.h"
 #include "DMConfig.h"
+#include "DMLog.h"
 #include "Chat.h"
 #include "Log.h"
 #include <cstdio>
@@ -31,7 +34,7 @@ public:
         Session* session = sDungeonMasterMgr->GetSessionByPlayer(player->GetGUID());
         if (!session)
         {
-            LOG_DEBUG("module", "DungeonMaster: OnPlayerEnterAll — {} entered map {} but has no session",
+            DM_LOG_DEBUG("DungeonMaster: OnPlayerEnterAll — {} entered map {} but has no session",
                 player->GetName(), map->GetId());
             return;
         }
@@ -58,8 +61,7 @@ public:
 
         session->InstanceId = instance->GetInstanceId();
 
-        ChatHandler(player->GetSession()).SendSysMessage(
-            "|cFF00FF00[Dungeon Master]|r Preparing the challenge...");
+        GetMessagePacket(DMMessage::PreparingChallenge).SendTo(player);
 
         sDungeonMasterMgr->PopulateDungeon(session, instance);
 
@@ -75,6 +77,21 @@ public:
             session->LevelBandMin, session->LevelBandMax);
         ChatHandler(player->GetSession()).SendSysMessage(buf);
     }
+
+    void OnMapUpdate(Map* map, uint32 diff) override
+    {
+        if (!sDMConfig->IsEnabled() || !map || !map->IsDungeon())
+            return;
+
+        if (InstanceMap* instance = map->ToInstanceMap())
+            sDungeonMasterMgr->UpdateSessionMap(instance, diff);
+    }
+
+    void OnDestroyInstance(void* /*mapInstanced*/, Map* map) override
+    {
+        if (map)
+            sDungeonMasterMgr->OnInstanceDestroyed(map->GetInstanceId());
+    }
 };
 
 void AddSC_dm_allmap_script()
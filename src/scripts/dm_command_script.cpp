@@ -1,6 +1,6 @@
 /*
  * mod-dungeon-master — dm_command_script.cpp
- * GM commands: .dm reload, .dm status, .dm list, .dm end, .dm clearcooldown
+ * GM commands: .dm reload, .dm status, .dm list, .dm end, .dm clearcooldown, .dm trace, .dm locks, .dm record
  */
 
 #include "ScriptMgr.h"
@@ -9,7 +9,11 @@
 #include "Player.h"
 #include "Group.h"
 #include "DungeonMasterMgr.h"
+#include "DMArena.h"
 #include "DMConfig.h"
+#include "DMHookRecorder.h"
+#include "DMMutex.h"
+#include "DMTrace.h"
 #include <cstdio>
 
 using namespace Acore::ChatCommands;
@@ -29,6 +33,9 @@ public:
             { "list",          HandleList,           SEC_GAMEMASTER,     Console::Yes },
             { "end",           HandleEnd,            SEC_ADMINISTRATOR,  Console::No  },
             { "clearcooldown", HandleClearCD,        SEC_GAMEMASTER,     Console::No  },
+            { "trace",         HandleTrace,          SEC_ADMINISTRATOR,  Console::Yes },
+            { "locks",         HandleLocks,          SEC_ADMINISTRATOR,  Console::Yes },
+            { "record",        HandleRecord,         SEC_ADMINISTRATOR,  Console::Yes },
         };
         static ChatCommandTable root = { { "dm", dmTable } };
         return root;
@@ -36,7 +43,7 @@ public:
 
     static bool HandleReload(ChatHandler* h)
     {
-        sDMConfig->LoadConfig(true);
+        DMConfig::Instance()->LoadAndApply(true);
         h->SendSysMessage("DungeonMaster: Configuration reloaded.");
         return true;
     }
@@ -57,6 +64,32 @@ public:
             uint32(sDMConfig->GetThemes().size()),
             uint32(sDMConfig->GetDungeons().size()));
         h->SendSysMessage(buf);
+        snprintf(buf, sizeof(buf), "Tracked instances: %u", sDungeonMasterMgr->GetTrackedInstanceCount());
+        h->SendSysMessage(buf);
+        snprintf(buf, sizeof(buf), "Spawn density: %.0f%% (world tick %u ms, %u live creatures)",
+            sDungeonMasterMgr->GetSpawnDensity() * 100.0f, sDungeonMasterMgr->GetAverageWorldTickMs(),
+            sDungeonMasterMgr->GetLiveCreatureCount());
+        h->SendSysMessage(buf);
+        auto combat = sDungeonMasterMgr->GetActiveCombatStats();
+        snprintf(buf, sizeof(buf), "Combat (%u active sessions): dealt / taken / before scaling / healed / overkill",
+            uint32(combat.size()));
+        h->SendSysMessage(buf);
+        for (auto const& row : combat)
+        {
+            auto stat = [&row](CombatStat s) { return (unsigned long long)row.Stats[size_t(s)]; };
+            snprintf(buf, sizeof(buf), "  #%u map %u: %llu / %llu / %llu / %llu / %llu",
+                row.SessionId, row.MapId,
+                stat(CombatStat::DamageDealt), stat(CombatStat::DamageTaken),
+                stat(CombatStat::DamageTakenRaw), stat(CombatStat::Healing),
+                stat(CombatStat::Overkill));
+            h->SendSysMessage(buf);
+        }
+        DMArena const& arena = sDMTickArena;
+        snprintf(buf, sizeof(buf), "Tick arena: %llu allocs over %llu ticks, %llu heap blocks, %u KB capacity, %u bytes high water",
+            (unsigned long long)arena.GetAllocations(), (unsigned long long)arena.GetResets(),
+            (unsigned long long)arena.GetBlockAllocations(),
+            uint32(arena.GetCapacity() / 1024), uint32(arena.GetHighWater()));
+        h->SendSysMessage(buf);
         return true;
     }
 
@@ -135,6 +168,89 @@ public:
         }
         return true;
     }
+
+    static bool HandleTrace(ChatHandler* h, Optional<std::string> mode)
+    {
+        char buf[256];
+        if (mode)
+        {
+            if (*mode == "on")
+            {
+                if (!sDMTrace->SetEnabled(true))
+                {
+                    snprintf(buf, sizeof(buf), "Cannot open trace file %s.", sDMTrace->GetPath().c_str());
+                    h->SendSysMessage(buf);
+                    return false;
+                }
+            }
+            else if (*mode == "off")
+                sDMTrace->SetEnabled(false);
+            else
+            {
+                h->SendSysMessage("Usage: .dm trace [on|off]");
+                return false;
+            }
+        }
+
+        snprintf(buf, sizeof(buf), "Trace: %s  File: %s  Events: %llu  Rotations: %u",
+            sDMTrace->IsEnabled() ? "on" : "off", sDMTrace->GetPath().c_str(),
+            (unsigned long long)sDMTrace->GetEventCount(), sDMTrace->GetRotationCount());
+        h->SendSysMessage(buf);
+        return true;
+    }
+
+    static bool HandleLocks(ChatHandler* h, Optional<std::string> mode)
+    {
+        if (mode)
+        {
+            if (*mode == "on")         DMMutex::SetProfilingEnabled(true);
+            else if (*mode == "off")   DMMutex::SetProfilingEnabled(false);
+            else if (*mode == "reset") DMMutex::ResetAll();
+            else
+            {
+                h->SendSysMessage("Usage: .dm locks [on|off|reset]");
+                return false;
+            }
+        }
+
+        h->SendSysMessage(DMMutex::IsProfilingEnabled()
+            ? "=== DM Lock Profiler (on) ==="
+            : "=== DM Lock Profiler (off — .dm locks on to record) ===");
+        for (std::string const& line : DMMutex::BuildReport())
+            h->SendSysMessage(line);
+        return true;
+    }
+
+    static bool HandleRecord(ChatHandler* h, Optional<std::string> mode)
+    {
+        char buf[256];
+        if (mode)
+        {
+            if (*mode == "on")
+            {
+                if (!sDMHookRecorder->SetEnabled(true))
+                {
+                    snprintf(buf, sizeof(buf), "Cannot open hook recording %s.", sDMHookRecorder->GetPath().c_str());
+                    h->SendSysMessage(buf);
+                    return false;
+                }
+            }
+            else if (*mode == "off")
+                sDMHookRecorder->SetEnabled(false);
+            else
+            {
+                h->SendSysMessage("Usage: .dm record [on|off]");
+                return false;
+            }
+        }
+
+        snprintf(buf, sizeof(buf), "Hook recorder: %s  File: %s  Records: %llu  Dropped: %llu",
+            sDMHookRecorder->IsEnabled() ? "on" : "off", sDMHookRecorder->GetPath().c_str(),
+            (unsigned long long)sDMHookRecorder->GetRecordCount(),
+            (unsigned long long)sDMHookRecorder->GetDroppedCount());
+        h->SendSysMessage(buf);
+        return true;
+    }
 };
 
 void AddSC_dm_command_script()
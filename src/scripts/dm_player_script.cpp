@@ -1,12 +1,15 @@
 /*
  * mod-dungeon-master — dm_player_script.cpp
  * Player death handling: blocks spirit release, checks for wipe.
+ * Reports member state transitions to the session and run managers.
  */
 
 #include "ScriptMgr.h"
 #include "Player.h"
 #include "Creature.h"
+#include "Map.h"
 #include "DungeonMasterMgr.h"
+#include "RoguelikeMgr.h"
 #include "DMConfig.h"
 
 using namespace DungeonMaster;
@@ -30,6 +33,63 @@ public:
 
         sDungeonMasterMgr->HandlePlayerDeath(player, session);
     }
+
+    void OnPlayerLogin(Player* player) override
+    {
+        if (!sDMConfig->IsEnabled())
+            return;
+        sDungeonMasterMgr->QueueMemberEvent(player, MemberEvent::Login);
+        sRoguelikeMgr->SetPlayerOnline(player->GetGUID(), true);
+    }
+
+    void OnPlayerLogout(Player* player) override
+    {
+        if (!sDMConfig->IsEnabled())
+            return;
+        sDungeonMasterMgr->QueueMemberEvent(player, MemberEvent::Logout);
+        sRoguelikeMgr->SetPlayerOnline(player->GetGUID(), false);
+    }
+
+    void OnPlayerMapChanged(Player* player) override
+    {
+        if (sDMConfig->IsEnabled())
+            sDungeonMasterMgr->QueueMemberEvent(player, MemberEvent::MapChanged);
+    }
+
+    // Death, resurrection and combat only matter inside a session's
+    // dungeon; skip the open world, where they fire constantly.
+    void OnPlayerJustDied(Player* player) override
+    {
+        if (InDungeon(player))
+            sDungeonMasterMgr->QueueMemberEvent(player, MemberEvent::Died);
+    }
+
+    void OnPlayerResurrect(Player* player, float /*restorePercent*/, bool /*applySickness*/) override
+    {
+        if (InDungeon(player))
+            sDungeonMasterMgr->QueueMemberEvent(player, MemberEvent::Resurrected);
+    }
+
+    void OnPlayerEnterCombat(Player* player, Unit* /*enemy*/) override
+    {
+        if (InDungeon(player))
+            sDungeonMasterMgr->QueueMemberEvent(player, MemberEvent::EnterCombat);
+    }
+
+    void OnPlayerLeaveCombat(Player* player) override
+    {
+        if (InDungeon(player))
+            sDungeonMasterMgr->QueueMemberEvent(player, MemberEvent::LeaveCombat);
+    }
+
+private:
+    static bool InDungeon(Player* player)
+    {
+        if (!sDMConfig->IsEnabled() || !player)
+            return false;
+        Map* map = player->GetMap();
+        return map && map->IsDungeon();
+    }
 };
 
 void AddSC_dm_player_script()
@@ -4,6 +4,7 @@
  *   - Session boss spells/melee: scaled by level ratio (template level → session level)
  *   - Session trash: already scaled by custom AI melee, passed through
  *   - Environmental (non-session): capped at 3% max HP
+ * and feeds the per-session combat telemetry counters.
  */
 
 #include "ScriptMgr.h"
@@ -12,11 +13,11 @@
 #include "SpellInfo.h"
 #include "DungeonMasterMgr.h"
 #include "DMConfig.h"
+#include "DMHookRecorder.h"
+#include "DMScalingMath.h"
 
 using namespace DungeonMaster;
 
-static constexpr float ENV_DAMAGE_MAX_PCT = 0.03f;
-
 class dm_unit_script : public UnitScript
 {
 public:
@@ -24,20 +25,48 @@ public:
 
     void ModifyPeriodicDamageAurasTick(Unit* target, Unit* attacker, uint32& damage, SpellInfo const* /*spellInfo*/) override
     {
-        ScaleDamage(target, attacker, damage);
+        ScaleDamage(target, attacker, damage, Core::HookType::PeriodicDamage);
     }
 
     void ModifySpellDamageTaken(Unit* target, Unit* attacker, int32& damage, SpellInfo const* /*spellInfo*/) override
     {
         if (damage <= 0) return;
         uint32 udmg = static_cast<uint32>(damage);
-        ScaleDamage(target, attacker, udmg);
+        ScaleDamage(target, attacker, udmg, Core::HookType::SpellDamage);
         damage = static_cast<int32>(udmg);
     }
 
     void ModifyMeleeDamage(Unit* target, Unit* attacker, uint32& damage) override
     {
-        ScaleDamage(target, attacker, damage);
+        ScaleDamage(target, attacker, damage, Core::HookType::MeleeDamage);
+    }
+
+    void OnDamage(Unit* attacker, Unit* victim, uint32& damage) override
+    {
+        if (!sDMConfig->IsEnabled() || !attacker || !victim || !damage || victim->ToPlayer())
+            return;
+
+        Player* player = attacker->ToPlayer();
+        if (!player && attacker->GetOwner())
+            player = attacker->GetOwner()->ToPlayer();
+        if (!player)
+            return;
+
+        if (SessionTelemetry* t = sDungeonMasterMgr->GetSessionTelemetry(victim->GetInstanceId()))
+        {
+            t->Add(CombatStat::DamageDealt, damage);
+            if (damage > victim->GetHealth())
+                t->Add(CombatStat::Overkill, damage - victim->GetHealth());
+        }
+    }
+
+    void OnHeal(Unit* /*healer*/, Unit* receiver, uint32& gain) override
+    {
+        if (!sDMConfig->IsEnabled() || !receiver || !gain || !receiver->ToPlayer())
+            return;
+
+        if (SessionTelemetry* t = sDungeonMasterMgr->GetSessionTelemetry(receiver->GetInstanceId()))
+            t->Add(CombatStat::Healing, gain);
     }
 
     void OnUnitDeath(Unit* unit, Unit* killer) override
@@ -49,6 +78,17 @@ public:
         if (!creature)
             return;
 
+        if (sDMHookRecorder->IsEnabled())
+        {
+            Core::HookRecord rec;
+            rec.Type       = uint8(Core::HookType::UnitDeath);
+            rec.Actor      = creature->GetGUID().GetRawValue();
+            rec.Other      = killer ? killer->GetGUID().GetRawValue() : 0;
+            rec.MapId      = creature->GetMapId();
+            rec.InstanceId = creature->GetInstanceId();
+            sDMHookRecorder->Record(rec);
+        }
+
         Player* player = nullptr;
         if (killer)
         {
@@ -71,11 +111,40 @@ public:
     }
 
 private:
-    void ScaleDamage(Unit* target, Unit* attacker, uint32& damage)
+    void ScaleDamage(Unit* target, Unit* attacker, uint32& damage, Core::HookType hook)
     {
         if (!sDMConfig->IsEnabled() || damage == 0)
             return;
 
+        uint32 incoming = damage;
+        ApplyScaling(target, attacker, damage);
+
+        if (target && target->ToPlayer())
+        {
+            if (SessionTelemetry* t = sDungeonMasterMgr->GetSessionTelemetry(target->GetInstanceId()))
+            {
+                t->Add(CombatStat::DamageTakenRaw, incoming);
+                t->Add(CombatStat::DamageTaken, damage);
+            }
+        }
+
+        if (sDMHookRecorder->IsEnabled() && target && target->ToPlayer())
+        {
+            Core::HookRecord rec;
+            rec.Type       = uint8(hook);
+            rec.Actor      = target->GetGUID().GetRawValue();
+            rec.Other      = attacker ? attacker->GetGUID().GetRawValue() : 0;
+            rec.MapId      = target->GetMapId();
+            rec.InstanceId = target->GetInstanceId();
+            rec.Amount     = incoming;
+            rec.Result     = damage;
+            rec.Extra      = target->GetMaxHealth();
+            sDMHookRecorder->Record(rec);
+        }
+    }
+
+    void ApplyScaling(Unit* target, Unit* attacker, uint32& damage)
+    {
         Player* player = target ? target->ToPlayer() : nullptr;
         if (!player)
             return;
@@ -97,27 +166,14 @@ private:
             {
                 float scale = sDungeonMasterMgr->GetSessionCreatureDamageScale(
                     playerGuid, attackerGuid);
-
-                if (scale < 1.0f)
-                    damage = std::max(1u, static_cast<uint32>(damage * scale));
-
+                damage = Core::ApplySessionCreatureScale(damage, scale);
                 return;
             }
         }
 
         // Non-session attacker (environmental hazards, traps, etc.)
         float envScale = sDungeonMasterMgr->GetEnvironmentalDamageScale(playerGuid);
-        if (envScale < 1.0f)
-            damage = static_cast<uint32>(damage * envScale);
-
-        uint32 maxHp = player->GetMaxHealth();
-        uint32 cap   = std::max(1u, static_cast<uint32>(maxHp * ENV_DAMAGE_MAX_PCT));
-
-        if (damage > cap)
-            damage = cap;
-
-        if (damage == 0)
-            damage = 1;
+        damage = Core::ApplyEnvironmentalScale(damage, envScale, player->GetMaxHealth());
     }
 };
 
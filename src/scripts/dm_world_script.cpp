@@ -6,7 +6,9 @@
 #include "ScriptMgr.h"
 #include "DungeonMasterMgr.h"
 #include "RoguelikeMgr.h"
+#include "DMArena.h"
 #include "DMConfig.h"
+#include "DMHookRecorder.h"
 #include "SpellMgr.h"
 #include "SpellInfo.h"
 #include "Log.h"
@@ -20,7 +22,7 @@ public:
 
     void OnAfterConfigLoad(bool reload) override
     {
-        sDMConfig->LoadConfig(reload);
+        DMConfig::Instance()->LoadAndApply(reload);
     }
 
     void OnStartup() override
@@ -63,14 +65,19 @@ public:
         if (!sDMConfig->IsEnabled()) return;
         LOG_INFO("module", "DungeonMaster: Shutdown — {} sessions active.",
             sDungeonMasterMgr->GetActiveSessionCount());
+        sDMHookRecorder->SetEnabled(false);
     }
 
     void OnUpdate(uint32 diff) override
     {
+        DMConfig::Instance()->ReclaimRetired();
+
         if (sDMConfig->IsEnabled())
         {
             sDungeonMasterMgr->Update(diff);
             sRoguelikeMgr->Update(diff);
+            sDMHookRecorder->Flush();
+            sDMTickArena.Reset();
         }
     }
 };
@@ -13,12 +13,13 @@
 #include "Log.h"
 #include "Chat.h"
 #include "ObjectAccessor.h"
+#include "GameTime.h"
 #include "DungeonMasterMgr.h"
 #include "RoguelikeMgr.h"
 #include "RoguelikeTypes.h"
 #include "DMConfig.h"
+#include "DMMutex.h"
 #include <cstdio>
-#include <mutex>
 #include <random>
 
 using namespace DungeonMaster;
@@ -66,10 +67,79 @@ struct PlayerDMSelection
     uint32 MapId         = 0;
     bool   ScaleToParty  = true;
     bool   IsRoguelike   = false;
+    uint64 LastTouched   = 0;
 };
 
+// Choices between gossip clicks. Dropped on confirm, cancel and logout;
+// an entry idle for SELECTION_TTL seconds reads as expired, and the map
+// never holds more than SELECTION_CAP (expired first, then least recent).
 static std::unordered_map<ObjectGuid, PlayerDMSelection> sSelections;
-static std::mutex sSelMutex;
+static DMMutex sSelMutex{ "sSelMutex" };
+static constexpr uint64 SELECTION_TTL = 10 * MINUTE;
+static constexpr size_t SELECTION_CAP = 1024;
+
+// Caller holds sSelMutex.
+static PlayerDMSelection& TouchSelection(ObjectGuid guid)
+{
+    uint64 now = GameTime::GetGameTime().count();
+    auto it = sSelections.find(guid);
+    if (it == sSelections.end())
+    {
+        if (sSelections.size() >= SELECTION_CAP)
+        {
+            auto oldest = sSelections.end();
+            for (auto e = sSelections.begin(); e != sSelections.end();)
+            {
+                if (now - e->second.LastTouched >= SELECTION_TTL)
+                    e = sSelections.erase(e);
+                else
+                {
+                    if (oldest == sSelections.end() || e->second.LastTouched < oldest->second.LastTouched)
+                        oldest = e;
+                    ++e;
+                }
+            }
+            if (sSelections.size() >= SELECTION_CAP)
+                sSelections.erase(oldest);
+        }
+        it = sSelections.emplace(guid, PlayerDMSelection{}).first;
+    }
+    else if (now - it->second.LastTouched >= SELECTION_TTL)
+        it->second = PlayerDMSelection{};   // expired: start over, as FindSelection would
+    it->second.LastTouched = now;
+    return it->second;
+}
+
+// Caller holds sSelMutex.
+static void StartSelection(ObjectGuid guid, bool roguelike)
+{
+    PlayerDMSelection& sel = TouchSelection(guid);
+    uint64 touched = sel.LastTouched;
+    sel = {};
+    sel.IsRoguelike = roguelike;
+    sel.LastTouched = touched;
+}
+
+// Copies a live selection out; an expired one is erased. With take, the
+// selection is consumed.
+static bool FindSelection(ObjectGuid guid, PlayerDMSelection& out, bool take = false)
+{
+    DMLockGuard lk(sSelMutex);
+    auto it = sSelections.find(guid);
+    if (it == sSelections.end())
+        return false;
+    if (GameTime::GetGameTime().count() - it->second.LastTouched >= SELECTION_TTL)
+    {
+        sSelections.erase(it);
+        return false;
+    }
+    out = it->second;
+    if (take)
+        sSelections.erase(it);
+    else
+        it->second.LastTouched = GameTime::GetGameTime().count();
+    return true;
+}
 
 class npc_dungeon_master : public CreatureScript
 {
@@ -155,7 +225,7 @@ public:
                 player->PlayerTalkClass->SendCloseGossip();
                 return true;
             }
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()] = {}; }
+            { DMLockGuard lk(sSelMutex); StartSelection(player->GetGUID(), false); }
             ShowDifficultyMenu(player, creature);
         }
         else if (action == GOSSIP_ACTION_MAIN_INFO)
@@ -168,9 +238,10 @@ public:
         {
             uint32 diffId = action - GOSSIP_ACTION_DIFF_BASE;
             bool isRoguelike = false;
-            { std::lock_guard<std::mutex> lk(sSelMutex);
-              sSelections[player->GetGUID()].DifficultyId = diffId;
-              isRoguelike = sSelections[player->GetGUID()].IsRoguelike; }
+            { DMLockGuard lk(sSelMutex);
+              PlayerDMSelection& sel = TouchSelection(player->GetGUID());
+              sel.DifficultyId = diffId;
+              isRoguelike = sel.IsRoguelike; }
             if (isRoguelike)
                 ShowRoguelikeScalingMenu(player, creature);
             else
@@ -178,34 +249,34 @@ public:
         }
         else if (action == GOSSIP_ACTION_SCALE_PARTY)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].ScaleToParty = true; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).ScaleToParty = true; }
             ShowThemeMenu(player, creature);
         }
         else if (action == GOSSIP_ACTION_SCALE_TIER)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].ScaleToParty = false; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).ScaleToParty = false; }
             ShowThemeMenu(player, creature);
         }
         else if (action >= GOSSIP_ACTION_THEME_BASE && action < GOSSIP_ACTION_DUNGEON_BASE)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].ThemeId = action - GOSSIP_ACTION_THEME_BASE; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).ThemeId = action - GOSSIP_ACTION_THEME_BASE; }
             ShowDungeonMenu(player, creature);
         }
         else if (action == GOSSIP_ACTION_DUNGEON_RANDOM)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].MapId = 0; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).MapId = 0; }
             ShowConfirmMenu(player, creature);
         }
         else if (action >= GOSSIP_ACTION_DUNGEON_BASE && action < GOSSIP_ACTION_CONFIRM)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].MapId = action - GOSSIP_ACTION_DUNGEON_BASE; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).MapId = action - GOSSIP_ACTION_DUNGEON_BASE; }
             ShowConfirmMenu(player, creature);
         }
         else if (action == GOSSIP_ACTION_CONFIRM)
             StartChallenge(player, creature);
         else if (action == GOSSIP_ACTION_CANCEL)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections.erase(player->GetGUID()); }
+            { DMLockGuard lk(sSelMutex); sSelections.erase(player->GetGUID()); }
             ShowMainMenu(player, creature);
         }
         // ---- Roguelike Actions ----
@@ -218,25 +289,23 @@ public:
                 player->PlayerTalkClass->SendCloseGossip();
                 return true;
             }
-            { std::lock_guard<std::mutex> lk(sSelMutex);
-              sSelections[player->GetGUID()] = {};
-              sSelections[player->GetGUID()].IsRoguelike = true; }
+            { DMLockGuard lk(sSelMutex); StartSelection(player->GetGUID(), true); }
             ShowRoguelikeDifficultyMenu(player, creature);
         }
         else if (action == GOSSIP_ACTION_ROGUELIKE_SCALE_PARTY)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].ScaleToParty = true; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).ScaleToParty = true; }
             ShowRoguelikeThemeMenu(player, creature);
         }
         else if (action == GOSSIP_ACTION_ROGUELIKE_SCALE_TIER)
         {
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].ScaleToParty = false; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).ScaleToParty = false; }
             ShowRoguelikeThemeMenu(player, creature);
         }
         else if (action >= GOSSIP_ACTION_ROGUELIKE_THEME && action < GOSSIP_ACTION_ROGUELIKE_QUIT)
         {
             uint32 themeId = action - GOSSIP_ACTION_ROGUELIKE_THEME;
-            { std::lock_guard<std::mutex> lk(sSelMutex); sSelections[player->GetGUID()].ThemeId = themeId; }
+            { DMLockGuard lk(sSelMutex); TouchSelection(player->GetGUID()).ThemeId = themeId; }
             StartRoguelike(player, creature);
         }
         else if (action == GOSSIP_ACTION_ROGUELIKE_QUIT)
@@ -292,25 +361,10 @@ private:
     void ShowDifficultyMenu(Player* player, Creature* creature)
     {
         player->PlayerTalkClass->ClearMenus();
-        uint8 lvl = player->GetLevel();
-
-        for (const auto& d : sDMConfig->GetDifficulties())
-        {
-            char buf[256];
-            if (!d.IsValidForLevel(lvl))
-                snprintf(buf, sizeof(buf), "|cFF808080%s|r (Lv %u-%u) - |cFFFF0000Requires %u+|r",
-                    d.Name.c_str(), d.MinLevel, d.MaxLevel, d.MinLevel);
-            else if (!d.IsOnLevelFor(lvl))
-                snprintf(buf, sizeof(buf), "%s |cFF808080(Lv %u-%u — Easy)|r",
-                    d.Name.c_str(), d.MinLevel, d.MaxLevel);
-            else
-                snprintf(buf, sizeof(buf), "|cFF00FF00%s|r (Lv %u-%u)",
-                    d.Name.c_str(), d.MinLevel, d.MaxLevel);
-
-            AddGossipItemFor(player,
-                d.IsValidForLevel(lvl) ? GOSSIP_ICON_BATTLE : GOSSIP_ICON_CHAT,
-                buf, GOSSIP_SENDER_MAIN, GOSSIP_ACTION_DIFF_BASE + d.Id);
-        }
+        DMConfigPin cfg = DMConfig::Instance()->Pin();
+        for (const MenuLine& line : cfg->GetDifficultyMenu(player->GetLevel(), false))
+            AddGossipItemFor(player, line.Enabled ? GOSSIP_ICON_BATTLE : GOSSIP_ICON_CHAT,
+                line.Text, GOSSIP_SENDER_MAIN, GOSSIP_ACTION_DIFF_BASE + line.Id);
         AddGossipItemFor(player, GOSSIP_ICON_CHAT, "|cFFFF0000<< Back|r", GOSSIP_SENDER_MAIN, GOSSIP_ACTION_CANCEL);
         SendGossipMenuFor(player, DEFAULT_GOSSIP_MESSAGE, creature->GetGUID());
     }
@@ -320,10 +374,7 @@ private:
         player->PlayerTalkClass->ClearMenus();
 
         PlayerDMSelection sel;
-        { std::lock_guard<std::mutex> lk(sSelMutex);
-          auto it = sSelections.find(player->GetGUID());
-          if (it == sSelections.end()) { player->PlayerTalkClass->SendCloseGossip(); return; }
-          sel = it->second; }
+        if (!FindSelection(player->GetGUID(), sel)) { player->PlayerTalkClass->SendCloseGossip(); return; }
 
         const DifficultyTier* diff = sDMConfig->GetDifficulty(sel.DifficultyId);
         if (!diff) { player->PlayerTalkClass->SendCloseGossip(); return; }
@@ -360,27 +411,22 @@ private:
     {
         player->PlayerTalkClass->ClearMenus();
 
-        uint32 diffId;
-        { std::lock_guard<std::mutex> lk(sSelMutex);
-          auto it = sSelections.find(player->GetGUID());
-          if (it == sSelections.end()) { player->PlayerTalkClass->SendCloseGossip(); return; }
-          diffId = it->second.DifficultyId; }
+        PlayerDMSelection sel;
+        if (!FindSelection(player->GetGUID(), sel)) { player->PlayerTalkClass->SendCloseGossip(); return; }
+        uint32 diffId = sel.DifficultyId;
 
-        const DifficultyTier* diff = sDMConfig->GetDifficulty(diffId);
+        DMConfigPin cfg = DMConfig::Instance()->Pin();
+        const DifficultyTier* diff = cfg->GetDifficulty(diffId);
         if (!diff) { player->PlayerTalkClass->SendCloseGossip(); return; }
 
-        auto dungeons = sDMConfig->GetDungeonsForLevel(diff->MinLevel, diff->MaxLevel);
+        MenuSpan dungeons = cfg->GetDungeonMenu(diffId);
 
         AddGossipItemFor(player, GOSSIP_ICON_BATTLE, "|cFFFFD700Random Dungeon|r",
             GOSSIP_SENDER_MAIN, GOSSIP_ACTION_DUNGEON_RANDOM);
 
-        for (const auto* dg : dungeons)
-        {
-            char buf[128];
-            snprintf(buf, sizeof(buf), "%s (Lv %u-%u)", dg->Name.c_str(), dg->MinLevel, dg->MaxLevel);
-            AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, buf,
-                GOSSIP_SENDER_MAIN, GOSSIP_ACTION_DUNGEON_BASE + dg->MapId);
-        }
+        for (const MenuLine& line : dungeons)
+            AddGossipItemFor(player, GOSSIP_ICON_INTERACT_1, line.Text,
+                GOSSIP_SENDER_MAIN, GOSSIP_ACTION_DUNGEON_BASE + line.Id);
 
         if (dungeons.empty())
             AddGossipItemFor(player, GOSSIP_ICON_CHAT,
@@ -395,10 +441,7 @@ private:
         player->PlayerTalkClass->ClearMenus();
 
         PlayerDMSelection sel;
-        { std::lock_guard<std::mutex> lk(sSelMutex);
-          auto it = sSelections.find(player->GetGUID());
-          if (it == sSelections.end()) { player->PlayerTalkClass->SendCloseGossip(); return; }
-          sel = it->second; }
+        if (!FindSelection(player->GetGUID(), sel)) { player->PlayerTalkClass->SendCloseGossip(); return; }
 
         const DifficultyTier* diff = sDMConfig->GetDifficulty(sel.DifficultyId);
         const Theme*          theme = sDMConfig->GetTheme(sel.ThemeId);
@@ -714,7 +757,6 @@ private:
     void ShowRoguelikeDifficultyMenu(Player* player, Creature* creature)
     {
         player->PlayerTalkClass->ClearMenus();
-        uint8 lvl = player->GetLevel();
 
         ChatHandler(player->GetSession()).SendSysMessage(
             "|cFF00FFFF========== Roguelike Mode ==========|r");
@@ -727,20 +769,10 @@ private:
         ChatHandler(player->GetSession()).SendSysMessage(
             "|cFF00FFFF========================================|r");
 
-        for (const auto& d : sDMConfig->GetDifficulties())
-        {
-            char buf[256];
-            if (!d.IsValidForLevel(lvl))
-                snprintf(buf, sizeof(buf), "|cFF808080%s|r (Lv %u-%u) - |cFFFF0000Requires %u+|r",
-                    d.Name.c_str(), d.MinLevel, d.MaxLevel, d.MinLevel);
-            else
-                snprintf(buf, sizeof(buf), "|cFF00FFFF%s|r (Lv %u-%u)",
-                    d.Name.c_str(), d.MinLevel, d.MaxLevel);
-
-            AddGossipItemFor(player,
-                d.IsValidForLevel(lvl) ? GOSSIP_ICON_BATTLE : GOSSIP_ICON_CHAT,
-                buf, GOSSIP_SENDER_MAIN, GOSSIP_ACTION_DIFF_BASE + d.Id);
-        }
+        DMConfigPin cfg = DMConfig::Instance()->Pin();
+        for (const MenuLine& line : cfg->GetDifficultyMenu(player->GetLevel(), true))
+            AddGossipItemFor(player, line.Enabled ? GOSSIP_ICON_BATTLE : GOSSIP_ICON_CHAT,
+                line.Text, GOSSIP_SENDER_MAIN, GOSSIP_ACTION_DIFF_BASE + line.Id);
         AddGossipItemFor(player, GOSSIP_ICON_CHAT, "|cFFFF0000<< Back|r",
             GOSSIP_SENDER_MAIN, GOSSIP_ACTION_CANCEL);
         SendGossipMenuFor(player, DEFAULT_GOSSIP_MESSAGE, creature->GetGUID());
@@ -783,14 +815,12 @@ private:
         player->PlayerTalkClass->SendCloseGossip();
 
         PlayerDMSelection sel;
-        { std::lock_guard<std::mutex> lk(sSelMutex);
-          auto it = sSelections.find(player->GetGUID());
-          if (it == sSelections.end()) {
-              ChatHandler(player->GetSession()).SendSysMessage(
-                  "|cFFFF0000[Roguelike]|r Selection expired. Try again.");
-              return; }
-          sel = it->second;
-          sSelections.erase(it); }
+        if (!FindSelection(player->GetGUID(), sel, true))
+        {
+            ChatHandler(player->GetSession()).SendSysMessage(
+                "|cFFFF0000[Roguelike]|r Selection expired. Try again.");
+            return;
+        }
 
         const DifficultyTier* diff = sDMConfig->GetDifficulty(sel.DifficultyId);
         if (!diff || !diff->IsValidForLevel(player->GetLevel()))
@@ -819,13 +849,11 @@ private:
         player->PlayerTalkClass->SendCloseGossip();
 
         PlayerDMSelection sel;
-        { std::lock_guard<std::mutex> lk(sSelMutex);
-          auto it = sSelections.find(player->GetGUID());
-          if (it == sSelections.end()) {
-              ChatHandler(player->GetSession()).SendSysMessage("|cFFFF0000[Dungeon Master]|r Selection expired. Try again.");
-              return; }
-          sel = it->second;
-          sSelections.erase(it); }
+        if (!FindSelection(player->GetGUID(), sel, true))
+        {
+            ChatHandler(player->GetSession()).SendSysMessage("|cFFFF0000[Dungeon Master]|r Selection expired. Try again.");
+            return;
+        }
 
         const DifficultyTier* diff = sDMConfig->GetDifficulty(sel.DifficultyId);
         if (!diff || !diff->IsValidForLevel(player->GetLevel()))
@@ -838,7 +866,7 @@ private:
         uint32 mapId = sel.MapId;
         if (mapId == 0)
         {
-            auto dgs = sDMConfig->GetDungeonsForLevel(diff->MinLevel, diff->MaxLevel);
+            DungeonSpan dgs = sDMConfig->GetDungeonsForDifficulty(sel.DifficultyId);
             if (dgs.empty()) {
                 ChatHandler(player->GetSession()).SendSysMessage("|cFFFF0000[Dungeon Master]|r No dungeons available!");
                 return; }
@@ -888,7 +916,21 @@ private:
     }
 };
 
+// Drops a half-finished selection when its player logs out.
+class npc_dungeon_master_player : public PlayerScript
+{
+public:
+    npc_dungeon_master_player() : PlayerScript("npc_dungeon_master_player") {}
+
+    void OnPlayerLogout(Player* player) override
+    {
+        DMLockGuard lk(sSelMutex);
+        sSelections.erase(player->GetGUID());
+    }
+};
+
 void AddSC_npc_dungeon_master()
 {
     new npc_dungeon_master();
+    new npc_dungeon_master_player();
 }
@@ -0,0 +1,713 @@
+/*
+ * mod-dungeon-master — dm_balance.cpp
+ * Monte Carlo balancing simulator for roguelike scaling. Reads
+ * mod_dungeon_master.conf, builds floors the way PopulateDungeon does
+ * (difficulty and party multipliers, tier scaling, affixes, elites, rares,
+ * bosses) and fights them with a party model whose DPS and effective HP grow
+ * with buff stacks. Reports floors reached and time-to-kill curves per tier.
+ *
+ *   dm_balance [--conf FILE] [--runs N] [--threads N] [--seed N]
+ *              [--set Key=Value]... [--sweep Key=v1,v2,...]... [--csv FILE]
+ *
+ * Keys are conf keys (e.g. DungeonMaster.Roguelike.ExponentialFactor) or the
+ * model keys below (Sim.*). --sweep runs every combination of the listed values.
+ *
+ * The model is normalized to a base creature (creature_classlevelstats at the
+ * party's level, difficulty 1.0, party of one): it has 1 HP unit and deals
+ * 1 damage unit per second. Player DPS/EHP are expressed in those units.
+ */
+
+#include "DMConfigParse.h"
+#include "DMRoguelikeMath.h"
+#include "DMScalingMath.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+using namespace DungeonMaster::Core;
+
+namespace
+{
+
+using KeyMap = std::unordered_map<std::string, std::string>;
+
+constexpr size_t AFFIX_COUNT = std::size(AFFIX_SCALING);
+
+// PopulateDungeon uses a fixed 1.5 for elite melee damage; the
+// Scaling.EliteDamageMult conf value is not applied.
+constexpr float ELITE_DAMAGE_MULT = 1.5f;
+
+// Hard cap on one fight; a party that can't finish in this time is counted as wiped.
+constexpr float MAX_FIGHT_SEC = 900.0f;
+
+struct BalanceConfig
+{
+    std::string Label;
+
+    // ---- From mod_dungeon_master.conf ----
+    DifficultyTier Difficulty;
+    float    PerPlayerHealth = 0.25f;
+    float    PerPlayerDamage = 0.10f;
+    float    SoloMultiplier  = 0.5f;
+    float    EliteHealthMult = 2.0f;
+    float    BossHealthMult  = 8.0f;
+    float    BossDamageMult  = 1.5f;
+    float    RareHealthMult  = 4.0f;
+    float    RareDamageMult  = 2.0f;
+    uint32_t EliteChance     = 20;
+    uint32_t RareSpawnChance = 5;
+    uint32_t BossCount       = 1;
+    uint32_t TransitionDelay = 30;
+    float    HpScaling       = 0.10f;
+    float    DmgScaling      = 0.08f;
+    float    ArmorScaling    = 0.05f;
+    uint32_t ExpThreshold    = 5;
+    float    ExpFactor       = 1.15f;
+    uint32_t AffixStartTier  = 3;
+    uint32_t SecondAffixTier = 7;
+    uint32_t ThirdAffixTier  = 10;
+    uint32_t MaxBuffs        = 20;
+
+    // ---- Model (Sim.*) ----
+    std::array<AffixScaling, AFFIX_COUNT> Affixes{};
+    float    BuffPctPerStack = BUFF_PCT_PER_STACK;
+    bool     CapBuffs        = false;   // Sim.CapBuffs: apply Roguelike.MaxBuffs
+    uint32_t PartySize       = 5;
+    float    PlayerDps       = 0.25f;   // base creature HP per second
+    float    PlayerEhp       = 100.0f;  // seconds one base creature needs to kill a player
+    float    Sustain         = 0.006f;  // fraction of party EHP healed per second in combat
+    float    SkillSigma      = 0.2f;    // per-player log-normal spread of DPS/EHP
+    float    PhysicalShare   = 0.5f;    // share of party damage reduced by creature armor
+    float    BaseArmorDR     = 0.3f;    // creature armor damage reduction at tier 1
+    float    BossSpellShare  = 0.5f;    // boss spell damage on top of melee
+    uint32_t MobsMin         = 60;
+    uint32_t MobsMax         = 150;
+    uint32_t PackMin         = 1;
+    uint32_t PackMax         = 3;
+    float    Downtime        = 6.0f;    // seconds between pulls
+    uint32_t MaxFloors       = 40;
+};
+
+float GetFloat(KeyMap const& m, char const* key, float def)
+{
+    auto it = m.find(key);
+    if (it == m.end()) return def;
+    try { return std::stof(StripQuotes(it->second)); }
+    catch (...) { std::fprintf(stderr, "dm_balance: bad value for %s\n", key); return def; }
+}
+
+uint32_t GetUInt(KeyMap const& m, char const* key, uint32_t def)
+{
+    auto it = m.find(key);
+    if (it == m.end()) return def;
+    try { return static_cast<uint32_t>(std::stoul(StripQuotes(it->second))); }
+    catch (...) { std::fprintf(stderr, "dm_balance: bad value for %s\n", key); return def; }
+}
+
+bool BuildConfig(KeyMap const& m, BalanceConfig& c)
+{
+    std::vector<DifficultyTier> tiers;
+    for (uint32_t i = 1; i <= 10; ++i)
+    {
+        auto it = m.find("DungeonMaster.Difficulty." + std::to_string(i));
+        if (it == m.end() || StripQuotes(it->second).empty())
+            break;
+        DifficultyTier t;
+        if (ParseDifficultyTier(it->second, i, t))
+            tiers.push_back(t);
+    }
+    if (tiers.empty())
+    {
+        DifficultyTier def;
+        def.Id = 1; def.Name = "Normal";
+        tiers.push_back(def);
+    }
+
+    uint32_t diffId = GetUInt(m, "Sim.Difficulty", tiers.back().Id);
+    DifficultyTier const* d = FindDifficulty(tiers, diffId);
+    if (!d)
+    {
+        std::fprintf(stderr, "dm_balance: no difficulty %u in the conf\n", diffId);
+        return false;
+    }
+    c.Difficulty = *d;
+
+    c.PerPlayerHealth = GetFloat(m, "DungeonMaster.Scaling.PerPlayerHealth", c.PerPlayerHealth);
+    c.PerPlayerDamage = GetFloat(m, "DungeonMaster.Scaling.PerPlayerDamage", c.PerPlayerDamage);
+    c.SoloMultiplier  = GetFloat(m, "DungeonMaster.Scaling.SoloMultiplier",  c.SoloMultiplier);
+    c.EliteHealthMult = GetFloat(m, "DungeonMaster.Scaling.EliteHealthMult", c.EliteHealthMult);
+    c.BossHealthMult  = GetFloat(m, "DungeonMaster.Scaling.BossHealthMult",  c.BossHealthMult);
+    c.BossDamageMult  = GetFloat(m, "DungeonMaster.Scaling.BossDamageMult",  c.BossDamageMult);
+    c.RareHealthMult  = GetFloat(m, "DungeonMaster.Scaling.RareHealthMult",  c.RareHealthMult);
+    c.RareDamageMult  = GetFloat(m, "DungeonMaster.Scaling.RareDamageMult",  c.RareDamageMult);
+    c.EliteChance     = GetUInt (m, "DungeonMaster.Dungeon.EliteChance",     c.EliteChance);
+    c.RareSpawnChance = GetUInt (m, "DungeonMaster.Dungeon.RareSpawnChance", c.RareSpawnChance);
+    c.BossCount       = GetUInt (m, "DungeonMaster.Dungeon.BossCount",       c.BossCount);
+    c.TransitionDelay = GetUInt (m, "DungeonMaster.Roguelike.TransitionDelay",      c.TransitionDelay);
+    c.HpScaling       = GetFloat(m, "DungeonMaster.Roguelike.HpScalingPerTier",     c.HpScaling);
+    c.DmgScaling      = GetFloat(m, "DungeonMaster.Roguelike.DmgScalingPerTier",    c.DmgScaling);
+    c.ArmorScaling    = GetFloat(m, "DungeonMaster.Roguelike.ArmorScalingPerTier",  c.ArmorScaling);
+    c.ExpThreshold    = GetUInt (m, "DungeonMaster.Roguelike.ExponentialThreshold", c.ExpThreshold);
+    c.ExpFactor       = GetFloat(m, "DungeonMaster.Roguelike.ExponentialFactor",    c.ExpFactor);
+    c.AffixStartTier  = GetUInt (m, "DungeonMaster.Roguelike.AffixStartTier",       c.AffixStartTier);
+    c.SecondAffixTier = GetUInt (m, "DungeonMaster.Roguelike.SecondAffixTier",      c.SecondAffixTier);
+    c.ThirdAffixTier  = GetUInt (m, "DungeonMaster.Roguelike.ThirdAffixTier",       c.ThirdAffixTier);
+    c.MaxBuffs        = GetUInt (m, "DungeonMaster.Roguelike.MaxBuffs",             c.MaxBuffs);
+
+    for (size_t i = 0; i < AFFIX_COUNT; ++i)
+    {
+        AffixScaling a = AFFIX_SCALING[i];
+        std::string p = std::string("Sim.Affix.") + a.Name + ".";
+        a.TrashHpMult     = GetFloat(m, (p + "TrashHp").c_str(),     a.TrashHpMult);
+        a.TrashDmgMult    = GetFloat(m, (p + "TrashDmg").c_str(),    a.TrashDmgMult);
+        a.BossHpMult      = GetFloat(m, (p + "BossHp").c_str(),      a.BossHpMult);
+        a.BossDmgMult     = GetFloat(m, (p + "BossDmg").c_str(),     a.BossDmgMult);
+        a.EliteChanceMult = GetFloat(m, (p + "EliteChance").c_str(), a.EliteChanceMult);
+        c.Affixes[i] = a;
+    }
+
+    c.BuffPctPerStack = GetFloat(m, "Sim.BuffPctPerStack", c.BuffPctPerStack);
+    c.CapBuffs        = GetUInt (m, "Sim.CapBuffs",        c.CapBuffs) != 0;
+    c.PartySize       = std::clamp<uint32_t>(GetUInt(m, "Sim.PartySize", c.PartySize), 1, 5);
+    c.PlayerDps       = GetFloat(m, "Sim.PlayerDps",       c.PlayerDps);
+    c.PlayerEhp       = GetFloat(m, "Sim.PlayerEhp",       c.PlayerEhp);
+    c.Sustain         = GetFloat(m, "Sim.Sustain",         c.Sustain);
+    c.SkillSigma      = GetFloat(m, "Sim.SkillSigma",      c.SkillSigma);
+    c.PhysicalShare   = GetFloat(m, "Sim.PhysicalShare",   c.PhysicalShare);
+    c.BaseArmorDR     = std::clamp(GetFloat(m, "Sim.BaseArmorDR", c.BaseArmorDR), 0.0f, 0.95f);
+    c.BossSpellShare  = GetFloat(m, "Sim.BossSpellShare",  c.BossSpellShare);
+    c.MobsMin         = GetUInt (m, "Sim.MobsMin",         c.MobsMin);
+    c.MobsMax         = std::max(c.MobsMin, GetUInt(m, "Sim.MobsMax", c.MobsMax));
+    c.PackMin         = std::max(1u, GetUInt(m, "Sim.PackMin", c.PackMin));
+    c.PackMax         = std::max(c.PackMin, GetUInt(m, "Sim.PackMax", c.PackMax));
+    c.Downtime        = GetFloat(m, "Sim.Downtime",        c.Downtime);
+    c.MaxFloors       = std::max(1u, GetUInt(m, "Sim.MaxFloors", c.MaxFloors));
+    return c.PlayerDps > 0.0f && c.PlayerEhp > 0.0f;
+}
+
+// ---- Per-tier scaling, computed once per configuration ----
+
+struct TierScaling
+{
+    float HpMult       = 1.0f;   // CalculateHealthMultiplier
+    float DmgMult      = 1.0f;   // CalculateDamageMultiplier
+    float BossDmgMult  = 1.0f;   // party + tier only (bossOnlyDmgMult)
+    float PartyDpsMult = 1.0f;   // creature armor vs party physical damage
+    uint32_t Affixes   = 0;
+};
+
+std::vector<TierScaling> BuildTierTable(BalanceConfig const& c)
+{
+    std::vector<TierScaling> out(c.MaxFloors + 1);
+    float r0 = c.BaseArmorDR / (1.0f - c.BaseArmorDR);
+    for (uint32_t tier = 1; tier <= c.MaxFloors; ++tier)
+    {
+        TierScaling& t = out[tier];
+        float tierHp  = TierScalingMultiplier(tier, c.HpScaling,  c.ExpThreshold, c.ExpFactor);
+        float tierDmg = TierScalingMultiplier(tier, c.DmgScaling, c.ExpThreshold, c.ExpFactor);
+        t.HpMult  = SessionMultiplier(c.Difficulty.HealthMultiplier, c.PartySize,
+            c.SoloMultiplier, c.PerPlayerHealth, tierHp);
+        t.DmgMult = SessionMultiplier(c.Difficulty.DamageMultiplier, c.PartySize,
+            c.SoloMultiplier, c.PerPlayerDamage, tierDmg);
+        t.BossDmgMult = PartyMultiplier(1.0f, c.PartySize, c.SoloMultiplier, c.PerPlayerDamage) * tierDmg;
+
+        // Armor A scales by m; reduction A/(A+K) is rebuilt from the tier-1 value.
+        float r  = r0 * TierArmorMultiplier(tier, c.ArmorScaling);
+        float dr = r / (r + 1.0f);
+        t.PartyDpsMult = (1.0f - c.PhysicalShare)
+            + c.PhysicalShare * (1.0f - dr) / (1.0f - c.BaseArmorDR);
+
+        t.Affixes = AffixCountForTier(tier, c.AffixStartTier, c.SecondAffixTier, c.ThirdAffixTier);
+    }
+    return out;
+}
+
+// ---- Fight model ----
+
+struct Enemy
+{
+    float Hp;
+    float Dps;
+};
+
+struct PartyState
+{
+    float Dps[5];
+    float MaxEhp[5];
+    uint32_t Size;
+};
+
+// Focus fire in order; damage lands on the first living player, who is
+// healed by the party's sustain. Dead players rejoin after the pull.
+// Returns fight duration, or a negative value on a wipe.
+float Fight(PartyState const& party, Enemy* enemies, size_t count, float dpsMult, float sustain)
+{
+    float hp[5];
+    float dps = 0.0f, heal = 0.0f;
+    for (uint32_t i = 0; i < party.Size; ++i)
+    {
+        hp[i] = party.MaxEhp[i];
+        dps  += party.Dps[i];
+        heal += party.MaxEhp[i];
+    }
+    dps *= dpsMult;
+
+    float incoming = 0.0f;
+    for (size_t i = 0; i < count; ++i)
+        incoming += enemies[i].Dps;
+
+    float healRate = heal * sustain;
+    uint32_t tank = 0;
+    size_t target = 0;
+    float elapsed = 0.0f;
+
+    while (target < count)
+    {
+        float net   = incoming - healRate;
+        float tKill = enemies[target].Hp / dps;
+
+        if (net > 0.0f && hp[tank] / net < tKill)
+        {
+            float tDie = hp[tank] / net;
+            enemies[target].Hp -= dps * tDie;
+            elapsed += tDie;
+
+            // Tank down: lose their damage and their share of healing.
+            dps      -= party.Dps[tank] * dpsMult;
+            healRate -= party.MaxEhp[tank] * sustain;
+            if (++tank >= party.Size || dps <= 0.0f)
+                return -1.0f;
+        }
+        else
+        {
+            elapsed += tKill;
+            hp[tank] = std::min(party.MaxEhp[tank], hp[tank] - net * tKill);
+            incoming -= enemies[target].Dps;
+            ++target;
+        }
+
+        if (elapsed > MAX_FIGHT_SEC)
+            return -1.0f;
+    }
+    return elapsed;
+}
+
+enum WipeCause : uint8_t { WIPE_NONE, WIPE_TRASH, WIPE_RARE, WIPE_BOSS, WIPE_CAUSES };
+
+// ---- Accumulated results ----
+
+struct TierStats
+{
+    uint64_t Reached   = 0;
+    uint64_t Cleared   = 0;
+    double   TrashTtk  = 0.0;   // seconds per trash pull
+    uint64_t TrashN    = 0;
+    double   BossTtk   = 0.0;   // seconds per boss kill
+    uint64_t BossN     = 0;
+    double   BossEhp   = 0.0;   // party EHP at each boss pull
+    double   BossNet   = 0.0;   // boss DPS left after sustain (0 if out-healed)
+    double   FloorTime = 0.0;   // seconds per cleared floor
+};
+
+struct Stats
+{
+    std::vector<uint64_t>  FloorHist;   // runs by floors cleared
+    std::vector<TierStats> Tiers;
+    uint64_t Wipes[WIPE_CAUSES] = {};
+    uint64_t Runs      = 0;
+    double   RunTime   = 0.0;
+    uint32_t PeakStacks = 0;
+
+    void Init(uint32_t maxFloors)
+    {
+        FloorHist.assign(maxFloors + 1, 0);
+        Tiers.assign(maxFloors + 1, {});
+    }
+
+    void Merge(Stats const& o)
+    {
+        for (size_t i = 0; i < FloorHist.size(); ++i)
+            FloorHist[i] += o.FloorHist[i];
+        for (size_t i = 0; i < Tiers.size(); ++i)
+        {
+            TierStats& a = Tiers[i];
+            TierStats const& b = o.Tiers[i];
+            a.Reached += b.Reached;  a.Cleared += b.Cleared;
+            a.TrashTtk += b.TrashTtk; a.TrashN += b.TrashN;
+            a.BossTtk += b.BossTtk;   a.BossN += b.BossN;
+            a.BossEhp += b.BossEhp;   a.BossNet += b.BossNet;
+            a.FloorTime += b.FloorTime;
+        }
+        for (int i = 0; i < WIPE_CAUSES; ++i)
+            Wipes[i] += o.Wipes[i];
+        Runs    += o.Runs;
+        RunTime += o.RunTime;
+        PeakStacks = std::max(PeakStacks, o.PeakStacks);
+    }
+};
+
+class RunSimulator
+{
+public:
+    RunSimulator(BalanceConfig const& cfg, std::vector<TierScaling> const& tiers, uint64_t seed)
+        : _cfg(cfg), _tiers(tiers), _rng(seed) { }
+
+    void Run(Stats& st)
+    {
+        BalanceConfig const& c = _cfg;
+
+        // Gear/skill spread, fixed for the whole run
+        std::lognormal_distribution<float> skill(0.0f, c.SkillSigma);
+        float baseDps[5], baseEhp[5];
+        for (uint32_t i = 0; i < c.PartySize; ++i)
+        {
+            baseDps[i] = c.PlayerDps * skill(_rng);
+            baseEhp[i] = c.PlayerEhp * skill(_rng);
+        }
+
+        uint32_t stacks = 0;
+        uint32_t cleared = 0;
+        double runTime = 0.0;
+        WipeCause cause = WIPE_NONE;
+
+        for (uint32_t tier = 1; tier <= c.MaxFloors; ++tier)
+        {
+            TierStats& ts = st.Tiers[tier];
+            ++ts.Reached;
+
+            PartyState party;
+            party.Size = c.PartySize;
+            float buff = 1.0f + c.BuffPctPerStack / 100.0f * stacks;
+            for (uint32_t i = 0; i < c.PartySize; ++i)
+            {
+                party.Dps[i]    = baseDps[i] * buff;
+                party.MaxEhp[i] = baseEhp[i] * buff;
+            }
+
+            double floorTime = 0.0;
+            cause = SimulateFloor(_tiers[tier], party, ts, floorTime);
+            runTime += floorTime;
+            if (cause != WIPE_NONE)
+                break;
+
+            ++ts.Cleared;
+            ts.FloorTime += floorTime;
+            ++cleared;
+
+            // OnDungeonCompleted: tier up, new affixes, one more buff stack
+            if (!c.CapBuffs || stacks < c.MaxBuffs)
+                ++stacks;
+            runTime += c.TransitionDelay;
+        }
+
+        ++st.Runs;
+        ++st.FloorHist[cleared];
+        ++st.Wipes[cause];
+        st.RunTime += runTime;
+        st.PeakStacks = std::max(st.PeakStacks, stacks);
+    }
+
+private:
+    float Roll01() { return std::uniform_real_distribution<float>(0.0f, 1.0f)(_rng); }
+    uint32_t RollInt(uint32_t lo, uint32_t hi) { return std::uniform_int_distribution<uint32_t>(lo, hi)(_rng); }
+
+    WipeCause SimulateFloor(TierScaling const& t, PartyState const& party, TierStats& ts, double& time)
+    {
+        BalanceConfig const& c = _cfg;
+
+        // SelectAffixesForTier: shuffle the pool, take the first N
+        float trashHp = 1.0f, trashDmg = 1.0f, bossHp = 1.0f, bossDmg = 1.0f, eliteMult = 1.0f;
+        if (t.Affixes)
+        {
+            std::array<uint32_t, AFFIX_COUNT> order;
+            for (uint32_t i = 0; i < AFFIX_COUNT; ++i) order[i] = i;
+            std::shuffle(order.begin(), order.end(), _rng);
+            for (uint32_t i = 0; i < t.Affixes && i < AFFIX_COUNT; ++i)
+            {
+                AffixScaling const& a = c.Affixes[order[i]];
+                trashHp *= a.TrashHpMult;  trashDmg *= a.TrashDmgMult;
+                bossHp  *= a.BossHpMult;   bossDmg  *= a.BossDmgMult;
+                eliteMult *= a.EliteChanceMult;
+            }
+        }
+
+        uint32_t mobs = RollInt(c.MobsMin, c.MobsMax);
+        bool rare = c.RareSpawnChance && RollInt(1, 100) <= c.RareSpawnChance;
+        uint32_t rareAt = rare ? RollInt(mobs / 3, std::max(mobs / 3, mobs * 2 / 3)) : UINT32_MAX;
+
+        Enemy pack[16];
+        uint32_t spawned = 0;
+        while (spawned < mobs)
+        {
+            uint32_t n = std::min(RollInt(c.PackMin, c.PackMax), mobs - spawned);
+            n = std::min<uint32_t>(n, std::size(pack));
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                bool elite = RollInt(1, 100) <= c.EliteChance;
+                if (eliteMult > 1.0f && !elite)
+                    elite = RollInt(1, 100) <= static_cast<uint32_t>(c.EliteChance * eliteMult);
+                pack[i].Hp  = t.HpMult  * (elite ? c.EliteHealthMult : 1.0f) * trashHp;
+                pack[i].Dps = t.DmgMult * (elite ? ELITE_DAMAGE_MULT : 1.0f) * trashDmg;
+            }
+
+            float d = Fight(party, pack, n, t.PartyDpsMult * (0.85f + 0.3f * Roll01()), c.Sustain);
+            if (d < 0.0f)
+                return WIPE_TRASH;
+            ts.TrashTtk += d;
+            ++ts.TrashN;
+            time += d + c.Downtime;
+
+            if (spawned < rareAt && spawned + n >= rareAt)
+            {
+                Enemy r{ t.HpMult * c.RareHealthMult * trashHp, t.DmgMult * c.RareDamageMult * trashDmg };
+                float rd = Fight(party, &r, 1, t.PartyDpsMult, c.Sustain);
+                if (rd < 0.0f)
+                    return WIPE_RARE;
+                time += rd + c.Downtime;
+            }
+            spawned += n;
+        }
+
+        for (uint32_t b = 0; b < c.BossCount; ++b)
+        {
+            Enemy boss{ t.HpMult * c.BossHealthMult * bossHp,
+                        t.BossDmgMult * c.BossDamageMult * bossDmg * (1.0f + c.BossSpellShare) };
+
+            float ehp = 0.0f;
+            for (uint32_t i = 0; i < party.Size; ++i)
+                ehp += party.MaxEhp[i];
+            ts.BossEhp += ehp;
+            ts.BossNet += std::max(0.0f, boss.Dps - ehp * c.Sustain);
+
+            float d = Fight(party, &boss, 1, t.PartyDpsMult, c.Sustain);
+            if (d < 0.0f)
+                return WIPE_BOSS;
+            ts.BossTtk += d;
+            ++ts.BossN;
+            time += d + c.Downtime;
+        }
+        return WIPE_NONE;
+    }
+
+    BalanceConfig const& _cfg;
+    std::vector<TierScaling> const& _tiers;
+    std::mt19937 _rng;
+};
+
+uint32_t Percentile(std::vector<uint64_t> const& hist, uint64_t total, double p)
+{
+    uint64_t want = static_cast<uint64_t>(std::ceil(total * p));
+    uint64_t acc = 0;
+    for (size_t i = 0; i < hist.size(); ++i)
+    {
+        acc += hist[i];
+        if (acc >= want && acc)
+            return static_cast<uint32_t>(i);
+    }
+    return static_cast<uint32_t>(hist.size() - 1);
+}
+
+struct Sweep
+{
+    std::string Key;
+    std::vector<std::string> Values;
+};
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::string confPath = DM_DEFAULT_CONF;
+    uint64_t runs = 200000;
+    uint32_t threads = std::max(1u, std::thread::hardware_concurrency());
+    uint64_t seed = 1;
+    char const* csvPath = nullptr;
+    KeyMap overrides;
+    std::vector<Sweep> sweeps;
+
+    auto splitKv = [](char const* arg, std::string& k, std::string& v)
+    {
+        char const* eq = std::strchr(arg, '=');
+        if (!eq) return false;
+        k.assign(arg, eq);
+        v.assign(eq + 1);
+        return !k.empty();
+    };
+
+    for (int i = 1; i < argc; ++i)
+    {
+        std::string k, v;
+        if (!std::strcmp(argv[i], "--conf") && i + 1 < argc)
+            confPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--runs") && i + 1 < argc)
+            runs = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--threads") && i + 1 < argc)
+            threads = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = std::strtoull(argv[++i], nullptr, 10);
+        else if (!std::strcmp(argv[i], "--csv") && i + 1 < argc)
+            csvPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--set") && i + 1 < argc && splitKv(argv[++i], k, v))
+            overrides[k] = v;
+        else if (!std::strcmp(argv[i], "--sweep") && i + 1 < argc && splitKv(argv[++i], k, v))
+            sweeps.push_back({ k, SplitString(v, ',') });
+        else
+        {
+            std::fprintf(stderr, "usage: dm_balance [--conf FILE] [--runs N] [--threads N] [--seed N] "
+                "[--set Key=Value]... [--sweep Key=v1,v2,...]... [--csv FILE]\n");
+            return 2;
+        }
+    }
+
+    KeyMap base;
+    if (!LoadConfFile(confPath, base))
+    {
+        std::fprintf(stderr, "dm_balance: cannot read %s\n", confPath.c_str());
+        return 1;
+    }
+    for (auto const& [k, v] : overrides)
+        base[k] = v;
+
+    // Cartesian product of the sweeps
+    std::vector<BalanceConfig> configs;
+    size_t combos = 1;
+    for (Sweep const& s : sweeps)
+        combos *= std::max<size_t>(1, s.Values.size());
+    for (size_t idx = 0; idx < combos; ++idx)
+    {
+        KeyMap m = base;
+        std::string label;
+        size_t rem = idx;
+        for (Sweep const& s : sweeps)
+        {
+            if (s.Values.empty()) continue;
+            std::string const& v = s.Values[rem % s.Values.size()];
+            rem /= s.Values.size();
+            m[s.Key] = v;
+            label += (label.empty() ? "" : " ") + s.Key + "=" + v;
+        }
+
+        BalanceConfig c;
+        if (!BuildConfig(m, c))
+            return 1;
+        c.Label = label.empty() ? "conf" : label;
+        configs.push_back(std::move(c));
+    }
+
+    FILE* csv = nullptr;
+    if (csvPath)
+    {
+        csv = std::fopen(csvPath, "w");
+        if (!csv)
+        {
+            std::fprintf(stderr, "dm_balance: cannot write %s\n", csvPath);
+            return 1;
+        }
+        std::fprintf(csv, "config,tier,reach_pct,clear_pct,hp_mult,dmg_mult,affixes,"
+            "trash_ttk_s,boss_ttk_s,boss_ttd_s,floor_min\n");
+    }
+
+    std::printf("dm_balance: %s, %llu run(s) per config, %u thread(s), %zu config(s)\n",
+        confPath.c_str(), (unsigned long long)runs, threads, configs.size());
+
+    for (size_t ci = 0; ci < configs.size(); ++ci)
+    {
+        BalanceConfig const& c = configs[ci];
+        std::vector<TierScaling> tiers = BuildTierTable(c);
+
+        auto t0 = std::chrono::steady_clock::now();
+        std::vector<Stats> perThread(threads);
+        std::atomic<uint64_t> next{ 0 };
+        std::vector<std::thread> pool;
+        constexpr uint64_t BATCH = 1024;
+        for (uint32_t ti = 0; ti < threads; ++ti)
+        {
+            pool.emplace_back([&, ti]
+            {
+                Stats& st = perThread[ti];
+                st.Init(c.MaxFloors);
+                RunSimulator sim(c, tiers, seed * 1000003ull + ci * 7919ull + ti);
+                for (;;)
+                {
+                    uint64_t begin = next.fetch_add(BATCH);
+                    if (begin >= runs) break;
+                    uint64_t end = std::min(runs, begin + BATCH);
+                    for (uint64_t r = begin; r < end; ++r)
+                        sim.Run(st);
+                }
+            });
+        }
+        for (auto& t : pool)
+            t.join();
+
+        Stats st;
+        st.Init(c.MaxFloors);
+        for (Stats const& s : perThread)
+            st.Merge(s);
+        double wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+        double meanFloors = 0.0;
+        for (size_t f = 0; f < st.FloorHist.size(); ++f)
+            meanFloors += double(f) * st.FloorHist[f];
+        meanFloors /= std::max<uint64_t>(1, st.Runs);
+        uint64_t wiped = st.Runs - st.Wipes[WIPE_NONE];
+        auto pct = [](uint64_t a, uint64_t b) { return b ? 100.0 * a / b : 0.0; };
+
+        std::printf("\n[%zu/%zu] %s\n", ci + 1, configs.size(), c.Label.c_str());
+        std::printf("  party %u, difficulty %u '%s' (HP x%.2f, DMG x%.2f), %.2f s, %.1f k runs/s\n",
+            c.PartySize, c.Difficulty.Id, c.Difficulty.Name.c_str(),
+            c.Difficulty.HealthMultiplier, c.Difficulty.DamageMultiplier,
+            wall, st.Runs / wall / 1e3);
+        std::printf("  floors cleared: mean %.2f  p10 %u  p50 %u  p90 %u  p99 %u  reached cap (%u) %.2f%%\n",
+            meanFloors, Percentile(st.FloorHist, st.Runs, 0.10), Percentile(st.FloorHist, st.Runs, 0.50),
+            Percentile(st.FloorHist, st.Runs, 0.90), Percentile(st.FloorHist, st.Runs, 0.99),
+            c.MaxFloors, pct(st.Wipes[WIPE_NONE], st.Runs));
+        std::printf("  wipes: trash %.1f%%  rare %.1f%%  boss %.1f%%   mean run %.1f min   peak buff stacks %u%s\n",
+            pct(st.Wipes[WIPE_TRASH], wiped), pct(st.Wipes[WIPE_RARE], wiped), pct(st.Wipes[WIPE_BOSS], wiped),
+            st.RunTime / std::max<uint64_t>(1, st.Runs) / 60.0, st.PeakStacks,
+            (!c.CapBuffs && st.PeakStacks > c.MaxBuffs) ? " (above Roguelike.MaxBuffs, which the server does not enforce)" : "");
+
+        std::printf("  %-4s %8s %8s %7s %7s %3s %10s %10s %10s %9s\n",
+            "tier", "reach%", "clear%", "hp x", "dmg x", "afx", "trash ttk", "boss ttk", "boss ttd", "floor min");
+        for (uint32_t tier = 1; tier <= c.MaxFloors; ++tier)
+        {
+            TierStats const& ts = st.Tiers[tier];
+            if (!ts.Reached)
+                break;
+            double trash = ts.TrashN ? ts.TrashTtk / ts.TrashN : 0.0;
+            double boss  = ts.BossN ? ts.BossTtk / ts.BossN : 0.0;
+            // Time the boss needs to kill the whole party, ratio of means
+            double ttd   = ts.BossNet > 0.0 ? ts.BossEhp / ts.BossNet : 0.0;
+            double floorMin = ts.Cleared ? ts.FloorTime / ts.Cleared / 60.0 : 0.0;
+            double reach = pct(ts.Reached, st.Runs), clear = pct(ts.Cleared, ts.Reached);
+
+            // Stop printing once the tail is noise; the CSV keeps every row.
+            if (reach >= 0.01)
+            {
+                std::printf("  %-4u %8.2f %8.2f %7.2f %7.2f %3u %9.1fs %9.1fs ", tier, reach, clear,
+                    tiers[tier].HpMult, tiers[tier].DmgMult, tiers[tier].Affixes, trash, boss);
+                if (ts.BossNet > 0.0) std::printf("%9.1fs ", ttd); else std::printf("%10s ", "-");
+                std::printf("%9.1f\n", floorMin);
+            }
+
+            if (csv)
+                std::fprintf(csv, "\"%s\",%u,%.4f,%.4f,%.4f,%.4f,%u,%.3f,%.3f,%.3f,%.3f\n",
+                    c.Label.c_str(), tier, reach, clear, tiers[tier].HpMult, tiers[tier].DmgMult,
+                    tiers[tier].Affixes, trash, boss, ttd, floorMin);
+        }
+    }
+
+    if (csv)
+        std::fclose(csv);
+    return 0;
+}
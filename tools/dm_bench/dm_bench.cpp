@@ -0,0 +1,385 @@
+/*
+ * mod-dungeon-master — dm_bench.cpp
+ * Microbenchmarks for the pure-logic core (dm_core): item scoring, loot and
+ * reward selection, themed creature selection, roguelike tier math, session
+ * multipliers and config lookups, run against a seeded synthetic pool the
+ * size of a stock world DB.
+ *
+ *   dm_bench [--filter SUBSTR] [--seed N] [--save FILE] [--compare FILE [--tolerance PCT]]
+ *
+ * --save writes "name ns/op" lines; --compare reads such a file and exits
+ * non-zero if any benchmark is slower than the baseline by more than
+ * --tolerance percent (default 25).
+ */
+
+#include "DMConfigParse.h"
+#include "DMLookupTable.h"
+#include "DMLootMath.h"
+#include "DMRoguelikeMath.h"
+#include "DMScalingMath.h"
+#include "DMSpawnMath.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+#include <iterator>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace DungeonMaster::Core;
+
+namespace
+{
+
+constexpr size_t ITEM_STATS = 10;   // MAX_ITEM_PROTO_STATS
+
+struct ItemStatEntry
+{
+    uint32_t ItemStatType  = 0;
+    int32_t  ItemStatValue = 0;
+};
+
+// Synthetic pools shaped like the module's startup queries on a stock DB.
+struct BenchData
+{
+    std::vector<RewardItem>   Rewards;
+    std::vector<LootPoolItem> Loot;
+    std::map<uint32_t, std::array<ItemStatEntry, ITEM_STATS>> Stats;
+    CreaturePoolByType Trash;
+    CreaturePoolByType Bosses;
+    std::vector<DifficultyTier> Difficulties;
+    std::vector<Theme> Themes;
+
+    void Build(uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        auto roll = [&](uint32_t lo, uint32_t hi) { return std::uniform_int_distribution<uint32_t>(lo, hi)(rng); };
+
+        static char const* const kDifficulties[] = {
+            "Novice,10,19,0.6,0.6,1.0,0.5",      "Apprentice,20,29,0.8,0.8,1.5,0.7",
+            "Journeyman,30,44,1.0,1.0,2.0,0.85", "Expert,45,59,1.3,1.2,3.0,1.0",
+            "Master,60,69,1.6,1.4,4.0,1.0",      "Grandmaster,70,80,2.0,1.6,6.0,1.2",
+        };
+        static char const* const kThemes[] = {
+            "Beast Hunt,1", "Dragon's Lair,2", "Demonic Invasion,3", "Elemental Chaos,4",
+            "Giant's Keep,5", "Undead Rising,6", "Humanoid Stronghold,7", "Mechanical Mayhem,9",
+            "Random Chaos,-1",
+        };
+        for (uint32_t i = 0; i < std::size(kDifficulties); ++i)
+        {
+            DifficultyTier t;
+            if (ParseDifficultyTier(kDifficulties[i], i + 1, t))
+                Difficulties.push_back(t);
+        }
+        for (uint32_t i = 0; i < std::size(kThemes); ++i)
+        {
+            Theme t;
+            if (ParseTheme(kThemes[i], i + 1, t))
+                Themes.push_back(t);
+        }
+
+        auto makeStats = [&](uint32_t entry)
+        {
+            auto& s = Stats[entry];
+            uint32_t n = roll(0, 4);
+            for (uint32_t i = 0; i < n; ++i)
+                s[i] = { roll(3, 7), int32_t(roll(1, 60)) };
+        };
+
+        for (uint32_t i = 0; i < 3000; ++i)
+        {
+            RewardItem r;
+            r.Entry          = 100000 + i;
+            r.MinLevel       = roll(1, 80);
+            r.ItemLevel      = uint16_t(r.MinLevel * 2 + roll(0, 20));
+            r.Quality        = uint8_t(roll(2, 4));
+            r.Class          = roll(0, 1) ? 2 : 4;
+            r.SubClass       = roll(0, 4);
+            r.AllowableClass = roll(0, 9) ? -1 : int32_t(1u << roll(0, 10));
+            Rewards.push_back(r);
+            makeStats(r.Entry);
+        }
+        for (uint32_t i = 0; i < 3000; ++i)
+        {
+            LootPoolItem l;
+            l.Entry          = 200000 + i;
+            l.MinLevel       = uint8_t(roll(0, 9) ? roll(1, 80) : 0);
+            l.ItemLevel      = uint16_t(roll(5, 200));
+            l.Quality        = uint8_t(roll(0, 4));
+            l.ItemClass      = uint8_t(roll(0, 2) ? (roll(0, 1) ? 2 : 4) : 15);
+            l.SubClass       = uint8_t(roll(0, 4));
+            l.AllowableClass = roll(0, 9) ? -1 : int32_t(1u << roll(0, 10));
+            Loot.push_back(l);
+            makeStats(l.Entry);
+        }
+        for (uint32_t i = 0; i < 2000; ++i)
+            Trash[roll(1, 10)].push_back({ 100000 + i, 0, 1, 80 });
+        for (uint32_t i = 0; i < 240; ++i)
+            Bosses[roll(1, 10)].push_back({ 150000 + i, 0, 1, 80 });
+    }
+
+    float Score(uint32_t entry, uint32_t playerClass) const
+    {
+        auto it = Stats.find(entry);
+        if (it == Stats.end()) return 0.0f;
+        return ScoreItemForClass(it->second.data(), ITEM_STATS, playerClass);
+    }
+};
+
+struct Result
+{
+    std::string Name;
+    double NsPerOp = 0.0;
+};
+
+// Grows the batch until one run takes ~20 ms, then keeps the fastest of 5.
+double Measure(std::function<uint64_t(uint32_t)> const& body, uint64_t& sink)
+{
+    using Clock = std::chrono::steady_clock;
+    uint32_t n = 16;
+    for (;;)
+    {
+        auto t0 = Clock::now();
+        sink += body(n);
+        double ms = std::chrono::duration<double, std::milli>(Clock::now() - t0).count();
+        if (ms >= 20.0 || n >= (1u << 28))
+            break;
+        n *= 2;
+    }
+
+    double best = 1e300;
+    for (int rep = 0; rep < 5; ++rep)
+    {
+        auto t0 = Clock::now();
+        sink += body(n);
+        double ns = std::chrono::duration<double, std::nano>(Clock::now() - t0).count();
+        best = std::min(best, ns / n);
+    }
+    return best;
+}
+
+std::map<std::string, double> LoadBaseline(char const* path)
+{
+    std::map<std::string, double> out;
+    FILE* f = std::fopen(path, "r");
+    if (!f)
+        return out;
+    char name[128];
+    double ns;
+    while (std::fscanf(f, "%127s %lf", name, &ns) == 2)
+        out[name] = ns;
+    std::fclose(f);
+    return out;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    char const* filter = nullptr;
+    char const* savePath = nullptr;
+    char const* comparePath = nullptr;
+    uint32_t seed = 1;
+    double tolerance = 25.0;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+            filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--save") && i + 1 < argc)
+            savePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--compare") && i + 1 < argc)
+            comparePath = argv[++i];
+        else if (!std::strcmp(argv[i], "--tolerance") && i + 1 < argc)
+            tolerance = std::strtod(argv[++i], nullptr);
+        else
+        {
+            std::fprintf(stderr, "usage: dm_bench [--filter SUBSTR] [--seed N] [--save FILE] "
+                "[--compare FILE [--tolerance PCT]]\n");
+            return 2;
+        }
+    }
+
+    BenchData data;
+    data.Build(seed);
+    std::mt19937 rng(seed);
+    std::vector<uint32_t> cands;
+    LevelWindow win;
+
+    // DMConfig's id lookups: dense index over the difficulty/theme ids
+    DenseIndex diffIndex, themeIndex;
+    for (size_t i = 0; i < data.Difficulties.size(); ++i)
+        diffIndex.Set(data.Difficulties[i].Id, i);
+    for (size_t i = 0; i < data.Themes.size(); ++i)
+        themeIndex.Set(data.Themes[i].Id, i);
+
+    // Per-call inputs cycle through these so branch history doesn't settle.
+    auto level  = [](uint32_t i) { return uint8_t(10 + (i * 37) % 71); };
+    auto klass  = [](uint32_t i) { uint32_t c = 1 + (i * 7) % 11; return c == 10 ? 11u : c; };
+
+    std::vector<std::pair<char const*, std::function<uint64_t(uint32_t)>>> benches = {
+        { "ScoreItemForClass", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+                acc += uint64_t(data.Score(100000 + (i % 3000), klass(i)) * 1000.0f);
+            return acc;
+        } },
+        { "SelectLootItem", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                uint32_t c = klass(i);
+                bool eq = (i & 1) != 0;
+                if (!CollectLootCandidates(data.Loot, level(i), 2, 4, eq, eq ? c : 0, cands, win))
+                    continue;
+                if (eq && cands.size() > 3)
+                    acc += PickTopScored(cands, [&](uint32_t e) { return data.Score(e, c); }, rng);
+                else
+                    acc += cands[std::uniform_int_distribution<size_t>(0, cands.size() - 1)(rng)];
+            }
+            return acc;
+        } },
+        { "SelectRewardItem", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                uint32_t c = klass(i);
+                if (!CollectRewardCandidates(data.Rewards, level(i), uint8_t(2 + i % 3), c, cands, win))
+                    continue;
+                if (cands.size() > 3)
+                    acc += PickTopScored(cands, [&](uint32_t e) { return data.Score(e, c); }, rng);
+                else
+                    acc += cands[0];
+            }
+            return acc;
+        } },
+        { "SelectCreatureForTheme.trash", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+                acc += SelectCreatureForTheme(data.Themes[i % data.Themes.size()].CreatureTypes,
+                    data.Trash, data.Bosses, false, rng).Entry;
+            return acc;
+        } },
+        { "SelectCreatureForTheme.boss", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+                acc += SelectCreatureForTheme(data.Themes[i % data.Themes.size()].CreatureTypes,
+                    data.Trash, data.Bosses, true, rng).Entry;
+            return acc;
+        } },
+        { "TierScalingMultiplier", [&](uint32_t n) {
+            float acc = 0.0f;
+            for (uint32_t i = 0; i < n; ++i)
+                acc += TierScalingMultiplier(1 + i % 30, 0.10f, 5, 1.15f);
+            return uint64_t(acc);
+        } },
+        { "AffixCountForTier", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+                acc += AffixCountForTier(1 + i % 30, 3, 7, 10);
+            return acc;
+        } },
+        { "CalculateHealthMultiplier", [&](uint32_t n) {
+            float acc = 0.0f;
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                DifficultyTier const* d = FindDifficulty(data.Difficulties, 1 + i % 6);
+                float tier = (i & 3) ? 1.0f : TierScalingMultiplier(1 + i % 30, 0.10f, 5, 1.15f);
+                acc += SessionMultiplier(d->HealthMultiplier, 1 + i % 5, 0.5f, 0.25f, tier);
+            }
+            return uint64_t(acc);
+        } },
+        { "FindDifficulty+FindTheme", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                acc += FindDifficulty(data.Difficulties, 1 + i % 6)->MinLevel;
+                acc += FindTheme(data.Themes, 1 + i % 9)->CreatureTypes.size();
+            }
+            return acc;
+        } },
+        { "DenseIndex difficulty+theme", [&](uint32_t n) {
+            uint64_t acc = 0;
+            for (uint32_t i = 0; i < n; ++i)
+            {
+                acc += data.Difficulties[diffIndex.Find(1 + i % 6)].MinLevel;
+                acc += data.Themes[themeIndex.Find(1 + i % 9)].CreatureTypes.size();
+            }
+            return acc;
+        } },
+        { "ParseDifficultyTier", [&](uint32_t n) {
+            uint64_t acc = 0;
+            DifficultyTier t;
+            for (uint32_t i = 0; i < n; ++i)
+                acc += ParseDifficultyTier("\"Journeyman,30,44,1.0,1.0,2.0,0.85\"", i, t) ? t.MaxLevel : 0;
+            return acc;
+        } },
+    };
+
+    std::map<std::string, double> baseline;
+    if (comparePath)
+    {
+        baseline = LoadBaseline(comparePath);
+        if (baseline.empty())
+        {
+            std::fprintf(stderr, "dm_bench: no baseline entries in %s\n", comparePath);
+            return 1;
+        }
+    }
+
+    std::printf("dm_bench: %zu reward, %zu loot items, %zu trash / %zu boss types, seed %u\n",
+        data.Rewards.size(), data.Loot.size(), data.Trash.size(), data.Bosses.size(), seed);
+
+    uint64_t sink = 0;
+    uint32_t regressions = 0;
+    std::vector<Result> results;
+    for (auto const& [name, body] : benches)
+    {
+        if (filter && !std::strstr(name, filter))
+            continue;
+
+        double ns = Measure(body, sink);
+        results.push_back({ name, ns });
+
+        auto it = baseline.find(name);
+        if (it == baseline.end())
+        {
+            std::printf("  %-30s %12.1f ns/op\n", name, ns);
+            continue;
+        }
+
+        double delta = (ns / it->second - 1.0) * 100.0;
+        bool regressed = delta > tolerance;
+        regressions += regressed;
+        std::printf("  %-30s %12.1f ns/op  %+7.1f%% vs %.1f%s\n",
+            name, ns, delta, it->second, regressed ? "  REGRESSION" : "");
+    }
+    std::printf("[checksum %llu]\n", (unsigned long long)sink);
+
+    if (savePath)
+    {
+        FILE* f = std::fopen(savePath, "w");
+        if (!f)
+        {
+            std::fprintf(stderr, "dm_bench: cannot write %s\n", savePath);
+            return 1;
+        }
+        for (Result const& r : results)
+            std::fprintf(f, "%s %.3f\n", r.Name.c_str(), r.NsPerOp);
+        std::fclose(f);
+    }
+
+    if (regressions)
+    {
+        std::printf("%u benchmark(s) regressed by more than %.0f%%\n", regressions, tolerance);
+        return 3;
+    }
+    return 0;
+}
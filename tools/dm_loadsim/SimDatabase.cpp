@@ -0,0 +1,308 @@
+/*
+ * mod-dungeon-master — SimDatabase.cpp
+ * Queries are matched on the distinctive fragments of the module's SQL;
+ * anything unrecognised returns an empty result and is counted.
+ */
+
+#include "SimDatabase.h"
+#include "ObjectMgr.h"
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+
+namespace DungeonMaster::Sim
+{
+
+namespace
+{
+
+constexpr uint32 TRASH_ENTRY_BASE  = 100000;
+constexpr uint32 BOSS_ENTRY_BASE   = 150000;
+constexpr uint32 REWARD_ITEM_BASE  = 100000;
+constexpr uint32 LOOT_ITEM_BASE    = 200000;
+constexpr uint32 TRASH_COUNT       = 2000;
+constexpr uint32 BOSS_COUNT        = 240;
+constexpr uint32 ITEM_COUNT        = 3000;
+
+// Creature types the module draws from (critters excluded).
+constexpr uint32 kTypes[] = { 1, 2, 3, 4, 5, 6, 7, 9, 10 };
+constexpr uint8  kUnitClasses[] = { 1, 2, 4, 8 };
+
+class Rows
+{
+public:
+    explicit Rows(uint32 fields) : _fields(fields) {}
+
+    Rows& Num(double v) { _data.emplace_back(v, std::string()); return *this; }
+    Rows& Str(std::string v) { _data.emplace_back(0.0, std::move(v)); return *this; }
+
+    QueryResult Done() { return std::make_shared<ResultSet>(_fields, std::move(_data)); }
+
+private:
+    uint32 _fields;
+    std::vector<Field> _data;
+};
+
+uint32 ParseMapId(std::string const& sql, char const* key)
+{
+    size_t at = sql.find(key);
+    return at == std::string::npos ? 0 : uint32(std::strtoul(sql.c_str() + at + std::strlen(key), nullptr, 10));
+}
+
+bool Has(std::string const& sql, char const* fragment)
+{
+    return sql.find(fragment) != std::string::npos;
+}
+
+} // namespace
+
+void SimDatabase::Install(uint32 seed)
+{
+    _seed = seed;
+    std::mt19937 rng(seed);
+    auto pick = [&](uint32 lo, uint32 hi) { return std::uniform_int_distribution<uint32>(lo, hi)(rng); };
+
+    auto& creatures = sObjectMgr->CreatureTemplates;
+    auto addCreature = [&](uint32 entry, std::string name, uint32 type, uint8 minL, uint8 maxL, uint32 rank,
+                           std::string script)
+    {
+        CreatureTemplate& t = creatures[entry];
+        t.Entry          = entry;
+        t.Name           = std::move(name);
+        t.type           = type;
+        t.minlevel       = minL;
+        t.maxlevel       = maxL;
+        t.rank           = rank;
+        t.unit_class     = kUnitClasses[pick(0, 3)];
+        t.BaseAttackTime = 2000;
+        t.ScriptName     = std::move(script);
+    };
+
+    for (uint32 i = 0; i < TRASH_COUNT; ++i)
+    {
+        uint8 minL = uint8(pick(1, 80));
+        uint32 roll = pick(0, 99);
+        uint32 rank = roll < 75 ? 0 : roll < 95 ? 1 : roll < 98 ? 4 : 2;
+        addCreature(TRASH_ENTRY_BASE + i, fmt::format("Sim Creature {}", i), kTypes[i % 9],
+            minL, uint8(std::min<uint32>(83, minL + pick(0, 2))), rank, "");
+        _trashEntries.push_back(TRASH_ENTRY_BASE + i);
+    }
+    for (uint32 i = 0; i < BOSS_COUNT; ++i)
+    {
+        uint8 minL = uint8(pick(10, 82));
+        addCreature(BOSS_ENTRY_BASE + i, fmt::format("Sim Boss {}", i), kTypes[i % 9],
+            minL, minL, pick(1, 2), "boss_sim");
+        _bossEntries.push_back(BOSS_ENTRY_BASE + i);
+    }
+    // Service NPCs the module summons by entry.
+    addCreature(500000, "Dungeon Master", 7, 80, 80, 0, "npc_dungeon_master");
+    addCreature(500001, "Dungeon Vendor", 7, 80, 80, 0, "");
+
+    auto& items = sObjectMgr->ItemTemplates;
+    for (uint32 i = 0; i < ITEM_COUNT; ++i)
+    {
+        for (uint32 base : { REWARD_ITEM_BASE, LOOT_ITEM_BASE })
+        {
+            ItemTemplate& t = items[base + i];
+            t.ItemId        = base + i;
+            t.Name1         = fmt::format("Sim Item {}", base + i);
+            t.RequiredLevel = pick(1, 80);
+            t.ItemLevel     = t.RequiredLevel + pick(0, 20);
+            if (base == REWARD_ITEM_BASE)
+            {
+                t.Quality = pick(2, 4);
+                t.Class   = pick(0, 1) ? 2 : 4;
+                do { t.InventoryType = pick(1, 26); }
+                while (t.InventoryType == 18 || t.InventoryType == 19 || t.InventoryType == 24);
+            }
+            else
+            {
+                static constexpr uint32 lootClasses[] = { 0, 2, 4, 7, 15 };
+                t.Quality       = pick(0, 4);
+                t.Class         = lootClasses[pick(0, 4)];
+                t.InventoryType = (t.Class == 2 || t.Class == 4) ? pick(1, 17) : 0;
+            }
+            t.SubClass = pick(0, 4);
+            for (uint32 s = 0; s < 3; ++s)
+            {
+                t.ItemStat[s].ItemStatType  = pick(3, 7);
+                t.ItemStat[s].ItemStatValue = int32(1 + t.ItemLevel / 6);
+            }
+        }
+        _rewardItems.push_back(REWARD_ITEM_BASE + i);
+        _lootItems.push_back(LOOT_ITEM_BASE + i);
+    }
+
+    WorldDatabase.SetProvider([this](std::string const& sql) { return WorldQuery(sql); });
+    CharacterDatabase.SetProvider([](std::string const&) { return QueryResult(); });
+}
+
+Position SimDatabase::GetEntrance(uint32 mapId) const
+{
+    std::mt19937 rng(_seed * 7919u + mapId);
+    std::uniform_real_distribution<float> d(-2000.0f, 2000.0f);
+    return Position(d(rng), d(rng), std::uniform_real_distribution<float>(-50.0f, 150.0f)(rng), 0.0f);
+}
+
+float SimDatabase::FanHeading(uint32 mapId) const
+{
+    std::mt19937 rng(_seed * 2654435761u + mapId);
+    return std::uniform_real_distribution<float>(0.0f, 6.2831f)(rng);
+}
+
+// Trash positions fan out from the entrance to ~400 yd; the farthest
+// boss candidates sit past them at the end of the dungeon.
+std::vector<Position> SimDatabase::SpawnPoints(uint32 mapId) const
+{
+    std::mt19937 rng(_seed * 104729u + mapId);
+    Position ent = GetEntrance(mapId);
+    uint32 n = std::uniform_int_distribution<uint32>(60, 150)(rng);
+    float heading = FanHeading(mapId);
+
+    std::vector<Position> pts;
+    pts.reserve(n);
+    for (uint32 i = 0; i < n; ++i)
+    {
+        float dist  = std::uniform_real_distribution<float>(10.0f, 400.0f)(rng);
+        float angle = heading + std::uniform_real_distribution<float>(-0.6f, 0.6f)(rng);
+        pts.emplace_back(ent.GetPositionX() + dist * std::cos(angle),
+                         ent.GetPositionY() + dist * std::sin(angle),
+                         ent.GetPositionZ(), angle + 3.1416f);
+    }
+    return pts;
+}
+
+std::vector<Position> SimDatabase::BossPoints(uint32 mapId) const
+{
+    std::mt19937 rng(_seed * 15485863u + mapId);
+    Position ent = GetEntrance(mapId);
+    float heading = FanHeading(mapId);
+
+    uint32 n = std::uniform_int_distribution<uint32>(3, 6)(rng);
+    std::vector<Position> pts;
+    for (uint32 i = 0; i < n; ++i)
+    {
+        float dist  = 150.0f + 260.0f * float(i + 1) / float(n);
+        float angle = heading + std::uniform_real_distribution<float>(-0.3f, 0.3f)(rng);
+        pts.emplace_back(ent.GetPositionX() + dist * std::cos(angle),
+                         ent.GetPositionY() + dist * std::sin(angle),
+                         ent.GetPositionZ(), angle + 3.1416f);
+    }
+    return pts;
+}
+
+std::vector<SimSpawn> SimDatabase::GetInstanceSpawns(uint32 mapId) const
+{
+    std::vector<SimSpawn> spawns;
+    std::vector<Position> pts = SpawnPoints(mapId);
+    for (size_t i = 0; i < pts.size(); ++i)
+        spawns.push_back({ pts[i], _trashEntries[(mapId * 31 + i) % _trashEntries.size()] });
+    std::vector<Position> bosses = BossPoints(mapId);
+    for (size_t i = 0; i < bosses.size(); ++i)
+        spawns.push_back({ bosses[i], _bossEntries[(mapId * 17 + i) % _bossEntries.size()] });
+    return spawns;
+}
+
+QueryResult SimDatabase::WorldQuery(std::string const& sql)
+{
+    auto const& creatures = sObjectMgr->CreatureTemplates;
+    auto const& items     = sObjectMgr->ItemTemplates;
+
+    // Creature pool (unscripted trash and elites)
+    if (Has(sql, "FROM creature_template ct") && Has(sql, "ct.ScriptName = ''"))
+    {
+        Rows rows(5);
+        for (uint32 entry : _trashEntries)
+        {
+            CreatureTemplate const& t = creatures.at(entry);
+            rows.Num(entry).Num(t.type).Num(t.minlevel).Num(t.maxlevel).Num(t.rank);
+        }
+        return rows.Done();
+    }
+
+    // Dungeon boss pool (scripted elites in dungeon maps)
+    if (Has(sql, "JOIN creature c ON c.id1 = ct.entry") && Has(sql, "ct.ScriptName != ''"))
+    {
+        Rows rows(5);
+        for (uint32 entry : _bossEntries)
+        {
+            CreatureTemplate const& t = creatures.at(entry);
+            rows.Num(entry).Str(t.Name).Num(t.type).Num(t.minlevel).Num(t.maxlevel);
+        }
+        return rows.Done();
+    }
+
+    // Class/level base stats
+    if (Has(sql, "FROM creature_classlevelstats"))
+    {
+        Rows rows(6);
+        for (uint8 cls : kUnitClasses)
+            for (uint32 lvl = 1; lvl <= 83; ++lvl)
+                rows.Num(lvl).Num(cls)
+                    .Num(40.0 + 1.1 * lvl * lvl * (cls == 8 ? 0.8 : 1.0))
+                    .Num(1.0 + 0.6 * lvl)
+                    .Num(20.0 * lvl)
+                    .Num(4.5 * lvl);
+        return rows.Done();
+    }
+
+    // Reward items
+    if (Has(sql, "FROM item_template") && Has(sql, "Quality >= 2 AND Quality <= 4"))
+    {
+        Rows rows(8);
+        for (uint32 entry : _rewardItems)
+        {
+            ItemTemplate const& t = items.at(entry);
+            rows.Num(entry).Num(t.RequiredLevel).Num(t.Quality).Num(t.InventoryType)
+                .Num(t.Class).Num(t.SubClass).Num(t.AllowableClass).Num(t.ItemLevel);
+        }
+        return rows.Done();
+    }
+
+    // Loot pool
+    if (Has(sql, "FROM item_template") && Has(sql, "SellPrice > 0"))
+    {
+        Rows rows(7);
+        for (uint32 entry : _lootItems)
+        {
+            ItemTemplate const& t = items.at(entry);
+            rows.Num(entry).Num(t.RequiredLevel).Num(t.Quality).Num(t.Class)
+                .Num(t.SubClass).Num(t.AllowableClass).Num(t.ItemLevel);
+        }
+        return rows.Done();
+    }
+
+    // Dungeon entrance
+    if (Has(sql, "FROM areatrigger_teleport"))
+    {
+        Position p = GetEntrance(ParseMapId(sql, "target_map = "));
+        return Rows(4).Num(p.GetPositionX()).Num(p.GetPositionY()).Num(p.GetPositionZ()).Num(p.GetOrientation()).Done();
+    }
+
+    // Boss candidates (checked before plain spawn points; both hit `creature`)
+    if (Has(sql, "mechanic_immune_mask > 0"))
+    {
+        uint32 mapId = ParseMapId(sql, "c.map = ");
+        Rows rows(7);
+        uint32 mask = 650854271;
+        for (Position const& p : BossPoints(mapId))
+            rows.Num(p.GetPositionX()).Num(p.GetPositionY()).Num(p.GetPositionZ()).Num(p.GetOrientation())
+                .Num(mask--).Num(1).Str(fmt::format("Sim Boss of map {}", mapId));
+        return rows.Done();
+    }
+
+    // Spawn points
+    if (Has(sql, "FROM creature WHERE map = "))
+    {
+        Rows rows(4);
+        for (Position const& p : SpawnPoints(ParseMapId(sql, "map = ")))
+            rows.Num(p.GetPositionX()).Num(p.GetPositionY()).Num(p.GetPositionZ()).Num(p.GetOrientation());
+        return rows.Done();
+    }
+
+    ++_unmatched;
+    return QueryResult();
+}
+
+} // namespace DungeonMaster::Sim
@@ -0,0 +1,54 @@
+/*
+ * mod-dungeon-master — SimDatabase.h
+ * Deterministic synthetic world database for dm_loadsim. Answers the
+ * queries DungeonMasterMgr issues at startup and per session, and fills
+ * sObjectMgr with matching creature/item templates.
+ */
+
+#ifndef DM_SIM_DATABASE_H
+#define DM_SIM_DATABASE_H
+
+#include "DatabaseEnv.h"
+#include "Position.h"
+#include <atomic>
+#include <vector>
+
+namespace DungeonMaster::Sim
+{
+
+struct SimSpawn
+{
+    Position Pos;
+    uint32   Entry = 0;
+};
+
+class SimDatabase
+{
+public:
+    // Generates templates and installs the world/character providers.
+    void Install(uint32 seed);
+
+    // Static spawns a fresh instance of mapId starts with.
+    std::vector<SimSpawn> GetInstanceSpawns(uint32 mapId) const;
+    Position GetEntrance(uint32 mapId) const;
+
+    uint64 GetUnmatchedQueries() const { return _unmatched.load(); }
+
+private:
+    QueryResult WorldQuery(std::string const& sql);
+
+    float FanHeading(uint32 mapId) const;
+    std::vector<Position> SpawnPoints(uint32 mapId) const;
+    std::vector<Position> BossPoints(uint32 mapId) const;
+
+    uint32 _seed = 1;
+    std::vector<uint32> _trashEntries;
+    std::vector<uint32> _bossEntries;
+    std::vector<uint32> _rewardItems;
+    std::vector<uint32> _lootItems;
+    std::atomic<uint64> _unmatched{ 0 };
+};
+
+} // namespace DungeonMaster::Sim
+
+#endif // DM_SIM_DATABASE_H
@@ -0,0 +1,419 @@
+/*
+ * mod-dungeon-master — SimWorld.cpp
+ * Player bots, instance creation/unload and the map worker pool.
+ */
+
+#include "SimWorld.h"
+#include "DMConfig.h"
+#include "DungeonMasterMgr.h"
+#include "RoguelikeMgr.h"
+#include "ScriptMgr.h"
+#include <algorithm>
+
+namespace DungeonMaster::Sim
+{
+
+thread_local std::mt19937 tRng{ 1 };
+
+namespace
+{
+
+constexpr uint32 HOME_MAP_ID       = 0;
+constexpr uint32 ENV_SPELL_ID      = 7001;   // stand-in for a trap / lava tick
+constexpr uint32 SWING_TIME_MS     = 2000;
+constexpr uint32 RETARGET_MS       = 500;
+constexpr uint32 DOT_PERIOD_MS     = 3000;
+constexpr uint32 INSTANCE_UNLOAD_MS = 60000;
+
+WorldParams sParams;
+
+float BaseHealth(uint8 level) { return 40.0f + 1.1f * level * level; }
+
+// Player bot, run on the map's worker thread: walks to the nearest hostile
+// (engaged ones first), melees it, regenerates out of combat and takes DoT
+// and environmental ticks through the damage hooks.
+void UpdateSimPlayer(Player* player, Map* map, uint32 diff)
+{
+    SimPlayer* p = static_cast<SimPlayer*>(player);
+    if (!p->IsAlive())
+        return;
+
+    // Debuffs from creatures tick every DOT_PERIOD_MS until they expire
+    p->DotTimer += diff;
+    bool dotTick = p->DotTimer >= DOT_PERIOD_MS;
+    if (dotTick)
+        p->DotTimer = 0;
+    std::vector<uint32> expired;
+    for (auto const& [spellId, app] : p->GetAppliedAuras())
+    {
+        Aura* aura = app->GetBase();
+        if (aura->GetCasterGUID() == p->GetGUID() || aura->GetDuration() < 0)
+            continue;
+        if (dotTick)
+            Stub::PeriodicTick(aura->GetCaster(), p, sSpellMgr->GetSpellInfo(spellId), 10 + p->GetLevel() * 3);
+        if (aura->GetDuration() <= int32(diff))
+            expired.push_back(spellId);
+        else
+            aura->SetDuration(aura->GetDuration() - int32(diff));
+    }
+    for (uint32 id : expired)
+        p->RemoveAura(id);
+    if (!p->IsAlive())
+        return;
+
+    bool inCombat = p->IsInCombat();
+    if (!inCombat && p->GetHealth() < p->GetMaxHealth())
+        p->SetHealth(p->GetHealth() + std::max(1u, p->GetMaxHealth() / 20 * diff / 1000));
+
+    if (!map->IsDungeon())
+        return;
+
+    // Environmental hazard: ~once per 2 minutes per player
+    if (RandInt(0, 120000) < diff)
+        Stub::PeriodicTick(nullptr, p, sSpellMgr->GetSpellInfo(ENV_SPELL_ID), p->GetMaxHealth() / 10);
+
+    Creature* target = map->GetCreature(p->Target);
+    bool targetValid = target && target->IsAlive() && target->IsInWorld();
+    p->RetargetTimer = p->RetargetTimer > diff ? p->RetargetTimer - diff : 0;
+    if (!targetValid || p->RetargetTimer == 0)
+    {
+        p->RetargetTimer = RETARGET_MS;
+        Creature* best = nullptr;
+        float bestDist = 1e9f;
+        bool bestEngaged = false;
+        for (Creature* c : map->GetAllCreatures())
+        {
+            if (!c->IsInWorld() || !c->IsAlive() || !c->IsHostileTo(p))
+                continue;
+            bool engaged = c->GetVictim() != nullptr;
+            float dist = p->GetExactDistSq(c);
+            if ((engaged && !bestEngaged) || (engaged == bestEngaged && dist < bestDist))
+            {
+                best = c;
+                bestDist = dist;
+                bestEngaged = engaged;
+            }
+        }
+        if (best && (!targetValid || (bestEngaged && !target->GetVictim())))
+        {
+            target = best;
+            p->Target = best->GetGUID();
+        }
+        targetValid = target && target->IsAlive() && target->IsInWorld();
+    }
+    if (!targetValid)
+        return;
+
+    float dist = p->GetDistance(target);
+    if (dist > 4.0f)
+    {
+        float step = std::min(dist - 3.5f, 7.0f * diff / 1000.0f);
+        float k = step / dist;
+        p->Relocate(p->GetPositionX() + (target->GetPositionX() - p->GetPositionX()) * k,
+                    p->GetPositionY() + (target->GetPositionY() - p->GetPositionY()) * k,
+                    p->GetPositionZ() + (target->GetPositionZ() - p->GetPositionZ()) * k);
+        return;
+    }
+
+    p->SwingTimer() = p->SwingTimer() > diff ? p->SwingTimer() - diff : 0;
+    if (p->SwingTimer() == 0)
+    {
+        p->SwingTimer() = SWING_TIME_MS;
+        p->Attack(target, true);
+        uint32 damage = uint32(BaseHealth(p->GetLevel()) * 0.2f * sParams.PlayerPower * RandFloat(0.9f, 1.1f));
+        Stub::MeleeHit(p, target, std::max(1u, damage));
+    }
+}
+
+} // namespace
+
+// ---- Map update workers ----
+
+MapUpdater::MapUpdater(uint32 threads, uint32 seed) : _seed(seed)
+{
+    for (uint32 i = 0; i < std::max(1u, threads); ++i)
+        _workers.emplace_back([this, i] { Run(i); });
+}
+
+MapUpdater::~MapUpdater()
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _stop = true;
+    }
+    _wake.notify_all();
+    for (auto& t : _workers)
+        t.join();
+}
+
+void MapUpdater::Update(std::vector<Map*> const& maps, uint32 diff)
+{
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _maps = &maps;
+        _diff = diff;
+        _next.store(0);
+        _pending = uint32(_workers.size());
+        ++_generation;
+    }
+    _wake.notify_all();
+    std::unique_lock<std::mutex> lock(_lock);
+    _done.wait(lock, [this] { return _pending == 0; });
+}
+
+void MapUpdater::Run(uint32 index)
+{
+    tRng.seed(_seed * 977 + index);
+    uint64 seen = 0;
+    for (;;)
+    {
+        std::vector<Map*> const* maps;
+        uint32 diff;
+        {
+            std::unique_lock<std::mutex> lock(_lock);
+            _wake.wait(lock, [&] { return _stop || _generation != seen; });
+            if (_stop)
+                return;
+            seen = _generation;
+            maps = _maps;
+            diff = _diff;
+        }
+
+        for (size_t i = _next.fetch_add(1); i < maps->size(); i = _next.fetch_add(1))
+            (*maps)[i]->Update(diff);
+
+        std::lock_guard<std::mutex> lock(_lock);
+        if (--_pending == 0)
+            _done.notify_one();
+    }
+}
+
+// ---- World ----
+
+SimWorld::SimWorld(SimDatabase const& db, WorldParams const& params) : _db(db), _params(params)
+{
+    sParams = params;
+    Stub::SetPlayerUpdateHandler(&UpdateSimPlayer);
+}
+
+SimWorld::~SimWorld()
+{
+    // Maps release their players; parties are destroyed after them.
+    _instances.clear();
+    _continents.clear();
+}
+
+void SimWorld::CreateParties(uint32 count)
+{
+    uint32 guid = 1;
+    for (uint32 i = 0; i < count; ++i)
+    {
+        auto party = std::make_unique<SimParty>();
+        party->PartyGroup = std::make_unique<Group>();
+        uint32 size = RandInt(1, 5);
+        uint8 level = uint8(RandInt(10, 80));
+        Map* home = GetContinent(HOME_MAP_ID);
+        for (uint32 m = 0; m < size; ++m)
+        {
+            uint8 lvl = uint8(std::clamp<int>(level + int(RandInt(0, 6)) - 3, 10, 80));
+            auto p = std::make_unique<SimPlayer>(ObjectGuid(HighGuid::Player, guid++),
+                fmt::format("Sim{}x{}", i, m), lvl, uint8(RandInt(1, 11)));
+            p->SetMaxHealth(uint32(BaseHealth(lvl) * 4.0f));
+            p->SetHealth(p->GetMaxHealth());
+            p->Relocate(RandFloat(-100.0f, 100.0f), RandFloat(-100.0f, 100.0f), 0.0f, 0.0f);
+            home->AddPlayer(p.get());
+            if (size > 1)
+                party->PartyGroup->AddMember(p.get());
+            party->Members.push_back(std::move(p));
+        }
+        party->IdleTimer = RandInt(0, 30000);
+        _parties.push_back(std::move(party));
+        _players += size;
+    }
+}
+
+void SimWorld::StartRun(SimParty& party)
+{
+    Player* leader = party.Members.front().get();
+    for (auto const& m : party.Members)
+        sDungeonMasterMgr->ClearCooldown(m->GetGUID());
+
+    std::vector<DifficultyTier const*> diffs;
+    for (DifficultyTier const& d : sDMConfig->GetDifficulties())
+        if (d.IsOnLevelFor(leader->GetLevel()))
+            diffs.push_back(&d);
+    if (diffs.empty())
+        for (DifficultyTier const& d : sDMConfig->GetDifficulties())
+            if (d.IsValidForLevel(leader->GetLevel()))
+                diffs.push_back(&d);
+    auto const& themes = sDMConfig->GetThemes();
+    if (diffs.empty() || themes.empty())
+        return;
+
+    DifficultyTier const* diff = diffs[RandInt(0, uint32(diffs.size() - 1))];
+    uint32 themeId = themes[RandInt(0, uint32(themes.size() - 1))].Id;
+
+    bool started = false;
+    if (RandInt(0, 99) < _params.RoguelikePct)
+    {
+        started = sRoguelikeMgr->StartRun(leader, diff->Id, themeId, true);
+        if (started)
+            ++RoguelikeStarted;
+    }
+    else
+    {
+        DungeonSpan dgs = sDMConfig->GetDungeonsForDifficulty(diff->Id);
+        if (dgs.empty())
+            return;
+        uint32 mapId = dgs[RandInt(0, uint32(dgs.size() - 1))]->MapId;
+
+        Session* s = sDungeonMasterMgr->CreateSession(leader, diff->Id, themeId, mapId, true);
+        if (s && !sDungeonMasterMgr->StartDungeon(s))
+        {
+            sDungeonMasterMgr->AbandonSession(s->SessionId);
+            s = nullptr;
+        }
+        if (s && !sDungeonMasterMgr->TeleportPartyIn(s))
+        {
+            sDungeonMasterMgr->AbandonSession(s->SessionId);
+            s = nullptr;
+        }
+        started = s != nullptr;
+    }
+
+    if (!started)
+    {
+        ++Rejected;
+        party.IdleTimer = 10000;
+        return;
+    }
+    ++Started;
+    party.InRun = true;
+    party.RunStartMs = uint64(GameTime::GetGameTimeMS().count());
+}
+
+void SimWorld::UpdateParties(uint32 diff)
+{
+    for (auto& party : _parties)
+    {
+        Player* leader = party->Members.front().get();
+        if (party->InRun)
+        {
+            ObjectGuid g = leader->GetGUID();
+            if (sDungeonMasterMgr->GetSessionByPlayer(g) || sRoguelikeMgr->IsPlayerInRun(g))
+                continue;
+            party->InRun = false;
+            ++Ended;
+            RunDurationsSec.push_back(
+                double(uint64(GameTime::GetGameTimeMS().count()) - party->RunStartMs) / 1000.0);
+            party->IdleTimer = RandInt(5000, 20000);
+            // Bags are emptied between runs, as a player would vendor.
+            for (auto const& m : party->Members)
+                if (m->GetInventoryCount() > Player::INVENTORY_SLOTS * 3 / 4)
+                    m->ClearInventory();
+            continue;
+        }
+
+        if (party->IdleTimer > diff)
+        {
+            party->IdleTimer -= diff;
+            continue;
+        }
+        StartRun(*party);
+    }
+}
+
+void SimWorld::ProcessTeleports()
+{
+    for (auto& party : _parties)
+    {
+        for (auto const& m : party->Members)
+        {
+            Player::PendingTeleport t;
+            if (!m->TakePendingTeleport(t))
+                continue;
+
+            Map* dest = GetOrCreateMap(t.MapId, *party);
+            if (dest == m->GetMap())
+            {
+                m->Relocate(t.Pos);
+                continue;
+            }
+            if (Map* from = m->GetMap())
+                from->RemovePlayer(m.get());
+            m->Relocate(t.Pos);
+            m->CombatStop();
+            m->Target.Clear();
+            dest->AddPlayer(m.get());
+            for (PlayerScript* s : Stub::ScriptList<PlayerScript>())
+                s->OnPlayerMapChanged(m.get());
+        }
+    }
+}
+
+void SimWorld::CollectMaps(std::vector<Map*>& out) const
+{
+    out.clear();
+    for (auto const& [id, map] : _continents)
+        out.push_back(map.get());
+    for (auto const& [key, map] : _instances)
+        out.push_back(map.get());
+}
+
+void SimWorld::UnloadEmptyInstances()
+{
+    for (auto it = _instances.begin(); it != _instances.end();)
+    {
+        if (it->second->EmptyTime < INSTANCE_UNLOAD_MS)
+        {
+            ++it;
+            continue;
+        }
+        for (AllMapScript* s : Stub::ScriptList<AllMapScript>())
+            s->OnDestroyInstance(nullptr, it->second.get());
+        it = _instances.erase(it);
+        ++InstancesUnloaded;
+    }
+}
+
+size_t SimWorld::GetCreatureCount() const
+{
+    size_t n = 0;
+    for (auto const& [key, map] : _instances)
+        n += map->GetCreatureCount();
+    return n;
+}
+
+Map* SimWorld::GetContinent(uint32 mapId)
+{
+    auto& slot = _continents[mapId];
+    if (!slot)
+        slot = std::make_unique<Map>(mapId, 0);
+    return slot.get();
+}
+
+// One instance per (map, party) while it stays loaded, like an
+// instance bind; a fresh one gets the map's static spawns and doors.
+Map* SimWorld::GetOrCreateMap(uint32 mapId, SimParty const& party)
+{
+    if (!sDMConfig->GetDungeon(mapId))
+        return GetContinent(mapId);
+
+    auto key = std::make_pair(mapId, party.Members.front()->GetGUID().GetRawValue());
+    auto& slot = _instances[key];
+    if (!slot)
+    {
+        slot = std::make_unique<InstanceMap>(mapId, ++_nextInstanceId, 4);
+        uint32 spawnId = 1;
+        for (SimSpawn const& s : _db.GetInstanceSpawns(mapId))
+            if (CreatureTemplate const* t = sObjectMgr->GetCreatureTemplate(s.Entry))
+                slot->AddDbCreature(t, s.Pos, spawnId++);
+        for (uint32 d = 0; d < 6; ++d)
+            slot->AddDbGameObject(180000 + d, d % 3 ? GAMEOBJECT_TYPE_DOOR : GAMEOBJECT_TYPE_CHEST,
+                _db.GetEntrance(mapId), d + 1);
+        ++InstancesCreated;
+    }
+    return slot.get();
+}
+
+} // namespace DungeonMaster::Sim
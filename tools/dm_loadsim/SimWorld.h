@@ -0,0 +1,135 @@
+/*
+ * mod-dungeon-master — SimWorld.h
+ * Bot parties, their maps and the map-update worker pool shared by
+ * dm_loadsim and dm_stress. The world owns every Map and Player it
+ * creates; players live for the whole simulation, maps until unloaded.
+ */
+
+#ifndef DM_SIM_WORLD_H
+#define DM_SIM_WORLD_H
+
+#include "SimDatabase.h"
+#include "Group.h"
+#include "Map.h"
+#include "Player.h"
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace DungeonMaster::Sim
+{
+
+extern thread_local std::mt19937 tRng;
+
+inline float RandFloat(float lo, float hi) { return std::uniform_real_distribution<float>(lo, hi)(tRng); }
+inline uint32 RandInt(uint32 lo, uint32 hi) { return std::uniform_int_distribution<uint32>(lo, hi)(tRng); }
+
+struct WorldParams
+{
+    uint32 RoguelikePct = 0;
+    float  PlayerPower  = 1.0f;
+    uint32 Seed         = 1;
+};
+
+class SimPlayer : public Player
+{
+public:
+    using Player::Player;
+
+    ObjectGuid Target;
+    uint32     RetargetTimer = 0;
+    uint32     DotTimer      = 0;
+};
+
+struct SimParty
+{
+    std::vector<std::unique_ptr<SimPlayer>> Members;
+    std::unique_ptr<Group> PartyGroup;
+    uint32 IdleTimer   = 0;
+    bool   InRun       = false;
+    uint64 RunStartMs  = 0;
+};
+
+// ---- Map update workers ----
+
+// Updates every map once per call, spread over the worker threads the way
+// the core's MapUpdater does; Update() returns when all maps are done.
+class MapUpdater
+{
+public:
+    MapUpdater(uint32 threads, uint32 seed);
+    ~MapUpdater();
+
+    void Update(std::vector<Map*> const& maps, uint32 diff);
+
+private:
+    void Run(uint32 index);
+
+    std::vector<std::thread> _workers;
+    std::mutex _lock;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    std::vector<Map*> const* _maps = nullptr;
+    std::atomic<size_t> _next{ 0 };
+    uint32 _diff = 0;
+    uint32 _pending = 0;
+    uint64 _generation = 0;
+    uint32 _seed = 1;
+    bool   _stop = false;
+};
+
+// ---- World ----
+
+class SimWorld
+{
+public:
+    // Installs the player bot as the stub player-update handler.
+    SimWorld(SimDatabase const& db, WorldParams const& params);
+    ~SimWorld();
+
+    void CreateParties(uint32 count);
+
+    // npc_dungeon_master's start flow, minus the gossip menus.
+    void StartRun(SimParty& party);
+    void UpdateParties(uint32 diff);
+
+    // Far teleports complete at the start of the next world tick.
+    void ProcessTeleports();
+
+    void CollectMaps(std::vector<Map*>& out) const;
+    void UnloadEmptyInstances();
+
+    std::vector<std::unique_ptr<SimParty>> const& GetParties() const { return _parties; }
+    size_t GetInstanceCount() const { return _instances.size(); }
+    size_t GetCreatureCount() const;
+    uint32 GetPlayerCount() const { return _players; }
+
+    uint64 Started = 0;
+    uint64 Rejected = 0;
+    uint64 Ended = 0;
+    uint64 RoguelikeStarted = 0;
+    uint64 InstancesCreated = 0;
+    uint64 InstancesUnloaded = 0;
+    std::vector<double> RunDurationsSec;
+
+private:
+    Map* GetContinent(uint32 mapId);
+    Map* GetOrCreateMap(uint32 mapId, SimParty const& party);
+
+    SimDatabase const& _db;
+    WorldParams _params;
+    std::vector<std::unique_ptr<SimParty>> _parties;
+    std::map<uint32, std::unique_ptr<Map>> _continents;
+    std::map<std::pair<uint32, uint64>, std::unique_ptr<InstanceMap>> _instances;
+    uint32 _nextInstanceId = 0;
+    uint32 _players = 0;
+};
+
+} // namespace DungeonMaster::Sim
+
+#endif // DM_SIM_WORLD_H
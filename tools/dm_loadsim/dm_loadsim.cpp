@@ -0,0 +1,298 @@
+/*
+ * mod-dungeon-master — dm_loadsim.cpp
+ * Headless load simulator. Links the real module sources against the
+ * stand-in core in tools/stubs and drives N parties through the full
+ * session lifecycle: create, teleport, populate, combat (hook traffic),
+ * deaths, rewards and end. Reports tick-time percentiles, DMMutex
+ * contention and memory growth.
+ *
+ *   dm_loadsim [--parties N] [--duration SEC] [--tick MS] [--map-threads N]
+ *              [--roguelike-pct P] [--seed S] [--query-latency-us US]
+ *              [--player-power X] [--conf FILE] [--set Key=Value]...
+ *              [--log-level 0-5]
+ */
+
+#include "DMArena.h"
+#include "DMConfig.h"
+#include "DMMutex.h"
+#include "DungeonMasterMgr.h"
+#include "RoguelikeMgr.h"
+#include "SimDatabase.h"
+#include "SimWorld.h"
+#include "ScriptMgr.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+void AddSC_dm_player_script();
+void AddSC_dm_world_script();
+void AddSC_dm_allmap_script();
+void AddSC_dm_unit_script();
+
+using namespace DungeonMaster;
+using namespace DungeonMaster::Sim;
+
+namespace
+{
+
+struct Options
+{
+    uint32      Parties        = 40;
+    uint32      DurationSec    = 1800;
+    uint32      TickMs         = 50;
+    uint32      MapThreads     = 4;
+    uint32      RoguelikePct   = 0;
+    uint32      Seed           = 1;
+    uint32      QueryLatencyUs = 0;
+    uint32      RssSampleSec   = 60;
+    float       PlayerPower    = 1.0f;
+    int         LogLevel       = Stub::LOG_LEVEL_ERROR;
+    std::string ConfPath       = DM_DEFAULT_CONF;
+    std::vector<std::pair<std::string, std::string>> Sets;
+};
+
+Options gOpt;
+
+// ---- Reporting ----
+
+struct Series
+{
+    std::vector<double> Samples;
+
+    double Percentile(double p)
+    {
+        if (Samples.empty())
+            return 0.0;
+        std::sort(Samples.begin(), Samples.end());
+        size_t idx = std::min(Samples.size() - 1, size_t(p / 100.0 * double(Samples.size())));
+        return Samples[idx];
+    }
+};
+
+double RssMB()
+{
+    long pages = 0, resident = 0;
+    if (FILE* f = std::fopen("/proc/self/statm", "r"))
+    {
+        if (std::fscanf(f, "%ld %ld", &pages, &resident) != 2)
+            resident = 0;
+        std::fclose(f);
+    }
+    return double(resident) * double(sysconf(_SC_PAGESIZE)) / (1024.0 * 1024.0);
+}
+
+void PrintSeries(char const* name, Series& s)
+{
+    std::printf("  %-6s p50 %7.3f  p90 %7.3f  p99 %7.3f  p99.9 %7.3f  max %8.3f ms\n", name,
+        s.Percentile(50), s.Percentile(90), s.Percentile(99), s.Percentile(99.9), s.Percentile(100));
+}
+
+bool ParseArgs(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        auto next = [&]() -> char const* { return i + 1 < argc ? argv[++i] : nullptr; };
+        auto num = [&]() -> uint32 { char const* v = next(); return v ? uint32(std::strtoul(v, nullptr, 10)) : 0; };
+
+        if (!std::strcmp(argv[i], "--parties"))               gOpt.Parties = num();
+        else if (!std::strcmp(argv[i], "--duration"))         gOpt.DurationSec = num();
+        else if (!std::strcmp(argv[i], "--tick"))             gOpt.TickMs = std::max(1u, num());
+        else if (!std::strcmp(argv[i], "--map-threads"))      gOpt.MapThreads = std::max(1u, num());
+        else if (!std::strcmp(argv[i], "--roguelike-pct"))    gOpt.RoguelikePct = std::min(100u, num());
+        else if (!std::strcmp(argv[i], "--seed"))             gOpt.Seed = num();
+        else if (!std::strcmp(argv[i], "--query-latency-us")) gOpt.QueryLatencyUs = num();
+        else if (!std::strcmp(argv[i], "--rss-sample"))       gOpt.RssSampleSec = std::max(1u, num());
+        else if (!std::strcmp(argv[i], "--log-level"))        gOpt.LogLevel = int(num());
+        else if (!std::strcmp(argv[i], "--player-power"))
+        {
+            char const* v = next();
+            gOpt.PlayerPower = v ? std::strtof(v, nullptr) : 1.0f;
+        }
+        else if (!std::strcmp(argv[i], "--conf"))
+        {
+            char const* v = next();
+            if (v)
+                gOpt.ConfPath = v;
+        }
+        else if (!std::strcmp(argv[i], "--set"))
+        {
+            char const* v = next();
+            char const* eq = v ? std::strchr(v, '=') : nullptr;
+            if (!eq)
+            {
+                std::fprintf(stderr, "dm_loadsim: --set expects Key=Value\n");
+                return false;
+            }
+            gOpt.Sets.emplace_back(std::string(v, eq), std::string(eq + 1));
+        }
+        else
+        {
+            std::fprintf(stderr, "dm_loadsim: unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (!ParseArgs(argc, argv))
+        return 2;
+
+    tRng.seed(gOpt.Seed);
+    Stub::gLogLevel = gOpt.LogLevel;
+
+    if (!sConfigMgr->LoadFile(gOpt.ConfPath))
+    {
+        std::fprintf(stderr, "dm_loadsim: cannot read config %s\n", gOpt.ConfPath.c_str());
+        return 1;
+    }
+    // Recording to disk would dominate the profile; opt back in with --set.
+    sConfigMgr->Set("DungeonMaster.HookRecorder.Enable", "0");
+    sConfigMgr->Set("DungeonMaster.Trace.Enable", "0");
+    sConfigMgr->Set("DungeonMaster.LockProfiler.Enable", "1");
+    for (auto const& [key, value] : gOpt.Sets)
+        sConfigMgr->Set(key, value);
+
+    SimDatabase db;
+    db.Install(gOpt.Seed);
+    WorldDatabase.SetQueryLatencyUs(gOpt.QueryLatencyUs);
+    CharacterDatabase.SetQueryLatencyUs(gOpt.QueryLatencyUs);
+
+    AddSC_dm_player_script();
+    AddSC_dm_world_script();
+    AddSC_dm_allmap_script();
+    AddSC_dm_unit_script();
+
+    double rssStart = RssMB();
+    auto wallStart = std::chrono::steady_clock::now();
+
+    for (WorldScript* s : Stub::ScriptList<WorldScript>())
+        s->OnAfterConfigLoad(false);
+    for (WorldScript* s : Stub::ScriptList<WorldScript>())
+        s->OnStartup();
+    if (!sDMConfig->IsEnabled())
+    {
+        std::fprintf(stderr, "dm_loadsim: module disabled by configuration\n");
+        return 1;
+    }
+    DMMutex::ResetAll();
+
+    SimWorld world(db, { gOpt.RoguelikePct, gOpt.PlayerPower, gOpt.Seed });
+    world.CreateParties(gOpt.Parties);
+    MapUpdater updater(gOpt.MapThreads, gOpt.Seed);
+
+    double rssReady = RssMB();
+    std::printf("dm_loadsim: %u parties (%u players), %u s simulated at %u ms ticks, %u map thread(s)\n",
+        gOpt.Parties, world.GetPlayerCount(), gOpt.DurationSec, gOpt.TickMs, gOpt.MapThreads);
+    std::printf("  %-8s %9s %9s %9s %10s %9s\n", "sim-sec", "sessions", "instances", "creatures", "rss-MB", "started");
+
+    Series worldMs, mapMs, totalMs;
+    uint32 peakSessions = 0;
+    double rssPeak = rssReady;
+    std::vector<Map*> maps;
+    uint64 ticks = uint64(gOpt.DurationSec) * 1000 / gOpt.TickMs;
+    uint64 sampleEvery = std::max<uint64>(1, uint64(gOpt.RssSampleSec) * 1000 / gOpt.TickMs);
+
+    for (uint64 tick = 1; tick <= ticks; ++tick)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+
+        // World phase: session updates (teleport arrival, gossip-driven
+        // starts, the module's world tick), as on the world thread.
+        world.ProcessTeleports();
+        world.UpdateParties(gOpt.TickMs);
+        for (WorldScript* s : Stub::ScriptList<WorldScript>())
+            s->OnUpdate(gOpt.TickMs);
+        auto t1 = std::chrono::steady_clock::now();
+
+        // Map phase: every map updated in parallel by the map workers.
+        world.CollectMaps(maps);
+        updater.Update(maps, gOpt.TickMs);
+        world.UnloadEmptyInstances();
+        auto t2 = std::chrono::steady_clock::now();
+
+        worldMs.Samples.push_back(std::chrono::duration<double, std::milli>(t1 - t0).count());
+        mapMs.Samples.push_back(std::chrono::duration<double, std::milli>(t2 - t1).count());
+        totalMs.Samples.push_back(std::chrono::duration<double, std::milli>(t2 - t0).count());
+
+        Stub::AdvanceGameTime(gOpt.TickMs);
+        peakSessions = std::max(peakSessions, sDungeonMasterMgr->GetActiveSessionCount());
+
+        if (tick % sampleEvery == 0 || tick == ticks)
+        {
+            double rss = RssMB();
+            rssPeak = std::max(rssPeak, rss);
+            std::printf("  %-8llu %9u %9zu %9zu %10.1f %9llu\n",
+                (unsigned long long)(tick * gOpt.TickMs / 1000), sDungeonMasterMgr->GetActiveSessionCount(),
+                world.GetInstanceCount(), world.GetCreatureCount(), rss, (unsigned long long)world.Started);
+        }
+    }
+
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+    double rssEnd = RssMB();
+
+    std::printf("\nruns: %llu started (%llu roguelike), %llu ended, %llu rejected, peak %u concurrent session(s)\n",
+        (unsigned long long)world.Started, (unsigned long long)world.RoguelikeStarted,
+        (unsigned long long)world.Ended, (unsigned long long)world.Rejected, peakSessions);
+    if (!world.RunDurationsSec.empty())
+    {
+        Series runs{ world.RunDurationsSec };
+        std::printf("  run length p50 %.0f s, p90 %.0f s, max %.0f s (simulated)\n",
+            runs.Percentile(50), runs.Percentile(90), runs.Percentile(100));
+    }
+    std::printf("  instances: %llu created, %llu unloaded, %u still tracked for creature cleanup\n",
+        (unsigned long long)world.InstancesCreated, (unsigned long long)world.InstancesUnloaded,
+        sDungeonMasterMgr->GetTrackedInstanceCount());
+
+    std::printf("\ntick time (%llu ticks, %.1f s wall, %.1fx real time):\n",
+        (unsigned long long)ticks, wallSec, wallSec > 0 ? gOpt.DurationSec / wallSec : 0.0);
+    PrintSeries("world", worldMs);
+    PrintSeries("map", mapMs);
+    PrintSeries("total", totalMs);
+
+    auto const& c = Stub::gCounters;
+    std::printf("\nhooks: melee %llu, spell %llu, periodic %llu\n",
+        (unsigned long long)c.MeleeHooks.load(), (unsigned long long)c.SpellHooks.load(),
+        (unsigned long long)c.PeriodicHooks.load());
+    std::printf("  deaths: %llu creature, %llu player; %llu summoned, %llu despawned\n",
+        (unsigned long long)c.CreatureDeaths.load(), (unsigned long long)c.PlayerDeaths.load(),
+        (unsigned long long)c.Summons.load(), (unsigned long long)c.Despawns.load());
+    std::printf("  chat: %llu messages (%.1f KB) from %llu packets built, %llu mails, %llu items stored, "
+        "%llu group loots, %llu teleports\n",
+        (unsigned long long)c.ChatMessages.load(), c.ChatBytes.load() / 1024.0,
+        (unsigned long long)c.ChatPacketsBuilt.load(),
+        (unsigned long long)c.Mails.load(), (unsigned long long)c.ItemsStored.load(),
+        (unsigned long long)c.GroupLoots.load(), (unsigned long long)c.Teleports.load());
+    std::printf("  log lines: %llu\n", (unsigned long long)Stub::gLogLines.load());
+    DMArena const& arena = sDMTickArena;
+    std::printf("  tick arena: %llu allocs over %llu ticks, %llu heap blocks, %.1f KB capacity, %llu bytes high water\n",
+        (unsigned long long)arena.GetAllocations(), (unsigned long long)arena.GetResets(),
+        (unsigned long long)arena.GetBlockAllocations(), arena.GetCapacity() / 1024.0,
+        (unsigned long long)arena.GetHighWater());
+
+    std::printf("\ndatabase:\n");
+    for (DatabaseWorkerPool const* pool : { &WorldDatabase, &CharacterDatabase })
+        std::printf("  %-10s %llu sync queries (%.1f ms on caller), %llu async statements\n",
+            pool->GetName(), (unsigned long long)pool->GetSyncQueries(), pool->GetSyncQueryNs() / 1e6,
+            (unsigned long long)pool->GetAsyncStatements());
+    if (db.GetUnmatchedQueries())
+        std::printf("  %llu world queries had no synthetic data\n", (unsigned long long)db.GetUnmatchedQueries());
+
+    std::printf("\nmemory: RSS %.1f MB at start, %.1f MB after load, %.1f MB peak, %.1f MB at end (%+.1f MB over run)\n",
+        rssStart, rssReady, rssPeak, rssEnd, rssEnd - rssReady);
+
+    std::printf("\nlock contention:\n");
+    for (std::string const& line : DMMutex::BuildReport())
+        std::printf("  %s\n", line.c_str());
+
+    for (WorldScript* s : Stub::ScriptList<WorldScript>())
+        s->OnShutdown();
+    Stub::UnloadScripts();
+    return 0;
+}
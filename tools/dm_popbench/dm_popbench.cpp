@@ -0,0 +1,390 @@
+/*
+ * mod-dungeon-master — dm_popbench.cpp
+ * Headless benchmark of PopulateDungeon's planning pipeline (DMPopulatePlan)
+ * for every dungeon in DUNGEON_TABLE: trash/rare/boss planning against the
+ * dungeon's spawn-point set, level-scaled stats and the spawned-creature
+ * records, with synthetic creature pools. Summoning itself is not modelled.
+ *
+ *   dm_popbench [--iterations N] [--seed N] [--filter SUBSTR] [--spawns FILE]
+ *               [--elite PCT] [--rare PCT] [--bosses N]
+ *
+ * Spawn sets are synthesized per map (a seeded walk from the entrance, boss
+ * points at the far end) unless --spawns gives a recorded set, one point
+ * per line: "mapId x y z o boss" (boss 0/1, in distance order).
+ *
+ * Reports per-dungeon wall time and heap allocations per population, and
+ * the time split across the pipeline phases.
+ */
+
+#include "DMDungeonTable.h"
+#include "DMPopulatePlan.h"
+#include "DMSpawnMath.h"
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <new>
+#include <random>
+#include <vector>
+
+using namespace DungeonMaster::Core;
+
+// ---- Allocation counting ----
+
+static uint64_t gAllocs = 0;
+static uint64_t gAllocBytes = 0;
+
+void* operator new(std::size_t size)
+{
+    ++gAllocs;
+    gAllocBytes += size;
+    if (void* p = std::malloc(size ? size : 1))
+        return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+
+namespace
+{
+
+// ---- Inputs ----
+
+struct BenchPoint
+{
+    float X = 0.0f, Y = 0.0f, Z = 0.0f, O = 0.0f;
+    bool  IsBossPosition = false;
+};
+
+// Stand-ins for the summoned creature and the session's records.
+struct BenchCreature
+{
+    uint32_t Entry       = 0;
+    uint32_t UnitClass   = 1;
+    uint32_t MaxHealth   = 0;
+    uint32_t Armor       = 0;
+    uint32_t AttackTime  = 2000;
+    CreatureStats Stats;
+};
+
+struct BenchRecord
+{
+    uint64_t Guid    = 0;
+    uint32_t Entry   = 0;
+    bool     IsElite = false;
+    bool     IsBoss  = false;
+    bool     IsRare  = false;
+};
+
+// Synthetic pools shaped like the module's startup queries on a stock DB.
+struct BenchData
+{
+    CreaturePoolByType Trash;
+    CreaturePoolByType Bosses;
+    CreaturePoolByType DungeonBosses;
+    std::map<std::pair<uint8_t, uint8_t>, ClassLevelStatEntry> ClassLevelStats;
+    std::vector<uint32_t> Theme;
+
+    void Build(uint32_t seed)
+    {
+        std::mt19937 rng(seed);
+        auto roll = [&](uint32_t lo, uint32_t hi) { return std::uniform_int_distribution<uint32_t>(lo, hi)(rng); };
+
+        for (uint32_t i = 0; i < 2000; ++i)
+            Trash[roll(1, 10)].push_back({ 100000 + i, 0, 1, 80 });
+        for (uint32_t i = 0; i < 240; ++i)
+            Bosses[roll(1, 10)].push_back({ 150000 + i, 0, 1, 80 });
+        for (uint32_t i = 0; i < 180; ++i)
+            DungeonBosses[roll(1, 10)].push_back({ 160000 + i, 0, 1, 80 });
+
+        // creature_classlevelstats: warrior, paladin, rogue, mage rows
+        static uint8_t const kClasses[] = { 1, 2, 4, 8 };
+        for (uint8_t cls : kClasses)
+        {
+            for (uint32_t lvl = 1; lvl <= 83; ++lvl)
+            {
+                ClassLevelStatEntry e;
+                e.BaseHP      = 40 + lvl * lvl * (cls == 8 ? 2 : 3);
+                e.BaseDamage  = 2.0f + lvl * 1.6f;
+                e.BaseArmor   = lvl * 60;
+                e.AttackPower = lvl * 9;
+                ClassLevelStats[{ cls, uint8_t(lvl) }] = e;
+            }
+        }
+
+        Theme = { 1, 2, 6, 7 };
+    }
+
+    ClassLevelStatEntry const* BaseStats(uint8_t unitClass, uint8_t level) const
+    {
+        auto it = ClassLevelStats.find({ unitClass, level });
+        if (it != ClassLevelStats.end())
+            return &it->second;
+        it = ClassLevelStats.find({ 1, level });
+        return it != ClassLevelStats.end() ? &it->second : nullptr;
+    }
+};
+
+// A walk from the entrance; the last 1-4 points are the boss positions.
+std::vector<BenchPoint> SynthesizeSpawns(DungeonDef const& d, uint32_t seed)
+{
+    std::mt19937 rng(seed ^ (d.Map * 2654435761u));
+    auto roll  = [&](uint32_t lo, uint32_t hi) { return std::uniform_int_distribution<uint32_t>(lo, hi)(rng); };
+    auto frand = [&](float lo, float hi) { return std::uniform_real_distribution<float>(lo, hi)(rng); };
+
+    // Bigger dungeons at higher levels, like the stock creature tables.
+    uint32_t trash  = roll(60, 140) + d.MaxLevel;
+    uint32_t bosses = roll(1, 4);
+
+    std::vector<BenchPoint> pts;
+    pts.reserve(trash + bosses);
+    float x = 0.0f, y = 0.0f, z = 0.0f, heading = frand(0.0f, 6.2831f);
+    for (uint32_t i = 0; i < trash + bosses; ++i)
+    {
+        heading += frand(-0.6f, 0.6f);
+        float step = frand(4.0f, 14.0f);
+        x += std::cos(heading) * step;
+        y += std::sin(heading) * step;
+        z += frand(-0.8f, 0.8f);
+
+        BenchPoint p;
+        p.X = x; p.Y = y; p.Z = z; p.O = heading;
+        p.IsBossPosition = i >= trash;
+        pts.push_back(p);
+    }
+    return pts;
+}
+
+bool LoadSpawns(char const* path, std::map<uint32_t, std::vector<BenchPoint>>& out)
+{
+    FILE* f = std::fopen(path, "r");
+    if (!f)
+        return false;
+    uint32_t map, boss;
+    BenchPoint p;
+    while (std::fscanf(f, "%u %f %f %f %f %u", &map, &p.X, &p.Y, &p.Z, &p.O, &boss) == 6)
+    {
+        p.IsBossPosition = boss != 0;
+        out[map].push_back(p);
+    }
+    std::fclose(f);
+    return true;
+}
+
+// ---- Pipeline ----
+
+enum Phase
+{
+    PHASE_TRASH,
+    PHASE_RARE,
+    PHASE_BOSSES,
+    PHASE_STATS,
+    PHASE_RECORDS,
+    PHASE_COUNT,
+};
+
+char const* const kPhaseNames[PHASE_COUNT] = { "trash", "rare", "bosses", "stats", "records" };
+
+struct DungeonResult
+{
+    double   TotalUs = 0.0;
+    std::array<double, PHASE_COUNT> PhaseUs{};
+    uint64_t Allocs = 0;
+    uint64_t AllocBytes = 0;
+    uint64_t Spawns = 0;
+};
+
+using Clock = std::chrono::steady_clock;
+
+double Since(Clock::time_point& t0)
+{
+    auto t1 = Clock::now();
+    double us = std::chrono::duration<double, std::micro>(t1 - t0).count();
+    t0 = t1;
+    return us;
+}
+
+// One PopulateDungeon minus the summons, timed phase by phase.
+void Populate(BenchData const& data, DungeonDef const& d, std::vector<BenchPoint> const& points,
+              PopulateParams const& params, std::mt19937& rng, uint64_t& nextGuid,
+              DungeonResult& res, uint64_t& sink)
+{
+    uint8_t level = uint8_t((d.MinLevel + d.MaxLevel) / 2);
+
+    auto pickTrash = [&] { return SelectCreatureForTheme(data.Theme, data.Trash, data.Bosses, false, rng).Entry; };
+    auto pickRare  = [&] { return SelectCreatureForTheme(data.Theme, data.Trash, data.Bosses, true, rng).Entry; };
+    auto pickBoss  = [&] { return SelectDungeonBoss(data.Theme, data.DungeonBosses, rng).Entry; };
+
+    uint64_t allocs = gAllocs, bytes = gAllocBytes;
+    auto start = Clock::now();
+    auto t0 = start;
+
+    PopulationPlan plan;
+    plan.Spawns.reserve(points.size() + 1);
+    PlanTrash(points, params, pickTrash, rng, plan);
+    res.PhaseUs[PHASE_TRASH] += Since(t0);
+    PlanRare(points, params, pickRare, rng, plan);
+    res.PhaseUs[PHASE_RARE] += Since(t0);
+    PlanBosses(points, params, pickBoss, plan);
+    res.PhaseUs[PHASE_BOSSES] += Since(t0);
+
+    std::vector<BenchCreature> creatures(plan.Spawns.size());
+    for (size_t i = 0; i < plan.Spawns.size(); ++i)
+    {
+        PlannedSpawn const& s = plan.Spawns[i];
+        BenchCreature& c = creatures[i];
+        c.Entry     = s.Entry;
+        c.UnitClass = 1u << (s.Entry % 4);
+        c.MaxHealth = 500 + s.Entry % 1000;
+        c.Armor     = 300 + s.Entry % 200;
+        bool isBoss = s.Role == SpawnRole::Boss;
+        c.Stats = ComputeCreatureStats(data.BaseStats(uint8_t(c.UnitClass), level), c.MaxHealth, c.Armor,
+            c.AttackTime, 1.4f, s.HpMult, isBoss ? 1.2f : 1.3f, s.DmgMult, 1.0f);
+    }
+    res.PhaseUs[PHASE_STATS] += Since(t0);
+
+    std::vector<BenchRecord> records;
+    std::vector<uint64_t> guids;
+    records.reserve(plan.Spawns.size());
+    guids.reserve(plan.Spawns.size() + 1);
+    for (PlannedSpawn const& s : plan.Spawns)
+    {
+        BenchRecord r;
+        r.Guid    = ++nextGuid;
+        r.Entry   = s.Entry;
+        r.IsElite = s.IsElite;
+        r.IsBoss  = s.Role == SpawnRole::Boss;
+        r.IsRare  = s.Role == SpawnRole::Rare;
+        records.push_back(r);
+        guids.push_back(r.Guid);
+    }
+    res.PhaseUs[PHASE_RECORDS] += Since(t0);
+
+    res.TotalUs += std::chrono::duration<double, std::micro>(t0 - start).count();
+    res.Allocs += gAllocs - allocs;
+    res.AllocBytes += gAllocBytes - bytes;
+    res.Spawns += plan.Spawns.size();
+
+    for (BenchCreature const& c : creatures)
+        sink += c.Stats.MaxHealth;
+    sink += guids.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    char const* filter = nullptr;
+    char const* spawnsPath = nullptr;
+    uint32_t iterations = 200;
+    uint32_t seed = 1;
+
+    PopulateParams params;
+    params.EliteChance = 15;
+    params.EliteHpMult = 2.0f;
+    params.RareChance  = 10;
+    params.RareHpMult  = 3.0f;
+    params.RareDmgMult = 1.5f;
+    params.BossCount   = 3;
+    params.BossHpMult  = 8.0f;
+    params.BossDmgMult = 2.5f;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--iterations") && i + 1 < argc)
+            iterations = std::max(1ul, std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--seed") && i + 1 < argc)
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--filter") && i + 1 < argc)
+            filter = argv[++i];
+        else if (!std::strcmp(argv[i], "--spawns") && i + 1 < argc)
+            spawnsPath = argv[++i];
+        else if (!std::strcmp(argv[i], "--elite") && i + 1 < argc)
+            params.EliteChance = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--rare") && i + 1 < argc)
+            params.RareChance = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--bosses") && i + 1 < argc)
+            params.BossCount = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else
+        {
+            std::fprintf(stderr, "usage: dm_popbench [--iterations N] [--seed N] [--filter SUBSTR] "
+                "[--spawns FILE] [--elite PCT] [--rare PCT] [--bosses N]\n");
+            return 2;
+        }
+    }
+
+    std::map<uint32_t, std::vector<BenchPoint>> recorded;
+    if (spawnsPath && !LoadSpawns(spawnsPath, recorded))
+    {
+        std::fprintf(stderr, "dm_popbench: cannot read %s\n", spawnsPath);
+        return 1;
+    }
+
+    BenchData data;
+    data.Build(seed);
+    std::mt19937 rng(seed);
+    uint64_t nextGuid = 0;
+    uint64_t sink = 0;
+
+    std::printf("dm_popbench: %zu dungeons, %u iterations, elite %u%%, rare %u%%, %u boss(es), seed %u\n",
+        std::size(DUNGEON_TABLE), iterations, params.EliteChance, params.RareChance, params.BossCount, seed);
+    std::printf("  %-5s %-28s %3s %5s %9s %8s %9s", "map", "dungeon", "src", "spawn", "us/pop", "allocs", "KiB");
+    for (char const* name : kPhaseNames)
+        std::printf(" %8s", name);
+    std::printf("\n");
+
+    DungeonResult all;
+    uint32_t dungeons = 0;
+    for (DungeonDef const& d : DUNGEON_TABLE)
+    {
+        if (filter && !std::strstr(d.Name, filter))
+            continue;
+
+        auto rec = recorded.find(d.Map);
+        bool isRecorded = rec != recorded.end();
+        std::vector<BenchPoint> points = isRecorded ? rec->second : SynthesizeSpawns(d, seed);
+
+        // One untimed pass to warm the pools and the allocator.
+        DungeonResult warm;
+        Populate(data, d, points, params, rng, nextGuid, warm, sink);
+
+        DungeonResult res;
+        for (uint32_t it = 0; it < iterations; ++it)
+            Populate(data, d, points, params, rng, nextGuid, res, sink);
+
+        double n = iterations;
+        std::printf("  %-5u %-28.28s %3s %5.0f %9.2f %8.1f %9.1f",
+            d.Map, d.Name, isRecorded ? "rec" : "syn", res.Spawns / n, res.TotalUs / n,
+            res.Allocs / n, res.AllocBytes / n / 1024.0);
+        for (double us : res.PhaseUs)
+            std::printf(" %8.2f", us / n);
+        std::printf("\n");
+
+        all.TotalUs += res.TotalUs / n;
+        all.Allocs += res.Allocs;
+        all.AllocBytes += res.AllocBytes;
+        all.Spawns += res.Spawns;
+        for (size_t p = 0; p < PHASE_COUNT; ++p)
+            all.PhaseUs[p] += res.PhaseUs[p] / n;
+        ++dungeons;
+    }
+
+    if (!dungeons)
+    {
+        std::fprintf(stderr, "dm_popbench: no dungeon matches '%s'\n", filter);
+        return 1;
+    }
+
+    double n = double(dungeons) * iterations;
+    std::printf("  %-5s %-28s %3s %5.0f %9.2f %8.1f %9.1f", "all", "(mean per dungeon)", "",
+        all.Spawns / n, all.TotalUs / dungeons, all.Allocs / n, all.AllocBytes / n / 1024.0);
+    for (double us : all.PhaseUs)
+        std::printf(" %8.2f", us / dungeons);
+    std::printf("\n[checksum %llu]\n", (unsigned long long)sink);
+    return 0;
+}
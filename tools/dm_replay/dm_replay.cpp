@@ -0,0 +1,324 @@
+/*
+ * mod-dungeon-master — dm_replay.cpp
+ * Replays a hook recording (.dmhk, see src/core/DMHookTrace.h) through the
+ * same ownership lookups and scaling math the damage hooks use, verifies the
+ * recomputed damage against what the server produced, then times the path.
+ *
+ *   dm_replay <file.dmhk> [--iterations N] [--verbose]
+ */
+
+#include "DMHookTrace.h"
+#include "DMScalingMath.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iterator>
+#include <unordered_map>
+#include <vector>
+
+using namespace DungeonMaster::Core;
+
+namespace
+{
+
+struct ReplayCreature
+{
+    uint64_t Guid          = 0;
+    bool     IsBoss        = false;
+    uint8_t  TemplateLevel = 0;
+    float    TargetBaseDamage   = -1.0f;
+    float    TemplateBaseDamage = -1.0f;
+};
+
+struct ReplaySession
+{
+    uint32_t Id             = 0;
+    uint8_t  EffectiveLevel = 0;
+    uint8_t  DungeonLevel   = 0;
+    bool     ScaleToParty   = true;
+    float    SoloMultiplier = 0.5f;
+    uint32_t PartySize      = 0;
+    std::vector<ReplayCreature> Creatures;
+
+    ReplayCreature const* FindCreature(uint64_t guid) const
+    {
+        for (auto const& c : Creatures)
+            if (c.Guid == guid)
+                return &c;
+        return nullptr;
+    }
+};
+
+// Mirrors DungeonMasterMgr's session indices and the lookup sequence in
+// dm_unit_script: session-by-player, then creature ownership, then scale.
+class ReplayState
+{
+public:
+    void Reset()
+    {
+        _sessions.clear();
+        _playerToSession.clear();
+        _instanceToSession.clear();
+    }
+
+    void Apply(HookRecord const& r)
+    {
+        switch (HookType(r.Type))
+        {
+            case HookType::SessionStart:
+            {
+                ReplaySession& s = _sessions[r.SessionId];
+                s = ReplaySession();
+                s.Id             = r.SessionId;
+                s.EffectiveLevel = static_cast<uint8_t>(r.Amount);
+                s.DungeonLevel   = static_cast<uint8_t>(r.Extra);
+                s.ScaleToParty   = (r.Flags & HOOK_FLAG_SCALE_TO_PARTY) != 0;
+                s.SoloMultiplier = r.F0;
+                break;
+            }
+            case HookType::PlayerJoin:
+                _playerToSession[r.Actor] = r.SessionId;
+                if (auto it = _sessions.find(r.SessionId); it != _sessions.end())
+                    ++it->second.PartySize;
+                break;
+            case HookType::InstanceBind:
+                _instanceToSession[r.InstanceId] = r.SessionId;
+                break;
+            case HookType::CreatureSpawn:
+                if (auto it = _sessions.find(r.SessionId); it != _sessions.end())
+                {
+                    ReplayCreature c;
+                    c.Guid               = r.Actor;
+                    c.IsBoss             = (r.Flags & HOOK_FLAG_BOSS) != 0;
+                    c.TemplateLevel      = static_cast<uint8_t>(r.Extra);
+                    c.TargetBaseDamage   = r.F0;
+                    c.TemplateBaseDamage = r.F1;
+                    it->second.Creatures.push_back(c);
+                }
+                break;
+            case HookType::SessionEnd:
+            {
+                for (auto it = _playerToSession.begin(); it != _playerToSession.end();)
+                    it = (it->second == r.SessionId) ? _playerToSession.erase(it) : std::next(it);
+                if (r.InstanceId)
+                    _instanceToSession.erase(r.InstanceId);
+                _sessions.erase(r.SessionId);
+                break;
+            }
+            default:
+                break;
+        }
+    }
+
+    // Returns the damage the hook would produce for a damage record.
+    uint32_t ScaleDamage(HookRecord const& r) const
+    {
+        uint32_t damage = r.Amount;
+        if (damage == 0)
+            return 0;
+
+        // Player GUIDs carry HighGuid::Player (0) in the top 16 bits.
+        if (r.Other && (r.Other >> 48) == 0)
+            return damage;
+
+        ReplaySession const* s = SessionByPlayer(r.Actor);
+        if (!s)
+            return damage;
+
+        if (r.Other && IsSessionCreature(r.Actor, r.Other))
+            return ApplySessionCreatureScale(damage, CreatureDamageScale(r.Actor, r.Other));
+
+        return ApplyEnvironmentalScale(damage, EnvironmentalScale(r.Actor), r.Extra);
+    }
+
+    size_t SessionCount() const { return _sessions.size(); }
+
+private:
+    ReplaySession const* SessionByPlayer(uint64_t player) const
+    {
+        auto pit = _playerToSession.find(player);
+        if (pit == _playerToSession.end())
+            return nullptr;
+        auto sit = _sessions.find(pit->second);
+        return sit != _sessions.end() ? &sit->second : nullptr;
+    }
+
+    bool IsSessionCreature(uint64_t player, uint64_t creature) const
+    {
+        ReplaySession const* s = SessionByPlayer(player);
+        return s && s->FindCreature(creature);
+    }
+
+    float CreatureDamageScale(uint64_t player, uint64_t creature) const
+    {
+        ReplaySession const* s = SessionByPlayer(player);
+        if (!s)
+            return 1.0f;
+        ReplayCreature const* c = s->FindCreature(creature);
+        if (!c || !c->IsBoss)
+            return 1.0f;
+
+        float target = (c->TargetBaseDamage >= 0.0f && c->TemplateBaseDamage >= 0.0f)
+            ? c->TargetBaseDamage : -1.0f;
+        return BossSpellDamageScale(s->EffectiveLevel, c->TemplateLevel,
+            target, c->TemplateBaseDamage, s->PartySize, s->SoloMultiplier);
+    }
+
+    float EnvironmentalScale(uint64_t player) const
+    {
+        ReplaySession const* s = SessionByPlayer(player);
+        if (!s || !s->ScaleToParty || !s->DungeonLevel)
+            return 1.0f;
+        return EnvironmentalDamageScale(s->EffectiveLevel, s->DungeonLevel);
+    }
+
+    std::unordered_map<uint32_t, ReplaySession> _sessions;
+    std::unordered_map<uint64_t, uint32_t>      _playerToSession;
+    std::unordered_map<uint32_t, uint32_t>      _instanceToSession;
+};
+
+bool IsDamageHook(uint8_t type)
+{
+    return type == uint8_t(HookType::PeriodicDamage)
+        || type == uint8_t(HookType::SpellDamage)
+        || type == uint8_t(HookType::MeleeDamage);
+}
+
+char const* HookName(uint8_t type)
+{
+    switch (HookType(type))
+    {
+        case HookType::PeriodicDamage: return "periodic";
+        case HookType::SpellDamage:    return "spell";
+        case HookType::MeleeDamage:    return "melee";
+        case HookType::UnitDeath:      return "death";
+        case HookType::SessionStart:   return "session-start";
+        case HookType::PlayerJoin:     return "player-join";
+        case HookType::InstanceBind:   return "instance-bind";
+        case HookType::CreatureSpawn:  return "creature-spawn";
+        case HookType::SessionEnd:     return "session-end";
+    }
+    return "unknown";
+}
+
+bool LoadTrace(char const* path, std::vector<HookRecord>& out, HookTraceHeader& hdr)
+{
+    FILE* f = std::fopen(path, "rb");
+    if (!f)
+    {
+        std::fprintf(stderr, "dm_replay: cannot open %s\n", path);
+        return false;
+    }
+
+    bool ok = std::fread(&hdr, sizeof(hdr), 1, f) == 1
+        && hdr.Magic == HOOK_TRACE_MAGIC
+        && hdr.Version == HOOK_TRACE_VERSION
+        && hdr.RecordSize == sizeof(HookRecord);
+    if (!ok)
+    {
+        std::fprintf(stderr, "dm_replay: %s is not a v%u hook recording\n", path, HOOK_TRACE_VERSION);
+        std::fclose(f);
+        return false;
+    }
+
+    HookRecord rec;
+    while (std::fread(&rec, sizeof(rec), 1, f) == 1)
+        out.push_back(rec);
+    std::fclose(f);
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    char const* path = nullptr;
+    uint32_t iterations = 10;
+    bool verbose = false;
+
+    for (int i = 1; i < argc; ++i)
+    {
+        if (!std::strcmp(argv[i], "--iterations") && i + 1 < argc)
+            iterations = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        else if (!std::strcmp(argv[i], "--verbose"))
+            verbose = true;
+        else if (argv[i][0] != '-')
+            path = argv[i];
+        else
+        {
+            std::fprintf(stderr, "dm_replay: unknown option %s\n", argv[i]);
+            return 2;
+        }
+    }
+
+    if (!path)
+    {
+        std::fprintf(stderr, "usage: dm_replay <file.dmhk> [--iterations N] [--verbose]\n");
+        return 2;
+    }
+
+    HookTraceHeader hdr;
+    std::vector<HookRecord> records;
+    if (!LoadTrace(path, records, hdr))
+        return 1;
+
+    // ---- Verify: recompute every damage hook and compare ----
+    uint64_t counts[256] = {};
+    uint64_t damageHooks = 0, mismatches = 0;
+    size_t peakSessions = 0;
+    ReplayState state;
+    for (HookRecord const& r : records)
+    {
+        ++counts[r.Type];
+        state.Apply(r);
+        peakSessions = std::max(peakSessions, state.SessionCount());
+        if (!IsDamageHook(r.Type))
+            continue;
+
+        ++damageHooks;
+        uint32_t out = state.ScaleDamage(r);
+        if (out != r.Result)
+        {
+            ++mismatches;
+            if (verbose && mismatches <= 20)
+                std::printf("  mismatch @%.3fs %s target=%llx attacker=%llx in=%u recorded=%u replay=%u\n",
+                    r.TimeUs / 1e6, HookName(r.Type),
+                    (unsigned long long)r.Actor, (unsigned long long)r.Other,
+                    r.Amount, r.Result, out);
+        }
+    }
+
+    double spanSec = records.empty() ? 0.0 : records.back().TimeUs / 1e6;
+    std::printf("dm_replay: %zu records over %.1f s, peak %zu concurrent session(s)\n",
+        records.size(), spanSec, peakSessions);
+    for (uint32_t t = 0; t < 256; ++t)
+        if (counts[t])
+            std::printf("  %-15s %llu\n", HookName(uint8_t(t)), (unsigned long long)counts[t]);
+    std::printf("verify: %llu damage hooks, %llu mismatch(es)\n",
+        (unsigned long long)damageHooks, (unsigned long long)mismatches);
+
+    // ---- Bench: full replay, state rebuilt each iteration ----
+    if (iterations && damageHooks)
+    {
+        uint64_t sink = 0;
+        auto t0 = std::chrono::steady_clock::now();
+        for (uint32_t it = 0; it < iterations; ++it)
+        {
+            state.Reset();
+            for (HookRecord const& r : records)
+            {
+                state.Apply(r);
+                if (IsDamageHook(r.Type))
+                    sink += state.ScaleDamage(r);
+            }
+        }
+        double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - t0).count();
+        double perHook = ns / (double(damageHooks) * iterations);
+        std::printf("bench: %u iteration(s), %.1f ns/damage hook (%.2f M hooks/s)  [checksum %llu]\n",
+            iterations, perHook, 1e3 / perHook, (unsigned long long)sink);
+    }
+
+    return mismatches ? 3 : 0;
+}
@@ -0,0 +1,473 @@
+/*
+ * mod-dungeon-master — dm_stress.cpp
+ * Concurrency stress harness for the session and roguelike run lifecycle.
+ * Runs the dm_loadsim world (bot parties, map worker threads firing the
+ * unit/player hooks and creature deaths) with a fast, roguelike-heavy
+ * schedule and random abandons, while extra "hammer" threads call the
+ * manager's lookup entry points — the ones that hand out Session* and
+ * RoguelikeRun* — against the same players, creatures and instances.
+ * Config reloads (.dm reload) are mixed in to exercise the snapshot swap.
+ * Build with -DDM_SANITIZER=thread or =address to catch races and
+ * use-after-frees; reports per-entry-point throughput.
+ *
+ *   dm_stress [--parties N] [--duration SEC] [--tick MS] [--map-threads N]
+ *             [--hammer-threads N] [--roguelike-pct P] [--abandon-per-min N]
+ *             [--reload-per-min N]
+ *             [--player-power X] [--seed S] [--conf FILE] [--set Key=Value]...
+ *             [--log-level 0-5]
+ */
+
+#include "DMConfig.h"
+#include "DMMutex.h"
+#include "DungeonMasterMgr.h"
+#include "RoguelikeMgr.h"
+#include "SimDatabase.h"
+#include "SimWorld.h"
+#include "ScriptMgr.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+void AddSC_dm_player_script();
+void AddSC_dm_world_script();
+void AddSC_dm_allmap_script();
+void AddSC_dm_unit_script();
+
+using namespace DungeonMaster;
+using namespace DungeonMaster::Sim;
+
+namespace
+{
+
+struct Options
+{
+    uint32      Parties        = 60;
+    uint32      DurationSec    = 900;
+    uint32      TickMs         = 50;
+    uint32      MapThreads     = 4;
+    uint32      HammerThreads  = 4;
+    uint32      RoguelikePct   = 70;
+    uint32      AbandonPerMin  = 6;
+    uint32      ReloadPerMin   = 2;
+    uint32      Seed           = 1;
+    float       PlayerPower    = 3.0f;
+    int         LogLevel       = Stub::LOG_LEVEL_ERROR;
+    std::string ConfPath       = DM_DEFAULT_CONF;
+    std::vector<std::pair<std::string, std::string>> Sets;
+};
+
+Options gOpt;
+
+// ---- Targets ----
+
+// What the hammer threads aim at: every bot player, plus the creatures and
+// instance ids seen in the last world phase. Rebuilt by the world thread
+// while the maps are idle and swapped in whole.
+struct Targets
+{
+    std::vector<ObjectGuid> Players;
+    std::vector<ObjectGuid> Creatures;
+    std::vector<uint32>     InstanceIds;
+};
+
+class TargetBoard
+{
+public:
+    void Publish(std::shared_ptr<Targets const> t)
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        _current = std::move(t);
+    }
+
+    std::shared_ptr<Targets const> Get() const
+    {
+        std::lock_guard<std::mutex> lock(_lock);
+        return _current;
+    }
+
+private:
+    mutable std::mutex _lock;
+    std::shared_ptr<Targets const> _current;
+};
+
+std::shared_ptr<Targets const> BuildTargets(SimWorld const& world, std::vector<Map*> const& maps)
+{
+    auto t = std::make_shared<Targets>();
+    for (auto const& party : world.GetParties())
+        for (auto const& m : party->Members)
+            t->Players.push_back(m->GetGUID());
+    for (Map* map : maps)
+    {
+        if (!map->IsDungeon())
+            continue;
+        t->InstanceIds.push_back(map->GetInstanceId());
+        for (Creature* c : map->GetAllCreatures())
+            t->Creatures.push_back(c->GetGUID());
+    }
+    return t;
+}
+
+// ---- Hammer threads ----
+
+enum HammerOp : uint32
+{
+    OP_SESSION_BY_PLAYER,
+    OP_SESSION_BY_INSTANCE,
+    OP_SESSION_STATUS,
+    OP_IS_SESSION_CREATURE,
+    OP_IS_SESSION_BOSS,
+    OP_ENV_DAMAGE_SCALE,
+    OP_RUN_BY_PLAYER,
+    OP_IS_PLAYER_IN_RUN,
+    OP_TIER_MULTIPLIERS,
+    OP_AFFIX_NAMES,
+    OP_ACTIVE_COUNTS,
+    OP_COOLDOWN,
+    OP_COUNT
+};
+
+constexpr char const* kOpNames[OP_COUNT] =
+{
+    "GetSessionByPlayer",
+    "GetSessionByInstance",
+    "GetSessionStatusString",
+    "IsSessionCreature",
+    "IsSessionBoss",
+    "GetEnvironmentalDamageScale",
+    "GetRunByPlayer",
+    "IsPlayerInRun",
+    "GetTier*Multiplier",
+    "GetActiveAffixNames",
+    "GetActive*Count",
+    "IsOnCooldown",
+};
+
+// One per hammer thread, padded so the owners' relaxed increments don't
+// share a cache line; the reporter only reads them.
+struct alignas(64) HammerCounters
+{
+    std::atomic<uint64> Ops[OP_COUNT] = {};
+};
+
+// Touches the fields a gossip menu or .dm command reads through the
+// returned pointer. Each thread folds what it read into its own sink and
+// publishes it on exit, so the reads can't be elided.
+thread_local uint64 tSink = 0;
+std::atomic<uint64> gSink{ 0 };
+
+void ReadSession(Session const* s)
+{
+    if (!s)
+        return;
+    uint64 v = s->SessionId + uint32(s->State) + s->MobsKilled + s->TotalMobs + s->Players.size();
+    for (auto const& pd : s->Players)
+        v += pd.Deaths;
+    tSink += v;
+}
+
+void ReadRun(RoguelikeRun const* r)
+{
+    if (!r)
+        return;
+    uint64 v = r->RunId + r->CurrentTier + r->CurrentSessionId + r->BuffStacks + r->Players.size();
+    for (RoguelikeAffix a : r->ActiveAffixes)
+        v += uint32(a);
+    tSink += v;
+}
+
+void HammerThread(uint32 index, TargetBoard const& board, std::atomic<bool> const& stop, HammerCounters& counters)
+{
+    tRng.seed(gOpt.Seed * 7919 + index);
+    uint32 lastRunId = 0;
+
+    while (!stop.load(std::memory_order_relaxed))
+    {
+        std::shared_ptr<Targets const> t = board.Get();
+        if (!t || t->Players.empty())
+        {
+            std::this_thread::yield();
+            continue;
+        }
+
+        // A batch per snapshot keeps the board lock out of the profile.
+        for (uint32 n = 0; n < 256; ++n)
+        {
+            ObjectGuid player = t->Players[RandInt(0, uint32(t->Players.size() - 1))];
+            ObjectGuid creature = t->Creatures.empty() ? ObjectGuid::Empty
+                : t->Creatures[RandInt(0, uint32(t->Creatures.size() - 1))];
+            uint32 op = RandInt(0, OP_COUNT - 1);
+
+            switch (op)
+            {
+                case OP_SESSION_BY_PLAYER:
+                    ReadSession(sDungeonMasterMgr->GetSessionByPlayer(player));
+                    break;
+                case OP_SESSION_BY_INSTANCE:
+                    if (!t->InstanceIds.empty())
+                        ReadSession(sDungeonMasterMgr->GetSessionByInstance(
+                            t->InstanceIds[RandInt(0, uint32(t->InstanceIds.size() - 1))]));
+                    break;
+                case OP_SESSION_STATUS:
+                    tSink += sDungeonMasterMgr->GetSessionStatusString(
+                        sDungeonMasterMgr->GetSessionByPlayer(player)).size();
+                    break;
+                case OP_IS_SESSION_CREATURE:
+                    tSink += sDungeonMasterMgr->IsSessionCreature(player, creature);
+                    break;
+                case OP_IS_SESSION_BOSS:
+                    tSink += sDungeonMasterMgr->IsSessionBoss(player, creature);
+                    break;
+                case OP_ENV_DAMAGE_SCALE:
+                    tSink += uint64(sDungeonMasterMgr->GetEnvironmentalDamageScale(player) * 100.0f);
+                    break;
+                case OP_RUN_BY_PLAYER:
+                    if (RoguelikeRun* run = sRoguelikeMgr->GetRunByPlayer(player))
+                    {
+                        lastRunId = run->RunId;
+                        ReadRun(run);
+                    }
+                    break;
+                case OP_IS_PLAYER_IN_RUN:
+                    tSink += sRoguelikeMgr->IsPlayerInRun(player);
+                    break;
+                case OP_TIER_MULTIPLIERS:
+                    tSink += uint64((sRoguelikeMgr->GetTierHealthMultiplier(lastRunId)
+                        + sRoguelikeMgr->GetTierDamageMultiplier(lastRunId)
+                        + sRoguelikeMgr->GetTierArmorMultiplier(lastRunId)) * 100.0f);
+                    break;
+                case OP_AFFIX_NAMES:
+                    tSink += sRoguelikeMgr->GetActiveAffixNames(lastRunId).size();
+                    break;
+                case OP_ACTIVE_COUNTS:
+                    tSink += sDungeonMasterMgr->GetActiveSessionCount() + sRoguelikeMgr->GetActiveRunCount();
+                    break;
+                case OP_COOLDOWN:
+                    tSink += sDungeonMasterMgr->IsOnCooldown(player) + sDungeonMasterMgr->GetRemainingCooldown(player);
+                    break;
+            }
+            counters.Ops[op].fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+    gSink.fetch_add(tSink);
+}
+
+// ---- Churn ----
+
+// Gives up a random party's run from the world thread, as the NPC's
+// "leave" option or .dm abandon would; roguelike runs end through
+// AbandonRun so the run and its current floor go together.
+bool AbandonRandomRun(SimWorld const& world)
+{
+    auto const& parties = world.GetParties();
+    if (parties.empty())
+        return false;
+
+    SimParty const& party = *parties[RandInt(0, uint32(parties.size() - 1))];
+    ObjectGuid leader = party.Members.front()->GetGUID();
+    if (RoguelikeRun* run = sRoguelikeMgr->GetRunByPlayer(leader))
+    {
+        sRoguelikeMgr->AbandonRun(run->RunId);
+        return true;
+    }
+    if (Session* s = sDungeonMasterMgr->GetSessionByPlayer(leader))
+    {
+        sDungeonMasterMgr->AbandonSession(s->SessionId);
+        return true;
+    }
+    return false;
+}
+
+bool ParseArgs(int argc, char** argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        auto next = [&]() -> char const* { return i + 1 < argc ? argv[++i] : nullptr; };
+        auto num = [&]() -> uint32 { char const* v = next(); return v ? uint32(std::strtoul(v, nullptr, 10)) : 0; };
+
+        if (!std::strcmp(argv[i], "--parties"))              gOpt.Parties = num();
+        else if (!std::strcmp(argv[i], "--duration"))        gOpt.DurationSec = num();
+        else if (!std::strcmp(argv[i], "--tick"))            gOpt.TickMs = std::max(1u, num());
+        else if (!std::strcmp(argv[i], "--map-threads"))     gOpt.MapThreads = std::max(1u, num());
+        else if (!std::strcmp(argv[i], "--hammer-threads"))  gOpt.HammerThreads = num();
+        else if (!std::strcmp(argv[i], "--roguelike-pct"))   gOpt.RoguelikePct = std::min(100u, num());
+        else if (!std::strcmp(argv[i], "--abandon-per-min")) gOpt.AbandonPerMin = num();
+        else if (!std::strcmp(argv[i], "--reload-per-min"))  gOpt.ReloadPerMin = num();
+        else if (!std::strcmp(argv[i], "--seed"))            gOpt.Seed = num();
+        else if (!std::strcmp(argv[i], "--log-level"))       gOpt.LogLevel = int(num());
+        else if (!std::strcmp(argv[i], "--player-power"))
+        {
+            char const* v = next();
+            gOpt.PlayerPower = v ? std::strtof(v, nullptr) : 1.0f;
+        }
+        else if (!std::strcmp(argv[i], "--conf"))
+        {
+            char const* v = next();
+            if (v)
+                gOpt.ConfPath = v;
+        }
+        else if (!std::strcmp(argv[i], "--set"))
+        {
+            char const* v = next();
+            char const* eq = v ? std::strchr(v, '=') : nullptr;
+            if (!eq)
+            {
+                std::fprintf(stderr, "dm_stress: --set expects Key=Value\n");
+                return false;
+            }
+            gOpt.Sets.emplace_back(std::string(v, eq), std::string(eq + 1));
+        }
+        else
+        {
+            std::fprintf(stderr, "dm_stress: unknown option %s\n", argv[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (!ParseArgs(argc, argv))
+        return 2;
+
+    tRng.seed(gOpt.Seed);
+    Stub::gLogLevel = gOpt.LogLevel;
+
+    if (!sConfigMgr->LoadFile(gOpt.ConfPath))
+    {
+        std::fprintf(stderr, "dm_stress: cannot read config %s\n", gOpt.ConfPath.c_str());
+        return 1;
+    }
+    // Short cooldowns and floor transitions keep the lifecycle churning.
+    sConfigMgr->Set("DungeonMaster.HookRecorder.Enable", "0");
+    sConfigMgr->Set("DungeonMaster.Trace.Enable", "0");
+    sConfigMgr->Set("DungeonMaster.LockProfiler.Enable", "1");
+    sConfigMgr->Set("DungeonMaster.Cooldown.Minutes", "0");
+    sConfigMgr->Set("DungeonMaster.Roguelike.TransitionDelay", "2");
+    for (auto const& [key, value] : gOpt.Sets)
+        sConfigMgr->Set(key, value);
+
+    SimDatabase db;
+    db.Install(gOpt.Seed);
+
+    AddSC_dm_player_script();
+    AddSC_dm_world_script();
+    AddSC_dm_allmap_script();
+    AddSC_dm_unit_script();
+
+    for (WorldScript* s : Stub::ScriptList<WorldScript>())
+        s->OnAfterConfigLoad(false);
+    for (WorldScript* s : Stub::ScriptList<WorldScript>())
+        s->OnStartup();
+    if (!sDMConfig->IsEnabled())
+    {
+        std::fprintf(stderr, "dm_stress: module disabled by configuration\n");
+        return 1;
+    }
+    DMMutex::ResetAll();
+
+    SimWorld world(db, { gOpt.RoguelikePct, gOpt.PlayerPower, gOpt.Seed });
+    world.CreateParties(gOpt.Parties);
+
+    std::printf("dm_stress: %u parties (%u players), %u s simulated at %u ms ticks, "
+        "%u map thread(s), %u hammer thread(s)\n",
+        gOpt.Parties, world.GetPlayerCount(), gOpt.DurationSec, gOpt.TickMs,
+        gOpt.MapThreads, gOpt.HammerThreads);
+
+    TargetBoard board;
+    std::atomic<bool> stop{ false };
+    std::vector<HammerCounters> counters(gOpt.HammerThreads);
+    std::vector<std::thread> hammers;
+    std::vector<Map*> maps;
+    world.CollectMaps(maps);
+    board.Publish(BuildTargets(world, maps));
+
+    auto wallStart = std::chrono::steady_clock::now();
+    for (uint32 i = 0; i < gOpt.HammerThreads; ++i)
+        hammers.emplace_back(HammerThread, i, std::cref(board), std::cref(stop), std::ref(counters[i]));
+
+    uint64 abandons = 0, reloads = 0;
+    uint32 peakSessions = 0, peakRuns = 0;
+    {
+        MapUpdater updater(gOpt.MapThreads, gOpt.Seed);
+        uint64 ticks = uint64(gOpt.DurationSec) * 1000 / gOpt.TickMs;
+        for (uint64 tick = 1; tick <= ticks; ++tick)
+        {
+            // World phase, as dm_loadsim, plus the odd abandon.
+            world.ProcessTeleports();
+            world.UpdateParties(gOpt.TickMs);
+            if (RandInt(0, 59999) < gOpt.AbandonPerMin * gOpt.TickMs && AbandonRandomRun(world))
+                ++abandons;
+            if (RandInt(0, 59999) < gOpt.ReloadPerMin * gOpt.TickMs)
+            {
+                for (WorldScript* s : Stub::ScriptList<WorldScript>())
+                    s->OnAfterConfigLoad(true);
+                ++reloads;
+            }
+            for (WorldScript* s : Stub::ScriptList<WorldScript>())
+                s->OnUpdate(gOpt.TickMs);
+
+            world.CollectMaps(maps);
+            board.Publish(BuildTargets(world, maps));
+
+            // Map phase: hooks and deaths on the workers, hammers still running.
+            updater.Update(maps, gOpt.TickMs);
+            world.UnloadEmptyInstances();
+
+            Stub::AdvanceGameTime(gOpt.TickMs);
+            peakSessions = std::max(peakSessions, sDungeonMasterMgr->GetActiveSessionCount());
+            peakRuns = std::max(peakRuns, sRoguelikeMgr->GetActiveRunCount());
+        }
+    }
+    world.CollectMaps(maps);
+    board.Publish(BuildTargets(world, maps));
+
+    stop.store(true);
+    for (auto& t : hammers)
+        t.join();
+    double wallSec = std::chrono::duration<double>(std::chrono::steady_clock::now() - wallStart).count();
+
+    std::printf("\nlifecycle: %llu runs started (%llu roguelike), %llu ended, %llu abandoned, %llu rejected\n",
+        (unsigned long long)world.Started, (unsigned long long)world.RoguelikeStarted,
+        (unsigned long long)world.Ended, (unsigned long long)abandons, (unsigned long long)world.Rejected);
+    std::printf("  %llu config reload(s), now at version %u\n",
+        (unsigned long long)reloads, sDMConfig->GetVersion());
+    std::printf("  peak %u session(s), %u run(s); %llu instances created, %llu unloaded; %.1f s wall\n",
+        peakSessions, peakRuns, (unsigned long long)world.InstancesCreated,
+        (unsigned long long)world.InstancesUnloaded, wallSec);
+
+    auto const& c = Stub::gCounters;
+    uint64 hookOps = c.MeleeHooks.load() + c.SpellHooks.load() + c.PeriodicHooks.load();
+    std::printf("\nmap threads: %llu damage hooks (%.0f/s), %llu creature deaths, %llu player deaths, %llu teleports\n",
+        (unsigned long long)hookOps, hookOps / wallSec, (unsigned long long)c.CreatureDeaths.load(),
+        (unsigned long long)c.PlayerDeaths.load(), (unsigned long long)c.Teleports.load());
+
+    std::printf("\nhammer threads:\n");
+    uint64 total = 0;
+    for (uint32 op = 0; op < OP_COUNT; ++op)
+    {
+        uint64 n = 0;
+        for (HammerCounters const& hc : counters)
+            n += hc.Ops[op].load(std::memory_order_relaxed);
+        total += n;
+        std::printf("  %-28s %12llu  %10.0f ops/s\n", kOpNames[op], (unsigned long long)n, n / wallSec);
+    }
+    std::printf("  %-28s %12llu  %10.0f ops/s\n", "total", (unsigned long long)total, total / wallSec);
+
+    std::printf("\nlock contention:\n");
+    for (std::string const& line : DMMutex::BuildReport())
+        std::printf("  %s\n", line.c_str());
+
+    for (WorldScript* s : Stub::ScriptList<WorldScript>())
+        s->OnShutdown();
+    Stub::UnloadScripts();
+    return 0;
+}
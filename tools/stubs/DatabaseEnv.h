@@ -0,0 +1,2 @@
+// Stand-in for the AzerothCore header of the same name (tools/dm_loadsim).
+#include "StubCore.h"
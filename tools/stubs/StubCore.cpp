@@ -0,0 +1,997 @@
+/*
+ * mod-dungeon-master — StubCore.cpp
+ * Runtime for the stand-in core types declared in StubCore.h.
+ */
+
+#include "StubCore.h"
+#include <cmath>
+#include <fstream>
+#include <random>
+#include <thread>
+
+ObjectGuid const ObjectGuid::Empty;
+
+DatabaseWorkerPool WorldDatabase("world");
+DatabaseWorkerPool CharacterDatabase("characters");
+
+namespace Stub
+{
+
+std::atomic<int>    gLogLevel{ LOG_LEVEL_ERROR };
+std::atomic<uint64> gLogLines{ 0 };
+Counters            gCounters;
+
+static std::mutex     sLogLock;
+static PlayerUpdateFn sPlayerUpdate = nullptr;
+
+// Game time starts at a fixed epoch so runs are comparable.
+static std::atomic<uint64> sGameTimeMs{ uint64(1700000000) * 1000 };
+static uint64 const        sStartTimeMs = uint64(1700000000) * 1000;
+
+// Player registry: mutated only between map updates (world thread).
+static std::unordered_map<ObjectGuid, Player*> sPlayers;
+
+static std::atomic<uint32> sNextCreatureCounter{ 0 };
+static std::atomic<uint32> sNextGameObjectCounter{ 0 };
+
+static thread_local std::mt19937 tRng{ std::random_device{}() };
+
+void LogWrite(int level, std::string const& msg)
+{
+    static char const* const names[] = { "", "FATAL", "ERROR", "WARN", "INFO", "DEBUG" };
+    std::lock_guard<std::mutex> lock(sLogLock);
+    std::fprintf(stderr, "%-5s %s\n", names[level], msg.c_str());
+}
+
+void AdvanceGameTime(uint32 diffMs)
+{
+    sGameTimeMs.fetch_add(diffMs, std::memory_order_relaxed);
+}
+
+void SetPlayerUpdateHandler(PlayerUpdateFn fn)
+{
+    sPlayerUpdate = fn;
+}
+
+static uint32 NextCounter(std::atomic<uint32>& counter)
+{
+    // Low GUID counters are 24 bits wide; skip 0 on wrap.
+    uint32 c = (counter.fetch_add(1, std::memory_order_relaxed) % 0xFFFFFE) + 1;
+    return c;
+}
+
+static void EnterCombat(Unit* attacker, Unit* victim)
+{
+    if (!attacker || !victim || attacker == victim)
+        return;
+
+    attacker->SetInCombatWith(victim);
+    victim->SetInCombatWith(attacker);
+
+    if (Creature* c = victim->ToCreature())
+    {
+        c->AddThreat(attacker, 1.0f);
+        if (!c->GetVictim() && c->AI())
+            c->AI()->AttackStart(attacker);
+    }
+}
+
+void DealDamage(Unit* attacker, Unit* victim, uint32 damage)
+{
+    if (!victim || !victim->IsAlive() || damage == 0)
+        return;
+
+    for (UnitScript* s : ScriptList<UnitScript>())
+        s->OnDamage(attacker, victim, damage);
+
+    EnterCombat(attacker, victim);
+
+    if (damage >= victim->GetHealth())
+        KillUnit(attacker, victim);
+    else
+        victim->SetHealth(victim->GetHealth() - damage);
+}
+
+void MeleeHit(Unit* attacker, Unit* victim, uint32 damage)
+{
+    for (UnitScript* s : ScriptList<UnitScript>())
+        s->ModifyMeleeDamage(victim, attacker, damage);
+    gCounters.MeleeHooks.fetch_add(1, std::memory_order_relaxed);
+    DealDamage(attacker, victim, damage);
+}
+
+void SpellHit(Unit* caster, Unit* victim, SpellInfo const* spell, int32 damage)
+{
+    for (UnitScript* s : ScriptList<UnitScript>())
+        s->ModifySpellDamageTaken(victim, caster, damage, spell);
+    gCounters.SpellHooks.fetch_add(1, std::memory_order_relaxed);
+    if (damage > 0)
+        DealDamage(caster, victim, uint32(damage));
+}
+
+void PeriodicTick(Unit* caster, Unit* victim, SpellInfo const* spell, uint32 damage)
+{
+    for (UnitScript* s : ScriptList<UnitScript>())
+        s->ModifyPeriodicDamageAurasTick(victim, caster, damage, spell);
+    gCounters.PeriodicHooks.fetch_add(1, std::memory_order_relaxed);
+    DealDamage(caster, victim, damage);
+}
+
+// Mirrors the order of Unit::Kill: AI JustDied, then the player-death
+// script hook, then the generic unit-death hook.
+void KillUnit(Unit* killer, Unit* victim)
+{
+    victim->SetHealth(0);
+    victim->SetAliveInternal(false);
+    victim->CombatStop();
+
+    if (Creature* c = victim->ToCreature())
+    {
+        gCounters.CreatureDeaths.fetch_add(1, std::memory_order_relaxed);
+        c->CorpseTimer = c->GetCorpseDelay() * 1000;
+        if (killer && killer->ToPlayer())
+            c->SetLootRecipient(killer);
+        if (c->AI())
+            c->AI()->JustDied(killer);
+    }
+    else if (Player* p = victim->ToPlayer())
+    {
+        gCounters.PlayerDeaths.fetch_add(1, std::memory_order_relaxed);
+        for (PlayerScript* s : ScriptList<PlayerScript>())
+            s->OnPlayerJustDied(p);
+        if (Creature* kc = killer ? killer->ToCreature() : nullptr)
+            for (PlayerScript* s : ScriptList<PlayerScript>())
+                s->OnPlayerKilledByCreature(kc, p);
+    }
+
+    for (UnitScript* s : ScriptList<UnitScript>())
+        s->OnUnitDeath(victim, killer);
+}
+
+// Spell model: enrage is a self buff, everything else deals damage sized
+// from the caster's template level (spell values are not level-scaled in
+// core, which is what the damage hooks correct for). Point-blank casts hit
+// every living player within 10 yd; targeted casts may leave a debuff.
+static void CastSpell(Unit* caster, Unit* target, uint32 spellId)
+{
+    SpellInfo const* spell = sSpellMgr->GetSpellInfo(spellId);
+    if (!spell || !caster->GetMap())
+        return;
+
+    if (spellId == 8599)
+    {
+        caster->AddAura(spellId, caster);
+        return;
+    }
+
+    uint8 spellLevel = caster->GetLevel();
+    if (Creature* c = caster->ToCreature())
+        spellLevel = c->GetCreatureTemplate()->maxlevel;
+
+    auto rollDamage = [&]()
+    {
+        float base = 20.0f + 6.0f * spellLevel;
+        return int32(base * std::uniform_real_distribution<float>(0.8f, 1.2f)(tRng));
+    };
+
+    if (target == caster)
+    {
+        for (auto const& ref : caster->GetMap()->GetPlayers())
+        {
+            Player* p = ref.GetSource();
+            if (p && p->IsAlive() && caster->IsWithinDistInMap(p, 10.0f))
+                SpellHit(caster, p, spell, rollDamage());
+        }
+        return;
+    }
+
+    if (!target || !target->IsAlive())
+        return;
+
+    SpellHit(caster, target, spell, rollDamage());
+    if (target->IsAlive() && std::uniform_int_distribution<int>(0, 99)(tRng) < 30)
+        if (Aura* aura = caster->AddAura(spellId, target))
+            aura->SetDuration(18000);
+}
+
+template<typename T>
+static void DeleteScripts()
+{
+    for (T* script : ScriptList<T>())
+        delete script;
+    ScriptList<T>().clear();
+}
+
+void UnloadScripts()
+{
+    DeleteScripts<UnitScript>();
+    DeleteScripts<PlayerScript>();
+    DeleteScripts<AllMapScript>();
+    DeleteScripts<WorldScript>();
+}
+
+} // namespace Stub
+
+// ---- Config ----
+
+ConfigMgr* ConfigMgr::instance()
+{
+    static ConfigMgr instance;
+    return &instance;
+}
+
+bool ConfigMgr::LoadFile(std::string const& path)
+{
+    std::ifstream in(path);
+    if (!in)
+        return false;
+
+    auto trim = [](std::string& s)
+    {
+        size_t b = s.find_first_not_of(" \t\r\n");
+        size_t e = s.find_last_not_of(" \t\r\n");
+        s = (b == std::string::npos) ? std::string() : s.substr(b, e - b + 1);
+    };
+
+    std::string line;
+    while (std::getline(in, line))
+    {
+        trim(line);
+        if (line.empty() || line[0] == '#' || line[0] == '[')
+            continue;
+        size_t eq = line.find('=');
+        if (eq == std::string::npos)
+            continue;
+        std::string key = line.substr(0, eq);
+        std::string value = line.substr(eq + 1);
+        trim(key);
+        trim(value);
+        // Like the core loader, surrounding quotes are not part of the value.
+        if (value.size() >= 2 && value.front() == '"' && value.back() == '"')
+            value = value.substr(1, value.size() - 2);
+        _values[key] = value;
+    }
+    return true;
+}
+
+// ---- GameTime ----
+
+Seconds GameTime::GetGameTime()
+{
+    return Seconds(Stub::sGameTimeMs.load(std::memory_order_relaxed) / 1000);
+}
+
+Milliseconds GameTime::GetGameTimeMS()
+{
+    return Milliseconds(Stub::sGameTimeMs.load(std::memory_order_relaxed));
+}
+
+uint32 GameTime::GetUptime()
+{
+    return uint32((Stub::sGameTimeMs.load(std::memory_order_relaxed) - Stub::sStartTimeMs) / 1000);
+}
+
+// ---- Position / WorldObject ----
+
+float Position::GetExactDist(Position const* p) const
+{
+    return std::sqrt(GetExactDistSq(p));
+}
+
+uint32 WorldObject::GetMapId() const
+{
+    return _map ? _map->GetId() : 0;
+}
+
+uint32 WorldObject::GetInstanceId() const
+{
+    return _map ? _map->GetInstanceId() : 0;
+}
+
+void WorldObject::GetCreatureListWithEntryInGrid(std::list<Creature*>& list, uint32 entry, float maxSearchRange) const
+{
+    if (!_map)
+        return;
+    for (Creature* c : _map->GetAllCreatures())
+        if (c->IsInWorld() && (!entry || c->GetEntry() == entry) && IsWithinDistInMap(c, maxSearchRange))
+            list.push_back(c);
+}
+
+// ---- Aura ----
+
+Unit* Aura::GetCaster() const
+{
+    if (_casterGuid == _owner->GetGUID())
+        return _owner;
+    return ObjectAccessor::GetUnit(*_owner, _casterGuid);
+}
+
+// ---- Unit ----
+
+Unit::~Unit()
+{
+    for (auto& pair : _appliedAuras)
+        delete pair.second;
+}
+
+bool Unit::IsHostileTo(Unit const* u) const
+{
+    if (!u)
+        return false;
+    bool meHostile = _faction == 14, otherHostile = u->_faction == 14;
+    return (meHostile && u->GetTypeId() == TYPEID_PLAYER) || (otherHostile && GetTypeId() == TYPEID_PLAYER);
+}
+
+bool Unit::IsInCombat() const
+{
+    for (ObjectGuid const& g : _combat)
+        if (Unit* u = ObjectAccessor::GetUnit(*this, g))
+            if (u->IsAlive() && u->IsInWorld())
+                return true;
+    return false;
+}
+
+void Unit::SetInCombatWith(Unit* enemy)
+{
+    if (!enemy)
+        return;
+    ObjectGuid g = enemy->GetGUID();
+    if (std::find(_combat.begin(), _combat.end(), g) == _combat.end())
+        _combat.push_back(g);
+}
+
+void Unit::AddThreat(Unit* victim, float /*threat*/)
+{
+    if (!victim)
+        return;
+    ObjectGuid g = victim->GetGUID();
+    if (std::find(_threat.begin(), _threat.end(), g) == _threat.end())
+        _threat.push_back(g);
+}
+
+Unit* Unit::GetVictim() const
+{
+    if (!_victim)
+        return nullptr;
+    Unit* v = ObjectAccessor::GetUnit(*this, _victim);
+    return (v && v->IsAlive() && v->IsInWorld()) ? v : nullptr;
+}
+
+bool Unit::Attack(Unit* victim, bool /*meleeAttack*/)
+{
+    if (!victim || victim == this || !victim->IsAlive())
+        return false;
+    _victim = victim->GetGUID();
+    SetInCombatWith(victim);
+    victim->SetInCombatWith(this);
+    return true;
+}
+
+Unit* Unit::SelectVictim()
+{
+    if (Unit* v = GetVictim())
+        return v;
+    for (ObjectGuid const& g : _threat)
+        if (Unit* u = ObjectAccessor::GetUnit(*this, g))
+            if (u->IsAlive() && u->IsInWorld())
+                return u;
+    return nullptr;
+}
+
+void Unit::CastSpell(Unit* target, uint32 spellId, bool /*triggered*/)
+{
+    Stub::CastSpell(this, target, spellId);
+}
+
+Aura* Unit::AddAura(uint32 spellId, Unit* target)
+{
+    if (!target)
+        return nullptr;
+
+    auto it = target->_appliedAuras.find(spellId);
+    if (it != target->_appliedAuras.end())
+        return it->second->GetBase();
+
+    auto* app = new AuraApplication(std::make_unique<Aura>(spellId, target, GetGUID()));
+    target->_appliedAuras.emplace(spellId, app);
+    return app->GetBase();
+}
+
+void Unit::RemoveAura(uint32 spellId)
+{
+    auto range = _appliedAuras.equal_range(spellId);
+    for (auto it = range.first; it != range.second; ++it)
+        delete it->second;
+    _appliedAuras.erase(range.first, range.second);
+}
+
+// ---- Creature ----
+
+Creature::Creature(ObjectGuid guid, CreatureTemplate const* tmpl, uint32 spawnId)
+    : Unit(TYPEID_UNIT, guid, tmpl->Entry, tmpl->Name), _template(tmpl), _spawnId(spawnId)
+{
+    InitFromTemplate(tmpl);
+}
+
+void Creature::InitFromTemplate(CreatureTemplate const* tmpl)
+{
+    _template = tmpl;
+    _level = tmpl->minlevel;
+    _maxHealth = _health = 40 + uint32(1.1f * _level * _level);
+    _attackTime = tmpl->BaseAttackTime;
+    _faction = 16;
+}
+
+bool Creature::Create(ObjectGuid::LowType guidlow, Map* map, uint32 /*phaseMask*/, uint32 entry, uint32 /*vehId*/,
+                      float x, float y, float z, float ang, CreatureData const* /*data*/)
+{
+    CreatureTemplate const* tmpl = sObjectMgr->GetCreatureTemplate(entry);
+    if (!tmpl)
+        return false;
+
+    _guid  = ObjectGuid(HighGuid::Unit, entry, guidlow);
+    _entry = entry;
+    _name  = tmpl->Name;
+    InitFromTemplate(tmpl);
+    Relocate(x, y, z, ang);
+    HomePosition.Relocate(x, y, z, ang);
+    SetMapInternal(map, false);
+    return true;
+}
+
+Creature::~Creature() = default;
+
+bool Creature::SetAI(CreatureAI* ai)
+{
+    _ai.reset(ai);
+    return true;
+}
+
+void Creature::DespawnOrUnsummon(uint32 /*msTimeToDespawn*/)
+{
+    if (_despawnPending)
+        return;
+    _despawnPending = true;
+    _inWorld = false;
+    Stub::gCounters.Despawns.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Creature::SetLootRecipient(Unit* unit, bool /*withGroup*/)
+{
+    _lootRecipient = unit ? unit->GetGUID() : ObjectGuid::Empty;
+}
+
+// ---- CreatureAI ----
+
+void CreatureAI::EnterEvadeMode(EvadeReason /*why*/)
+{
+    me->CombatStop();
+    me->SetHealth(me->GetMaxHealth());
+    me->Relocate(me->HomePosition);
+}
+
+void CreatureAI::AttackStart(Unit* victim)
+{
+    bool engaged = me->IsInCombat();
+    if (me->Attack(victim, true) && !engaged)
+        JustEngagedWith(victim);
+}
+
+bool CreatureAI::UpdateVictim()
+{
+    if (!me->IsInCombat())
+    {
+        if (me->GetVictim() || me->SelectVictim())
+            EnterEvadeMode(EVADE_REASON_NO_HOSTILES);
+        return false;
+    }
+
+    Unit* victim = me->SelectVictim();
+    if (!victim)
+    {
+        EnterEvadeMode(EVADE_REASON_NO_HOSTILES);
+        return false;
+    }
+    if (victim != me->GetVictim())
+        me->Attack(victim, true);
+    return true;
+}
+
+void CreatureAI::DoMeleeAttackIfReady()
+{
+    Unit* victim = me->GetVictim();
+    if (!victim || me->SwingTimer() > 0 || me->GetExactDistSq(victim) > 25.0f)
+        return;
+
+    float lo = me->GetWeaponDamageRange(BASE_ATTACK, MINDAMAGE);
+    float hi = me->GetWeaponDamageRange(BASE_ATTACK, MAXDAMAGE);
+    uint32 damage = uint32(std::uniform_real_distribution<float>(lo, std::max(lo, hi) + 0.01f)(Stub::tRng));
+    me->SwingTimer() = me->GetAttackTime(BASE_ATTACK);
+    Stub::MeleeHit(me, victim, std::max(1u, damage));
+}
+
+// ---- GameObject ----
+
+void GameObject::Delete()
+{
+    _inWorld = false;
+}
+
+// ---- Map ----
+
+Map::~Map()
+{
+    for (auto const& ref : _players)
+        ref.GetSource()->SetMapInternal(nullptr, false);
+}
+
+Creature* Map::GetCreature(ObjectGuid guid)
+{
+    auto it = _creatures.find(guid);
+    return it != _creatures.end() ? it->second.get() : nullptr;
+}
+
+TempSummon* Map::SummonCreature(uint32 entry, Position const& pos, void* /*properties*/, uint32 /*duration*/,
+                                WorldObject* /*summoner*/, uint32 /*spellId*/, uint32 /*vehId*/, bool /*visibleBySummonerOnly*/)
+{
+    CreatureTemplate const* tmpl = sObjectMgr->GetCreatureTemplate(entry);
+    if (!tmpl)
+        return nullptr;
+
+    ObjectGuid guid(HighGuid::Unit, entry, Stub::NextCounter(Stub::sNextCreatureCounter));
+    auto summon = std::make_unique<TempSummon>(guid, tmpl);
+    TempSummon* c = summon.get();
+    c->Relocate(pos);
+    c->HomePosition = pos;
+    c->SetMapInternal(this, true);
+    _creatures.emplace(guid, std::move(summon));
+    _creatureList.push_back(c);
+    Stub::gCounters.Summons.fetch_add(1, std::memory_order_relaxed);
+    return c;
+}
+
+ObjectGuid::LowType Map::GenerateCreatureLowGuid()
+{
+    return Stub::NextCounter(Stub::sNextCreatureCounter);
+}
+
+bool Map::AddToMap(Creature* creature, bool /*checkTransport*/)
+{
+    if (!creature || creature->IsInWorld())
+        return false;
+
+    creature->SetMapInternal(this, true);
+    _creatures.emplace(creature->GetGUID(), std::unique_ptr<Creature>(creature));
+    _creatureList.push_back(creature);
+    if (creature->IsSummon())
+        Stub::gCounters.Summons.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+Creature* Map::AddDbCreature(CreatureTemplate const* tmpl, Position const& pos, uint32 spawnId)
+{
+    ObjectGuid guid(HighGuid::Unit, tmpl->Entry, Stub::NextCounter(Stub::sNextCreatureCounter));
+    auto creature = std::make_unique<Creature>(guid, tmpl, spawnId);
+    Creature* c = creature.get();
+    c->Relocate(pos);
+    c->HomePosition = pos;
+    c->SetMapInternal(this, true);
+    _creatures.emplace(guid, std::move(creature));
+    _creatureList.push_back(c);
+    _creatureBySpawnId.emplace(spawnId, c);
+    return c;
+}
+
+GameObject* Map::AddDbGameObject(uint32 entry, GameobjectTypes type, Position const& pos, uint32 spawnId)
+{
+    ObjectGuid guid(HighGuid::GameObject, entry, Stub::NextCounter(Stub::sNextGameObjectCounter));
+    _gameObjects.push_back(std::make_unique<GameObject>(guid, entry, type));
+    GameObject* go = _gameObjects.back().get();
+    go->Relocate(pos);
+    go->SetMapInternal(this, true);
+    _goBySpawnId.emplace(spawnId, go);
+    return go;
+}
+
+void Map::AddPlayer(Player* player)
+{
+    _players.emplace_back(player);
+    player->SetMapInternal(this, true);
+    EmptyTime = 0;
+    for (AllMapScript* s : Stub::ScriptList<AllMapScript>())
+        s->OnPlayerEnterAll(this, player);
+}
+
+void Map::RemovePlayer(Player* player)
+{
+    for (AllMapScript* s : Stub::ScriptList<AllMapScript>())
+        s->OnPlayerLeaveAll(this, player);
+    _players.erase(std::remove_if(_players.begin(), _players.end(),
+        [player](MapReference const& r) { return r.GetSource() == player; }), _players.end());
+    player->SetMapInternal(nullptr, false);
+}
+
+void Map::RemoveCreature(ObjectGuid guid)
+{
+    auto it = _creatures.find(guid);
+    if (it == _creatures.end())
+        return;
+
+    Creature* c = it->second.get();
+    if (uint32 spawnId = c->GetSpawnId())
+    {
+        auto range = _creatureBySpawnId.equal_range(spawnId);
+        for (auto sit = range.first; sit != range.second; ++sit)
+            if (sit->second == c)
+            {
+                _creatureBySpawnId.erase(sit);
+                break;
+            }
+    }
+    _creatureList.erase(std::find(_creatureList.begin(), _creatureList.end(), c));
+    _creatures.erase(it);
+}
+
+void Map::Update(uint32 diff)
+{
+    // Creatures: AI, chase and corpse decay. Scripts may summon while we
+    // iterate, so walk by index over the size captured up front.
+    size_t count = _creatureList.size();
+    for (size_t i = 0; i < count && i < _creatureList.size(); ++i)
+    {
+        Creature* c = _creatureList[i];
+        if (c->IsDespawnPending())
+            continue;
+
+        if (!c->IsAlive())
+        {
+            if (c->CorpseTimer <= diff)
+                c->DespawnOrUnsummon();
+            else
+                c->CorpseTimer -= diff;
+            continue;
+        }
+
+        c->SwingTimer() = c->SwingTimer() > diff ? c->SwingTimer() - diff : 0;
+        if (Unit* victim = c->GetVictim())
+        {
+            float dist = c->GetDistance(victim);
+            if (dist > 4.0f)
+            {
+                float step = std::min(dist - 3.5f, 8.0f * diff / 1000.0f);
+                float k = step / dist;
+                c->Relocate(c->GetPositionX() + (victim->GetPositionX() - c->GetPositionX()) * k,
+                            c->GetPositionY() + (victim->GetPositionY() - c->GetPositionY()) * k,
+                            c->GetPositionZ() + (victim->GetPositionZ() - c->GetPositionZ()) * k);
+            }
+        }
+        if (CreatureAI* ai = c->AI())
+            ai->UpdateAI(diff);
+    }
+
+    if (Stub::sPlayerUpdate)
+        for (size_t i = 0; i < _players.size(); ++i)
+            Stub::sPlayerUpdate(_players[i].GetSource(), this, diff);
+
+    for (auto const& ref : _players)
+        ref.GetSource()->UpdateCombatHooks();
+
+    for (AllMapScript* s : Stub::ScriptList<AllMapScript>())
+        s->OnMapUpdate(this, diff);
+
+    // Removal list, processed at the end of the update like the core's.
+    std::vector<ObjectGuid> removed;
+    for (Creature* c : _creatureList)
+        if (c->IsDespawnPending())
+            removed.push_back(c->GetGUID());
+    for (ObjectGuid const& g : removed)
+        RemoveCreature(g);
+
+    for (auto it = _goBySpawnId.begin(); it != _goBySpawnId.end();)
+        it = it->second->IsInWorld() ? std::next(it) : _goBySpawnId.erase(it);
+
+    EmptyTime = _players.empty() ? EmptyTime + diff : 0;
+}
+
+// ---- Item / ObjectMgr / World ----
+
+Item* Item::CreateItem(uint32 item, uint32 /*count*/, Player const* /*player*/)
+{
+    if (!sObjectMgr->GetItemTemplate(item))
+        return nullptr;
+    return new Item(item);
+}
+
+ObjectMgr* ObjectMgr::instance()
+{
+    static ObjectMgr instance;
+    return &instance;
+}
+
+ItemTemplate const* ObjectMgr::GetItemTemplate(uint32 entry) const
+{
+    auto it = ItemTemplates.find(entry);
+    return it != ItemTemplates.end() ? &it->second : nullptr;
+}
+
+CreatureTemplate const* ObjectMgr::GetCreatureTemplate(uint32 entry) const
+{
+    auto it = CreatureTemplates.find(entry);
+    return it != CreatureTemplates.end() ? &it->second : nullptr;
+}
+
+World* World::instance()
+{
+    static World instance;
+    return &instance;
+}
+
+// ---- Chat ----
+
+// SMSG_MESSAGECHAT for CHAT_MSG_SYSTEM: type, language, two guids,
+// length-prefixed text and the tag byte.
+size_t ChatHandler::BuildChatPacket(WorldPacket& data, ChatMsg /*chatType*/, Language /*language*/,
+                                    ObjectGuid /*senderGUID*/, ObjectGuid /*receiverGUID*/,
+                                    std::string_view message, uint8 /*chatTag*/)
+{
+    Stub::gCounters.ChatPacketsBuilt.fetch_add(1, std::memory_order_relaxed);
+    data._size = 1 + 4 + 8 + 4 + 8 + 4 + message.size() + 1 + 1;
+    return data._size;
+}
+
+void WorldSession::SendPacket(WorldPacket const* packet)
+{
+    Stub::gCounters.ChatMessages.fetch_add(1, std::memory_order_relaxed);
+    Stub::gCounters.ChatBytes.fetch_add(packet->size(), std::memory_order_relaxed);
+    MessagesSent.fetch_add(1, std::memory_order_relaxed);
+    BytesSent.fetch_add(packet->size(), std::memory_order_relaxed);
+}
+
+// As the core: split into lines, build and send a packet per line.
+void ChatHandler::SendSysMessage(std::string_view str, bool /*escapeCharacters*/)
+{
+    if (!_session)
+        return;
+
+    size_t start = 0;
+    for (;;)
+    {
+        size_t end = str.find('\n', start);
+        WorldPacket data;
+        BuildChatPacket(data, CHAT_MSG_SYSTEM, LANG_UNIVERSAL, ObjectGuid::Empty, ObjectGuid::Empty,
+            str.substr(start, end == std::string_view::npos ? end : end - start), 0);
+        _session->SendPacket(&data);
+        if (end == std::string_view::npos)
+            break;
+        start = end + 1;
+    }
+}
+
+// ---- Group ----
+
+void Group::AddMember(Player* player)
+{
+    auto ref = std::make_unique<GroupReference>(player);
+    if (!_members.empty())
+        _members.back()->SetNext(ref.get());
+    else
+        _leader = player->GetGUID();
+    _members.push_back(std::move(ref));
+    player->SetGroupInternal(this);
+}
+
+void Group::GroupLoot(Loot* /*loot*/, WorldObject* /*pLootedObject*/)
+{
+    Stub::gCounters.GroupLoots.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ---- Player ----
+
+Player::Player(ObjectGuid guid, std::string name, uint8 level, uint8 cls)
+    : Unit(TYPEID_PLAYER, guid, 0, std::move(name)), _session(std::make_unique<WorldSession>(this)), _class(cls)
+{
+    _level = level;
+    _faction = 1;
+    Stub::sPlayers[guid] = this;
+}
+
+Player::~Player()
+{
+    Stub::sPlayers.erase(_guid);
+}
+
+bool Player::TeleportTo(uint32 mapid, float x, float y, float z, float orientation,
+                        uint32 /*options*/, Unit* /*target*/, bool /*newInstance*/)
+{
+    _teleportPending = true;
+    _teleport.MapId = mapid;
+    _teleport.Pos = Position(x, y, z, orientation);
+    Stub::gCounters.Teleports.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+bool Player::TakePendingTeleport(PendingTeleport& out)
+{
+    if (!_teleportPending)
+        return false;
+    out = _teleport;
+    _teleportPending = false;
+    return true;
+}
+
+void Player::ResurrectPlayer(float restorePercent, bool applySickness)
+{
+    _alive = true;
+    _health = std::max(1u, uint32(_maxHealth * restorePercent));
+    for (PlayerScript* s : Stub::ScriptList<PlayerScript>())
+        s->OnPlayerResurrect(this, restorePercent, applySickness);
+}
+
+void Player::UpdateCombatHooks()
+{
+    bool inCombat = IsAlive() && IsInCombat();
+    if (inCombat == _combatReported)
+        return;
+    _combatReported = inCombat;
+    for (PlayerScript* s : Stub::ScriptList<PlayerScript>())
+    {
+        if (inCombat)
+            s->OnPlayerEnterCombat(this, nullptr);
+        else
+            s->OnPlayerLeaveCombat(this);
+    }
+}
+
+void Player::SpawnCorpseBones(bool /*triggerSave*/)
+{
+}
+
+void Player::GiveXP(uint32 xp, Unit* /*victim*/, float /*group_rate*/, bool /*isLFGReward*/)
+{
+    _xp += xp;
+}
+
+bool Player::ModifyMoney(int32 amount, bool /*sendError*/)
+{
+    _money = (amount < 0 && uint32(-amount) > _money) ? 0 : _money + amount;
+    return true;
+}
+
+InventoryResult Player::CanStoreNewItem(uint8 /*bag*/, uint8 /*slot*/, ItemPosCountVec& dest,
+                                        uint32 /*item*/, uint32 count, uint32* /*no_space_count*/) const
+{
+    if (_items.size() >= INVENTORY_SLOTS)
+        return EQUIP_ERR_INVENTORY_FULL;
+    dest.push_back({ uint16(_items.size()), count });
+    return EQUIP_ERR_OK;
+}
+
+Item* Player::StoreNewItem(ItemPosCountVec const& /*pos*/, uint32 item, bool /*update*/, int32 /*randomPropertyId*/)
+{
+    _items.push_back(std::make_unique<Item>(item));
+    Stub::gCounters.ItemsStored.fetch_add(1, std::memory_order_relaxed);
+    return _items.back().get();
+}
+
+void Player::SendNewItem(Item* /*item*/, uint32 /*count*/, bool /*received*/, bool /*created*/,
+                         bool /*broadcast*/, bool /*sendChatMessage*/)
+{
+    _session->MessagesSent.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ---- ObjectAccessor ----
+
+Player* ObjectAccessor::FindPlayer(ObjectGuid guid)
+{
+    auto it = Stub::sPlayers.find(guid);
+    return (it != Stub::sPlayers.end() && it->second->IsInWorld()) ? it->second : nullptr;
+}
+
+Player* ObjectAccessor::FindConnectedPlayer(ObjectGuid guid)
+{
+    auto it = Stub::sPlayers.find(guid);
+    return it != Stub::sPlayers.end() ? it->second : nullptr;
+}
+
+Creature* ObjectAccessor::GetCreature(WorldObject const& u, ObjectGuid guid)
+{
+    return u.GetMap() ? u.GetMap()->GetCreature(guid) : nullptr;
+}
+
+Unit* ObjectAccessor::GetUnit(WorldObject const& u, ObjectGuid guid)
+{
+    if (guid.IsPlayer())
+    {
+        Player* p = FindPlayer(guid);
+        return (p && p->GetMap() == u.GetMap()) ? p : nullptr;
+    }
+    return GetCreature(u, guid);
+}
+
+// ---- Mail ----
+
+MailDraft::~MailDraft()
+{
+    for (Item* item : _items)
+        delete item;
+}
+
+MailDraft& MailDraft::AddItem(Item* item)
+{
+    if (item)
+        _items.push_back(item);
+    return *this;
+}
+
+void MailDraft::SendMailTo(CharacterDatabaseTransaction trans, MailReceiver const& /*receiver*/,
+                           MailSender const& /*sender*/, MailCheckMask /*checked*/, uint32 /*deliver_delay*/,
+                           uint32 /*custom_expiration*/, bool /*deleteMailItemsFromDB*/, bool /*sendMail*/)
+{
+    if (trans)
+        trans->Append("INSERT INTO mail ...");
+    Stub::gCounters.Mails.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ---- Database ----
+
+QueryResult DatabaseWorkerPool::Query(std::string const& sql)
+{
+    auto t0 = std::chrono::steady_clock::now();
+    QueryResult result = _provider ? _provider(sql) : nullptr;
+    if (_latencyUs)
+        std::this_thread::sleep_for(std::chrono::microseconds(_latencyUs));
+    _syncQueryNs.fetch_add(uint64(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now() - t0).count()), std::memory_order_relaxed);
+    _syncQueries.fetch_add(1, std::memory_order_relaxed);
+    if (result && result->GetRowCount() == 0)
+        return nullptr;
+    return result;
+}
+
+void DatabaseWorkerPool::Execute(std::string const& /*sql*/)
+{
+    _asyncStatements.fetch_add(1, std::memory_order_relaxed);
+}
+
+void DatabaseWorkerPool::CommitTransaction(CharacterDatabaseTransaction trans)
+{
+    if (trans)
+        _asyncStatements.fetch_add(trans->GetSize(), std::memory_order_relaxed);
+}
+
+// ---- SpellMgr ----
+
+SpellMgr::SpellMgr() : _spells(new std::atomic<SpellInfo*>[MAX_SPELL_ID])
+{
+    for (uint32 i = 0; i < MAX_SPELL_ID; ++i)
+        _spells[i].store(nullptr, std::memory_order_relaxed);
+}
+
+SpellMgr::~SpellMgr()
+{
+    for (uint32 i = 0; i < MAX_SPELL_ID; ++i)
+        delete _spells[i].load(std::memory_order_relaxed);
+}
+
+SpellMgr* SpellMgr::instance()
+{
+    static SpellMgr instance;
+    return &instance;
+}
+
+SpellInfo const* SpellMgr::GetSpellInfo(uint32 spellId)
+{
+    if (spellId >= MAX_SPELL_ID)
+        return nullptr;
+
+    SpellInfo* info = _spells[spellId].load(std::memory_order_acquire);
+    if (info)
+        return info;
+
+    auto* fresh = new SpellInfo();
+    fresh->Id = spellId;
+    if (_spells[spellId].compare_exchange_strong(info, fresh, std::memory_order_acq_rel))
+        return fresh;
+    delete fresh;
+    return info;
+}
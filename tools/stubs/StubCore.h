@@ -0,0 +1,1350 @@
+/*
+ * mod-dungeon-master — StubCore.h
+ * Minimal stand-ins for the AzerothCore types the module touches, so the
+ * real module sources compile and run headless (tools/dm_loadsim). Every
+ * AC-named header in this directory includes this file.
+ *
+ * Only the surface the module uses is modelled, with just enough behaviour
+ * for a simulation: units fight, die and resurrect, teleports are deferred
+ * to the next world tick like the core's far teleports, and creatures live
+ * in per-map stores updated by map worker threads.
+ */
+
+#ifndef DM_STUB_CORE_H
+#define DM_STUB_CORE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <fmt/format.h>
+
+// ---- Define.h ----
+typedef int8_t   int8;
+typedef int16_t  int16;
+typedef int32_t  int32;
+typedef int64_t  int64;
+typedef uint8_t  uint8;
+typedef uint16_t uint16;
+typedef uint32_t uint32;
+typedef uint64_t uint64;
+
+template<typename T>
+using Optional = std::optional<T>;
+
+constexpr uint32 MINUTE = 60;
+constexpr uint32 HOUR   = MINUTE * 60;
+constexpr uint32 DAY    = HOUR * 24;
+
+// ---- Log.h ----
+namespace Stub
+{
+    enum LogLevel { LOG_LEVEL_DISABLED = 0, LOG_LEVEL_FATAL, LOG_LEVEL_ERROR, LOG_LEVEL_WARN, LOG_LEVEL_INFO, LOG_LEVEL_DEBUG, LOG_LEVEL_TRACE };
+    extern std::atomic<int> gLogLevel;
+    extern std::atomic<uint64> gLogLines;
+    void LogWrite(int level, std::string const& msg);
+}
+
+#define DM_STUB_LOG(level, filter, ...)                                  \
+    do {                                                                 \
+        Stub::gLogLines.fetch_add(1, std::memory_order_relaxed);         \
+        if ((level) <= Stub::gLogLevel.load(std::memory_order_relaxed))  \
+            Stub::LogWrite(level, fmt::format(__VA_ARGS__));             \
+    } while (0)
+
+#define LOG_FATAL(filter, ...) DM_STUB_LOG(Stub::LOG_LEVEL_FATAL, filter, __VA_ARGS__)
+#define LOG_ERROR(filter, ...) DM_STUB_LOG(Stub::LOG_LEVEL_ERROR, filter, __VA_ARGS__)
+#define LOG_WARN(filter, ...)  DM_STUB_LOG(Stub::LOG_LEVEL_WARN,  filter, __VA_ARGS__)
+#define LOG_INFO(filter, ...)  DM_STUB_LOG(Stub::LOG_LEVEL_INFO,  filter, __VA_ARGS__)
+#define LOG_DEBUG(filter, ...) DM_STUB_LOG(Stub::LOG_LEVEL_DEBUG, filter, __VA_ARGS__)
+#define LOG_TRACE(filter, ...) DM_STUB_LOG(Stub::LOG_LEVEL_TRACE, filter, __VA_ARGS__)
+
+// ---- Config.h ----
+class ConfigMgr
+{
+public:
+    static ConfigMgr* instance();
+
+    bool LoadFile(std::string const& path);
+    void Set(std::string const& key, std::string const& value) { _values[key] = value; }
+
+    template<typename T>
+    T GetOption(std::string const& name, T const& def) const
+    {
+        auto it = _values.find(name);
+        if (it == _values.end())
+            return def;
+        std::string const& v = it->second;
+        if constexpr (std::is_same_v<T, std::string>)
+            return v;
+        else if constexpr (std::is_same_v<T, bool>)
+            return v == "1" || v == "true" || v == "TRUE" || v == "yes";
+        else if constexpr (std::is_floating_point_v<T>)
+            return static_cast<T>(std::strtod(v.c_str(), nullptr));
+        else
+            return static_cast<T>(std::strtoll(v.c_str(), nullptr, 10));
+    }
+
+private:
+    std::unordered_map<std::string, std::string> _values;
+};
+
+#define sConfigMgr ConfigMgr::instance()
+
+// ---- GameTime.h ----
+using Seconds      = std::chrono::seconds;
+using Milliseconds = std::chrono::milliseconds;
+
+namespace GameTime
+{
+    Seconds      GetGameTime();
+    Milliseconds GetGameTimeMS();
+    uint32       GetUptime();
+}
+
+namespace Stub
+{
+    void AdvanceGameTime(uint32 diffMs);
+}
+
+// ---- ObjectGuid.h ----
+enum class HighGuid : uint32
+{
+    Player     = 0x0000,
+    Item       = 0x4000,
+    GameObject = 0xF110,
+    Unit       = 0xF130,
+};
+
+class ObjectGuid
+{
+public:
+    typedef uint32 LowType;
+
+    static ObjectGuid const Empty;
+
+    ObjectGuid() = default;
+    explicit ObjectGuid(uint64 raw) : _guid(raw) {}
+    ObjectGuid(HighGuid hi, uint32 entry, uint32 counter)
+        : _guid(counter ? uint64(counter) | (uint64(entry) << 24) | (uint64(hi) << 48) : 0) {}
+    ObjectGuid(HighGuid hi, uint32 counter)
+        : _guid(counter ? uint64(counter) | (uint64(hi) << 48) : 0) {}
+
+    uint64   GetRawValue() const { return _guid; }
+    HighGuid GetHigh() const { return HighGuid((_guid >> 48) & 0xFFFF); }
+    uint32   GetEntry() const { return uint32((_guid >> 24) & 0xFFFFFF); }
+    uint32   GetCounter() const
+    {
+        return GetHigh() == HighGuid::Player ? uint32(_guid & 0xFFFFFFFF) : uint32(_guid & 0xFFFFFF);
+    }
+
+    bool IsEmpty() const    { return _guid == 0; }
+    bool IsPlayer() const   { return !IsEmpty() && GetHigh() == HighGuid::Player; }
+    bool IsCreature() const { return GetHigh() == HighGuid::Unit; }
+    void Clear()            { _guid = 0; }
+
+    std::string ToString() const { return fmt::format("GUID Full: 0x{:016X}", _guid); }
+
+    bool operator!() const { return IsEmpty(); }
+    bool operator==(ObjectGuid const& o) const { return _guid == o._guid; }
+    bool operator!=(ObjectGuid const& o) const { return _guid != o._guid; }
+    bool operator<(ObjectGuid const& o) const  { return _guid < o._guid; }
+
+private:
+    uint64 _guid = 0;
+};
+
+namespace std
+{
+    template<>
+    struct hash<ObjectGuid>
+    {
+        size_t operator()(ObjectGuid const& g) const noexcept { return hash<uint64>()(g.GetRawValue()); }
+    };
+}
+
+// ---- Position.h ----
+struct Position
+{
+    Position(float x = 0, float y = 0, float z = 0, float o = 0)
+        : m_positionX(x), m_positionY(y), m_positionZ(z), m_orientation(o) {}
+
+    float m_positionX;
+    float m_positionY;
+    float m_positionZ;
+    float m_orientation;
+
+    float GetPositionX() const  { return m_positionX; }
+    float GetPositionY() const  { return m_positionY; }
+    float GetPositionZ() const  { return m_positionZ; }
+    float GetOrientation() const { return m_orientation; }
+
+    void Relocate(float x, float y, float z, float o) { m_positionX = x; m_positionY = y; m_positionZ = z; m_orientation = o; }
+    void Relocate(float x, float y, float z)          { m_positionX = x; m_positionY = y; m_positionZ = z; }
+    void Relocate(Position const& p)                  { *this = p; }
+    Position GetPosition() const { return *this; }
+
+    float GetExactDistSq(Position const* p) const
+    {
+        float dx = m_positionX - p->m_positionX, dy = m_positionY - p->m_positionY, dz = m_positionZ - p->m_positionZ;
+        return dx * dx + dy * dy + dz * dz;
+    }
+    float GetExactDist(Position const* p) const;
+};
+
+// ---- SharedDefines / UpdateFields (subset) ----
+enum PhaseMasks : uint32
+{
+    PHASEMASK_NORMAL   = 0x00000001,
+    PHASEMASK_ANYWHERE = 0xFFFFFFFF,
+};
+
+enum TypeID : uint8
+{
+    TYPEID_OBJECT     = 0,
+    TYPEID_ITEM       = 1,
+    TYPEID_UNIT       = 3,
+    TYPEID_PLAYER     = 4,
+    TYPEID_GAMEOBJECT = 5,
+};
+
+enum StubUpdateFields : uint16
+{
+    UNIT_FIELD_BYTES_0 = 0,
+    UNIT_FIELD_FLAGS,
+    UNIT_FIELD_FLAGS_2,
+    UNIT_DYNAMIC_FLAGS,
+    PLAYER_FIELD_BYTES,
+    STUB_FIELD_COUNT
+};
+
+enum UnitFlags : uint32
+{
+    UNIT_FLAG_NON_ATTACKABLE   = 0x00000002,
+    UNIT_FLAG_IMMUNE_TO_PC     = 0x00000100,
+    UNIT_FLAG_IMMUNE_TO_NPC    = 0x00000200,
+    UNIT_FLAG_PACIFIED         = 0x00020000,
+    UNIT_FLAG_STUNNED          = 0x00040000,
+    UNIT_FLAG_FLEEING          = 0x00800000,
+    UNIT_FLAG_NOT_SELECTABLE   = 0x02000000,
+};
+
+enum UnitDynFlags : uint32
+{
+    UNIT_DYNFLAG_LOOTABLE = 0x0001,
+};
+
+enum PlayerFieldByteFlags : uint32
+{
+    PLAYER_FIELD_BYTE_TRACK_STEALTHED   = 0x00000002,
+    PLAYER_FIELD_BYTE_RELEASE_TIMER     = 0x00000008,
+    PLAYER_FIELD_BYTE_NO_RELEASE_WINDOW = 0x00000010,
+};
+
+enum ReactStates : uint8
+{
+    REACT_PASSIVE    = 0,
+    REACT_DEFENSIVE  = 1,
+    REACT_AGGRESSIVE = 2,
+};
+
+enum CreatureType : uint32
+{
+    CREATURE_TYPE_BEAST         = 1,
+    CREATURE_TYPE_DRAGONKIN     = 2,
+    CREATURE_TYPE_DEMON         = 3,
+    CREATURE_TYPE_ELEMENTAL     = 4,
+    CREATURE_TYPE_GIANT         = 5,
+    CREATURE_TYPE_UNDEAD        = 6,
+    CREATURE_TYPE_HUMANOID      = 7,
+    CREATURE_TYPE_CRITTER       = 8,
+    CREATURE_TYPE_MECHANICAL    = 9,
+    CREATURE_TYPE_NOT_SPECIFIED = 10,
+};
+
+enum WeaponAttackType : uint8 { BASE_ATTACK = 0, OFF_ATTACK = 1, RANGED_ATTACK = 2 };
+enum WeaponDamageRange : uint8 { MINDAMAGE = 0, MAXDAMAGE = 1 };
+
+enum SpellSchools : uint8
+{
+    SPELL_SCHOOL_NORMAL = 0,
+    SPELL_SCHOOL_HOLY   = 1,
+    SPELL_SCHOOL_FIRE   = 2,
+    SPELL_SCHOOL_NATURE = 3,
+    SPELL_SCHOOL_FROST  = 4,
+    SPELL_SCHOOL_SHADOW = 5,
+    SPELL_SCHOOL_ARCANE = 6,
+    MAX_SPELL_SCHOOL    = 7,
+};
+
+constexpr uint32 SPELL_SCHOOL_MASK_ALL = 0x7F;
+constexpr uint32 MAX_MECHANIC = 32;
+
+enum SpellImmunity : uint8
+{
+    IMMUNITY_EFFECT   = 0,
+    IMMUNITY_STATE    = 1,
+    IMMUNITY_SCHOOL   = 2,
+    IMMUNITY_DAMAGE   = 3,
+    IMMUNITY_DISPEL   = 4,
+    IMMUNITY_MECHANIC = 5,
+    IMMUNITY_ID       = 6,
+};
+
+enum MovementGeneratorType : uint8
+{
+    IDLE_MOTION_TYPE   = 0,
+    RANDOM_MOTION_TYPE = 1,
+};
+
+enum GameobjectTypes : uint8
+{
+    GAMEOBJECT_TYPE_DOOR   = 0,
+    GAMEOBJECT_TYPE_BUTTON = 1,
+    GAMEOBJECT_TYPE_CHEST  = 3,
+};
+
+enum EncounterState
+{
+    NOT_STARTED   = 0,
+    IN_PROGRESS   = 1,
+    FAIL          = 2,
+    DONE          = 3,
+    SPECIAL       = 4,
+    TO_BE_DECIDED = 5,
+};
+
+enum InventoryResult : uint8
+{
+    EQUIP_ERR_OK            = 0,
+    EQUIP_ERR_INVENTORY_FULL = 50,
+};
+
+constexpr uint8 NULL_BAG  = 0;
+constexpr uint8 NULL_SLOT = 255;
+constexpr uint32 MAX_ITEM_PROTO_STATS = 10;
+
+enum WorldIntConfigs
+{
+    CONFIG_MAX_PLAYER_LEVEL = 0,
+    INT_CONFIG_VALUE_COUNT
+};
+
+enum LootType : uint8 { LOOT_NONE = 0, LOOT_CORPSE = 1 };
+enum LootMethod : uint8 { FREE_FOR_ALL = 0, ROUND_ROBIN = 1, MASTER_LOOT = 2, GROUP_LOOT = 3, NEED_BEFORE_GREED = 4 };
+
+enum MailMessageType { MAIL_NORMAL = 0, MAIL_AUCTION = 2, MAIL_CREATURE = 3 };
+enum MailStationery  { MAIL_STATIONERY_TEST = 1, MAIL_STATIONERY_DEFAULT = 41, MAIL_STATIONERY_GM = 61 };
+enum MailCheckMask   { MAIL_CHECK_MASK_NONE = 0 };
+
+class Map;
+class InstanceMap;
+class Unit;
+class Player;
+class Creature;
+class GameObject;
+class Group;
+class WorldSession;
+class CreatureAI;
+class Item;
+struct SpellInfo;
+
+// ---- Object / WorldObject ----
+class WorldObject : public Position
+{
+public:
+    WorldObject(TypeID type, ObjectGuid guid, uint32 entry, std::string name)
+        : _type(type), _guid(guid), _entry(entry), _name(std::move(name)) {}
+    virtual ~WorldObject() = default;
+
+    ObjectGuid         GetGUID() const  { return _guid; }
+    uint32             GetEntry() const { return _entry; }
+    TypeID             GetTypeId() const { return _type; }
+    std::string const& GetName() const  { return _name; }
+
+    bool   IsInWorld() const { return _inWorld; }
+    Map*   GetMap() const    { return _map; }
+    uint32 GetMapId() const;
+    uint32 GetInstanceId() const;
+
+    Player*         ToPlayer()         { return _type == TYPEID_PLAYER ? reinterpret_cast<Player*>(this) : nullptr; }
+    Player const*   ToPlayer() const   { return _type == TYPEID_PLAYER ? reinterpret_cast<Player const*>(this) : nullptr; }
+    Creature*       ToCreature()       { return _type == TYPEID_UNIT ? reinterpret_cast<Creature*>(this) : nullptr; }
+    Creature const* ToCreature() const { return _type == TYPEID_UNIT ? reinterpret_cast<Creature const*>(this) : nullptr; }
+
+    float GetDistance(WorldObject const* o) const { return GetExactDist(o); }
+    bool  IsWithinDistInMap(WorldObject const* o, float dist) const
+    {
+        return o && o->_map == _map && GetExactDistSq(o) <= dist * dist;
+    }
+    bool  IsWithinLOSInMap(WorldObject const*) const { return true; }
+
+    void   SetUInt32Value(uint16 field, uint32 v) { _fields[field] = v; }
+    uint32 GetUInt32Value(uint16 field) const     { return _fields[field]; }
+    void   SetFlag(uint16 field, uint32 f)        { _fields[field] |= f; }
+    void   RemoveFlag(uint16 field, uint32 f)     { _fields[field] &= ~f; }
+    bool   HasFlag(uint16 field, uint32 f) const  { return (_fields[field] & f) != 0; }
+    void   SetByteValue(uint16 field, uint8 offset, uint8 v)
+    {
+        _fields[field] = (_fields[field] & ~(0xFFu << (offset * 8))) | (uint32(v) << (offset * 8));
+    }
+    void   SetObjectScale(float s) { _scale = s; }
+    float  GetObjectScale() const  { return _scale; }
+    void   setActive(bool on)      { _active = on; }
+    bool   isActiveObject() const  { return _active; }
+    void   UpdateObjectVisibility(bool /*forced*/ = true) {}
+    void   SendUpdateToPlayer(Player* /*player*/) {}
+
+    void GetCreatureListWithEntryInGrid(std::list<Creature*>& list, uint32 entry, float maxSearchRange) const;
+
+    // Stub-only: map membership is managed by Map::AddPlayer/AddCreature.
+    void SetMapInternal(Map* map, bool inWorld) { _map = map; _inWorld = inWorld; }
+
+protected:
+    TypeID      _type;
+    ObjectGuid  _guid;
+    uint32      _entry;
+    std::string _name;
+    Map*        _map = nullptr;
+    bool        _inWorld = false;
+    bool        _active = false;
+    float       _scale = 1.0f;
+    uint32      _fields[STUB_FIELD_COUNT] = {};
+};
+
+// ---- Aura ----
+class Aura
+{
+public:
+    Aura(uint32 id, Unit* owner, ObjectGuid caster) : _id(id), _owner(owner), _casterGuid(caster) {}
+
+    uint32     GetId() const { return _id; }
+    ObjectGuid GetCasterGUID() const { return _casterGuid; }
+    Unit*      GetCaster() const;
+    Unit*      GetOwner() const { return _owner; }
+    uint8      GetStackAmount() const { return _stacks; }
+    void       SetStackAmount(uint8 n) { _stacks = n; }
+    void       SetMaxDuration(int32 d) { _maxDuration = d; }
+    void       SetDuration(int32 d) { _duration = d; }
+    int32      GetDuration() const { return _duration; }
+
+private:
+    uint32     _id;
+    Unit*      _owner;
+    ObjectGuid _casterGuid;
+    uint8      _stacks = 1;
+    int32      _maxDuration = -1;
+    int32      _duration = -1;
+};
+
+class AuraApplication
+{
+public:
+    explicit AuraApplication(std::unique_ptr<Aura> base) : _base(std::move(base)) {}
+    Aura* GetBase() const { return _base.get(); }
+
+private:
+    std::unique_ptr<Aura> _base;
+};
+
+// ---- MotionMaster ----
+class MotionMaster
+{
+public:
+    void MoveRandom(float wanderDistance = 0.0f) { _type = RANDOM_MOTION_TYPE; _wander = wanderDistance; }
+    void MoveIdle() { _type = IDLE_MOTION_TYPE; }
+    MovementGeneratorType GetCurrentMovementGeneratorType() const { return _type; }
+
+private:
+    MovementGeneratorType _type = IDLE_MOTION_TYPE;
+    float _wander = 0.0f;
+};
+
+// ---- Unit ----
+class Unit : public WorldObject
+{
+public:
+    typedef std::multimap<uint32, AuraApplication*> AuraApplicationMap;
+
+    using WorldObject::WorldObject;
+    ~Unit() override;
+
+    bool IsAlive() const { return _alive; }
+    void SetAliveInternal(bool alive) { _alive = alive; }
+
+    uint8  GetLevel() const { return _level; }
+    void   SetLevel(uint8 lvl) { _level = lvl; }
+    uint32 GetHealth() const { return _health; }
+    uint32 GetMaxHealth() const { return _maxHealth; }
+    void   SetHealth(uint32 hp) { _health = std::min(hp, _maxHealth); }
+    void   SetMaxHealth(uint32 hp) { _maxHealth = hp; if (_health > hp) _health = hp; }
+    bool   HealthBelowPct(int32 pct) const { return uint64(_health) * 100 < uint64(_maxHealth) * uint64(pct); }
+
+    void   SetFaction(uint32 f) { _faction = f; }
+    uint32 GetFaction() const   { return _faction; }
+    bool   IsHostileTo(Unit const* u) const;
+    bool   IsFriendlyTo(Unit const* u) const { return !IsHostileTo(u); }
+
+    void        SetReactState(ReactStates s) { _react = s; }
+    ReactStates GetReactState() const        { return _react; }
+    bool        HasReactState(ReactStates s) const { return _react == s; }
+
+    void SetImmuneToPC(bool on)  { on ? SetFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IMMUNE_TO_PC)  : RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IMMUNE_TO_PC); }
+    void SetImmuneToNPC(bool on) { on ? SetFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IMMUNE_TO_NPC) : RemoveFlag(UNIT_FIELD_FLAGS, UNIT_FLAG_IMMUNE_TO_NPC); }
+    void SetDynamicFlag(uint32 f) { SetFlag(UNIT_DYNAMIC_FLAGS, f); }
+
+    void   SetBaseWeaponDamage(WeaponAttackType att, WeaponDamageRange r, float v) { _weaponDamage[att][r] = v; }
+    float  GetWeaponDamageRange(WeaponAttackType att, WeaponDamageRange r) const   { return _weaponDamage[att][r]; }
+    void   UpdateDamagePhysical(WeaponAttackType) {}
+    void   SetArmor(uint32 a) { _armor = a; }
+    uint32 GetArmor() const   { return _armor; }
+    void   SetResistance(SpellSchools school, int32 v) { _resist[school] = v; }
+    void   ApplySpellImmune(uint32 /*spellId*/, uint32 /*op*/, uint32 /*type*/, bool /*apply*/) {}
+    uint32 GetAttackTime(WeaponAttackType) const { return _attackTime; }
+    void   SetAttackTime(WeaponAttackType, uint32 ms) { _attackTime = ms; }
+
+    // Combat
+    bool  IsInCombat() const;
+    void  SetInCombatWith(Unit* enemy);
+    void  AddThreat(Unit* victim, float threat);
+    Unit* GetVictim() const;
+    bool  Attack(Unit* victim, bool meleeAttack);
+    void  AttackStop() { _victim.Clear(); }
+    void  CombatStop() { _combat.clear(); _threat.clear(); _victim.Clear(); }
+    Unit* SelectVictim();
+    Unit* GetOwner() const { return nullptr; }
+    void  CastSpell(Unit* target, uint32 spellId, bool triggered = false);
+
+    MotionMaster* GetMotionMaster() { return &_motion; }
+
+    // Auras
+    AuraApplicationMap&       GetAppliedAuras()       { return _appliedAuras; }
+    AuraApplicationMap const& GetAppliedAuras() const { return _appliedAuras; }
+    Aura* AddAura(uint32 spellId, Unit* target);
+    void  RemoveAura(uint32 spellId);
+    bool  HasAura(uint32 spellId) const { return _appliedAuras.count(spellId) != 0; }
+
+    // Stub-only
+    uint32& SwingTimer() { return _swingTimer; }
+
+protected:
+    bool        _alive = true;
+    uint8       _level = 1;
+    uint32      _health = 1;
+    uint32      _maxHealth = 1;
+    uint32      _faction = 35;
+    ReactStates _react = REACT_AGGRESSIVE;
+    float       _weaponDamage[3][2] = {};
+    uint32      _armor = 0;
+    int32       _resist[MAX_SPELL_SCHOOL] = {};
+    uint32      _attackTime = 2000;
+    uint32      _swingTimer = 0;
+    MotionMaster _motion;
+    ObjectGuid  _victim;
+    std::vector<ObjectGuid> _combat;
+    std::vector<ObjectGuid> _threat;
+    AuraApplicationMap _appliedAuras;
+};
+
+// ---- Creature ----
+struct CreatureTemplate
+{
+    uint32      Entry          = 0;
+    std::string Name;
+    uint32      type           = 0;
+    uint8       minlevel       = 1;
+    uint8       maxlevel       = 1;
+    uint32      rank           = 0;
+    uint8       unit_class     = 1;
+    uint32      BaseAttackTime = 2000;
+    std::string ScriptName;
+};
+
+struct LootStoreItem
+{
+    LootStoreItem(uint32 itemid, uint32 reference, float chance, bool needs_quest,
+                  uint16 lootmode, uint8 groupid, int32 mincount, uint8 maxcount)
+        : itemid(itemid), reference(reference), chance(chance), needs_quest(needs_quest),
+          lootmode(lootmode), groupid(groupid), mincount(mincount), maxcount(maxcount) {}
+
+    uint32 itemid;
+    uint32 reference;
+    float  chance;
+    bool   needs_quest;
+    uint16 lootmode;
+    uint8  groupid;
+    int32  mincount;
+    uint8  maxcount;
+};
+
+struct LootItem
+{
+    uint32 itemid = 0;
+    uint8  count = 1;
+    bool   is_looted = false;
+    bool   is_blocked = false;
+    bool   freeforall = false;
+    bool   is_underthreshold = false;
+    bool   is_counted = false;
+    bool   needs_quest = false;
+};
+
+struct Loot
+{
+    std::vector<LootItem> items;
+    uint32   gold = 0;
+    LootType loot_type = LOOT_NONE;
+
+    void clear() { items.clear(); gold = 0; loot_type = LOOT_NONE; }
+    bool empty() const { return items.empty() && gold == 0; }
+    bool isLooted() const
+    {
+        return gold == 0 && std::none_of(items.begin(), items.end(),
+            [](LootItem const& li) { return !li.is_looted; });
+    }
+    void AddItem(LootStoreItem const& item)
+    {
+        LootItem li;
+        li.itemid = item.itemid;
+        li.count  = uint8(item.mincount);
+        items.push_back(li);
+    }
+};
+
+class CreatureAI;
+
+struct CreatureData;
+struct SummonPropertiesEntry;
+
+class Creature : public Unit
+{
+public:
+    Creature(ObjectGuid guid, CreatureTemplate const* tmpl, uint32 spawnId);
+    ~Creature() override;
+
+    // Off-map construction, as in the core: Create() then Map::AddToMap().
+    bool Create(ObjectGuid::LowType guidlow, Map* map, uint32 phaseMask, uint32 entry, uint32 vehId,
+                float x, float y, float z, float ang, CreatureData const* data = nullptr);
+    void SetHomePosition(Position const& pos) { HomePosition = pos; }
+
+    CreatureTemplate const* GetCreatureTemplate() const { return _template; }
+    uint32 GetSpawnId() const { return _spawnId; }
+
+    void SetWanderDistance(float d) { _wanderDistance = d; }
+    void SetDefaultMovementType(MovementGeneratorType t) { _defaultMovement = t; }
+    void SetCorpseDelay(uint32 delay) { _corpseDelay = delay; }
+    uint32 GetCorpseDelay() const { return _corpseDelay; }
+    void SetRespawnTime(uint32 respawn) { _respawnDelay = respawn; }
+
+    bool SetAI(CreatureAI* ai);
+    CreatureAI* AI() const { return _ai.get(); }
+
+    void DespawnOrUnsummon(uint32 msTimeToDespawn = 0);
+    bool IsDespawnPending() const { return _despawnPending; }
+
+    bool IsPet() const      { return false; }
+    bool IsGuardian() const { return false; }
+    bool IsTotem() const    { return false; }
+    bool IsSummon() const   { return _summon; }
+
+    void SetLootRecipient(Unit* unit, bool withGroup = true);
+    ObjectGuid GetLootRecipientGUID() const { return _lootRecipient; }
+
+    Loot loot;
+
+    // Stub-only
+    Position HomePosition;
+    uint32   CorpseTimer = 0;
+
+protected:
+    Creature() : Unit(TYPEID_UNIT, ObjectGuid::Empty, 0, std::string()), _template(nullptr), _spawnId(0) {}
+    void InitFromTemplate(CreatureTemplate const* tmpl);
+
+    CreatureTemplate const* _template;
+    uint32 _spawnId;
+    float  _wanderDistance = 0.0f;
+    MovementGeneratorType _defaultMovement = IDLE_MOTION_TYPE;
+    uint32 _corpseDelay = 60;
+    uint32 _respawnDelay = 0;
+    bool   _despawnPending = false;
+    bool   _summon = false;
+    ObjectGuid _lootRecipient;
+    std::unique_ptr<CreatureAI> _ai;
+};
+
+class TempSummon : public Creature
+{
+public:
+    TempSummon(ObjectGuid guid, CreatureTemplate const* tmpl) : Creature(guid, tmpl, 0) { _summon = true; }
+    TempSummon(SummonPropertiesEntry const* /*properties*/, ObjectGuid /*owner*/, bool /*isWorldObject*/) { _summon = true; }
+
+    void InitStats(uint32 /*duration*/) {}
+    void InitSummon() {}
+};
+
+// ---- CreatureAI ----
+class CreatureAI
+{
+public:
+    enum EvadeReason
+    {
+        EVADE_REASON_NO_HOSTILES,
+        EVADE_REASON_BOUNDARY,
+        EVADE_REASON_NO_PATH,
+        EVADE_REASON_SEQUENCE_BREAK,
+        EVADE_REASON_OTHER,
+    };
+
+    explicit CreatureAI(Creature* creature) : me(creature) {}
+    virtual ~CreatureAI() = default;
+
+    virtual void MoveInLineOfSight(Unit* /*who*/) {}
+    virtual void UpdateAI(uint32 diff) = 0;
+    virtual void EnterEvadeMode(EvadeReason why = EVADE_REASON_OTHER);
+    virtual void JustDied(Unit* /*killer*/) {}
+    virtual void JustEngagedWith(Unit* /*who*/) {}
+    virtual void AttackStart(Unit* victim);
+
+protected:
+    bool UpdateVictim();
+    void DoMeleeAttackIfReady();
+
+    Creature* const me;
+};
+
+// ---- GameObject ----
+class GameObject : public WorldObject
+{
+public:
+    GameObject(ObjectGuid guid, uint32 entry, GameobjectTypes type)
+        : WorldObject(TYPEID_GAMEOBJECT, guid, entry, "GameObject"), _goType(type) {}
+
+    GameobjectTypes GetGoType() const { return _goType; }
+    void Delete();
+
+private:
+    GameobjectTypes _goType;
+};
+
+// ---- InstanceScript ----
+class InstanceScript
+{
+public:
+    explicit InstanceScript(uint32 encounterCount) : _states(encounterCount, NOT_STARTED) {}
+    virtual ~InstanceScript() = default;
+
+    EncounterState GetBossState(uint32 id) const { return id < _states.size() ? _states[id] : TO_BE_DECIDED; }
+    bool SetBossState(uint32 id, EncounterState s)
+    {
+        if (id >= _states.size())
+            return false;
+        _states[id] = s;
+        return true;
+    }
+
+private:
+    std::vector<EncounterState> _states;
+};
+
+// ---- Map / InstanceMap ----
+class MapReference
+{
+public:
+    explicit MapReference(Player* p) : _player(p) {}
+    Player* GetSource() const { return _player; }
+
+private:
+    Player* _player;
+};
+
+class Map
+{
+public:
+    typedef std::vector<MapReference> PlayerList;
+    typedef std::unordered_multimap<uint32, Creature*>   CreatureBySpawnIdContainer;
+    typedef std::unordered_multimap<uint32, GameObject*> GameObjectBySpawnIdContainer;
+
+    Map(uint32 id, uint32 instanceId) : _id(id), _instanceId(instanceId) {}
+    virtual ~Map();
+
+    uint32 GetId() const         { return _id; }
+    uint32 GetInstanceId() const { return _instanceId; }
+    virtual bool IsDungeon() const { return false; }
+    InstanceMap* ToInstanceMap();
+
+    PlayerList const& GetPlayers() const { return _players; }
+    bool HavePlayers() const { return !_players.empty(); }
+
+    Creature* GetCreature(ObjectGuid guid);
+    CreatureBySpawnIdContainer&   GetCreatureBySpawnIdStore()   { return _creatureBySpawnId; }
+    GameObjectBySpawnIdContainer& GetGameObjectBySpawnIdStore() { return _goBySpawnId; }
+
+    TempSummon* SummonCreature(uint32 entry, Position const& pos, void* properties = nullptr,
+                               uint32 duration = 0, WorldObject* summoner = nullptr,
+                               uint32 spellId = 0, uint32 vehId = 0, bool visibleBySummonerOnly = false);
+
+    template<HighGuid high>
+    ObjectGuid::LowType GenerateLowGuid()
+    {
+        static_assert(high == HighGuid::Unit, "stub generates unit GUIDs only");
+        return GenerateCreatureLowGuid();
+    }
+    bool AddToMap(Creature* creature, bool checkTransport = false);
+
+    // Stub-only
+    void AddPlayer(Player* player);
+    void RemovePlayer(Player* player);
+    Creature* AddDbCreature(CreatureTemplate const* tmpl, Position const& pos, uint32 spawnId);
+    GameObject* AddDbGameObject(uint32 entry, GameobjectTypes type, Position const& pos, uint32 spawnId);
+    void Update(uint32 diff);
+    std::vector<Creature*> const& GetAllCreatures() const { return _creatureList; }
+    uint32 EmptyTime = 0;
+    size_t GetCreatureCount() const { return _creatures.size(); }
+
+protected:
+    void RemoveCreature(ObjectGuid guid);
+    static ObjectGuid::LowType GenerateCreatureLowGuid();
+
+    uint32 _id;
+    uint32 _instanceId;
+    PlayerList _players;
+    std::unordered_map<ObjectGuid, std::unique_ptr<Creature>> _creatures;
+    std::vector<Creature*> _creatureList;
+    std::vector<std::unique_ptr<GameObject>> _gameObjects;
+    CreatureBySpawnIdContainer   _creatureBySpawnId;
+    GameObjectBySpawnIdContainer _goBySpawnId;
+    std::vector<ObjectGuid> _pendingDespawn;
+    std::mutex _despawnLock;
+};
+
+class InstanceMap : public Map
+{
+public:
+    InstanceMap(uint32 id, uint32 instanceId, uint32 encounters)
+        : Map(id, instanceId), _script(std::make_unique<InstanceScript>(encounters)) {}
+
+    bool IsDungeon() const override { return true; }
+    InstanceScript* GetInstanceScript() { return _script.get(); }
+
+private:
+    std::unique_ptr<InstanceScript> _script;
+};
+
+inline InstanceMap* Map::ToInstanceMap() { return IsDungeon() ? static_cast<InstanceMap*>(this) : nullptr; }
+
+// ---- Item / ObjectMgr ----
+struct _ItemStat
+{
+    uint32 ItemStatType  = 0;
+    int32  ItemStatValue = 0;
+};
+
+struct ItemTemplate
+{
+    uint32      ItemId        = 0;
+    std::string Name1;
+    uint32      Class         = 0;
+    uint32      SubClass      = 0;
+    uint32      Quality       = 0;
+    uint32      InventoryType = 0;
+    int32       AllowableClass = -1;
+    uint32      ItemLevel     = 0;
+    uint32      RequiredLevel = 0;
+    _ItemStat   ItemStat[MAX_ITEM_PROTO_STATS];
+};
+
+class Item
+{
+public:
+    explicit Item(uint32 entry) : _entry(entry) {}
+    static Item* CreateItem(uint32 item, uint32 count, Player const* player = nullptr);
+    uint32 GetEntry() const { return _entry; }
+
+private:
+    uint32 _entry;
+};
+
+struct ItemPosCount
+{
+    uint16 pos;
+    uint32 count;
+};
+typedef std::vector<ItemPosCount> ItemPosCountVec;
+
+class ObjectMgr
+{
+public:
+    static ObjectMgr* instance();
+
+    ItemTemplate const*     GetItemTemplate(uint32 entry) const;
+    CreatureTemplate const* GetCreatureTemplate(uint32 entry) const;
+
+    // Stub-only: filled by the synthetic world database.
+    std::unordered_map<uint32, ItemTemplate>     ItemTemplates;
+    std::unordered_map<uint32, CreatureTemplate> CreatureTemplates;
+};
+
+#define sObjectMgr ObjectMgr::instance()
+
+// ---- World ----
+class World
+{
+public:
+    static World* instance();
+    uint32 getIntConfig(WorldIntConfigs index) const { return index == CONFIG_MAX_PLAYER_LEVEL ? 80 : 0; }
+};
+
+#define sWorld World::instance()
+
+// ---- WorldSession / Chat ----
+enum ChatMsg : uint32
+{
+    CHAT_MSG_SYSTEM = 0x00,
+};
+
+enum Language : uint32
+{
+    LANG_UNIVERSAL = 0,
+};
+
+// Stub-only: holds the encoded size, not the bytes.
+class WorldPacket
+{
+public:
+    size_t size() const { return _size; }
+    void   clear()      { _size = 0; }
+
+    size_t _size = 0;
+};
+
+class WorldSession
+{
+public:
+    explicit WorldSession(Player* player) : _player(player) {}
+    Player* GetPlayer() const { return _player; }
+
+    void SendPacket(WorldPacket const* packet);
+
+    // Stub-only: outbound system messages.
+    std::atomic<uint64> MessagesSent{ 0 };
+    std::atomic<uint64> BytesSent{ 0 };
+
+private:
+    Player* _player;
+};
+
+class ChatHandler
+{
+public:
+    explicit ChatHandler(WorldSession* session) : _session(session) {}
+    virtual ~ChatHandler() = default;
+
+    static size_t BuildChatPacket(WorldPacket& data, ChatMsg chatType, Language language,
+                                  ObjectGuid senderGUID, ObjectGuid receiverGUID,
+                                  std::string_view message, uint8 chatTag);
+
+    void SendSysMessage(std::string_view str, bool escapeCharacters = false);
+    void PSendSysMessage(std::string_view str) { SendSysMessage(str); }
+    WorldSession* GetSession() { return _session; }
+    Player* GetPlayer() const { return _session ? _session->GetPlayer() : nullptr; }
+
+private:
+    WorldSession* _session;
+};
+
+// ---- Group ----
+class GroupReference
+{
+public:
+    explicit GroupReference(Player* p) : _player(p) {}
+    Player*         GetSource() const { return _player; }
+    GroupReference* next() const      { return _next; }
+    void            SetNext(GroupReference* n) { _next = n; }
+
+private:
+    Player*         _player;
+    GroupReference* _next = nullptr;
+};
+
+class Group
+{
+public:
+    Group() = default;
+
+    GroupReference* GetFirstMember() { return _members.empty() ? nullptr : _members.front().get(); }
+    uint32     GetMembersCount() const { return uint32(_members.size()); }
+    uint8      GetLootThreshold() const { return 2; }
+    LootMethod GetLootMethod() const    { return GROUP_LOOT; }
+    void       GroupLoot(Loot* loot, WorldObject* pLootedObject);
+    ObjectGuid GetLeaderGUID() const    { return _leader; }
+
+    // Stub-only
+    void AddMember(Player* player);
+
+private:
+    std::vector<std::unique_ptr<GroupReference>> _members;
+    ObjectGuid _leader;
+};
+
+// ---- Player ----
+class Player : public Unit
+{
+public:
+    Player(ObjectGuid guid, std::string name, uint8 level, uint8 cls);
+    ~Player() override;
+
+    WorldSession* GetSession() const { return _session.get(); }
+    Group*        GetGroup() const   { return _group; }
+    void          SetGroupInternal(Group* g) { _group = g; }
+    uint8         getClass() const   { return _class; }
+    bool          IsGameMaster() const { return false; }
+
+    bool TeleportTo(uint32 mapid, float x, float y, float z, float orientation,
+                    uint32 options = 0, Unit* target = nullptr, bool newInstance = false);
+    bool IsBeingTeleported() const { return _teleportPending; }
+
+    void ResurrectPlayer(float restorePercent, bool applySickness = false);
+    void SpawnCorpseBones(bool triggerSave = true);
+    void GiveXP(uint32 xp, Unit* victim, float group_rate = 1.0f, bool isLFGReward = false);
+    bool ModifyMoney(int32 amount, bool sendError = true);
+    uint32 GetMoney() const { return _money; }
+
+    InventoryResult CanStoreNewItem(uint8 bag, uint8 slot, ItemPosCountVec& dest,
+                                    uint32 item, uint32 count, uint32* no_space_count = nullptr) const;
+    Item* StoreNewItem(ItemPosCountVec const& pos, uint32 item, bool update, int32 randomPropertyId = 0);
+    void  SendNewItem(Item* item, uint32 count, bool received, bool created, bool broadcast = false, bool sendChatMessage = true);
+
+    // Stub-only
+    struct PendingTeleport { uint32 MapId; Position Pos; };
+    bool TakePendingTeleport(PendingTeleport& out);
+    void ClearInventory() { _items.clear(); }
+    size_t GetInventoryCount() const { return _items.size(); }
+    uint64 GetXP() const { return _xp; }
+    // Combat is derived, not flagged, here; Map::Update calls this to
+    // fire the enter / leave combat hooks on each edge.
+    void UpdateCombatHooks();
+
+    static constexpr size_t INVENTORY_SLOTS = 96;
+
+private:
+    std::unique_ptr<WorldSession> _session;
+    Group* _group = nullptr;
+    uint8  _class;
+    uint32 _money = 0;
+    uint64 _xp = 0;
+    bool   _teleportPending = false;
+    bool   _combatReported  = false;
+    PendingTeleport _teleport{};
+    std::vector<std::unique_ptr<Item>> _items;
+};
+
+// ---- ObjectAccessor ----
+namespace ObjectAccessor
+{
+    Player*   FindPlayer(ObjectGuid guid);
+    Player*   FindConnectedPlayer(ObjectGuid guid);
+    Creature* GetCreature(WorldObject const& u, ObjectGuid guid);
+    Unit*     GetUnit(WorldObject const& u, ObjectGuid guid);
+}
+
+// ---- Mail ----
+class MailSender
+{
+public:
+    MailSender(MailMessageType type, uint32 senderGuidLowOrEntry, MailStationery stationery = MAIL_STATIONERY_DEFAULT)
+        : _type(type), _sender(senderGuidLowOrEntry), _stationery(stationery) {}
+
+private:
+    MailMessageType _type;
+    uint32 _sender;
+    MailStationery _stationery;
+};
+
+class MailReceiver
+{
+public:
+    MailReceiver(Player* receiver, uint32 receiverLowGuid) : _receiver(receiver), _lowGuid(receiverLowGuid) {}
+    uint32 GetPlayerGUIDLow() const { return _lowGuid; }
+
+private:
+    Player* _receiver;
+    uint32  _lowGuid;
+};
+
+class Transaction;
+typedef std::shared_ptr<Transaction> CharacterDatabaseTransaction;
+
+class MailDraft
+{
+public:
+    MailDraft(std::string subject, std::string body) : _subject(std::move(subject)), _body(std::move(body)) {}
+    ~MailDraft();
+
+    MailDraft& AddItem(Item* item);
+    MailDraft& AddMoney(uint32 money) { _money = money; return *this; }
+    void SendMailTo(CharacterDatabaseTransaction trans, MailReceiver const& receiver, MailSender const& sender,
+                    MailCheckMask checked = MAIL_CHECK_MASK_NONE, uint32 deliver_delay = 0,
+                    uint32 custom_expiration = 0, bool deleteMailItemsFromDB = false, bool sendMail = true);
+
+private:
+    std::string _subject;
+    std::string _body;
+    uint32 _money = 0;
+    std::vector<Item*> _items;
+};
+
+// ---- Database ----
+class Field
+{
+public:
+    Field() = default;
+    Field(double num, std::string str) : _num(num), _str(std::move(str)) {}
+
+    template<typename T>
+    T Get() const
+    {
+        if constexpr (std::is_same_v<T, std::string>)
+            return _str;
+        else if constexpr (std::is_same_v<T, bool>)
+            return _num != 0.0;
+        else
+            return static_cast<T>(_num);
+    }
+    bool IsNull() const { return _null; }
+
+private:
+    double      _num = 0.0;
+    std::string _str;
+    bool        _null = false;
+};
+
+class ResultSet
+{
+public:
+    ResultSet(uint32 fieldCount, std::vector<Field> rows)
+        : _fieldCount(fieldCount), _rows(std::move(rows)) {}
+
+    Field* Fetch() { return &_rows[_row * _fieldCount]; }
+    bool   NextRow() { return ++_row < GetRowCount(); }
+    uint64 GetRowCount() const { return _fieldCount ? _rows.size() / _fieldCount : 0; }
+    uint32 GetFieldCount() const { return _fieldCount; }
+
+private:
+    uint32 _fieldCount;
+    size_t _row = 0;
+    std::vector<Field> _rows;
+};
+
+typedef std::shared_ptr<ResultSet> QueryResult;
+
+class Transaction
+{
+public:
+    void Append(std::string const& sql) { _statements.push_back(sql); }
+    size_t GetSize() const { return _statements.size(); }
+
+private:
+    std::vector<std::string> _statements;
+};
+
+class DatabaseWorkerPool
+{
+public:
+    typedef std::function<QueryResult(std::string const&)> Provider;
+
+    explicit DatabaseWorkerPool(char const* name) : _name(name) {}
+
+    // Synchronous on the calling thread, like the core's DirectExecute/Query.
+    QueryResult Query(std::string const& sql);
+    QueryResult Query(char const* sql) { return Query(std::string(sql)); }
+
+    // Queued to the async worker; never blocks the caller.
+    void Execute(std::string const& sql);
+    void Execute(char const* sql) { Execute(std::string(sql)); }
+
+    CharacterDatabaseTransaction BeginTransaction() { return std::make_shared<Transaction>(); }
+    void CommitTransaction(CharacterDatabaseTransaction trans);
+
+    // Stub-only
+    void   SetProvider(Provider p) { _provider = std::move(p); }
+    void   SetQueryLatencyUs(uint32 us) { _latencyUs = us; }
+    uint64 GetSyncQueries() const   { return _syncQueries.load(std::memory_order_relaxed); }
+    uint64 GetSyncQueryNs() const   { return _syncQueryNs.load(std::memory_order_relaxed); }
+    uint64 GetAsyncStatements() const { return _asyncStatements.load(std::memory_order_relaxed); }
+    char const* GetName() const { return _name; }
+
+private:
+    char const* _name;
+    Provider _provider;
+    uint32   _latencyUs = 0;
+    std::atomic<uint64> _syncQueries{ 0 };
+    std::atomic<uint64> _syncQueryNs{ 0 };
+    std::atomic<uint64> _asyncStatements{ 0 };
+};
+
+extern DatabaseWorkerPool WorldDatabase;
+extern DatabaseWorkerPool CharacterDatabase;
+
+// ---- SpellInfo / SpellMgr ----
+struct SpellInfo
+{
+    uint32 Id = 0;
+    uint32 StackAmount = 0;
+    uint32 SchoolMask = 1;
+};
+
+class SpellMgr
+{
+public:
+    static SpellMgr* instance();
+    SpellInfo const* GetSpellInfo(uint32 spellId);
+
+    static constexpr uint32 MAX_SPELL_ID = 100000;
+
+private:
+    SpellMgr();
+    ~SpellMgr();
+
+    // Filled on first lookup; lookups stay lock-free like the core's array.
+    std::unique_ptr<std::atomic<SpellInfo*>[]> _spells;
+};
+
+#define sSpellMgr SpellMgr::instance()
+
+// ---- ScriptMgr ----
+namespace Stub
+{
+    template<typename T>
+    std::vector<T*>& ScriptList()
+    {
+        static std::vector<T*> list;
+        return list;
+    }
+}
+
+class ScriptObject
+{
+public:
+    explicit ScriptObject(char const* name) : _name(name) {}
+    virtual ~ScriptObject() = default;
+    std::string const& GetName() const { return _name; }
+
+private:
+    std::string _name;
+};
+
+class UnitScript : public ScriptObject
+{
+public:
+    explicit UnitScript(char const* name, bool /*addToScripts*/ = true) : ScriptObject(name)
+    {
+        Stub::ScriptList<UnitScript>().push_back(this);
+    }
+
+    virtual void OnHeal(Unit* /*healer*/, Unit* /*reciever*/, uint32& /*gain*/) {}
+    virtual void OnDamage(Unit* /*attacker*/, Unit* /*victim*/, uint32& /*damage*/) {}
+    virtual void ModifyPeriodicDamageAurasTick(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/, SpellInfo const* /*spellInfo*/) {}
+    virtual void ModifyMeleeDamage(Unit* /*target*/, Unit* /*attacker*/, uint32& /*damage*/) {}
+    virtual void ModifySpellDamageTaken(Unit* /*target*/, Unit* /*attacker*/, int32& /*damage*/, SpellInfo const* /*spellInfo*/) {}
+    virtual void OnUnitDeath(Unit* /*unit*/, Unit* /*killer*/) {}
+};
+
+class PlayerScript : public ScriptObject
+{
+public:
+    explicit PlayerScript(char const* name) : ScriptObject(name)
+    {
+        Stub::ScriptList<PlayerScript>().push_back(this);
+    }
+
+    virtual void OnPlayerKilledByCreature(Creature* /*killer*/, Player* /*killed*/) {}
+    virtual void OnPlayerLogin(Player* /*player*/) {}
+    virtual void OnPlayerLogout(Player* /*player*/) {}
+    virtual void OnPlayerMapChanged(Player* /*player*/) {}
+    virtual void OnPlayerJustDied(Player* /*player*/) {}
+    virtual void OnPlayerResurrect(Player* /*player*/, float /*restorePercent*/, bool /*applySickness*/) {}
+    virtual void OnPlayerEnterCombat(Player* /*player*/, Unit* /*enemy*/) {}
+    virtual void OnPlayerLeaveCombat(Player* /*player*/) {}
+};
+
+class AllMapScript : public ScriptObject
+{
+public:
+    explicit AllMapScript(char const* name) : ScriptObject(name)
+    {
+        Stub::ScriptList<AllMapScript>().push_back(this);
+    }
+
+    virtual void OnPlayerEnterAll(Map* /*map*/, Player* /*player*/) {}
+    virtual void OnPlayerLeaveAll(Map* /*map*/, Player* /*player*/) {}
+    virtual void OnMapUpdate(Map* /*map*/, uint32 /*diff*/) {}
+    virtual void OnDestroyInstance(void* /*mapInstanced*/, Map* /*map*/) {}
+};
+
+class WorldScript : public ScriptObject
+{
+public:
+    explicit WorldScript(char const* name) : ScriptObject(name)
+    {
+        Stub::ScriptList<WorldScript>().push_back(this);
+    }
+
+    virtual void OnAfterConfigLoad(bool /*reload*/) {}
+    virtual void OnStartup() {}
+    virtual void OnShutdown() {}
+    virtual void OnUpdate(uint32 /*diff*/) {}
+};
+
+// ---- Simulation plumbing (stub-only) ----
+namespace Stub
+{
+    struct Counters
+    {
+        std::atomic<uint64> MeleeHooks{ 0 };
+        std::atomic<uint64> SpellHooks{ 0 };
+        std::atomic<uint64> PeriodicHooks{ 0 };
+        std::atomic<uint64> CreatureDeaths{ 0 };
+        std::atomic<uint64> PlayerDeaths{ 0 };
+        std::atomic<uint64> ChatMessages{ 0 };
+        std::atomic<uint64> ChatBytes{ 0 };
+        std::atomic<uint64> ChatPacketsBuilt{ 0 };
+        std::atomic<uint64> Mails{ 0 };
+        std::atomic<uint64> ItemsStored{ 0 };
+        std::atomic<uint64> Summons{ 0 };
+        std::atomic<uint64> Despawns{ 0 };
+        std::atomic<uint64> GroupLoots{ 0 };
+        std::atomic<uint64> Teleports{ 0 };
+    };
+    extern Counters gCounters;
+
+    // Per-player behaviour run inside Map::Update; the driver supplies it.
+    typedef void (*PlayerUpdateFn)(Player* player, Map* map, uint32 diff);
+    void SetPlayerUpdateHandler(PlayerUpdateFn fn);
+
+    // Damage entry points. Each runs the matching UnitScript hooks first,
+    // then applies the damage, so scripts see the same traffic as in core.
+    void MeleeHit(Unit* attacker, Unit* victim, uint32 damage);
+    void SpellHit(Unit* caster, Unit* victim, SpellInfo const* spell, int32 damage);
+    void PeriodicTick(Unit* caster, Unit* victim, SpellInfo const* spell, uint32 damage);
+    void DealDamage(Unit* attacker, Unit* victim, uint32 damage);
+    void KillUnit(Unit* killer, Unit* victim);
+
+    // Deletes every registered script, as ScriptMgr::Unload does at shutdown.
+    void UnloadScripts();
+}
+
+#endif // DM_STUB_CORE_H